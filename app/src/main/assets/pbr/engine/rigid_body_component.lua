@@ -52,6 +52,16 @@ local function SetLocation ( self, location )
     av_RigidBodyComponentSetLocation ( self._handle, location._handle )
 end
 
+-- Sensor reports overlaps via Scene:GetSensorEvents and does not collide with other bodies.
+local function SetSensor ( self, isSensor )
+    assert ( type ( self ) == "table" and self._type == eObjectType.RigidBodyComponent,
+        [[RigidBodyComponent:SetSensor - Calling not via ":" syntax.]]
+    )
+
+    assert ( type ( isSensor ) == "boolean", [[RigidBodyComponent:SetSensor - "isSensor" is not a boolean.]] )
+    av_RigidBodyComponentSetSensor ( self._handle, isSensor )
+end
+
 local function SetShapeBox ( self, size, forceAwake )
     assert ( type ( self ) == "table" and self._type == eObjectType.RigidBodyComponent,
         [[RigidBodyComponent:SetShapeBox - Calling not via ":" syntax.]]
@@ -65,6 +75,31 @@ local function SetShapeBox ( self, size, forceAwake )
     av_RigidBodyComponentSetShapeBox ( self._handle, size._handle, forceAwake )
 end
 
+local function SetShapeCapsule ( self, radius, height, forceAwake )
+    assert ( type ( self ) == "table" and self._type == eObjectType.RigidBodyComponent,
+        [[RigidBodyComponent:SetShapeCapsule - Calling not via ":" syntax.]]
+    )
+
+    assert ( type ( radius ) == "number", [[RigidBodyComponent:SetShapeCapsule - "radius" is not number.]] )
+    assert ( type ( height ) == "number", [[RigidBodyComponent:SetShapeCapsule - "height" is not number.]] )
+
+    assert ( type ( forceAwake ) == "boolean",
+        [[RigidBodyComponent:SetShapeCapsule - "forceAwake" is not a boolean.]]
+    )
+
+    av_RigidBodyComponentSetShapeCapsule ( self._handle, radius, height, forceAwake )
+end
+
+local function SetShapeMesh ( self, meshFile, forceAwake )
+    assert ( type ( self ) == "table" and self._type == eObjectType.RigidBodyComponent,
+        [[RigidBodyComponent:SetShapeMesh - Calling not via ":" syntax.]]
+    )
+
+    assert ( type ( meshFile ) == "string", [[RigidBodyComponent:SetShapeMesh - "meshFile" is not a string.]] )
+    assert ( type ( forceAwake ) == "boolean", [[RigidBodyComponent:SetShapeMesh - "forceAwake" is not a boolean.]] )
+    av_RigidBodyComponentSetShapeMesh ( self._handle, meshFile, forceAwake )
+end
+
 local function SetShapeSphere ( self, radius, forceAwake )
     assert ( type ( self ) == "table" and self._type == eObjectType.RigidBodyComponent,
         [[RigidBodyComponent:SetShapeSphere - Calling not via ":" syntax.]]
@@ -139,7 +174,10 @@ function RegisterRigidBodyComponent ( handle, nativeRigidBody )
     obj.AddForce = AddForce
     obj.GetLocation = GetLocation
     obj.SetLocation = SetLocation
+    obj.SetSensor = SetSensor
     obj.SetShapeBox = SetShapeBox
+    obj.SetShapeCapsule = SetShapeCapsule
+    obj.SetShapeMesh = SetShapeMesh
     obj.SetShapeSphere = SetShapeSphere
     obj.GetTransform = GetTransform
     obj.GetVelocityLinear = GetVelocityLinear
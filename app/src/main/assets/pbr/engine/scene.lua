@@ -4,6 +4,7 @@ require "av://engine/div_ui_element.lua"
 require "av://engine/image_ui_element.lua"
 require "av://engine/rigid_body_component.lua"
 require "av://engine/script_component.lua"
+require "av://engine/sensor_event.lua"
 require "av://engine/sound_emitter_global_component.lua"
 require "av://engine/sound_emitter_spatial_component.lua"
 require "av://engine/static_mesh_component.lua"
@@ -122,10 +123,42 @@ local function GetPenetrationBox ( self, localMatrix, size, groups )
     return av_SceneGetPenetrationBox ( self._handle, localMatrix._handle, size._handle, groups._handle )
 end
 
+-- Method returns table with "_count", "_penetrations", "_queryCount" and "_offsets" fields. Penetrations of the query
+-- "i" are in range [ _offsets[ i ], _offsets[ i + 1 ] ) of "_penetrations" array. The table is reused by the next call.
+local function GetPenetrationBoxBatch ( self, localMatrices, sizes, count, groups )
+    assert ( type ( self ) == "table" and self._type == eObjectType.Scene,
+        [[Scene:GetPenetrationBoxBatch - Calling not via ":" syntax.]]
+    )
+
+    assert ( type ( localMatrices ) == "table", [[Scene:GetPenetrationBoxBatch - "localMatrices" is not table.]] )
+    assert ( type ( sizes ) == "table", [[Scene:GetPenetrationBoxBatch - "sizes" is not table.]] )
+
+    assert ( type ( count ) == "number" and count <= #localMatrices and count <= #sizes,
+        [[Scene:GetPenetrationBoxBatch - "count" is not valid.]]
+    )
+
+    assert ( type ( groups ) == "table" and groups._type == eObjectType.BitField,
+        [[Scene:GetPenetrationBoxBatch - "groups" is not BitField.]]
+    )
+
+    return av_SceneGetPenetrationBoxBatch ( self._handle, localMatrices, sizes, count, groups._handle )
+end
+
 local function GetPhysicsToRendererScaleFactor ( self )
     return av_SceneGetPhysicsToRendererScaleFactor ()
 end
 
+-- Method returns table with "_count", "_sensors", "_others" and "_types" fields. The event "i" is described by
+-- items "i" of the arrays. "_types" items are eSensorEvent values. The events are collected by the last physics
+-- simulation. The table is reused by the next call.
+local function GetSensorEvents ( self )
+    assert ( type ( self ) == "table" and self._type == eObjectType.Scene,
+        [[Scene:GetSensorEvents - Calling not via ":" syntax.]]
+    )
+
+    return av_SceneGetSensorEvents ( self._handle )
+end
+
 local function GetRendererToPhysicsScaleFactor ( self )
     return av_SceneGetRendererToPhysicsScaleFactor ()
 end
@@ -285,6 +318,27 @@ local function Raycast ( self, from, to, groups )
     return av_SceneRaycast ( self._handle, from._handle, to._handle, groups._handle )
 end
 
+-- Method returns table with "_count" and "_hits" fields. Every ray has item in "_hits" array with "_isHit", "_body",
+-- "_point" and "_normal" fields. The table is reused by the next call.
+local function RaycastBatch ( self, froms, tos, count, groups )
+    assert ( type ( self ) == "table" and self._type == eObjectType.Scene,
+        [[Scene:RaycastBatch - Calling not via ":" syntax.]]
+    )
+
+    assert ( type ( froms ) == "table", [[Scene:RaycastBatch - "froms" is not table.]] )
+    assert ( type ( tos ) == "table", [[Scene:RaycastBatch - "tos" is not table.]] )
+
+    assert ( type ( count ) == "number" and count <= #froms and count <= #tos,
+        [[Scene:RaycastBatch - "count" is not valid.]]
+    )
+
+    assert ( type ( groups ) == "table" and groups._type == eObjectType.BitField,
+        [[Scene:RaycastBatch - "groups" is not BitField.]]
+    )
+
+    return av_SceneRaycastBatch ( self._handle, froms, tos, count, groups._handle )
+end
+
 local function SetActiveCamera ( self, camera )
     assert ( type ( self ) == "table" and self._type == eObjectType.Scene,
         [[Scene:SetActiveCamera - Calling not via ":" syntax.]]
@@ -428,7 +482,9 @@ local function Constructor ( self, handle )
     obj.FindActor = FindActor
     obj.FindActors = FindActors
     obj.GetPenetrationBox = GetPenetrationBox
+    obj.GetPenetrationBoxBatch = GetPenetrationBoxBatch
     obj.GetPhysicsToRendererScaleFactor = GetPhysicsToRendererScaleFactor
+    obj.GetSensorEvents = GetSensorEvents
     obj.GetRendererToPhysicsScaleFactor = GetRendererToPhysicsScaleFactor
     obj.GetRenderTargetAspectRatio = GetRenderTargetAspectRatio
     obj.GetRenderTargetWidth = GetRenderTargetWidth
@@ -442,6 +498,7 @@ local function Constructor ( self, handle )
     obj.OverlapTestBoxBox = OverlapTestBoxBox
     obj.Quit = Quit
     obj.Raycast = Raycast
+    obj.RaycastBatch = RaycastBatch
     obj.SetActiveCamera = SetActiveCamera
     obj.SetBrightness = SetBrightness
     obj.SetExposureCompensation = SetExposureCompensation
@@ -0,0 +1,10 @@
+eSensorEvent = {
+    Enter = 0,
+    Stay = 1,
+    Exit = 2
+}
+
+------------------------------------------------------------------------------------------------------------------------
+
+-- Module contract
+return nil
@@ -1,4 +1,4 @@
-// version 1.95
+// version 1.97
 
 #ifndef GX_MATH_HPP
 #define GX_MATH_HPP
@@ -11,6 +11,7 @@ GX_DISABLE_COMMON_WARNINGS
 #include <cfloat>
 #include <climits>
 #include <cmath>
+#include <span>
 
 GX_RESTORE_WARNING_STATE
 
@@ -131,6 +132,11 @@ struct [[maybe_unused]] GXVec3 final
 
     [[maybe_unused]] GXVoid Init ( GXFloat x, GXFloat y, GXFloat z ) noexcept;
     [[maybe_unused]] GXVoid Normalize () noexcept;
+
+    // The reciprocal square root estimate refined by Newton-Raphson iterations. The length of the result differs
+    // from 1.0F by less than 1.0e-6F. The scalar backend is the same as Normalize.
+    [[maybe_unused]] GXVoid NormalizeFast () noexcept;
+
     [[maybe_unused]] GXVoid Reverse () noexcept;
 
     [[maybe_unused]] GXVoid Sum ( GXVec3 const &a, GXVec3 const &b ) noexcept;
@@ -593,6 +599,10 @@ struct [[maybe_unused]] GXQuat final
 
     [[maybe_unused]] GXVoid Identity () noexcept;
     [[maybe_unused]] GXVoid Normalize () noexcept;
+
+    // The same error bound as GXVec3::NormalizeFast.
+    [[maybe_unused]] GXVoid NormalizeFast () noexcept;
+
     [[maybe_unused]] GXVoid Inverse ( GXQuat const &q ) noexcept;
 
     // Result is valid if "unitQuaternion" is normalized.
@@ -824,6 +834,34 @@ struct [[maybe_unused]] GXMat4 final
 
 //----------------------------------------------------------------------------------------------------------------------
 
+// Structure of arrays views for the batch functions. Element "i" consists of the "i"-th values of the spans.
+// All spans of the view must have the same size.
+template<typename T>
+struct [[maybe_unused]] GXVec3SoA final
+{
+    std::span<T>    _x;
+    std::span<T>    _y;
+    std::span<T>    _z;
+};
+
+template<typename T>
+struct [[maybe_unused]] GXQuatSoA final
+{
+    std::span<T>    _r;
+    std::span<T>    _a;
+    std::span<T>    _b;
+    std::span<T>    _c;
+};
+
+template<typename T>
+struct [[maybe_unused]] GXAABBSoA final
+{
+    GXVec3SoA<T>    _min;
+    GXVec3SoA<T>    _max;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 struct [[maybe_unused]] GXAABB final
 {
     GXUByte     _vertices;
@@ -934,6 +972,13 @@ class [[maybe_unused]] GXProjectionClipPlanes final
         // Trivial invisibility test.
         [[maybe_unused, nodiscard]] GXBool IsVisible ( GXAABB const &bounds ) const noexcept;
 
+        // The same test for every box of the batch. Bit "i % 32" of "visibility[ i / 32 ]" is set if the box "i"
+        // is visible. "visibility" must have "( n + 31 ) / 32" elements or more. Unused bits of the last element
+        // are cleared.
+        [[maybe_unused]] GXVoid IsVisible ( std::span<GXUInt> visibility,
+            GXAABBSoA<GXFloat const> const &bounds
+        ) const noexcept;
+
     private:
         [[nodiscard]] GXUByte PlaneTest ( GXFloat x, GXFloat y, GXFloat z ) const noexcept;
 };
@@ -980,5 +1025,33 @@ class [[maybe_unused]] GXProjectionClipPlanes final
     GXMat4 const &viewProjectionMatrix
 ) noexcept;
 
+// The batch functions process every element of "out". The inputs must have the same amount of elements or more.
+// Structure of arrays output could use the same memory as the input.
+
+// out[ i ] is points[ i ] transformed like GXMat4::MultiplyAsPoint does.
+[[maybe_unused]] GXVoid GXCALL GXMultiplyAsPointBatch ( GXVec3SoA<GXFloat> const &out,
+    GXMat4 const &transform,
+    GXVec3SoA<GXFloat const> const &points
+) noexcept;
+
+// out[ i ] is the same as GXAABB::Transform of bounds[ i ] by transforms[ i ]. The bounds must not be empty.
+[[maybe_unused]] GXVoid GXCALL GXTransformAABBBatch ( GXAABBSoA<GXFloat> const &out,
+    GXAABBSoA<GXFloat const> const &bounds,
+    std::span<GXMat4 const> transforms
+) noexcept;
+
+// out[ i ] = a[ i ] * b[ i ]. The output must not overlap the inputs.
+[[maybe_unused]] GXVoid GXCALL GXMultiplyMat4Batch ( std::span<GXMat4> out,
+    std::span<GXMat4 const> a,
+    std::span<GXMat4 const> b
+) noexcept;
+
+// out[ i ] is the same as GXQuat::SphericalLinearInterpolation of start[ i ] and finish[ i ].
+[[maybe_unused]] GXVoid GXCALL GXSphericalLinearInterpolationBatch ( GXQuatSoA<GXFloat> const &out,
+    GXQuatSoA<GXFloat const> const &start,
+    GXQuatSoA<GXFloat const> const &finish,
+    GXFloat interpolationFactor
+) noexcept;
+
 
 #endif // GX_MATH_HPP
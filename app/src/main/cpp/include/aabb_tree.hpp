@@ -0,0 +1,95 @@
+#ifndef ANDROID_VULKAN_AABB_TREE_HPP
+#define ANDROID_VULKAN_AABB_TREE_HPP
+
+
+#include "broad_phase.hpp"
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <unordered_map>
+
+GX_RESTORE_WARNING_STATE
+
+
+namespace android_vulkan {
+
+// Incremental dynamic bounding volume hierarchy over rigid body fat bounds. The leaf is reinserted only when the body
+// leaves its fat bounds. The implementation is based on ideas from
+// Erin Catto, Dynamic Bounding Volume Hierarchies, GDC 2019
+// https://box2d.org/files/ErinCatto_DynamicBVH_GDC2019.pdf
+//
+// Box2D v2.4.1 (SHA-1: 9ebbbcd960ad424e03e5de6e66a40764c16f51bc)
+// <repo>/src/collision/b2_dynamic_tree.cpp
+class AABBTree final : public BroadPhase
+{
+    public:
+        constexpr static uint32_t NULL_NODE = std::numeric_limits<uint32_t>::max ();
+
+    private:
+        struct Node final
+        {
+            GXAABB          _bounds {};
+            RigidBodyRef    _body {};
+
+            // Collision groups of the leaf shape. Internal node has union of the children groups. So the subtree
+            // without common groups is skipped before the bounds test.
+            uint32_t        _groups = 0U;
+
+            uint32_t        _parent = NULL_NODE;
+            uint32_t        _left = NULL_NODE;
+            uint32_t        _right = NULL_NODE;
+
+            // Leaf has zero height. Free node has negative height.
+            int32_t         _height = -1;
+
+            [[nodiscard]] bool IsLeaf () const noexcept;
+        };
+
+    private:
+        uint32_t                                        _freeList = NULL_NODE;
+        std::vector<Node>                               _nodes {};
+        std::unordered_map<RigidBody const*, uint32_t>  _proxies {};
+        uint32_t                                        _root = NULL_NODE;
+        std::vector<uint32_t>                           _stack {};
+
+    public:
+        AABBTree () noexcept;
+
+        AABBTree ( AABBTree const & ) = delete;
+        AABBTree &operator = ( AABBTree const & ) = delete;
+
+        AABBTree ( AABBTree && ) = delete;
+        AABBTree &operator = ( AABBTree && ) = delete;
+
+        ~AABBTree () override = default;
+
+        void Insert ( RigidBodyRef const &body ) noexcept override;
+        void Remove ( RigidBody const &body ) noexcept override;
+        void Reset () noexcept override;
+        void Update ( float deltaTime ) noexcept override;
+        void CollectPairs ( Pairs &pairs ) noexcept override;
+        void QueryBounds ( Bodies &bodies, GXAABB const &bounds ) noexcept override;
+        void QueryRay ( Bodies &bodies, GXVec3 const &from, GXVec3 const &to ) noexcept override;
+
+        [[maybe_unused, nodiscard]] int32_t GetHeight () const noexcept;
+
+    private:
+        [[nodiscard]] uint32_t AllocateNode () noexcept;
+        void FreeNode ( uint32_t node ) noexcept;
+
+        [[nodiscard]] uint32_t Balance ( uint32_t a ) noexcept;
+        void InsertLeaf ( uint32_t leaf ) noexcept;
+        void RemoveLeaf ( uint32_t leaf ) noexcept;
+        void Refit ( uint32_t node ) noexcept;
+
+        template<typename T>
+        void Traverse ( Bodies &bodies, T const &isOverlapped ) noexcept;
+
+        [[nodiscard]] static float GetPerimeter ( GXAABB const &bounds ) noexcept;
+        static void Merge ( GXAABB &result, GXAABB const &a, GXAABB const &b ) noexcept;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_AABB_TREE_HPP
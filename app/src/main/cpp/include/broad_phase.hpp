@@ -0,0 +1,86 @@
+#ifndef ANDROID_VULKAN_BROAD_PHASE_HPP
+#define ANDROID_VULKAN_BROAD_PHASE_HPP
+
+
+#include "rigid_body.hpp"
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <vector>
+
+GX_RESTORE_WARNING_STATE
+
+
+namespace android_vulkan {
+
+enum class eBroadPhase : uint8_t
+{
+    AABBTree = 0U,
+    SweepAndPrune = 1U
+};
+
+// Broadphase keeps "fat" bounds of the registered bodies. Fat bounds are slightly bigger than real shape bounds.
+// So the broadphase must update own data only when the body leaves its fat bounds.
+class BroadPhase
+{
+    public:
+        using Pair = std::pair<RigidBodyRef const*, RigidBodyRef const*>;
+        using Pairs = std::vector<Pair>;
+        using Bodies = std::vector<RigidBodyRef const*>;
+
+    public:
+        BroadPhase ( BroadPhase const & ) = delete;
+        BroadPhase &operator = ( BroadPhase const & ) = delete;
+
+        BroadPhase ( BroadPhase && ) = delete;
+        BroadPhase &operator = ( BroadPhase && ) = delete;
+
+        virtual ~BroadPhase () = default;
+
+        virtual void Insert ( RigidBodyRef const &body ) noexcept = 0;
+        virtual void Remove ( RigidBody const &body ) noexcept = 0;
+        virtual void Reset () noexcept = 0;
+
+        // The method refits fat bounds of the bodies which left them since last call.
+        virtual void Update ( float deltaTime ) noexcept = 0;
+
+        // The method returns unique pairs of overlapped fat bounds. Kinematic vs kinematic pairs and pairs without
+        // common collision groups are skipped.
+        // The dynamic body is always the first element of the pair. The pointers stay valid until next broadphase
+        // change.
+        virtual void CollectPairs ( Pairs &pairs ) noexcept = 0;
+
+        // The method returns bodies which fat bounds overlap the bounds. The pointers stay valid until next
+        // broadphase change.
+        virtual void QueryBounds ( Bodies &bodies, GXAABB const &bounds ) noexcept = 0;
+
+        // The method returns bodies which fat bounds are crossed by the segment. The pointers stay valid until next
+        // broadphase change.
+        virtual void QueryRay ( Bodies &bodies, GXVec3 const &from, GXVec3 const &to ) noexcept = 0;
+
+        [[nodiscard]] eBroadPhase GetType () const noexcept;
+
+    protected:
+        explicit BroadPhase ( eBroadPhase type ) noexcept;
+
+        static void ComputeFatBounds ( GXAABB &fat, RigidBody &body, float deltaTime ) noexcept;
+        [[nodiscard]] static bool IsContained ( GXAABB const &outer, GXAABB const &inner ) noexcept;
+
+        // Fat bounds of the continuous collision body must contain the shape bounds swept over the next step.
+        // Otherwise the speculative contacts could miss the obstacle.
+        [[nodiscard]] static bool IsRefitNeeded ( GXAABB const &fat, RigidBody &body, float deltaTime ) noexcept;
+
+        // Slab test. "direction" is the vector from the segment start to the segment end.
+        [[nodiscard]] static bool IsSegmentOverlapped ( GXAABB const &bounds,
+            GXVec3 const &from,
+            GXVec3 const &direction
+        ) noexcept;
+
+    private:
+        eBroadPhase     _type;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_BROAD_PHASE_HPP
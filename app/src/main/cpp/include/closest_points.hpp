@@ -0,0 +1,30 @@
+#ifndef ANDROID_VULKAN_CLOSEST_POINTS_HPP
+#define ANDROID_VULKAN_CLOSEST_POINTS_HPP
+
+
+#include <GXCommon/GXMath.hpp>
+
+
+namespace android_vulkan {
+
+// The function returns parameter of the closest point in range [0, 1]. Degenerate segment returns zero.
+[[nodiscard]] float ClosestPointSegment ( GXVec3 &result,
+    GXVec3 const &point,
+    GXVec3 const &begin,
+    GXVec3 const &end
+) noexcept;
+
+// Closest points of segments [p0, p1] and [q0, q1]. Based on ideas from Christer Ericson, Real-Time Collision
+// Detection, 2005, chapter 5.1.9.
+void ClosestPointsSegments ( GXVec3 &onFirst,
+    GXVec3 &onSecond,
+    GXVec3 const &p0,
+    GXVec3 const &p1,
+    GXVec3 const &q0,
+    GXVec3 const &q1
+) noexcept;
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_CLOSEST_POINTS_HPP
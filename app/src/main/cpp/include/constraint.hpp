@@ -0,0 +1,112 @@
+#ifndef ANDROID_VULKAN_CONSTRAINT_HPP
+#define ANDROID_VULKAN_CONSTRAINT_HPP
+
+
+#include "rigid_body.hpp"
+
+
+namespace android_vulkan {
+
+enum class eConstraintType : uint8_t
+{
+    BallSocket = 0U,
+    Distance = 1U,
+    Fixed = 2U,
+    Hinge = 3U
+};
+
+// Joint between two rigid bodies. At least one of the bodies must be dynamic. The joints are solved by VelocitySolver
+// together with the contacts. The accumulated impulses are kept between the steps. So the joints are warm started.
+//
+// The anchors and axes are passed in world space. They are captured in the local spaces of the bodies at construction
+// time. So the bodies must be placed before the joint creation.
+class Constraint
+{
+    protected:
+        // Point-to-point part. All three rows are solved together as 3x3 system.
+        struct PointBlock final
+        {
+            GXVec3      _anchorA {};
+            GXVec3      _anchorB {};
+            GXVec3      _bias {};
+            GXMat3      _effectiveMass {};
+            GXVec3      _lambda {};
+
+            // World space arms from the centers of mass to the anchors.
+            GXVec3      _rA {};
+            GXVec3      _rB {};
+        };
+
+    protected:
+        RigidBodyRef            _bodyA;
+        RigidBodyRef            _bodyB;
+
+        // Kinematic body has zero inverse mass and zero inverse inertia tensor.
+        GXMat3                  _inertiaTensorInverseA {};
+        GXMat3                  _inertiaTensorInverseB {};
+        float                   _massInverseA = 0.0F;
+        float                   _massInverseB = 0.0F;
+
+    private:
+        eConstraintType const   _type;
+
+    public:
+        Constraint () = delete;
+
+        Constraint ( Constraint const & ) = delete;
+        Constraint &operator = ( Constraint const & ) = delete;
+
+        Constraint ( Constraint && ) = delete;
+        Constraint &operator = ( Constraint && ) = delete;
+
+        virtual ~Constraint () = default;
+
+        [[nodiscard]] RigidBodyRef const &GetBodyA () const noexcept;
+        [[nodiscard]] RigidBodyRef const &GetBodyB () const noexcept;
+        [[maybe_unused, nodiscard]] eConstraintType GetType () const noexcept;
+
+        // The joint is active if at least one of the bodies is awake dynamic body.
+        [[nodiscard]] bool IsActive () const noexcept;
+
+        // The method computes effective masses and applies the accumulated impulses of the previous step.
+        void Prepare ( float fixedTimeStepInverse ) noexcept;
+
+        virtual void Solve () noexcept = 0;
+
+    protected:
+        explicit Constraint ( eConstraintType type, RigidBodyRef const &bodyA, RigidBodyRef const &bodyB ) noexcept;
+
+        // "stabilization" is the Baumgarte factor divided by the time step.
+        virtual void OnPrepare ( float stabilization ) noexcept = 0;
+
+        // Body A receives the opposite impulse.
+        void ApplyAngularImpulse ( GXVec3 const &impulse ) noexcept;
+        void ApplyImpulse ( GXVec3 const &impulse, GXVec3 const &rA, GXVec3 const &rB ) noexcept;
+
+        // Velocity of the anchor B relative to the anchor A.
+        [[nodiscard]] GXVec3 GetRelativeVelocity ( GXVec3 const &rA, GXVec3 const &rB ) const noexcept;
+        [[nodiscard]] GXVec3 GetRelativeVelocityAngular () const noexcept;
+
+        void InitPoint ( PointBlock &block, GXVec3 const &anchor ) const noexcept;
+        void PreparePoint ( PointBlock &block, float stabilization ) noexcept;
+        void SolvePoint ( PointBlock &block ) noexcept;
+
+        [[nodiscard]] static GXVec3 ToLocalDirection ( RigidBody const &body, GXVec3 const &direction ) noexcept;
+        [[nodiscard]] static GXVec3 ToLocalPoint ( RigidBody const &body, GXVec3 const &point ) noexcept;
+        [[nodiscard]] static GXVec3 ToWorldDirection ( RigidBody const &body, GXVec3 const &direction ) noexcept;
+
+    private:
+        static void ApplyToBody ( RigidBody &body,
+            float massInverse,
+            GXMat3 const &inertiaTensorInverse,
+            GXVec3 const &linear,
+            GXVec3 const &angular
+        ) noexcept;
+};
+
+using ConstraintRef = std::shared_ptr<Constraint>;
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_CONSTRAINT_HPP
@@ -0,0 +1,41 @@
+#ifndef ANDROID_VULKAN_CONSTRAINT_BALL_SOCKET_HPP
+#define ANDROID_VULKAN_CONSTRAINT_BALL_SOCKET_HPP
+
+
+#include "constraint.hpp"
+
+
+namespace android_vulkan {
+
+// The anchor points of the bodies are kept together. The bodies rotate freely around the anchor.
+class [[maybe_unused]] ConstraintBallSocket final : public Constraint
+{
+    private:
+        PointBlock      _point {};
+
+    public:
+        ConstraintBallSocket () = delete;
+
+        ConstraintBallSocket ( ConstraintBallSocket const & ) = delete;
+        ConstraintBallSocket &operator = ( ConstraintBallSocket const & ) = delete;
+
+        ConstraintBallSocket ( ConstraintBallSocket && ) = delete;
+        ConstraintBallSocket &operator = ( ConstraintBallSocket && ) = delete;
+
+        [[maybe_unused]] explicit ConstraintBallSocket ( RigidBodyRef const &bodyA,
+            RigidBodyRef const &bodyB,
+            GXVec3 const &anchor
+        ) noexcept;
+
+        ~ConstraintBallSocket () override = default;
+
+        void Solve () noexcept override;
+
+    private:
+        void OnPrepare ( float stabilization ) noexcept override;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_CONSTRAINT_BALL_SOCKET_HPP
@@ -0,0 +1,52 @@
+#ifndef ANDROID_VULKAN_CONSTRAINT_DISTANCE_HPP
+#define ANDROID_VULKAN_CONSTRAINT_DISTANCE_HPP
+
+
+#include "constraint.hpp"
+
+
+namespace android_vulkan {
+
+// The distance between the anchor points of the bodies is kept equal to the distance at construction time.
+class [[maybe_unused]] ConstraintDistance final : public Constraint
+{
+    private:
+        GXVec3      _anchorA {};
+        GXVec3      _anchorB {};
+        float       _bias = 0.0F;
+        float       _effectiveMass = 0.0F;
+        float       _lambda = 0.0F;
+        float const _length;
+        GXVec3      _normal { 0.0F, 1.0F, 0.0F };
+        GXVec3      _rA {};
+        GXVec3      _rB {};
+
+    public:
+        ConstraintDistance () = delete;
+
+        ConstraintDistance ( ConstraintDistance const & ) = delete;
+        ConstraintDistance &operator = ( ConstraintDistance const & ) = delete;
+
+        ConstraintDistance ( ConstraintDistance && ) = delete;
+        ConstraintDistance &operator = ( ConstraintDistance && ) = delete;
+
+        [[maybe_unused]] explicit ConstraintDistance ( RigidBodyRef const &bodyA,
+            RigidBodyRef const &bodyB,
+            GXVec3 const &anchorA,
+            GXVec3 const &anchorB
+        ) noexcept;
+
+        ~ConstraintDistance () override = default;
+
+        [[maybe_unused, nodiscard]] float GetLength () const noexcept;
+
+        void Solve () noexcept override;
+
+    private:
+        void OnPrepare ( float stabilization ) noexcept override;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_CONSTRAINT_DISTANCE_HPP
@@ -0,0 +1,45 @@
+#ifndef ANDROID_VULKAN_CONSTRAINT_FIXED_HPP
+#define ANDROID_VULKAN_CONSTRAINT_FIXED_HPP
+
+
+#include "constraint.hpp"
+
+
+namespace android_vulkan {
+
+// The relative position and orientation of the bodies are kept as at construction time. The point part uses the center
+// of mass of the body B as anchor. The three angular rows are solved together as 3x3 system.
+class [[maybe_unused]] ConstraintFixed final : public Constraint
+{
+    private:
+        // The basis of the body B in the local space of the body A.
+        GXVec3          _axesA[ 3U ] {};
+
+        GXVec3          _bias {};
+        GXMat3          _effectiveMass {};
+        GXVec3          _lambda {};
+        PointBlock      _point {};
+
+    public:
+        ConstraintFixed () = delete;
+
+        ConstraintFixed ( ConstraintFixed const & ) = delete;
+        ConstraintFixed &operator = ( ConstraintFixed const & ) = delete;
+
+        ConstraintFixed ( ConstraintFixed && ) = delete;
+        ConstraintFixed &operator = ( ConstraintFixed && ) = delete;
+
+        [[maybe_unused]] explicit ConstraintFixed ( RigidBodyRef const &bodyA, RigidBodyRef const &bodyB ) noexcept;
+
+        ~ConstraintFixed () override = default;
+
+        void Solve () noexcept override;
+
+    private:
+        void OnPrepare ( float stabilization ) noexcept override;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_CONSTRAINT_FIXED_HPP
@@ -0,0 +1,51 @@
+#ifndef ANDROID_VULKAN_CONSTRAINT_HINGE_HPP
+#define ANDROID_VULKAN_CONSTRAINT_HINGE_HPP
+
+
+#include "constraint.hpp"
+
+
+namespace android_vulkan {
+
+// The anchor points of the bodies are kept together and the bodies rotate only around the hinge axis. The two angular
+// rows are perpendicular to the axis of the body A. They are solved together as 2x2 system.
+class [[maybe_unused]] ConstraintHinge final : public Constraint
+{
+    private:
+        GXVec3          _axisA {};
+        GXVec3          _axisB {};
+        float           _bias[ 2U ] {};
+        GXVec3          _directions[ 2U ] {};
+        float           _effectiveMass[ 2U ][ 2U ] {};
+        float           _lambda[ 2U ] {};
+        PointBlock      _point {};
+
+    public:
+        ConstraintHinge () = delete;
+
+        ConstraintHinge ( ConstraintHinge const & ) = delete;
+        ConstraintHinge &operator = ( ConstraintHinge const & ) = delete;
+
+        ConstraintHinge ( ConstraintHinge && ) = delete;
+        ConstraintHinge &operator = ( ConstraintHinge && ) = delete;
+
+        // "axis" must be unit vector.
+        [[maybe_unused]] explicit ConstraintHinge ( RigidBodyRef const &bodyA,
+            RigidBodyRef const &bodyB,
+            GXVec3 const &anchor,
+            GXVec3 const &axis
+        ) noexcept;
+
+        ~ConstraintHinge () override = default;
+
+        void Solve () noexcept override;
+
+    private:
+        void ApplyAngularLambda ( float lambda0, float lambda1 ) noexcept;
+        void OnPrepare ( float stabilization ) noexcept override;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_CONSTRAINT_HINGE_HPP
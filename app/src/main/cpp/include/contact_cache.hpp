@@ -0,0 +1,110 @@
+#ifndef ANDROID_VULKAN_CONTACT_CACHE_HPP
+#define ANDROID_VULKAN_CONTACT_CACHE_HPP
+
+
+#include "contact_feature.hpp"
+#include "rigid_body.hpp"
+
+
+namespace android_vulkan {
+
+struct ContactManifold;
+
+// Persistent cache of the contact pairs. It's open addressing hash table with linear probing over compact array of
+// records. The pair key does not depend on body order. Every record keeps latest manifold of the pair for warm start and
+// snapshot of the last narrowphase result in local spaces of the bodies. The snapshot allows to skip GJK and EPA while
+// relative transform of the bodies stays almost the same.
+class ContactCache final
+{
+    public:
+        constexpr static size_t MAX_CONTACTS = 4U;
+
+        struct CachedContact final
+        {
+            GXVec3                  _localA {};
+            GXVec3                  _localB {};
+
+            // Contact basis in body A space.
+            GXVec3                  _tangent {};
+            GXVec3                  _bitangent {};
+            GXVec3                  _normal {};
+
+            // Penetration is restored as projection of "point A - point B" vector on the normal multiplied by the sign.
+            float                   _depthSign = 1.0F;
+
+            float                   _friction = 0.5F;
+            float                   _restitution = 0.5F;
+            ContactFeature          _feature = 0U;
+        };
+
+        struct Record final
+        {
+            // Bodies are in snapshot order.
+            RigidBody const*        _bodyA = nullptr;
+            RigidBody const*        _bodyB = nullptr;
+
+            // Latest manifold of the pair. It's warm start source for the next simulation step.
+            ContactManifold*        _manifold = nullptr;
+            bool                    _isUsed = true;
+
+            Shape const*            _shapeA = nullptr;
+            Shape const*            _shapeB = nullptr;
+
+            // Transform from body B space to body A space at the snapshot moment.
+            GXMat4                  _relative {};
+
+            // Zero means there is no snapshot.
+            size_t                  _contactCount = 0U;
+            CachedContact           _contacts[ MAX_CONTACTS ] {};
+        };
+
+    private:
+        constexpr static uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max ();
+
+        struct Slot final
+        {
+            RigidBody const*        _bodyA = nullptr;
+            RigidBody const*        _bodyB = nullptr;
+            uint32_t                _record = EMPTY_SLOT;
+        };
+
+    private:
+        size_t                      _mask = 0U;
+        std::vector<Record>         _records {};
+        std::vector<Slot>           _slots {};
+
+    public:
+        ContactCache () = default;
+
+        ContactCache ( ContactCache const & ) = delete;
+        ContactCache &operator = ( ContactCache const & ) = delete;
+
+        ContactCache ( ContactCache && ) = delete;
+        ContactCache &operator = ( ContactCache && ) = delete;
+
+        ~ContactCache () = default;
+
+        // The method returns nullptr if the pair is not cached. Concurrent calls are safe while cache is not modified.
+        [[nodiscard]] Record const* Find ( RigidBody const* a, RigidBody const* b ) const noexcept;
+
+        // The method creates empty record if the pair is not cached. The second value is true in that case.
+        [[nodiscard]] std::pair<Record*, bool> Obtain ( RigidBody const* a, RigidBody const* b ) noexcept;
+
+        [[nodiscard]] std::vector<Record> &GetRecords () noexcept;
+
+        // The method removes records which were not used since the previous call. Then usage flags are reset.
+        void RemoveUnused () noexcept;
+
+    private:
+        [[nodiscard]] size_t FindSlot ( RigidBody const* a, RigidBody const* b ) const noexcept;
+        void Grow () noexcept;
+        void RemoveSlot ( size_t slot ) noexcept;
+
+        [[nodiscard]] static size_t Hash ( RigidBody const* a, RigidBody const* b ) noexcept;
+        [[nodiscard]] static bool IsSame ( Slot const &slot, RigidBody const* a, RigidBody const* b ) noexcept;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_CONTACT_CACHE_HPP
@@ -6,6 +6,8 @@
 #include "cyrus_beck.hpp"
 #include "epa.hpp"
 #include "gjk.hpp"
+#include "mesh_contact_detector.hpp"
+#include "ray_caster.hpp"
 #include "sutherland_hodgman.hpp"
 
 
@@ -13,18 +15,36 @@ namespace android_vulkan {
 
 class ContactDetector final
 {
+    public:
+        // Forward declaration. This will init '_checkHandlers' static field.
+        class StaticInitializer;
+
     private:
+        using CheckHandler = void ( ContactDetector::* ) ( ContactManager &contactManager,
+            RigidBodyRef const &a,
+            RigidBodyRef const &b,
+            float friction,
+            float restitution
+        ) noexcept;
+
         using FirstContactData = std::pair<ContactManifold*, Contact*>;
 
+        constexpr static auto SHAPE_TYPES = static_cast<size_t> ( eShapeType::COUNT );
+
     private:
         CyrusBeck               _cyrusBeck;
         EPA                     _epa;
         GJK                     _gjk;
+        MeshContactDetector     _meshContactDetector;
+        RayCaster               _rayCaster;
         Vertices                _rays;
         Vertices                _shapeAPoints;
         Vertices                _shapeBPoints;
         SutherlandHodgman       _sutherlandHodgman;
 
+        // Indexed by shape types of body A and body B.
+        static CheckHandler     _checkHandlers[ SHAPE_TYPES ][ SHAPE_TYPES ];
+
     public:
         ContactDetector () noexcept;
 
@@ -38,6 +58,21 @@ class ContactDetector final
 
         void Check ( ContactManager &contactManager, RigidBodyRef const &a, RigidBodyRef const &b ) noexcept;
 
+        // Boolean overlap test without contact generation. It's used for sensors. So EPA and clipping are skipped.
+        // The unsupported pairs are never overlapped. See ContactDetector::StaticInitializer.
+        [[nodiscard]] bool IsOverlapped ( RigidBodyRef const &a, RigidBodyRef const &b ) noexcept;
+
+        // Speculative contact for the separated pair where at least one body has continuous collision. The center of
+        // that body is traced against the other shape along the relative displacement of the next step extended by
+        // the bounds radius. The contact has negative penetration which is equal to the gap along the hit normal. So
+        // the velocity solver allows approaching velocity which closes the gap exactly within the step. Rotation
+        // during the step is ignored.
+        void CheckSpeculative ( ContactManager &contactManager,
+            RigidBodyRef const &a,
+            RigidBodyRef const &b,
+            float deltaTime
+        ) noexcept;
+
     private:
         [[nodiscard]] FirstContactData AllocateFirstContact ( ContactManager &contactManager,
             RigidBodyRef const &a,
@@ -46,6 +81,73 @@ class ContactDetector final
             float restitution
         ) const noexcept;
 
+        void CheckCapsuleBox ( ContactManager &contactManager,
+            RigidBodyRef const &capsule,
+            RigidBodyRef const &box,
+            float friction,
+            float restitution
+        ) noexcept;
+
+        void CheckCapsuleCapsule ( ContactManager &contactManager,
+            RigidBodyRef const &a,
+            RigidBodyRef const &b,
+            float friction,
+            float restitution
+        ) noexcept;
+
+        void CheckCapsuleSphere ( ContactManager &contactManager,
+            RigidBodyRef const &capsule,
+            RigidBodyRef const &sphere,
+            float friction,
+            float restitution
+        ) noexcept;
+
+        // GJK and EPA based contact generation. It's used for the pairs which have no closed form solution.
+        void CheckConvex ( ContactManager &contactManager,
+            RigidBodyRef const &a,
+            RigidBodyRef const &b,
+            float friction,
+            float restitution
+        ) noexcept;
+
+        void CheckMesh ( ContactManager &contactManager,
+            RigidBodyRef const &a,
+            RigidBodyRef const &b,
+            float friction,
+            float restitution
+        ) noexcept;
+
+        void CheckSphereBox ( ContactManager &contactManager,
+            RigidBodyRef const &sphere,
+            RigidBodyRef const &box,
+            float friction,
+            float restitution
+        ) noexcept;
+
+        void CheckSphereSphere ( ContactManager &contactManager,
+            RigidBodyRef const &a,
+            RigidBodyRef const &b,
+            float friction,
+            float restitution
+        ) noexcept;
+
+        // The pair is not supported.
+        void CheckStub ( ContactManager &contactManager,
+            RigidBodyRef const &a,
+            RigidBodyRef const &b,
+            float friction,
+            float restitution
+        ) noexcept;
+
+        // Adapter for the handlers which expect the bodies in reverse order.
+        template<CheckHandler handler>
+        void CheckSwapped ( ContactManager &contactManager,
+            RigidBodyRef const &a,
+            RigidBodyRef const &b,
+            float friction,
+            float restitution
+        ) noexcept;
+
         void CollectBackwardExtremePoints ( Vertices &vertices, Shape const &shape, GXMat3 const &tbn ) noexcept;
         void CollectForwardExtremePoints ( Vertices &vertices, Shape const &shape, GXMat3 const &tbn ) noexcept;
         void GenerateRays () noexcept;
@@ -83,6 +185,17 @@ class ContactDetector final
 
         [[maybe_unused]] void NotifyEPAFail () noexcept;
 
+        // The method is used by the manifold builders which do not need GJK and EPA.
+        static void AppendContact ( ContactManager &contactManager,
+            ContactManifold &manifold,
+            GXVec3 const &pointA,
+            GXVec3 const &normal,
+            float penetration,
+            ContactFeature feature,
+            float friction,
+            float restitution
+        ) noexcept;
+
         static void AppendExtremePoint ( Vertices &vertices,
             Shape const &shape,
             GXMat3 const &tbn,
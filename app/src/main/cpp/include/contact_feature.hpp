@@ -0,0 +1,46 @@
+#ifndef ANDROID_VULKAN_CONTACT_FEATURE_HPP
+#define ANDROID_VULKAN_CONTACT_FEATURE_HPP
+
+
+#include <GXCommon/GXWarning.hpp>
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <cstddef>
+#include <cstdint>
+
+GX_RESTORE_WARNING_STATE
+
+
+namespace android_vulkan {
+
+// Feature ID describes which vertices and edges of the clipping polygons produced the contact point. It's stable while
+// the bodies stay in resting contact. So it's used for matching contacts between simulation steps.
+using ContactFeature = uint32_t;
+
+// Reference polygon is the clipping window. Incident polygon is the polygon which is clipped.
+enum class eContactFeature : uint8_t
+{
+    None = 0U,
+    ReferenceVertex = 1U,
+    ReferenceEdge = 2U,
+    IncidentVertex = 3U,
+    IncidentEdge = 4U
+};
+
+// Single feature takes 8 bits: 3 bits for type and 5 bits for polygon vertex or edge index.
+[[nodiscard]] constexpr ContactFeature MakeContactFeature ( eContactFeature type, size_t index ) noexcept
+{
+    return ( static_cast<ContactFeature> ( type ) << 5U ) | ( static_cast<ContactFeature> ( index ) & 0x1FU );
+}
+
+// Intersection point of two polygon features.
+[[nodiscard]] constexpr ContactFeature CombineContactFeatures ( ContactFeature a, ContactFeature b ) noexcept
+{
+    return ( a << 8U ) | b;
+}
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_CONTACT_FEATURE_HPP
@@ -2,13 +2,12 @@
 #define ANDROID_VULKAN_CONTACT_MANAGER_HPP
 
 
-#include "rigid_body.hpp"
+#include "contact_cache.hpp"
 
 GX_DISABLE_COMMON_WARNINGS
 
 #include <array>
 #include <vector>
-#include <unordered_map>
 
 GX_RESTORE_WARNING_STATE
 
@@ -30,6 +29,9 @@ struct Contact final
     GXVec3                  _pointB {};
     float                   _penetration = 0.0F;
 
+    // Warm start matches contacts of the same pair by feature ID first.
+    ContactFeature          _feature = 0U;
+
     // Velocity solver entities.
     VelocitySolverData      _dataT {};
     VelocitySolverData      _dataB {};
@@ -55,7 +57,8 @@ struct ContactManifold final
     size_t                          _contactCount = 0U;
     Contact*                        _contacts = nullptr;
 
-    bool                            _warmStartIsUsed = true;
+    // The manifold was restored from the contact cache without GJK and EPA.
+    bool                            _isRestored = false;
 
     [[maybe_unused]] uint16_t       _epaSteps = 0U;
     [[maybe_unused]] uint16_t       _gjkSteps = 0U;
@@ -63,40 +66,26 @@ struct ContactManifold final
 
 class ContactManager final
 {
+    public:
+        // Upper limit of contacts which could be allocated for single manifold before simplification.
+        constexpr static size_t MAX_MANIFOLD_CONTACTS = 16U;
+
     private:
-        using Key = std::pair<RigidBody*, RigidBody*>;
         using Set = std::pair<std::vector<ContactManifold>, std::vector<Contact>>;
 
-        class Hasher final
-        {
-            public:
-                Hasher () = default;
-
-                Hasher ( Hasher const & ) = default;
-                Hasher &operator = ( Hasher const & ) = default;
-
-                Hasher ( Hasher && ) = default;
-                Hasher &operator = ( Hasher && ) = default;
-
-                ~Hasher() = default;
-
-                // hash function. std::unordered_map requirement.
-                [[nodiscard]] size_t operator () ( Key const &me ) const noexcept;
-
-            private:
-                std::hash<void const*>      _hashServer {};
-        };
-
-        using Mapper = std::unordered_map<Key, ContactManifold*, Hasher>;
-
     private:
+        ContactCache                        _contactCache {};
         std::array<Set, 2U>                 _sets {};
-        Mapper                              _warmStartMapper {};
         std::vector<size_t>                 _indices;
+        bool                                _isWarmStartEnabled = true;
 
     public:
         ContactManager () noexcept;
 
+        // Scratch storage for narrowphase workers. It starts with small capacity. Warm method only simplifies
+        // the manifold. Warm start is done later when the manifold is appended to the main contact manager.
+        explicit ContactManager ( size_t initialContactManifolds ) noexcept;
+
         ContactManager ( ContactManager const & ) = delete;
         ContactManager &operator = ( ContactManager const & ) = delete;
 
@@ -108,6 +97,22 @@ class ContactManager final
         [[nodiscard]] Contact &AllocateContact ( ContactManifold &contactManifold ) noexcept;
         [[nodiscard]] ContactManifold &AllocateContactManifold () noexcept;
 
+        // The method moves the manifold and copies its contacts to the current contact set. Then warm start happens.
+        void Append ( ContactManifold &contactManifold ) noexcept;
+
+        // Solver substepping support. The method must be called right after the integration with the same time step.
+        // The contact points are moved with the bodies and the penetration is updated by relative motion along
+        // the normal. So collision detection is not needed between substeps.
+        void Advance ( float deltaTime ) noexcept;
+
+        // The method restores the pair manifold from the contact cache to the target contact manager if relative
+        // transform of the bodies barely changed since the last narrowphase. The method returns false otherwise.
+        // Concurrent calls are safe while own contact manager is not modified.
+        [[nodiscard]] bool RestoreManifold ( ContactManager &target,
+            RigidBodyRef const &a,
+            RigidBodyRef const &b
+        ) const noexcept;
+
         [[nodiscard]] std::vector<ContactManifold> &GetContactManifolds () noexcept;
         [[nodiscard]] std::vector<ContactManifold> const &GetContactManifolds () const noexcept;
 
@@ -115,10 +120,14 @@ class ContactManager final
         void Warm ( ContactManifold &manifold ) noexcept;
 
     private:
-        void RemoveOutdatedWarmRecords () noexcept;
+        void GrowContactManifolds () noexcept;
+        void GrowContacts () noexcept;
         void ResetFrontSet () noexcept;
         void SimplifyManifold ( ContactManifold &manifold ) noexcept;
         void SwapSets () noexcept;
+        void WarmStart ( ContactManifold &manifold, ContactManifold const &cache ) noexcept;
+
+        static void UpdateSnapshot ( ContactCache::Record &record, ContactManifold const &manifold ) noexcept;
 };
 
 } // namespace android_vulkan
@@ -2,6 +2,7 @@
 #define ANDROID_VULKAN_CYRUS_BECK_HPP
 
 
+#include "contact_feature.hpp"
 #include "vertices.hpp"
 
 
@@ -12,7 +13,8 @@ namespace android_vulkan {
 class CyrusBeck final
 {
     private:
-        Vertices    _vertices;
+        ContactFeature      _features[ 2U ] {};
+        Vertices            _vertices;
 
     public:
         CyrusBeck () noexcept;
@@ -31,6 +33,9 @@ class CyrusBeck final
             Vertices const &edge,
             GXVec3 const &edgeDir
         ) noexcept;
+
+        // Feature ID of the result point: the edge vertex itself or intersection of the edge with the face side.
+        [[nodiscard]] ContactFeature GetFeature ( size_t point ) const noexcept;
 };
 
 } // namespace android_vulkan
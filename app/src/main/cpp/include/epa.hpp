@@ -3,16 +3,15 @@
 
 
 #include "simplex.hpp"
-#include "vertices.hpp"
 
 
 namespace android_vulkan {
 
 struct Face final
 {
-    size_t      _a = 0U;
-    size_t      _b = 0U;
-    size_t      _c = 0U;
+    uint8_t     _a = 0U;
+    uint8_t     _b = 0U;
+    uint8_t     _c = 0U;
     GXVec3      _normal = GXVec3 ( 0.0F, 0.0F, 0.0F );
 
     Face () = default;
@@ -23,7 +22,7 @@ struct Face final
     Face ( Face && ) = default;
     Face &operator = ( Face && ) = default;
 
-    explicit Face ( size_t a, size_t b, size_t c, Vertices const &vertices ) noexcept;
+    explicit Face ( uint8_t a, uint8_t b, uint8_t c, GXVec3 const* vertices ) noexcept;
 
     ~Face () = default;
 };
@@ -31,21 +30,37 @@ struct Face final
 // The implementation is based on ideas from
 // https://www.youtube.com/watch?v=6rgiPrzqt9w
 // https://www.youtube.com/watch?v=0XQ2FSz3EK8
+// Every step adds exactly one vertex to the polytope. So the step limit bounds the polytope size and all storage is
+// kept inside the object without heap allocations.
 class EPA final
 {
+    public:
+        constexpr static uint16_t MAX_STEPS = 16U;
+
     private:
-        using Edge = std::pair<size_t, size_t>;
+        // Initial tetrahedron plus one vertex per step. Faces and edges are limited by the Euler formula for
+        // the convex polytope.
+        constexpr static size_t MAX_VERTICES = 4U + MAX_STEPS;
+        constexpr static size_t MAX_FACES = 2U * MAX_VERTICES - 4U;
+        constexpr static size_t MAX_EDGES = 3U * MAX_VERTICES - 6U;
+
+        using Edge = std::pair<uint8_t, uint8_t>;
         using FindResult = std::pair<size_t, float>;
 
     private:
-        float                   _depth;
-        GXVec3                  _normal;
+        float                               _depth;
+        GXVec3                              _normal;
 
-        std::vector<Edge>       _edges;
-        std::vector<Face>       _faces;
-        Vertices                _vertices;
+        size_t                              _edgeCount;
+        size_t                              _faceCount;
+        size_t                              _vertexCount;
 
-        uint16_t                _steps;
+        std::array<Edge, MAX_EDGES>         _edges;
+        std::array<Face, MAX_FACES>         _faces;
+        std::array<GXVec3, MAX_VERTICES>    _vertices;
+
+        bool                                _isApproximate;
+        uint16_t                            _steps;
 
     public:
         EPA () noexcept;
@@ -68,13 +83,19 @@ class EPA final
         [[nodiscard]] uint16_t GetFaceCount () const noexcept;
         [[nodiscard]] uint16_t GetVertexCount () const noexcept;
 
+        // The result is the closest face of the polytope when the algorithm did not converge within the step limit or
+        // the polytope storage was exhausted. The depth is underestimated in this case.
+        [[nodiscard]] bool IsApproximate () const noexcept;
+
         void Reset () noexcept;
         [[nodiscard]] bool Run ( Simplex const &simplex, Shape const &shapeA, Shape const &shapeB ) noexcept;
 
     private:
         void CreatePolytope ( Simplex const &simplex ) noexcept;
-        [[nodiscard]] FindResult FindClosestFace () noexcept;
-        void SolveEdge ( size_t a, size_t b ) noexcept;
+        [[nodiscard]] FindResult FindClosestFace () const noexcept;
+
+        // The method returns false if the edge storage is exhausted.
+        [[nodiscard]] bool SolveEdge ( uint8_t a, uint8_t b ) noexcept;
 };
 
 } // namespace android_vulkan
@@ -0,0 +1,114 @@
+#ifndef ANDROID_VULKAN_MESH_CONTACT_DETECTOR_HPP
+#define ANDROID_VULKAN_MESH_CONTACT_DETECTOR_HPP
+
+
+#include "contact_feature.hpp"
+#include "shape_box.hpp"
+#include "shape_capsule.hpp"
+#include "shape_convex_hull.hpp"
+#include "shape_mesh.hpp"
+#include "shape_sphere.hpp"
+
+
+namespace android_vulkan {
+
+// Dedicated contact generation of sphere, capsule, box and convex hull versus static triangle mesh. Candidate triangles
+// are taken from the mesh hierarchy. Sphere and capsule use closest points to the triangle. Box uses separating axis
+// test with 13 axes and reference face clipping. Convex hull uses the same test with the hull face normals and the
+// cross products of the hull edges and the triangle edges. Contacts of all triangles are merged. The mesh is considered
+// as body A. So the normals point the direction which the convex shape must be moved to eliminate collision.
+class MeshContactDetector final
+{
+    public:
+        struct MeshContact final
+        {
+            // The point on the mesh.
+            GXVec3                          _pointA;
+
+            // The deepest point of the convex shape.
+            GXVec3                          _pointB;
+
+            GXVec3                          _normal;
+            float                           _penetration;
+            ContactFeature                  _feature;
+        };
+
+        using MeshContacts = std::vector<MeshContact>;
+
+    private:
+        constexpr static size_t MAX_POLYGON_VERTICES = 32U;
+
+        struct Polygon final
+        {
+            size_t                          _count = 0U;
+            ContactFeature                  _features[ MAX_POLYGON_VERTICES ] {};
+            GXVec3                          _vertices[ MAX_POLYGON_VERTICES ] {};
+        };
+
+        struct Box final
+        {
+            GXVec3                          _axes[ 3U ];
+            GXVec3                          _center;
+            GXVec3                          _halfSize;
+        };
+
+    private:
+        MeshContacts                        _contacts {};
+
+        // World space data of the convex hull. Edges and face normals are prepared once for all candidate triangles.
+        // Every edge takes two consecutive elements.
+        Vertices                            _hullEdges {};
+        Vertices                            _hullFeature {};
+        Vertices                            _hullNormals {};
+
+        std::vector<uint32_t>               _triangles {};
+
+    public:
+        MeshContactDetector () = default;
+
+        MeshContactDetector ( MeshContactDetector const & ) = delete;
+        MeshContactDetector &operator = ( MeshContactDetector const & ) = delete;
+
+        MeshContactDetector ( MeshContactDetector && ) = delete;
+        MeshContactDetector &operator = ( MeshContactDetector && ) = delete;
+
+        ~MeshContactDetector () = default;
+
+        // Result is empty if there is no penetration or if the shape type is not supported.
+        [[nodiscard]] MeshContacts &Run ( ShapeMesh const &mesh, Shape const &shape ) noexcept;
+
+        [[nodiscard]] static bool IsSupported ( Shape const &shape ) noexcept;
+
+    private:
+        void Append ( MeshContact const &contact ) noexcept;
+
+        void CheckBox ( ShapeMesh::Triangle const &triangle, uint32_t index, Box const &box ) noexcept;
+
+        void CheckCapsule ( ShapeMesh::Triangle const &triangle,
+            uint32_t index,
+            ShapeCapsule const &capsule
+        ) noexcept;
+
+        void CheckConvexHull ( ShapeMesh::Triangle const &triangle,
+            uint32_t index,
+            ShapeConvexHull const &hull
+        ) noexcept;
+
+        void CheckSphere ( ShapeMesh::Triangle const &triangle, uint32_t index, ShapeSphere const &sphere ) noexcept;
+        void PrepareConvexHull ( ShapeConvexHull const &hull ) noexcept;
+
+        // Contacts of the sphere or capsule caps against neighbour triangles are merged.
+        void ReduceRoundContacts ( float radius ) noexcept;
+
+        // The method keeps the part of the polygon which satisfies "dot ( normal, p ) <= offset".
+        static void Clip ( Polygon &polygon,
+            GXVec3 const &normal,
+            float offset,
+            ContactFeature planeFeature
+        ) noexcept;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_MESH_CONTACT_DETECTOR_HPP
@@ -0,0 +1,75 @@
+#ifndef ANDROID_VULKAN_NARROW_PHASE_HPP
+#define ANDROID_VULKAN_NARROW_PHASE_HPP
+
+
+#include "broad_phase.hpp"
+#include "contact_detector.hpp"
+#include "worker_pool.hpp"
+
+
+namespace android_vulkan {
+
+// Parallel narrowphase. Candidate pairs are split into fixed size batches. Workers grab batches one by one and run
+// own ContactDetector over them. Every worker writes manifolds to own scratch ContactManager. After that the manifolds
+// are appended to the main ContactManager in batch order. So the result does not depend on amount of workers.
+// Pairs with barely changed relative transform restore manifold from the contact cache of the main ContactManager
+// without GJK and EPA. Separated pairs with continuous collision body get speculative contact. Pairs with sensor get
+// boolean overlap test only. Overlapped sensor pairs are collected in the same batch order without manifolds.
+class NarrowPhase final
+{
+    private:
+        struct Batch final
+        {
+            size_t                          _worker = 0U;
+            size_t                          _firstManifold = 0U;
+            size_t                          _manifoldCount = 0U;
+            size_t                          _firstSensorPair = 0U;
+            size_t                          _sensorPairCount = 0U;
+        };
+
+        struct Worker final
+        {
+            ContactDetector                 _contactDetector {};
+            ContactManager                  _contactManager;
+            BroadPhase::Pairs               _sensorPairs {};
+
+            Worker () noexcept;
+        };
+
+    private:
+        std::vector<Batch>                  _batches {};
+        ContactManager const*               _contactManager = nullptr;
+        float                               _deltaTime = 0.0F;
+        std::atomic_size_t                  _nextBatch = 0U;
+        BroadPhase::Pairs const*            _pairs = nullptr;
+        size_t                              _workerCount = 0U;
+        std::unique_ptr<Worker[]>           _workers {};
+
+    public:
+        NarrowPhase () = default;
+
+        NarrowPhase ( NarrowPhase const & ) = delete;
+        NarrowPhase &operator = ( NarrowPhase const & ) = delete;
+
+        NarrowPhase ( NarrowPhase && ) = delete;
+        NarrowPhase &operator = ( NarrowPhase && ) = delete;
+
+        ~NarrowPhase () = default;
+
+        // Pairs without active bodies are skipped. See SimulationIslands::IsActive. Sensor pairs are always tested.
+        // The sensor is the first body of the "sensorPairs" item. Pairs of two sensors are ignored.
+        void Run ( ContactManager &contactManager,
+            BroadPhase::Pairs &sensorPairs,
+            BroadPhase::Pairs const &pairs,
+            float deltaTime,
+            WorkerPool &workerPool
+        ) noexcept;
+
+    private:
+        static void Job ( WorkerPool::Context context, size_t worker ) noexcept;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_NARROW_PHASE_HPP
@@ -0,0 +1,76 @@
+#ifndef ANDROID_VULKAN_PCM_MIXER_HPP
+#define ANDROID_VULKAN_PCM_MIXER_HPP
+
+
+#include "pcm_source.hpp"
+#include <android_vulkan_sdk/primitive_types.hpp>
+
+
+namespace android_vulkan {
+
+// Software mixer of all playing sources into one interleaved stereo buffer. The class has no AAudio dependencies.
+// So it could be driven by any output backend.
+class PCMMixer final
+{
+    public:
+        constexpr static auto TOTAL_SOUND_CHANNELS = static_cast<size_t> ( eSoundChannel::Speech ) + 1U;
+
+    private:
+        struct Track final
+        {
+            PCMSource*                  _source = nullptr;
+            size_t                      _channel = 0U;
+        };
+
+    private:
+        // This is part of mix thread sync. Mix thread should be mutex free to avoid audio glitches.
+        std::atomic_bool                _lock = false;
+
+        // The capacity is reserved once. So the track list is never reallocated under the lock.
+        std::vector<Track>              _tracks {};
+
+    public:
+        PCMMixer () noexcept;
+
+        PCMMixer ( PCMMixer const & ) = delete;
+        PCMMixer &operator = ( PCMMixer const & ) = delete;
+
+        PCMMixer ( PCMMixer && ) = delete;
+        PCMMixer &operator = ( PCMMixer && ) = delete;
+
+        ~PCMMixer () = default;
+
+        // The method returns false if the source is already added or there is no free track.
+        [[nodiscard]] bool Add ( PCMSource &source, eSoundChannel channel ) noexcept;
+
+        // The method returns false if the source is not found.
+        [[nodiscard]] bool Remove ( PCMSource &source ) noexcept;
+
+        void Clear () noexcept;
+        [[nodiscard]] size_t GetSourceCount () noexcept;
+
+        // The method overwrites the buffer content. The sources are summed in the order of adding. Every sum is
+        // saturated to PCMStreamer::PCMType range. Silence is written if there is no sources.
+        void Mix ( std::span<PCMStreamer::PCMType> buffer,
+            std::span<float const, TOTAL_SOUND_CHANNELS> channelVolume
+        ) noexcept;
+
+        [[nodiscard]] constexpr static int32_t GetChannelCount () noexcept
+        {
+            return 2;
+        }
+
+        [[nodiscard]] constexpr static int32_t GetSampleRate () noexcept
+        {
+            return 44100;
+        }
+
+    private:
+        void Lock () noexcept;
+        void Unlock () noexcept;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_PCM_MIXER_HPP
@@ -0,0 +1,32 @@
+#ifndef ANDROID_VULKAN_PCM_SOURCE_HPP
+#define ANDROID_VULKAN_PCM_SOURCE_HPP
+
+
+#include "pcm_streamer.hpp"
+
+
+namespace android_vulkan {
+
+// Anything which could be played by PCMMixer. The interface has no AAudio dependencies.
+class PCMSource
+{
+    public:
+        PCMSource ( PCMSource const & ) = delete;
+        PCMSource &operator = ( PCMSource const & ) = delete;
+
+        PCMSource ( PCMSource && ) = delete;
+        PCMSource &operator = ( PCMSource && ) = delete;
+
+        // The buffer contains interleaved stereo samples. The method must add own samples to the buffer content.
+        // See PCMStreamer::GetNextBuffer.
+        virtual void FillPCM ( std::span<PCMStreamer::PCMType> buffer, float channelVolume ) noexcept = 0;
+
+    protected:
+        PCMSource () = default;
+        virtual ~PCMSource () = default;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_PCM_SOURCE_HPP
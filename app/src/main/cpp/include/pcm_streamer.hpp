@@ -13,7 +13,7 @@ GX_RESTORE_WARNING_STATE
 
 namespace android_vulkan {
 
-class SoundEmitter;
+class PCMSource;
 
 class PCMStreamer
 {
@@ -21,7 +21,7 @@ class PCMStreamer
         constexpr static int16_t INTEGER_DIVISION_SCALE = std::numeric_limits<int16_t>::max () - 1U;
 
         using PCMType = int16_t;
-        using OnStopRequest = void ( * ) ( SoundEmitter &emitter ) noexcept;
+        using OnStopRequest = void ( * ) ( PCMSource &source ) noexcept;
 
         class Gain final
         {
@@ -82,8 +82,8 @@ class PCMStreamer
 
     protected:
         OnStopRequest               _onStopRequest = nullptr;
-        SoundEmitter                &_soundEmitter;
         SoundStorage::SoundFile     _soundFile {};
+        PCMSource                   &_source;
 
         size_t                      _offset = 0U;
         LoopHandler                 _loopHandler = &PCMStreamer::HandleLoopedMono;
@@ -101,6 +101,8 @@ class PCMStreamer
 
         virtual ~PCMStreamer () = default;
 
+        // The method adds the samples to the buffer content with saturation. So several streamers could be mixed
+        // into the same buffer. The buffer must be cleared before the first streamer.
         virtual void GetNextBuffer ( std::span<PCMType> buffer, Gain left, Gain right ) noexcept = 0;
         virtual void OnDecompress () noexcept;
 
@@ -116,7 +118,7 @@ class PCMStreamer
         ) noexcept;
 
     protected:
-        explicit PCMStreamer ( SoundEmitter &soundEmitter, OnStopRequest callback, bool decompressor ) noexcept;
+        explicit PCMStreamer ( PCMSource &source, OnStopRequest callback, bool decompressor ) noexcept;
 
         [[nodiscard]] virtual std::optional<Info> ResolveInfo ( bool looped, size_t samplesPerBurst ) noexcept = 0;
 
@@ -45,7 +45,7 @@ class PCMStreamerOGG final : public PCMStreamer
         PCMStreamerOGG ( PCMStreamerOGG && ) = delete;
         PCMStreamerOGG &operator = ( PCMStreamerOGG && ) = delete;
 
-        explicit PCMStreamerOGG ( SoundEmitter &soundEmitter, OnStopRequest callback ) noexcept;
+        explicit PCMStreamerOGG ( PCMSource &source, OnStopRequest callback ) noexcept;
 
         ~PCMStreamerOGG () override;
 
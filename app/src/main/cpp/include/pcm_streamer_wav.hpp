@@ -18,7 +18,7 @@ class PCMStreamerWAV final : public PCMStreamer
         PCMStreamerWAV ( PCMStreamerWAV && ) = delete;
         PCMStreamerWAV &operator = ( PCMStreamerWAV && ) = delete;
 
-        explicit PCMStreamerWAV ( SoundEmitter &soundEmitter, OnStopRequest callback ) noexcept;
+        explicit PCMStreamerWAV ( PCMSource &source, OnStopRequest callback ) noexcept;
 
         ~PCMStreamerWAV () override = default;
 
@@ -2,14 +2,19 @@
 #define ANDROID_VULKAN_PHYSICS_HPP
 
 
-#include "contact_detector.hpp"
+#include "broad_phase.hpp"
+#include "constraint.hpp"
 #include "contact_manager.hpp"
 #include "global_force.hpp"
+#include "narrow_phase.hpp"
 #include "ray_caster.hpp"
+#include "simulation_islands.hpp"
+#include "velocity_solver.hpp"
 
 GX_DISABLE_COMMON_WARNINGS
 
 #include <mutex>
+#include <span>
 #include <unordered_set>
 
 GX_RESTORE_WARNING_STATE
@@ -26,20 +31,123 @@ struct Penetration final
     GXVec3          _normal;
 };
 
+struct RaycastQuery final
+{
+    GXVec3          _from;
+    GXVec3          _to;
+    uint32_t        _groups;
+};
+
+struct ShapeQuery final
+{
+    Shape const*    _shape;
+    uint32_t        _groups;
+};
+
+// Accumulated wall time of the simulation phases since the last Physics::ResetPhaseTimings call.
+struct PhysicsPhaseTimings final
+{
+    std::chrono::nanoseconds    _broadPhase {};
+    std::chrono::nanoseconds    _narrowPhase {};
+
+    // Simulation islands and velocity solver.
+    std::chrono::nanoseconds    _solve {};
+
+    // Integration and sleep update.
+    std::chrono::nanoseconds    _integrate {};
+
+    size_t                      _steps = 0U;
+};
+
+enum class eSensorEvent : uint8_t
+{
+    Enter = 0U,
+    Stay = 1U,
+    Exit = 2U
+};
+
+struct SensorEvent final
+{
+    RigidBodyRef    _sensor;
+    RigidBodyRef    _other;
+    eSensorEvent    _type;
+};
+
 class Physics final
 {
+    private:
+        enum class eBodyCommand : uint8_t
+        {
+            Add,
+            Remove,
+            UpdateIntegrationType
+        };
+
+        struct BodyCommand final
+        {
+            // Add and remove commands keep the body alive until the command is applied.
+            RigidBodyRef                        _ref;
+            RigidBody*                          _body;
+            eBodyCommand                        _type;
+        };
+
+        struct SensorOverlap final
+        {
+            RigidBodyRef                        _sensor;
+            RigidBodyRef                        _other;
+        };
+
+        using SensorKey = std::pair<RigidBody const*, RigidBody const*>;
+
     private:
         float                                   _accumulator = 0.0F;
-        ContactDetector                         _contactDetector {};
+        std::vector<Constraint*>                _activeConstraints {};
+
+        // Queries refit the broadphase only if any body moved since the last refit. The flag is set by the simulation
+        // step, by teleports and by the applied body commands.
+        std::atomic_bool                        _boundsDirty = true;
+
+        std::unique_ptr<BroadPhase>             _broadPhase {};
+        BroadPhase::Pairs                       _candidatePairs {};
+
+        // Body registration does not wait for the simulation step. The commands are applied at the step boundary.
+        // The queue grows outside of the lock. So there is no heap allocation under the lock.
+        std::vector<BodyCommand>                _commands {};
+        std::atomic_bool                        _commandLock = false;
+        std::vector<BodyCommand>                _commandsToApply {};
+
+        // Registration order is kept. So the joints are always solved in the same order.
+        std::vector<ConstraintRef>              _constraints {};
+
         ContactManager                          _contactManager {};
-        std::unordered_set<RigidBodyRef>        _dynamics {};
+
+        // Dense arrays of the dynamic and kinematic bodies. The body knows its index. So removing is swap with the last
+        // element.
+        std::vector<RigidBodyRef>               _dynamics {};
         float                                   _fixedTimeStep;
         float                                   _fixedTimeStepInverse;
         std::unordered_set<GlobalForceRef>      _globalForces {};
         bool                                    _isPause = true;
-        std::unordered_set<RigidBodyRef>        _kinematics {};
+        std::vector<RigidBodyRef>               _kinematics {};
+        size_t                                  _maxSteps;
+        MeshContactDetector                     _meshContactDetector {};
         std::mutex                              _mutex {};
+        NarrowPhase                             _narrowPhase {};
+        PhysicsPhaseTimings                     _phaseTimings {};
+        BroadPhase::Bodies                      _queryBodies {};
+
+        // The overlaps of the previous step keep the bodies alive. So the exit event is reported for removed body too.
+        std::vector<SensorEvent>                _sensorEvents {};
+        std::vector<SensorKey>                  _sensorKeys {};
+        std::vector<SensorKey>                  _sensorKeysPrevious {};
+        std::vector<SensorOverlap>              _sensorOverlaps {};
+        BroadPhase::Pairs                       _sensorPairs {};
+
+        SimulationIslands                       _simulationIslands {};
+        size_t                                  _substeps;
         float                                   _timeSpeed;
+        VelocitySolver                          _velocitySolver {};
+        WorkerPool                              _workerPool {};
 
         bool                                    _debugRun = false;
 
@@ -54,18 +162,55 @@ class Physics final
 
         ~Physics () = default;
 
+        // Both bodies of the joint must be registered. The joint is removed automatically with any of its bodies.
+        [[maybe_unused, nodiscard]] bool AddConstraint ( ConstraintRef const &constraint ) noexcept;
+        [[maybe_unused, nodiscard]] bool RemoveConstraint ( ConstraintRef const &constraint ) noexcept;
+
         [[maybe_unused, nodiscard]] bool AddGlobalForce ( GlobalForceRef const &globalForce ) noexcept;
         [[maybe_unused, nodiscard]] bool RemoveGlobalForce ( GlobalForceRef const &globalForce ) noexcept;
 
+        // The methods could be called from any thread during the simulation step. The body joins or leaves
+        // the simulation at the next step boundary. Queries see the change immediately.
         [[maybe_unused, nodiscard]] bool AddRigidBody ( RigidBodyRef const &rigidBody ) noexcept;
         [[maybe_unused, nodiscard]] bool RemoveRigidBody ( RigidBodyRef const &rigidBody ) noexcept;
 
+        [[maybe_unused, nodiscard]] eBroadPhase GetBroadPhase () const noexcept;
+
+        // The method rebuilds broadphase data of all registered bodies if broadphase type was changed.
+        [[maybe_unused]] void SetBroadPhase ( eBroadPhase type ) noexcept;
+
         [[nodiscard]] std::vector<ContactManifold> const &GetContactManifolds () const noexcept;
 
+        // Amount of worker threads in addition to the simulation thread. Simulation result does not depend on it.
+        [[maybe_unused, nodiscard]] size_t GetWorkerThreads () const noexcept;
+        [[maybe_unused]] void SetWorkerThreads ( size_t threads ) noexcept;
+
+        // The velocity solver and the integration run "substeps" times per fixed step with proportionally smaller
+        // time step. Collision detection runs once per fixed step. The solver iterations are split between substeps.
+        [[maybe_unused, nodiscard]] size_t GetSubsteps () const noexcept;
+        [[maybe_unused]] void SetSubsteps ( size_t substeps ) noexcept;
+
         [[maybe_unused, nodiscard]] float GetTimeSpeed () const noexcept;
         [[maybe_unused]] void SetTimeSpeed ( float speed ) noexcept;
 
+        // Upper limit of the fixed steps per Simulate call. The rest of the frame time is dropped. So the simulation
+        // runs slower than real time after a long frame instead of making the next frame even longer.
+        [[maybe_unused, nodiscard]] size_t GetMaxSteps () const noexcept;
+        [[maybe_unused]] void SetMaxSteps ( size_t steps ) noexcept;
+
+        // Events of all steps of the last Simulate call in the step order. The events of one step are in the broadphase
+        // pair order. Exit events follow enter and stay events of the step. Kinematic versus kinematic pairs are
+        // not reported. See BroadPhase::CollectPairs.
+        [[maybe_unused, nodiscard]] std::vector<SensorEvent> const &GetSensorEvents () const noexcept;
+
+        [[maybe_unused, nodiscard]] PhysicsPhaseTimings const &GetPhaseTimings () const noexcept;
+        [[maybe_unused]] void ResetPhaseTimings () noexcept;
+
         [[nodiscard]] bool IsPaused () const noexcept;
+
+        // The method could be called from any thread. See RigidBody::SetLocation.
+        void OnBoundsChanged () noexcept;
+
         void OnIntegrationTypeChanged ( RigidBody &rigidBody ) noexcept;
         void Pause () noexcept;
 
@@ -74,7 +219,15 @@ class Physics final
             EPA &epa,
             ShapeRef const &shape,
             uint32_t groups
-        ) const noexcept;
+        ) noexcept;
+
+        // Penetrations of the query "i" are in range [ offsets[ i ], offsets[ i + 1 ] ) of the "result" vector.
+        // The broadphase is refitted at most once per batch.
+        [[maybe_unused]] void PenetrationTestBatch ( std::vector<Penetration> &result,
+            std::vector<size_t> &offsets,
+            EPA &epa,
+            std::span<ShapeQuery const> queries
+        ) noexcept;
 
         // The method returns true if ray hits anything. Otherwise the method returns false.
         // "groups" will be used as filter during the ray casting.
@@ -83,7 +236,13 @@ class Physics final
             GXVec3 const &from,
             GXVec3 const &to,
             uint32_t groups
-        ) const noexcept;
+        ) noexcept;
+
+        // The method returns the closest hit for every ray. "_body" field is empty if the ray hits nothing.
+        // The broadphase is refitted at most once per batch.
+        [[maybe_unused]] void RaycastBatch ( std::vector<RaycastResult> &result,
+            std::span<RaycastQuery const> queries
+        ) noexcept;
 
         void Resume () noexcept;
         void Reset () noexcept;
@@ -93,12 +252,51 @@ class Physics final
         // "groups" will be used as filter during the test.
         void SweepTest ( std::vector<RigidBodyRef> &result, ShapeRef const &sweepShape, uint32_t groups ) noexcept;
 
+        // Bodies of the query "i" are in range [ offsets[ i ], offsets[ i + 1 ] ) of the "result" vector.
+        // The broadphase is refitted at most once per batch.
+        [[maybe_unused]] void SweepTestBatch ( std::vector<RigidBodyRef> &result,
+            std::vector<size_t> &offsets,
+            std::span<ShapeQuery const> queries
+        ) noexcept;
+
         void OnDebugRun () noexcept;
 
     private:
+        void ApplyBodyCommands () noexcept;
+        void CollectActiveConstraints () noexcept;
         void CollectContacts () noexcept;
-        void Integrate () noexcept;
+        void Integrate ( float deltaTime ) noexcept;
+        void UpdateSensorEvents () noexcept;
+
+        void QueryPenetration ( std::vector<Penetration> &result,
+            EPA &epa,
+            Shape const &shape,
+            uint32_t groups
+        ) noexcept;
+
+        [[nodiscard]] bool QueryRay ( RaycastResult &result,
+            RayCaster &rayCaster,
+            GXVec3 const &from,
+            GXVec3 const &to,
+            uint32_t groups
+        ) noexcept;
+
+        void QuerySweep ( std::vector<RigidBodyRef> &result, Shape const &sweep, uint32_t groups ) noexcept;
+
+        // The method applies pending body commands and refits the broadphase if bounds are dirty. The caller must hold
+        // the mutex.
+        void PrepareQuery () noexcept;
+
+        void PushBodyCommand ( RigidBodyRef const &ref, RigidBody &body, eBodyCommand type ) noexcept;
+        void LockCommands () noexcept;
+        void UnlockCommands () noexcept;
         void ResolveIntegrationType ( RigidBody &rigidBody ) noexcept;
+
+        // The method returns the dense array which contains the body or nullptr if the body is not added yet.
+        [[nodiscard]] std::vector<RigidBodyRef>* FindBodies ( RigidBody const &rigidBody ) noexcept;
+
+        static void AppendBody ( std::vector<RigidBodyRef> &bodies, RigidBodyRef const &body ) noexcept;
+        static void EraseBody ( std::vector<RigidBodyRef> &bodies, uint32_t index ) noexcept;
 };
 
 } // namespace android_vulkan
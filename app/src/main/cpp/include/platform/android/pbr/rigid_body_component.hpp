@@ -64,7 +64,10 @@ class RigidBodyComponent final : public Component
         [[nodiscard]] static int OnGarbageCollected ( lua_State* state );
         [[nodiscard]] static int OnGetLocation ( lua_State* state );
         [[nodiscard]] static int OnSetLocation ( lua_State* state );
+        [[nodiscard]] static int OnSetSensor ( lua_State* state );
         [[nodiscard]] static int OnSetShapeBox ( lua_State* state );
+        [[nodiscard]] static int OnSetShapeCapsule ( lua_State* state );
+        [[nodiscard]] static int OnSetShapeMesh ( lua_State* state );
         [[nodiscard]] static int OnSetShapeSphere ( lua_State* state );
         [[nodiscard]] static int OnGetTransform ( lua_State* state );
         [[nodiscard]] static int OnGetVelocityLinear ( lua_State* state );
@@ -7,6 +7,7 @@
 #include <platform/android/pbr/font_storage.hpp>
 #include <platform/android/pbr/scriptable_penetration.hpp>
 #include <platform/android/pbr/scriptable_raycast_result.hpp>
+#include <platform/android/pbr/scriptable_sensor_events.hpp>
 #include "render_session.hpp"
 #include "renderable_component.hpp"
 #include "scriptable_gamepad.hpp"
@@ -24,13 +25,18 @@ class Scene final
         CameraComponent                                 _defaultCamera { "Default Camera" };
         MaterialRef                                     _defaultMaterial {};
 
+        std::vector<android_vulkan::ShapeRef>           _batchShapes {};
         android_vulkan::EPA                             _epa {};
         ScriptableGamepad                               _gamepad {};
+        std::vector<size_t>                             _penetrationOffsets {};
         std::vector<android_vulkan::Penetration>        _penetrations {};
         android_vulkan::Physics*                        _physics = nullptr;
+        std::vector<android_vulkan::RaycastQuery>       _raycastQueries {};
+        std::vector<android_vulkan::RaycastResult>      _raycastResults {};
         ScriptablePenetration                           _scriptablePenetration {};
         ScriptableRaycastResult                         _scriptableRaycastResult {};
         android_vulkan::ShapeRef                        _shapeBoxes[ 2U ] = {};
+        std::vector<android_vulkan::ShapeQuery>         _shapeQueries {};
         android_vulkan::SoundMixer                      _soundMixer {};
         std::vector<android_vulkan::RigidBodyRef>       _sweepTestResult {};
 
@@ -117,8 +123,24 @@ class Scene final
             uint32_t groups
         ) noexcept;
 
+        // "localIdx" and "sizeIdx" are stack indices of Lua arrays with GXMat4 and GXVec3 objects.
+        [[nodiscard]] int DoPenetrationBoxBatch ( lua_State &vm,
+            int localIdx,
+            int sizeIdx,
+            size_t count,
+            uint32_t groups
+        ) noexcept;
+
         [[nodiscard]] int DoRaycast ( lua_State &vm, GXVec3 const &from, GXVec3 const &to, uint32_t groups ) noexcept;
 
+        // "fromIdx" and "toIdx" are stack indices of Lua arrays with GXVec3 objects.
+        [[nodiscard]] int DoRaycastBatch ( lua_State &vm,
+            int fromIdx,
+            int toIdx,
+            size_t count,
+            uint32_t groups
+        ) noexcept;
+
         [[nodiscard]] int DoSweepTestBox ( lua_State &vm,
             GXMat4 const &local,
             GXVec3 const &size,
@@ -134,7 +156,9 @@ class Scene final
         [[nodiscard]] static int OnAppendUILayer ( lua_State* state );
         [[nodiscard]] static int OnDetachUILayer ( lua_State* state );
         [[nodiscard]] static int OnGetPenetrationBox ( lua_State* state );
+        [[nodiscard]] static int OnGetPenetrationBoxBatch ( lua_State* state );
         [[nodiscard]] static int OnGetPhysicsToRendererScaleFactor ( lua_State* state );
+        [[nodiscard]] static int OnGetSensorEvents ( lua_State* state );
         [[nodiscard]] static int OnGetRendererToPhysicsScaleFactor ( lua_State* state );
 
         [[nodiscard]] static int OnGetRenderTargetAspectRatio ( lua_State* state );
@@ -145,6 +169,7 @@ class Scene final
 
         [[nodiscard]] static int OnQuit ( lua_State* state );
         [[nodiscard]] static int OnRaycast ( lua_State* state );
+        [[nodiscard]] static int OnRaycastBatch ( lua_State* state );
         [[nodiscard]] static int OnSetActiveCamera ( lua_State* state );
         [[nodiscard]] static int OnSetBrightness ( lua_State* state );
         [[nodiscard]] static int OnSetExposureCompensation ( lua_State* state );
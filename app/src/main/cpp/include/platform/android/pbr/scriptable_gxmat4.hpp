@@ -12,6 +12,8 @@ extern "C" {
 
 } // extern "C"
 
+#include <optional>
+
 GX_RESTORE_WARNING_STATE
 
 
@@ -47,6 +49,9 @@ class ScriptableGXMat4 final
 
         [[nodiscard]] static GXMat4 &Extract ( lua_State* state, int idx ) noexcept;
 
+        // Method expects Lua table representation of the GXMat4 in the Lua stack.
+        [[nodiscard]] static std::optional<GXMat4*> ExtractFromLua ( lua_State &vm, int idx ) noexcept;
+
     private:
         static void Insert ( Item* item, Item* &list ) noexcept;
 
@@ -30,6 +30,12 @@ class ScriptablePenetration final
             std::vector<android_vulkan::Penetration> const &penetrations
         ) noexcept;
 
+        // Penetrations of the query "i" are in range [ _offsets[ i ], _offsets[ i + 1 ] ) of "_penetrations" array.
+        [[nodiscard]] bool PublishBatchResult ( lua_State &vm,
+            std::vector<android_vulkan::Penetration> const &penetrations,
+            std::vector<size_t> const &offsets
+        ) noexcept;
+
     private:
         [[nodiscard]] bool Append ( lua_State &vm,
             int errorHandlerIdx,
@@ -12,6 +12,9 @@ extern "C" {
 
 } // extern "C"
 
+#include <span>
+#include <vector>
+
 GX_RESTORE_WARNING_STATE
 
 
@@ -20,8 +23,16 @@ namespace pbr {
 class ScriptableRaycastResult final
 {
     private:
-        GXVec3*     _normal = nullptr;
-        GXVec3*     _point = nullptr;
+        struct BatchItem final
+        {
+            GXVec3*                 _normal = nullptr;
+            GXVec3*                 _point = nullptr;
+        };
+
+    private:
+        std::vector<BatchItem>      _batch {};
+        GXVec3*                     _normal = nullptr;
+        GXVec3*                     _point = nullptr;
 
     public:
         ScriptableRaycastResult () = default;
@@ -38,6 +49,19 @@ class ScriptableRaycastResult final
         void Destroy ( lua_State &vm ) noexcept;
 
         [[nodiscard]] bool PublishResult ( lua_State &vm, android_vulkan::RaycastResult const &result ) noexcept;
+
+        // Every ray gets item in "_hits" array of the batch table. "_body", "_point" and "_normal" fields of the item
+        // make sense only if "_isHit" field is true. Lua objects of the items are reused between calls.
+        [[nodiscard]] bool PublishBatchResult ( lua_State &vm,
+            std::span<android_vulkan::RaycastResult const> results
+        ) noexcept;
+
+    private:
+        [[nodiscard]] bool AppendBatchItem ( lua_State &vm,
+            int errorHandlerIdx,
+            int vec3Constructor,
+            int hitsIdx
+        ) noexcept;
 };
 
 } // namespace pbr
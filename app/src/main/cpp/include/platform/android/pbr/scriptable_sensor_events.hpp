@@ -0,0 +1,46 @@
+#ifndef PBR_SCRIPTABLE_SENSOR_EVENTS_HPP
+#define PBR_SCRIPTABLE_SENSOR_EVENTS_HPP
+
+
+#include <physics.hpp>
+
+GX_DISABLE_COMMON_WARNINGS
+
+extern "C" {
+
+#include <lua/lstate.h>
+
+} // extern "C"
+
+GX_RESTORE_WARNING_STATE
+
+
+namespace pbr {
+
+class ScriptableSensorEvents final
+{
+    public:
+        ScriptableSensorEvents () = delete;
+
+        ScriptableSensorEvents ( ScriptableSensorEvents const & ) = delete;
+        ScriptableSensorEvents &operator = ( ScriptableSensorEvents const & ) = delete;
+
+        ScriptableSensorEvents ( ScriptableSensorEvents && ) = delete;
+        ScriptableSensorEvents &operator = ( ScriptableSensorEvents && ) = delete;
+
+        ~ScriptableSensorEvents () = delete;
+
+        [[nodiscard]] static bool Init ( lua_State &vm ) noexcept;
+        static void Destroy ( lua_State &vm ) noexcept;
+
+        // The event "i" is described by items "i" of "_sensors", "_others" and "_types" arrays. So no table is
+        // created per event. The arrays are reused between calls.
+        [[nodiscard]] static bool PublishResult ( lua_State &vm,
+            std::vector<android_vulkan::SensorEvent> const &events
+        ) noexcept;
+};
+
+} // namespace pbr
+
+
+#endif // PBR_SCRIPTABLE_SENSOR_EVENTS_HPP
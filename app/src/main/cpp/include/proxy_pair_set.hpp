@@ -0,0 +1,79 @@
+#ifndef ANDROID_VULKAN_PROXY_PAIR_SET_HPP
+#define ANDROID_VULKAN_PROXY_PAIR_SET_HPP
+
+
+#include <GXCommon/GXWarning.hpp>
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+GX_RESTORE_WARNING_STATE
+
+
+namespace android_vulkan {
+
+// Persistent set of broadphase proxy pairs. It's open addressing hash table with linear probing over compact array of
+// pairs. The same layout as in ContactCache. The pair does not depend on proxy order.
+class ProxyPairSet final
+{
+    public:
+        struct Pair final
+        {
+            // "_a" is always less than "_b".
+            uint32_t                _a = 0U;
+            uint32_t                _b = 0U;
+        };
+
+    private:
+        constexpr static uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max ();
+
+    private:
+        size_t                      _mask = 0U;
+        std::vector<Pair>           _pairs {};
+
+        // Index in the compact array.
+        std::vector<uint32_t>       _slots {};
+
+    public:
+        ProxyPairSet () = default;
+
+        ProxyPairSet ( ProxyPairSet const & ) = delete;
+        ProxyPairSet &operator = ( ProxyPairSet const & ) = delete;
+
+        ProxyPairSet ( ProxyPairSet && ) = delete;
+        ProxyPairSet &operator = ( ProxyPairSet && ) = delete;
+
+        ~ProxyPairSet () = default;
+
+        // The method does nothing if the pair is present already.
+        void Add ( uint32_t a, uint32_t b ) noexcept;
+
+        // The method does nothing if the pair is not present.
+        void Remove ( uint32_t a, uint32_t b ) noexcept;
+
+        // The method removes all pairs of the proxy.
+        void RemoveProxy ( uint32_t proxy ) noexcept;
+
+        void Reset () noexcept;
+
+        // The order of the pairs depends on the history of adding and removing only.
+        [[nodiscard]] std::span<Pair const> GetPairs () const noexcept;
+
+    private:
+        void Erase ( size_t index ) noexcept;
+        [[nodiscard]] size_t FindSlot ( Pair const &pair ) const noexcept;
+        void Grow () noexcept;
+        void RemoveSlot ( size_t slot ) noexcept;
+
+        [[nodiscard]] static size_t Hash ( Pair const &pair ) noexcept;
+        [[nodiscard]] static Pair MakePair ( uint32_t a, uint32_t b ) noexcept;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_PROXY_PAIR_SET_HPP
@@ -3,8 +3,8 @@
 
 
 #include "gjk_base.hpp"
+#include "rigid_body.hpp"
 #include "shape.hpp"
-#include "contact_detector.hpp"
 
 
 namespace android_vulkan {
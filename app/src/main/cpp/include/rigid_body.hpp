@@ -32,7 +32,10 @@ class RigidBody final
 
         bool                        _isAwake;
         bool                        _isCanSleep;
+        bool                        _isContinuousCollision;
         bool                        _isKinematic;
+        bool                        _isSensor;
+        uint32_t                    _islandIndex;
 
         GXVec3                      _location;
 
@@ -40,6 +43,10 @@ class RigidBody final
         float                       _massInverse;
 
         Physics*                    _physics;
+
+        // Index in the dense body array of the Physics. It's valid only after the registration command is applied.
+        uint32_t                    _physicsIndex;
+
         GXQuat                      _rotation;
 
         ShapeRef                    _shape;
@@ -101,6 +108,18 @@ class RigidBody final
         void EnableSleep () noexcept;
         [[maybe_unused, nodiscard]] bool IsCanSleep () const noexcept;
 
+        // Continuous collision generates speculative contacts along the motion of the next step. So the fast body does
+        // not tunnel through thin obstacles. See ContactDetector::CheckSpeculative.
+        [[maybe_unused]] void DisableContinuousCollision () noexcept;
+        [[maybe_unused]] void EnableContinuousCollision () noexcept;
+        [[nodiscard]] bool IsContinuousCollision () const noexcept;
+
+        // Sensor only detects overlaps. It produces no contacts and does not push other bodies.
+        // See Physics::GetSensorEvents.
+        [[maybe_unused]] void DisableSensor () noexcept;
+        [[maybe_unused]] void EnableSensor () noexcept;
+        [[nodiscard]] bool IsSensor () const noexcept;
+
         [[nodiscard]] Context GetContext () const noexcept;
         void SetContext ( Context context ) noexcept;
 
@@ -139,11 +158,22 @@ class RigidBody final
 
         void Integrate ( float deltaTime ) noexcept;
 
-        [[maybe_unused, nodiscard]] bool IsAwake () const noexcept;
+        [[nodiscard]] bool IsAwake () const noexcept;
         void SetAwake () noexcept;
 
-        void OnRegister ( Physics &physics ) noexcept;
-        void OnUnregister () noexcept;
+        // Sleeping is decided for whole simulation island. See SimulationIslands.
+        [[nodiscard]] bool IsReadyToSleep () const noexcept;
+        void Sleep () noexcept;
+
+        [[nodiscard]] uint32_t GetIslandIndex () const noexcept;
+        void SetIslandIndex ( uint32_t index ) noexcept;
+
+        [[nodiscard]] uint32_t GetPhysicsIndex () const noexcept;
+        void SetPhysicsIndex ( uint32_t index ) noexcept;
+
+        // The methods return false if the body is already registered or is not registered in the given physics.
+        [[nodiscard]] bool OnRegister ( Physics &physics ) noexcept;
+        [[nodiscard]] bool OnUnregister ( Physics const &physics ) noexcept;
 
         void UpdatePositionAndRotation ( float deltaTime ) noexcept;
 
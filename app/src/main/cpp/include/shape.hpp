@@ -17,7 +17,12 @@ namespace android_vulkan {
 enum class eShapeType : uint8_t
 {
     Sphere = 0U,
-    Box = 1U
+    Box = 1U,
+    ConvexHull = 2U,
+    Mesh = 3U,
+    Capsule = 4U,
+
+    COUNT = 5U
 };
 
 class Shape
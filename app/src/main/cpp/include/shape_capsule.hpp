@@ -0,0 +1,48 @@
+#ifndef ANDROID_VULKAN_SHAPE_CAPSULE_HPP
+#define ANDROID_VULKAN_SHAPE_CAPSULE_HPP
+
+
+#include "shape.hpp"
+
+
+namespace android_vulkan {
+
+// Capsule is a sphere swept along the segment. The segment lies on the local Y axis and it's centered at the origin.
+class [[maybe_unused]] ShapeCapsule final : public Shape
+{
+    private:
+        float const     _halfHeight;
+        float const     _radius;
+
+        // World space segment end points. They are updated every time when the transform changes.
+        GXVec3          _segmentWorld[ 2U ];
+
+    public:
+        ShapeCapsule () = delete;
+
+        ShapeCapsule ( ShapeCapsule const & ) = delete;
+        ShapeCapsule &operator = ( ShapeCapsule const & ) = delete;
+
+        ShapeCapsule ( ShapeCapsule && ) = delete;
+        ShapeCapsule &operator = ( ShapeCapsule && ) = delete;
+
+        // The height is the distance between centers of the caps. So the full capsule height is height + 2 * radius.
+        [[maybe_unused]] explicit ShapeCapsule ( float radius, float height ) noexcept;
+
+        ~ShapeCapsule () override = default;
+
+        [[maybe_unused, nodiscard]] float GetHeight () const noexcept;
+        [[nodiscard]] float GetRadius () const noexcept;
+
+        [[nodiscard]] GXVec3 const &GetSegmentBeginWorld () const noexcept;
+        [[nodiscard]] GXVec3 const &GetSegmentEndWorld () const noexcept;
+
+    private:
+        void CalculateInertiaTensor ( float mass ) noexcept override;
+        [[nodiscard]] GXVec3 GetExtremePointWorld ( GXVec3 const &direction ) const noexcept override;
+        void UpdateBounds () noexcept override;
+};
+
+} // namespace android_vulkan
+
+#endif // ANDROID_VULKAN_SHAPE_CAPSULE_HPP
@@ -0,0 +1,96 @@
+#ifndef ANDROID_VULKAN_SHAPE_CONVEX_HULL_HPP
+#define ANDROID_VULKAN_SHAPE_CONVEX_HULL_HPP
+
+
+#include "shape.hpp"
+#include "vertices.hpp"
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <atomic>
+#include <span>
+
+GX_RESTORE_WARNING_STATE
+
+
+namespace android_vulkan {
+
+// Convex hull of the point cloud. The hull keeps vertex adjacency, so the support point is found by hill climbing over
+// hull edges from the previous support vertex instead of scanning all vertices. Coplanar hull triangles are merged into
+// polygonal faces. The faces are used by the contact manifold builders.
+class [[maybe_unused]] ShapeConvexHull final : public Shape
+{
+    public:
+        struct Face final
+        {
+            GXVec3                          _normal;
+
+            // Range in face vertex array. Vertices are counterclockwise around the normal.
+            uint32_t                        _first;
+            uint32_t                        _count;
+        };
+
+    private:
+        // Adjacent vertices of the vertex "i" are in range [ _adjacencyOffsets[ i ], _adjacencyOffsets[ i + 1 ] ).
+        std::vector<uint32_t>               _adjacency {};
+        std::vector<uint32_t>               _adjacencyOffsets {};
+
+        // Volume integral of "r * transpose ( r )" over the hull with unit density. It's used for inertia tensor.
+        GXMat3                              _covariance {};
+
+        std::vector<uint32_t>               _faceVertices {};
+        std::vector<Face>                   _faces {};
+
+        // Faces which contain the vertex "i" are in range [ _vertexFaceOffsets[ i ], _vertexFaceOffsets[ i + 1 ] ).
+        std::vector<uint32_t>               _vertexFaces {};
+        std::vector<uint32_t>               _vertexFaceOffsets {};
+
+        // Start vertex of the next hill climbing. Any value is valid start. So relaxed access is enough for
+        // concurrent narrowphase workers.
+        mutable std::atomic<uint32_t>       _lastSupport = 0U;
+
+        std::vector<GXVec3>                 _vertices {};
+        float                               _volume = 0.0F;
+
+    public:
+        ShapeConvexHull () = delete;
+
+        ShapeConvexHull ( ShapeConvexHull const & ) = delete;
+        ShapeConvexHull &operator = ( ShapeConvexHull const & ) = delete;
+
+        ShapeConvexHull ( ShapeConvexHull && ) = delete;
+        ShapeConvexHull &operator = ( ShapeConvexHull && ) = delete;
+
+        // Points are in rigid body space. Inertia tensor is calculated around rigid body origin. Points which do not
+        // form volume produce bounding box of the points.
+        [[maybe_unused]] explicit ShapeConvexHull ( std::span<GXVec3 const> points ) noexcept;
+
+        ~ShapeConvexHull () override = default;
+
+        [[maybe_unused, nodiscard]] std::vector<uint32_t> const &GetFaceVertices () const noexcept;
+        [[maybe_unused, nodiscard]] std::vector<Face> const &GetFaces () const noexcept;
+        [[maybe_unused, nodiscard]] std::vector<GXVec3> const &GetVertices () const noexcept;
+
+        // The method returns world vertices of the hull feature which is extreme along the unit direction: face polygon
+        // if face normal is almost parallel to the direction, edge if edge is almost perpendicular to the direction and
+        // single vertex otherwise.
+        void CollectFeatureWorld ( Vertices &vertices, GXVec3 const &directionWorld ) const noexcept;
+
+    private:
+        void CalculateInertiaTensor ( float mass ) noexcept override;
+        [[nodiscard]] GXVec3 GetExtremePointWorld ( GXVec3 const &direction ) const noexcept override;
+        void UpdateBounds () noexcept override;
+
+        [[nodiscard]] bool Build ( std::span<GXVec3 const> points ) noexcept;
+        void BuildFaces ( std::vector<uint32_t> const &triangles ) noexcept;
+        void BuildMassProperties ( std::vector<uint32_t> const &triangles ) noexcept;
+        void BuildTopology ( std::vector<uint32_t> const &triangles ) noexcept;
+
+        [[nodiscard]] uint32_t FindSupport ( GXVec3 const &directionLocal ) const noexcept;
+        [[nodiscard]] GXVec3 ToLocalDirection ( GXVec3 const &directionWorld ) const noexcept;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_SHAPE_CONVEX_HULL_HPP
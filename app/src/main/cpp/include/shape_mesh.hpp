@@ -0,0 +1,109 @@
+#ifndef ANDROID_VULKAN_SHAPE_MESH_HPP
+#define ANDROID_VULKAN_SHAPE_MESH_HPP
+
+
+#include "shape.hpp"
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <span>
+#include <vector>
+
+GX_RESTORE_WARNING_STATE
+
+
+namespace android_vulkan {
+
+// Static triangle mesh. It's intended for level geometry which never moves, so the shape must be attached to
+// kinematic rigid body. The triangles are sorted by internal bounding volume hierarchy with node bounds quantized to
+// 16 bits per axis relative to the mesh bounds. The hierarchy is traversed without stack: every internal node keeps
+// index of the node after own subtree. The shape has no volume. The contact detector handles sphere and box versus
+// mesh pairs only.
+class [[maybe_unused]] ShapeMesh final : public Shape
+{
+    public:
+        struct Triangle final
+        {
+            GXVec3                  _vertices[ 3U ];
+
+            // Counterclockwise vertex order defines the normal.
+            GXVec3                  _normal;
+        };
+
+    private:
+        struct Node final
+        {
+            uint16_t                _min[ 3U ];
+            uint16_t                _max[ 3U ];
+
+            // Leaf keeps triangle index marked by LEAF_FLAG. Internal node keeps index of the node after the subtree.
+            uint32_t                _index;
+        };
+
+        struct QuantizedBounds final
+        {
+            uint16_t                _min[ 3U ];
+            uint16_t                _max[ 3U ];
+        };
+
+    private:
+        constexpr static uint32_t   LEAF_FLAG = 0x80000000U;
+
+        // Local space vertices of triangle "i" are "_vertices[ _indices[ 3 * i + k ] ]" where k is in [ 0, 2 ].
+        std::vector<uint32_t>       _indices {};
+        std::vector<Node>           _nodes {};
+        GXVec3                      _quantizationScale {};
+        GXMat4                      _transformWorldInverse {};
+
+        // World space copy of the triangles. It's updated every time when the transform changes.
+        std::vector<Triangle>       _trianglesWorld {};
+
+        std::vector<GXVec3>         _vertices {};
+
+    public:
+        ShapeMesh () = delete;
+
+        ShapeMesh ( ShapeMesh const & ) = delete;
+        ShapeMesh &operator = ( ShapeMesh const & ) = delete;
+
+        ShapeMesh ( ShapeMesh && ) = delete;
+        ShapeMesh &operator = ( ShapeMesh && ) = delete;
+
+        // Vertices are in rigid body space. Every three indices form triangle. Degenerate triangles are dropped.
+        [[maybe_unused]] explicit ShapeMesh ( std::span<GXVec3 const> vertices,
+            std::span<uint32_t const> indices
+        ) noexcept;
+
+        ~ShapeMesh () override = default;
+
+        // The method appends indices of the triangles which bounds overlap the world bounds.
+        void CollectTriangles ( std::vector<uint32_t> &triangles, GXAABB const &boundsWorld ) const noexcept;
+
+        [[nodiscard]] Triangle const &GetTriangleWorld ( uint32_t triangle ) const noexcept;
+        [[maybe_unused, nodiscard]] size_t GetTriangleCount () const noexcept;
+
+        // The method returns true if the segment hits the mesh. Both triangle sides are solid. The closest hit point
+        // is returned. The normal faces against the segment direction.
+        [[nodiscard]] bool Raycast ( GXVec3 &point,
+            GXVec3 &normal,
+            GXVec3 const &from,
+            GXVec3 const &to
+        ) const noexcept;
+
+    private:
+        void CalculateInertiaTensor ( float mass ) noexcept override;
+        [[nodiscard]] GXVec3 GetExtremePointWorld ( GXVec3 const &direction ) const noexcept override;
+        void UpdateBounds () noexcept override;
+
+        void BuildNode ( std::span<uint32_t> order,
+            std::vector<GXAABB> const &triangleBounds,
+            std::vector<GXVec3> const &centers
+        ) noexcept;
+
+        [[nodiscard]] QuantizedBounds Quantize ( GXAABB const &bounds ) const noexcept;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_SHAPE_MESH_HPP
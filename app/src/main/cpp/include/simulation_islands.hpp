@@ -0,0 +1,71 @@
+#ifndef ANDROID_VULKAN_SIMULATION_ISLANDS_HPP
+#define ANDROID_VULKAN_SIMULATION_ISLANDS_HPP
+
+
+#include "constraint.hpp"
+#include "contact_manager.hpp"
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <vector>
+
+GX_RESTORE_WARNING_STATE
+
+
+namespace android_vulkan {
+
+// Simulation island is a group of dynamic bodies connected by contact manifolds and joints. Kinematic bodies don't
+// connect islands. The islands are rebuilt every step with union-find over the contact manifolds and joints. The island
+// falls asleep only when all its bodies are ready to sleep. The island wakes up completely when any of its bodies is
+// awake or it touches moving kinematic body.
+//
+// Sleeping bodies don't produce contact manifolds with each other and with static kinematic bodies. So the velocity
+// solver never sees sleeping islands.
+class SimulationIslands final
+{
+    private:
+        struct Island final
+        {
+            bool                    _hasAwake = false;
+            bool                    _isReadyToSleep = true;
+        };
+
+    private:
+        std::vector<RigidBody*>     _bodies {};
+        std::vector<Island>         _islands {};
+        std::vector<uint32_t>       _parents {};
+        std::vector<uint32_t>       _sizes {};
+
+    public:
+        SimulationIslands () noexcept;
+
+        SimulationIslands ( SimulationIslands const & ) = delete;
+        SimulationIslands &operator = ( SimulationIslands const & ) = delete;
+
+        SimulationIslands ( SimulationIslands && ) = delete;
+        SimulationIslands &operator = ( SimulationIslands && ) = delete;
+
+        ~SimulationIslands () = default;
+
+        // The method builds islands and wakes up islands which have at least one awake body.
+        void Build ( std::vector<RigidBodyRef> const &dynamics,
+            std::vector<ContactManifold> const &manifolds,
+            std::vector<ConstraintRef> const &constraints
+        ) noexcept;
+
+        // The method must be called after integration. It puts to sleep islands which are ready to sleep.
+        void UpdateSleep () noexcept;
+
+        // Awake dynamic body or moving kinematic body.
+        [[nodiscard]] static bool IsActive ( RigidBody const &body ) noexcept;
+
+    private:
+        void Connect ( RigidBody const &a, RigidBody const &b ) noexcept;
+        [[nodiscard]] uint32_t Find ( uint32_t node ) noexcept;
+        void Unite ( uint32_t a, uint32_t b ) noexcept;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_SIMULATION_ISLANDS_HPP
@@ -2,7 +2,7 @@
 #define ANDROID_VULKAN_SOUND_EMITTER_HPP
 
 
-#include "pcm_streamer.hpp"
+#include "pcm_source.hpp"
 #include <android_vulkan_sdk/primitive_types.hpp>
 
 GX_DISABLE_COMMON_WARNINGS
@@ -16,7 +16,7 @@ namespace android_vulkan {
 
 class SoundMixer;
 
-class SoundEmitter
+class SoundEmitter : public PCMSource
 {
     protected:
         enum class eStreamerType : uint16_t
@@ -44,8 +44,6 @@ class SoundEmitter
         SoundEmitter ( SoundEmitter && ) = delete;
         SoundEmitter &operator = ( SoundEmitter && ) = delete;
 
-        virtual void FillPCM ( std::span<PCMStreamer::PCMType> buffer, float channelVolume ) noexcept = 0;
-
         // Note method should be called in child class.
         [[nodiscard]] virtual bool Play () noexcept;
 
@@ -67,10 +65,10 @@ class SoundEmitter
 
     protected:
         SoundEmitter () = default;
-        virtual ~SoundEmitter () = default;
+        ~SoundEmitter () override = default;
 
         [[nodiscard]] static eStreamerType GetStreamerType ( std::string_view const asset ) noexcept;
-        static void OnStopRequested ( SoundEmitter &soundEmitter ) noexcept;
+        static void OnStopRequested ( PCMSource &source ) noexcept;
 };
 
 } // namespace android_vulkan
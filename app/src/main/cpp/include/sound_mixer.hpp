@@ -2,15 +2,14 @@
 #define ANDROID_VULKAN_SOUND_MIXER_HPP
 
 
+#include "pcm_mixer.hpp"
 #include "sound_emitter.hpp"
 #include "sound_listener_info.hpp"
 #include "sound_storage.hpp"
 
 GX_DISABLE_COMMON_WARNINGS
 
-#include <deque>
 #include <limits>
-#include <list>
 #include <optional>
 #include <thread>
 #include <unordered_set>
@@ -21,8 +20,8 @@ GX_RESTORE_WARNING_STATE
 
 namespace android_vulkan {
 
-// Class is taking into consideration AAudio limitations.
-// See docs/aaudio-issues.md
+// Class is taking into consideration AAudio limitations. All playing emitters are mixed in software into one
+// AAudio stream. See docs/aaudio-issues.md
 class SoundMixer final
 {
     private:
@@ -35,45 +34,8 @@ class SoundMixer final
             AAudioStream*                               _stream = nullptr;
         };
 
-        class StreamInfo;
-        using StreamList = std::list<StreamInfo*>;
-
-        class StreamInfo final
-        {
-            private:
-                std::unique_ptr<std::atomic_bool>       _fillLock = std::make_unique<std::atomic_bool> ( false );
-                bool                                    _fillSilence = true;
-
-            public:
-                SoundEmitter*                           _emitter = nullptr;
-                SoundMixer*                             _mixer = nullptr;
-                AAudioStream*                           _stream = nullptr;
-                StreamList::iterator                    _used {};
-
-            public:
-                StreamInfo () = default;
-
-                StreamInfo ( StreamInfo const & ) = delete;
-                StreamInfo &operator = ( StreamInfo const & ) = delete;
-
-                StreamInfo ( StreamInfo && ) = default;
-                StreamInfo &operator = ( StreamInfo && ) = delete;
-
-                explicit StreamInfo ( SoundMixer &mixer, StreamList::iterator used ) noexcept;
-
-                ~StreamInfo () = default;
-
-                // This is part of AAudio fill thread sync.
-                // AAudio fill thread should be mutex free to avoid audio glitches.
-                [[nodiscard]] bool LockAndReturnFillSilence () noexcept;
-                void Release () noexcept;
-                void Modify ( bool fillSilence ) noexcept;
-        };
-
-        using StreamMap = std::unordered_map<SoundEmitter*, StreamInfo*>;
-
     private:
-        constexpr static auto TOTAL_SOUND_CHANNELS = static_cast<size_t> ( eSoundChannel::Speech ) + 1U;
+        constexpr static auto TOTAL_SOUND_CHANNELS = PCMMixer::TOTAL_SOUND_CHANNELS;
 
         std::vector<ActionInfo>                         _actionQueue {};
 
@@ -84,6 +46,8 @@ class SoundMixer final
         Decompressors                                   _decompressors {};
 
         float                                           _effectiveChannelVolume[ TOTAL_SOUND_CHANNELS ] {};
+        std::unordered_set<SoundEmitter*>               _emitters {};
+        bool                                            _isPaused = false;
 
         SoundListenerInfo                               _listenerInfo {};
         GXQuat                                          _listenerOrientation {};
@@ -91,16 +55,10 @@ class SoundMixer final
 
         float                                           _masterVolume = 1.0F;
         std::mutex                                      _mutex {};
+        PCMMixer                                        _pcmMixer {};
 
         SoundStorage                                    _soundStorage {};
-
-        StreamMap                                       _streamMap {};
-        std::vector<StreamInfo>                         _streamInfo {};
-        std::deque<AAudioStream*>                       _streamToResume {};
-
-        StreamList                                      _free {};
-        StreamList                                      _stopping {};
-        StreamList                                      _used {};
+        AAudioStream*                                   _stream = nullptr;
 
         bool                                            _workerFlag = true;
         std::thread                                     _workerThread {};
@@ -154,7 +112,7 @@ class SoundMixer final
 
         [[nodiscard]] constexpr static int32_t GetChannelCount () noexcept
         {
-            return 2;
+            return PCMMixer::GetChannelCount ();
         }
 
         [[nodiscard]] constexpr static aaudio_format_t GetFormat () noexcept
@@ -164,14 +122,14 @@ class SoundMixer final
 
         [[nodiscard]] constexpr static int32_t GetSampleRate () noexcept
         {
-            return 44100;
+            return PCMMixer::GetSampleRate ();
         }
 
     private:
-        [[nodiscard]] bool CreateHardwareStreams () noexcept;
-        [[nodiscard]] std::optional<AAudioStream*> CreateStream ( StreamInfo &streamInfo ) noexcept;
+        [[nodiscard]] std::optional<AAudioStream*> CreateStream () noexcept;
 
         void RecreateSoundStream ( AAudioStream &stream ) noexcept;
+        [[nodiscard]] bool RemoveEmitter ( SoundEmitter &emitter, char const* where ) noexcept;
         [[nodiscard]] bool ResolveBufferSize () noexcept;
         [[nodiscard]] bool SetStreamBufferSize ( AAudioStream &stream, char const* where ) const noexcept;
         [[nodiscard]] bool ValidateStream ( AAudioStream &stream ) const noexcept;
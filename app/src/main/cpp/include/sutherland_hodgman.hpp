@@ -3,14 +3,16 @@
 
 
 #include <GXCommon/GXMath.hpp>
+#include "contact_feature.hpp"
 #include "vertices.hpp"
+#include <tuple>
 #include <vector>
 
 
 namespace android_vulkan {
 
-//                                                    a       b
-using SutherlandHodgmanResult = std::vector<std::pair<GXVec3, GXVec3>>;
+//                                                     a       b       feature
+using SutherlandHodgmanResult = std::vector<std::tuple<GXVec3, GXVec3, ContactFeature>>;
 
 // Sutherland–Hodgman algorithm. The implementation is based on ideas from
 // https://en.wikipedia.org/wiki/Sutherland%E2%80%93Hodgman_algorithm
@@ -19,10 +21,23 @@ class SutherlandHodgman final
     private:
         using Projection = std::vector<GXVec2>;
 
+        struct ClipFeature final
+        {
+            // Feature of the point itself.
+            ContactFeature          _point;
+
+            // Feature of the polygon edge which starts from the point.
+            ContactFeature          _edge;
+        };
+
+        using ClipFeatures = std::vector<ClipFeature>;
+
     private:
+        ClipFeatures                _clipFeatures {};
         Projection                  _clipPoints {};
         SutherlandHodgmanResult     _result {};
         Projection                  _windowPoints {};
+        ClipFeatures                _workingFeatures {};
         Projection                  _workingPoints {};
 
     public:
@@ -38,7 +53,7 @@ class SutherlandHodgman final
 
         // Method returns pairs of points. Shape A is considered as clipping window in clipping operation.
         // Note the method will reject any shape A points which will be in front of shape B. So only penetration pairs
-        // will be returned.
+        // will be returned. Every pair has feature ID in terms of shape A edges and shape B vertices and edges.
          [[nodiscard]] SutherlandHodgmanResult const &Run ( Vertices const &shapeAPoints,
              GXVec3 const &shapeANormal,
              Vertices const &shapeBPoints,
@@ -0,0 +1,97 @@
+#ifndef ANDROID_VULKAN_SWEEP_AND_PRUNE_HPP
+#define ANDROID_VULKAN_SWEEP_AND_PRUNE_HPP
+
+
+#include "broad_phase.hpp"
+#include "proxy_pair_set.hpp"
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <unordered_map>
+
+GX_RESTORE_WARNING_STATE
+
+
+namespace android_vulkan {
+
+// Incremental sort and sweep over persistent endpoint arrays. Endpoints are kept sorted along every axis with
+// the insertion sort. Bodies move a little between the steps, so the arrays are almost sorted and the sort costs
+// O(n + swaps). Every swap of minimum and maximum endpoints of two bodies starts or ends their overlap along the axis.
+// The persistent pair set is updated right at the swap. So pair collection only copies the set out and costs
+// O(pairs). Queries scan the axis with maximum variance of the body centers.
+// The implementation is based on ideas from
+// Pierre Terdiman, Sweep-and-prune, 2007
+// http://www.codercorner.com/SAP.pdf
+class SweepAndPrune final : public BroadPhase
+{
+    private:
+        constexpr static uint32_t NULL_PROXY = std::numeric_limits<uint32_t>::max ();
+
+        struct Endpoint final
+        {
+            float           _value = 0.0F;
+
+            // Lowest bit is set for the maximum endpoint. Other bits store proxy index.
+            uint32_t        _data = 0U;
+        };
+
+        struct Proxy final
+        {
+            GXAABB          _bounds {};
+            RigidBodyRef    _body {};
+
+            // Copy of the shape collision groups. The pair is rejected by the groups before the bounds test.
+            uint32_t        _groups = 0U;
+
+            // The next free proxy for released proxies.
+            uint32_t        _nextFree = NULL_PROXY;
+        };
+
+    private:
+        // The axis of the queries.
+        uint8_t                                         _axis = 0U;
+
+        std::vector<Endpoint>                           _endpoints[ 3U ] {};
+        uint32_t                                        _freeList = NULL_PROXY;
+
+        // Pairs of proxies with overlapped fat bounds. Collision groups and kinematic bodies are not filtered here.
+        ProxyPairSet                                    _pairs {};
+
+        std::unordered_map<RigidBody const*, uint32_t>  _proxyMap {};
+        std::vector<Proxy>                              _proxies {};
+
+    public:
+        SweepAndPrune () noexcept;
+
+        SweepAndPrune ( SweepAndPrune const & ) = delete;
+        SweepAndPrune &operator = ( SweepAndPrune const & ) = delete;
+
+        SweepAndPrune ( SweepAndPrune && ) = delete;
+        SweepAndPrune &operator = ( SweepAndPrune && ) = delete;
+
+        ~SweepAndPrune () override = default;
+
+        void Insert ( RigidBodyRef const &body ) noexcept override;
+        void Remove ( RigidBody const &body ) noexcept override;
+        void Reset () noexcept override;
+        void Update ( float deltaTime ) noexcept override;
+        void CollectPairs ( Pairs &pairs ) noexcept override;
+        void QueryBounds ( Bodies &bodies, GXAABB const &bounds ) noexcept override;
+        void QueryRay ( Bodies &bodies, GXVec3 const &from, GXVec3 const &to ) noexcept override;
+
+    private:
+        [[nodiscard]] uint8_t FindQueryAxis () const noexcept;
+        void SortEndpoints ( uint8_t axis ) noexcept;
+        void UpdateEndpointValues ( uint8_t axis ) noexcept;
+
+        // The method calls the visitor with index of every proxy which fat bounds could overlap the bounds.
+        template<typename T>
+        void Scan ( GXAABB const &bounds, T const &visitor ) const noexcept;
+
+        [[nodiscard]] static bool IsLess ( Endpoint const &a, Endpoint const &b ) noexcept;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_SWEEP_AND_PRUNE_HPP
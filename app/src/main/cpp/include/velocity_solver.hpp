@@ -2,7 +2,15 @@
 #define ANDROID_VULKAN_VELOCITY_SOLVER_HPP
 
 
+#include "constraint.hpp"
 #include "contact_manager.hpp"
+#include "worker_pool.hpp"
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <span>
+
+GX_RESTORE_WARNING_STATE
 
 
 namespace android_vulkan {
@@ -16,8 +24,69 @@ namespace android_vulkan {
 //
 // Bullet engine ver. 3.20 (commit: 48dc1c45da685c77d3642545c4851b05fb3a1e8b):
 // src/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.cpp
+//
+// The manifolds are split into colors with greedy graph coloring. Manifolds of the same color don't share dynamic
+// bodies. So every color is solved by all workers in parallel and the colors are solved one by one. The result does
+// not depend on amount of workers.
+//
+// The normal impulses of the manifold are solved in Jacobi manner: every contact uses the same start velocities and
+// the velocity deltas are summed. So the contacts of the manifold are packed into structure of arrays and solved
+// together by SolveNormalBatch. The method has NEON, SSE and scalar implementations. Only one of them is compiled.
+// See <repo>/app/src/main/cpp/sources/intrinsics/velocity_solver_*.cpp
+//
+// The joints are solved before the contacts on every iteration. Joints share bodies with each other much more often
+// than contacts do. So they are not colored and they are solved by single worker.
 class VelocitySolver final
 {
+    public:
+        // Manifold has four contacts at most after ContactManager::Warm.
+        constexpr static size_t BATCH_LANES = 4U;
+
+    private:
+        // The last color is reserved for manifolds which can't be colored. Such manifolds are solved by single worker.
+        constexpr static size_t MAX_COLORS = 64U;
+        constexpr static size_t OVERFLOW_COLOR = MAX_COLORS;
+
+        enum class eStage : uint8_t
+        {
+            Prepare,
+            Joint,
+            Normal,
+            Friction
+        };
+
+        // The lanes without contact are zeroed. Such lanes produce zero impulse.
+        struct alignas ( 16U ) NormalBatch final
+        {
+            float       _j[ 2U ][ 6U ][ BATCH_LANES ];
+            float       _mj[ 2U ][ 6U ][ BATCH_LANES ];
+            float       _effectiveMass[ BATCH_LANES ];
+            float       _lambda[ BATCH_LANES ];
+
+            // The Baumgarte term is "_stabilization + max ( _restitution * vClosing + _restitutionBias, 0 )".
+            // Note closing velocity along the normal is equal to the Jacobian and velocity vector dot product.
+            // Speculative contact has positive "_stabilization". It allows approaching velocity which closes the gap
+            // within the step.
+            float       _stabilization[ BATCH_LANES ];
+            float       _restitution[ BATCH_LANES ];
+            float       _restitutionBias[ BATCH_LANES ];
+        };
+
+    private:
+        std::vector<uint64_t>                       _bodyColors {};
+        size_t                                      _colorCount = 0U;
+        std::array<size_t, MAX_COLORS + 2U>         _colorOffsets {};
+        std::vector<uint8_t>                        _colors {};
+        std::span<Constraint* const>                _constraints {};
+        ContactManifold*                            _manifolds = nullptr;
+        std::vector<NormalBatch>                    _normalBatches {};
+        std::vector<uint32_t>                       _order {};
+        float                                       _fixedTimeStepInverse = 0.0F;
+        uint16_t                                    _iterations = 0U;
+        float                                       _stabilizationFactor = 0.0F;
+        float                                       _substepTimeInverse = 0.0F;
+        WorkerPool*                                 _workerPool = nullptr;
+
     public:
         VelocitySolver () = default;
 
@@ -29,32 +98,53 @@ class VelocitySolver final
 
         ~VelocitySolver () = default;
 
-        static void Run ( ContactManager &contactManager, float fixedTimeStepInverse ) noexcept;
+        // The method uses the dense index of the dynamic bodies assigned by SimulationIslands::Build.
+        // "constraints" must contain only active joints.
+        // The method advances the bodies by "1 / substeps" of the fixed step. The iterations are split between
+        // the substeps. So the total solver cost stays close to the cost of single step.
+        void Run ( ContactManager &contactManager,
+            std::span<Constraint* const> constraints,
+            float fixedTimeStepInverse,
+            size_t substeps,
+            size_t dynamicBodies,
+            WorkerPool &workerPool
+        ) noexcept;
 
     private:
-        [[nodiscard]] static float ComputeBaumgarteTerm ( GXVec3 const &wA,
-            GXVec3 const &wB,
-            GXVec3 const &cmA,
-            GXVec3 const &cmB,
-            GXVec3 const &dV,
-            Contact const &contact,
-            float stabilizationFactor
-        ) noexcept;
+        void ColorManifolds ( std::vector<ContactManifold> &manifolds, size_t dynamicBodies ) noexcept;
+        void SolveColor ( size_t color, size_t worker, eStage stage ) noexcept;
+        void SolveConstraints ( size_t worker, eStage stage ) noexcept;
+
+        static void Job ( WorkerPool::Context context, size_t worker ) noexcept;
 
         [[maybe_unused]] static void DebugContactInManifold ( ContactManager const &contactManager ) noexcept;
         [[maybe_unused]] static void DebugWarmStart ( ContactManager const &contactManager ) noexcept;
 
+        static void PackNormalBatch ( NormalBatch &batch,
+            ContactManifold const &manifold,
+            float stabilizationFactor,
+            float substepTimeInverse
+        ) noexcept;
+
         static void PreparePair ( ContactManifold &manifold ) noexcept;
         static void PrepareSingle ( ContactManifold &manifold ) noexcept;
 
         // Basically it's a solver for dynamic vs dynamic body.
         static void SolvePairFriction ( ContactManifold &manifold ) noexcept;
-        static void SolvePairNormal ( ContactManifold &manifold, float stabilizationFactor ) noexcept;
+        static void SolvePairNormal ( ContactManifold &manifold, NormalBatch &batch ) noexcept;
 
         // Basically it's a solver for dynamic vs kinematic body.
         // Note the body A in the manifold data structure is dynamic while body B is kinematic.
         static void SolveSingleFriction ( ContactManifold &manifold ) noexcept;
-        static void SolveSingleNormal ( ContactManifold &manifold, float stabilizationFactor ) noexcept;
+        static void SolveSingleNormal ( ContactManifold &manifold, NormalBatch &batch ) noexcept;
+
+        // Computes normal impulses of the all lanes and returns velocity deltas of the both bodies.
+        static void SolveNormalBatch ( NormalBatch &batch,
+            GXVec6 const &vwA,
+            GXVec6 const &vwB,
+            GXVec6 &deltaA,
+            GXVec6 &deltaB
+        ) noexcept;
 
         static void SwapBodies ( ContactManifold &manifold ) noexcept;
 
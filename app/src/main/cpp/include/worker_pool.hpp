@@ -0,0 +1,72 @@
+#ifndef ANDROID_VULKAN_WORKER_POOL_HPP
+#define ANDROID_VULKAN_WORKER_POOL_HPP
+
+
+#include <GXCommon/GXWarning.hpp>
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+GX_RESTORE_WARNING_STATE
+
+
+namespace android_vulkan {
+
+// Persistent pool of worker threads for short fork-join jobs. The job is executed once by every worker. The caller
+// thread is always the worker zero. So the pool without threads executes the job in place. Workers spin for a while
+// after the job is done before falling asleep because physics dispatches many small jobs per frame.
+class WorkerPool final
+{
+    public:
+        using Context = void*;
+        using Job = void ( * ) ( Context context, size_t worker ) noexcept;
+
+    private:
+        std::atomic_size_t              _barrierCount = 0U;
+        std::atomic_uint32_t            _barrierPhase = 0U;
+        std::atomic_size_t              _busy = 0U;
+        std::condition_variable         _condition {};
+        Context                         _context = nullptr;
+        std::atomic_uint32_t            _generation = 0U;
+        std::atomic_bool                _isRunning = false;
+        Job                             _job = nullptr;
+        std::mutex                      _mutex {};
+        std::vector<std::thread>        _threads {};
+
+    public:
+        WorkerPool () = default;
+
+        WorkerPool ( WorkerPool const & ) = delete;
+        WorkerPool &operator = ( WorkerPool const & ) = delete;
+
+        WorkerPool ( WorkerPool && ) = delete;
+        WorkerPool &operator = ( WorkerPool && ) = delete;
+
+        ~WorkerPool ();
+
+        // The method must be called by all workers from the job. It returns when all workers reach the barrier.
+        void Barrier () noexcept;
+
+        // Total amount of workers including the caller thread.
+        [[nodiscard]] size_t GetWorkerCount () const noexcept;
+
+        // The method blocks the caller thread until all workers finish the job.
+        void Run ( Job job, Context context ) noexcept;
+
+        // "threads" does not include the caller thread.
+        void Start ( size_t threads ) noexcept;
+        void Stop () noexcept;
+
+    private:
+        void Work ( size_t worker, uint32_t generationSeen ) noexcept;
+};
+
+} // namespace android_vulkan
+
+
+#endif // ANDROID_VULKAN_WORKER_POOL_HPP
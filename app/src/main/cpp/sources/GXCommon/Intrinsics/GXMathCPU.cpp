@@ -1,4 +1,4 @@
-// version 1.15
+// version 1.17
 
 #include <precompiled_headers.hpp>
 #include <GXCommon/GXMath.hpp>
@@ -53,6 +53,11 @@
 
 //----------------------------------------------------------------------------------------------------------------------
 
+[[maybe_unused]] GXVoid GXVec3::NormalizeFast () noexcept
+{
+    Multiply ( *this, 1.0F / std::sqrt ( DotProduct ( *this ) ) );
+}
+
 [[maybe_unused]] GXVoid GXVec3::Reverse () noexcept
 {
     _data[ 0U ] = -_data[ 0U ];
@@ -250,6 +255,11 @@
     Multiply ( *this, 1.0F / std::sqrt ( squaredLength ) );
 }
 
+[[maybe_unused]] GXVoid GXQuat::NormalizeFast () noexcept
+{
+    Normalize ();
+}
+
 [[maybe_unused]] GXVoid GXQuat::Inverse ( GXQuat const &q ) noexcept
 {
     GXFloat const squaredLength = q._data[ 0U ] * q._data[ 0U ] +
@@ -733,3 +743,127 @@
         ( y <= maxBounds[ 1U ] ) &
         ( z <= maxBounds[ 2U ] );
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXProjectionClipPlanes::IsVisible ( std::span<GXUInt> visibility,
+    GXAABBSoA<GXFloat const> const &bounds
+) const noexcept
+{
+    // The box is invisible if the corner farthest along the plane normal is behind any plane. Rounding of the sum
+    // is monotonic. So the result is the same as the test of all eight corners.
+    constexpr size_t wordBits = 32U;
+
+    GXFloat const* inMin[] = { bounds._min._x.data (), bounds._min._y.data (), bounds._min._z.data () };
+    GXFloat const* inMax[] = { bounds._max._x.data (), bounds._max._y.data (), bounds._max._z.data () };
+
+    size_t const count = bounds._min._x.size ();
+    GXUInt* const words = visibility.data ();
+    std::fill_n ( words, ( count + wordBits - 1U ) / wordBits, 0U );
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        GXFloat const low[] = { inMin[ 0U ][ i ], inMin[ 1U ][ i ], inMin[ 2U ][ i ] };
+        GXFloat const high[] = { inMax[ 0U ][ i ], inMax[ 1U ][ i ], inMax[ 2U ][ i ] };
+        bool isVisible = true;
+
+        for ( GXPlane const &plane : _planes )
+        {
+            GXFloat const x = std::max ( plane._a * low[ 0U ], plane._a * high[ 0U ] );
+            GXFloat const y = std::max ( plane._b * low[ 1U ], plane._b * high[ 1U ] );
+            GXFloat const z = std::max ( plane._c * low[ 2U ], plane._c * high[ 2U ] );
+            isVisible &= !( x + y + z + plane._d < 0.0F );
+        }
+
+        words[ i / wordBits ] |= static_cast<GXUInt> ( isVisible ) << ( i % wordBits );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXCALL GXMultiplyAsPointBatch ( GXVec3SoA<GXFloat> const &out,
+    GXMat4 const &transform,
+    GXVec3SoA<GXFloat const> const &points
+) noexcept
+{
+    auto const &m = transform._data;
+    size_t const count = out._x.size ();
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        GXFloat const x = points._x[ i ];
+        GXFloat const y = points._y[ i ];
+        GXFloat const z = points._z[ i ];
+
+        out._x[ i ] = x * m[ 0U ][ 0U ] + y * m[ 1U ][ 0U ] + z * m[ 2U ][ 0U ] + m[ 3U ][ 0U ];
+        out._y[ i ] = x * m[ 0U ][ 1U ] + y * m[ 1U ][ 1U ] + z * m[ 2U ][ 1U ] + m[ 3U ][ 1U ];
+        out._z[ i ] = x * m[ 0U ][ 2U ] + y * m[ 1U ][ 2U ] + z * m[ 2U ][ 2U ] + m[ 3U ][ 2U ];
+    }
+}
+
+[[maybe_unused]] GXVoid GXCALL GXTransformAABBBatch ( GXAABBSoA<GXFloat> const &out,
+    GXAABBSoA<GXFloat const> const &bounds,
+    std::span<GXMat4 const> transforms
+) noexcept
+{
+    // The corner with the smallest component takes the smaller product of every row. Rounding of the sum is monotonic.
+    // So the result is bit exact with the transform of all eight corners.
+    std::span<GXFloat> const outMin[] = { out._min._x, out._min._y, out._min._z };
+    std::span<GXFloat> const outMax[] = { out._max._x, out._max._y, out._max._z };
+    size_t const count = out._min._x.size ();
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        GXFloat const low[] = { bounds._min._x[ i ], bounds._min._y[ i ], bounds._min._z[ i ] };
+        GXFloat const high[] = { bounds._max._x[ i ], bounds._max._y[ i ], bounds._max._z[ i ] };
+        auto const &m = transforms[ i ]._data;
+
+        for ( size_t c = 0U; c < 3U; ++c )
+        {
+            GXFloat const x0 = low[ 0U ] * m[ 0U ][ c ];
+            GXFloat const x1 = high[ 0U ] * m[ 0U ][ c ];
+            GXFloat const y0 = low[ 1U ] * m[ 1U ][ c ];
+            GXFloat const y1 = high[ 1U ] * m[ 1U ][ c ];
+            GXFloat const z0 = low[ 2U ] * m[ 2U ][ c ];
+            GXFloat const z1 = high[ 2U ] * m[ 2U ][ c ];
+
+            outMin[ c ][ i ] = std::min ( x0, x1 ) + std::min ( y0, y1 ) + std::min ( z0, z1 ) + m[ 3U ][ c ];
+            outMax[ c ][ i ] = std::max ( x0, x1 ) + std::max ( y0, y1 ) + std::max ( z0, z1 ) + m[ 3U ][ c ];
+        }
+    }
+}
+
+[[maybe_unused]] GXVoid GXCALL GXMultiplyMat4Batch ( std::span<GXMat4> out,
+    std::span<GXMat4 const> a,
+    std::span<GXMat4 const> b
+) noexcept
+{
+    size_t const count = out.size ();
+
+    for ( size_t i = 0U; i < count; ++i )
+        out[ i ].Multiply ( a[ i ], b[ i ] );
+}
+
+[[maybe_unused]] GXVoid GXCALL GXSphericalLinearInterpolationBatch ( GXQuatSoA<GXFloat> const &out,
+    GXQuatSoA<GXFloat const> const &start,
+    GXQuatSoA<GXFloat const> const &finish,
+    GXFloat interpolationFactor
+) noexcept
+{
+    size_t const count = out._r.size ();
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        GXQuat result {};
+
+        result.SphericalLinearInterpolation ( GXQuat ( start._r[ i ], start._a[ i ], start._b[ i ], start._c[ i ] ),
+            GXQuat ( finish._r[ i ], finish._a[ i ], finish._b[ i ], finish._c[ i ] ),
+            interpolationFactor
+        );
+
+        out._r[ i ] = result._data[ 0U ];
+        out._a[ i ] = result._data[ 1U ];
+        out._b[ i ] = result._data[ 2U ];
+        out._c[ i ] = result._data[ 3U ];
+    }
+}
@@ -1,4 +1,4 @@
-// version 1.16
+// version 1.18
 
 #include <precompiled_headers.hpp>
 #include <GXCommon/GXMath.hpp>
@@ -6,6 +6,22 @@
 
 namespace {
 
+// The batch functions process four elements per iteration. The rest is processed one element at a time.
+constexpr size_t BATCH_LANES = 4U;
+
+// Bits per element of the visibility mask. See GXProjectionClipPlanes::IsVisible.
+constexpr size_t WORD_BITS = 32U;
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// The estimate has 8 bits only. So two Newton-Raphson steps are needed to make the relative error less than 5.0e-7F.
+[[nodiscard]] float32_t ReciprocalSquareRoot ( float32_t value ) noexcept
+{
+    float32_t y = vrsqrtes_f32 ( value );
+    y *= vrsqrtss_f32 ( value * y, y );
+    return y * vrsqrtss_f32 ( value * y, y );
+}
+
 [[nodiscard]] GXBool AABBIsOverlapped ( float32x4_t const &leftA,
     float32x2_t const &leftB,
     float32x4_t const &rightA,
@@ -30,6 +46,84 @@ namespace {
     return ( gather4 | gather2 ) == 0b0011'1111U;
 }
 
+void Transpose ( float32x4_t &r0, float32x4_t &r1, float32x4_t &r2, float32x4_t &r3 ) noexcept
+{
+    float32x4x2_t const t01 = vtrnq_f32 ( r0, r1 );
+    float32x4x2_t const t23 = vtrnq_f32 ( r2, r3 );
+
+    r0 = vcombine_f32 ( vget_low_f32 ( t01.val[ 0U ] ), vget_low_f32 ( t23.val[ 0U ] ) );
+    r1 = vcombine_f32 ( vget_low_f32 ( t01.val[ 1U ] ), vget_low_f32 ( t23.val[ 1U ] ) );
+    r2 = vcombine_f32 ( vget_high_f32 ( t01.val[ 0U ] ), vget_high_f32 ( t23.val[ 0U ] ) );
+    r3 = vcombine_f32 ( vget_high_f32 ( t01.val[ 1U ] ), vget_high_f32 ( t23.val[ 1U ] ) );
+}
+
+// One component of the points transformed by GXMat4::MultiplyAsPoint. "column" contains the broadcast elements
+// of the matrix column.
+[[nodiscard]] float32x4_t PointComponent ( float32x4_t x,
+    float32x4_t y,
+    float32x4_t z,
+    float32x4_t const* column
+) noexcept
+{
+    float32x4_t const a = vaddq_f32 ( vmulq_f32 ( x, column[ 0U ] ), vmulq_f32 ( y, column[ 1U ] ) );
+    return vaddq_f32 ( vaddq_f32 ( a, vmulq_f32 ( z, column[ 2U ] ) ), column[ 3U ] );
+}
+
+// One component of the transformed bounds. "column" contains the elements of the matrix column for every lane.
+// See GXTransformAABBBatch in GXMathCPU.cpp.
+void BoundsComponent ( float32x4_t &low,
+    float32x4_t &high,
+    float32x4_t const* boundsMin,
+    float32x4_t const* boundsMax,
+    float32x4_t const* column
+) noexcept
+{
+    float32x4_t const x0 = vmulq_f32 ( boundsMin[ 0U ], column[ 0U ] );
+    float32x4_t const x1 = vmulq_f32 ( boundsMax[ 0U ], column[ 0U ] );
+    float32x4_t const y0 = vmulq_f32 ( boundsMin[ 1U ], column[ 1U ] );
+    float32x4_t const y1 = vmulq_f32 ( boundsMax[ 1U ], column[ 1U ] );
+    float32x4_t const z0 = vmulq_f32 ( boundsMin[ 2U ], column[ 2U ] );
+    float32x4_t const z1 = vmulq_f32 ( boundsMax[ 2U ], column[ 2U ] );
+
+    float32x4_t const lowXY = vaddq_f32 ( vminq_f32 ( x0, x1 ), vminq_f32 ( y0, y1 ) );
+    low = vaddq_f32 ( vaddq_f32 ( lowXY, vminq_f32 ( z0, z1 ) ), column[ 3U ] );
+
+    float32x4_t const highXY = vaddq_f32 ( vmaxq_f32 ( x0, x1 ), vmaxq_f32 ( y0, y1 ) );
+    high = vaddq_f32 ( vaddq_f32 ( highXY, vmaxq_f32 ( z0, z1 ) ), column[ 3U ] );
+}
+
+// The lanes where the corner farthest along the plane normal is behind the plane. Rounding of the sum is monotonic.
+// So the result is the same as the test of all eight corners.
+[[nodiscard]] uint32x4_t PlaneBehind ( float32x4_t const* low,
+    float32x4_t const* high,
+    float32x4_t const* plane
+) noexcept
+{
+    auto const term = [ & ] ( size_t axis ) noexcept -> float32x4_t {
+        float32x4_t const a = vmulq_f32 ( plane[ axis ], low[ axis ] );
+        return vmaxq_f32 ( a, vmulq_f32 ( plane[ axis ], high[ axis ] ) );
+    };
+
+    float32x4_t const xy = vaddq_f32 ( term ( 0U ), term ( 1U ) );
+    float32x4_t const test = vaddq_f32 ( vaddq_f32 ( xy, term ( 2U ) ), plane[ 3U ] );
+    return vcltzq_f32 ( test );
+}
+
+// The interpolation weights of GXQuat::SphericalLinearInterpolation. "cosom" is not negative.
+void SlerpScales ( GXFloat &scale0, GXFloat &scale1, GXFloat cosom, GXFloat interpolationFactor ) noexcept
+{
+    scale0 = 1.0F - interpolationFactor;
+    scale1 = interpolationFactor;
+
+    if ( 1.0F - cosom <= GX_MATH_FLOAT_EPSILON ) [[unlikely]]
+        return;
+
+    GXFloat const omega = std::acos ( cosom );
+    GXFloat const sinom = 1.0F / std::sin ( omega );
+    scale0 = sinom * std::sin ( omega * scale0 );
+    scale1 = sinom * std::sin ( omega * interpolationFactor );
+}
+
 } // end of anonymous namespace
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -78,6 +172,11 @@ namespace {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+[[maybe_unused]] GXVoid GXVec3::NormalizeFast () noexcept
+{
+    Multiply ( *this, ReciprocalSquareRoot ( DotProduct ( *this ) ) );
+}
+
 [[maybe_unused]] GXVoid GXVec3::Reverse () noexcept
 {
     // Note vld1q_f32 expects float32_t[ 4U ] array as input. So the 4-th component is garbage but it's not used in
@@ -324,6 +423,16 @@ namespace {
     vst1q_f32 ( _data, vmulq_n_f32 ( alpha, 1.0F / std::sqrt ( squaredLength ) ) );
 }
 
+[[maybe_unused]] GXVoid GXQuat::NormalizeFast () noexcept
+{
+    float32x4_t const alpha = vld1q_f32 ( _data );
+    float32_t squaredLength = vaddvq_f32 ( vmulq_f32 ( alpha, alpha ) );
+
+    assert ( squaredLength > GX_MATH_FLOAT_EPSILON );
+
+    vst1q_f32 ( _data, vmulq_n_f32 ( alpha, ReciprocalSquareRoot ( squaredLength ) ) );
+}
+
 [[maybe_unused]] GXVoid GXQuat::Inverse ( GXQuat const &q ) noexcept
 {
     float32x4_t const alpha = vld1q_f32 ( q._data );
@@ -1001,3 +1110,283 @@ namespace {
         vld1_f32 ( maxBounds + 1U )
     );
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXProjectionClipPlanes::IsVisible ( std::span<GXUInt> visibility,
+    GXAABBSoA<GXFloat const> const &bounds
+) const noexcept
+{
+    GXFloat const* inMin[] = { bounds._min._x.data (), bounds._min._y.data (), bounds._min._z.data () };
+    GXFloat const* inMax[] = { bounds._max._x.data (), bounds._max._y.data (), bounds._max._z.data () };
+
+    size_t const count = bounds._min._x.size ();
+    GXUInt* const words = visibility.data ();
+    std::fill_n ( words, ( count + WORD_BITS - 1U ) / WORD_BITS, 0U );
+    size_t i = 0U;
+
+    float32x4_t planes[ 6U ][ 4U ];
+
+    for ( size_t p = 0U; p < 6U; ++p )
+    {
+        GXPlane const &plane = _planes[ p ];
+        planes[ p ][ 0U ] = vdupq_n_f32 ( plane._a );
+        planes[ p ][ 1U ] = vdupq_n_f32 ( plane._b );
+        planes[ p ][ 2U ] = vdupq_n_f32 ( plane._c );
+        planes[ p ][ 3U ] = vdupq_n_f32 ( plane._d );
+    }
+
+    constexpr uint32_t const laneBits[ BATCH_LANES ] = { 1U, 2U, 4U, 8U };
+    uint32x4_t const bits = vld1q_u32 ( laneBits );
+
+    size_t const vectorCount = count - count % BATCH_LANES;
+
+    for ( ; i < vectorCount; i += BATCH_LANES )
+    {
+        float32x4_t const low[] =
+        {
+            vld1q_f32 ( inMin[ 0U ] + i ),
+            vld1q_f32 ( inMin[ 1U ] + i ),
+            vld1q_f32 ( inMin[ 2U ] + i )
+        };
+
+        float32x4_t const high[] =
+        {
+            vld1q_f32 ( inMax[ 0U ] + i ),
+            vld1q_f32 ( inMax[ 1U ] + i ),
+            vld1q_f32 ( inMax[ 2U ] + i )
+        };
+
+        uint32x4_t behind = vdupq_n_u32 ( 0U );
+
+        for ( auto const &plane : planes )
+            behind = vorrq_u32 ( behind, PlaneBehind ( low, high, plane ) );
+
+        auto const visible = static_cast<GXUInt> ( vaddvq_u32 ( vbicq_u32 ( bits, behind ) ) );
+        words[ i / WORD_BITS ] |= visible << ( i % WORD_BITS );
+    }
+
+    for ( ; i < count; ++i )
+    {
+        GXFloat const low[] = { inMin[ 0U ][ i ], inMin[ 1U ][ i ], inMin[ 2U ][ i ] };
+        GXFloat const high[] = { inMax[ 0U ][ i ], inMax[ 1U ][ i ], inMax[ 2U ][ i ] };
+        bool isVisible = true;
+
+        for ( GXPlane const &plane : _planes )
+        {
+            GXFloat const x = std::max ( plane._a * low[ 0U ], plane._a * high[ 0U ] );
+            GXFloat const y = std::max ( plane._b * low[ 1U ], plane._b * high[ 1U ] );
+            GXFloat const z = std::max ( plane._c * low[ 2U ], plane._c * high[ 2U ] );
+            isVisible &= !( x + y + z + plane._d < 0.0F );
+        }
+
+        words[ i / WORD_BITS ] |= static_cast<GXUInt> ( isVisible ) << ( i % WORD_BITS );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXCALL GXMultiplyAsPointBatch ( GXVec3SoA<GXFloat> const &out,
+    GXMat4 const &transform,
+    GXVec3SoA<GXFloat const> const &points
+) noexcept
+{
+    auto const &m = transform._data;
+    float32x4_t columns[ 3U ][ 4U ];
+
+    for ( size_t c = 0U; c < 3U; ++c )
+    {
+        for ( size_t r = 0U; r < 4U; ++r )
+            columns[ c ][ r ] = vdupq_n_f32 ( m[ r ][ c ] );
+    }
+
+    GXFloat* const outX = out._x.data ();
+    GXFloat* const outY = out._y.data ();
+    GXFloat* const outZ = out._z.data ();
+
+    GXFloat const* pointX = points._x.data ();
+    GXFloat const* pointY = points._y.data ();
+    GXFloat const* pointZ = points._z.data ();
+
+    size_t const count = out._x.size ();
+    size_t const vectorCount = count - count % BATCH_LANES;
+    size_t i = 0U;
+
+    for ( ; i < vectorCount; i += BATCH_LANES )
+    {
+        float32x4_t const x = vld1q_f32 ( pointX + i );
+        float32x4_t const y = vld1q_f32 ( pointY + i );
+        float32x4_t const z = vld1q_f32 ( pointZ + i );
+
+        vst1q_f32 ( outX + i, PointComponent ( x, y, z, columns[ 0U ] ) );
+        vst1q_f32 ( outY + i, PointComponent ( x, y, z, columns[ 1U ] ) );
+        vst1q_f32 ( outZ + i, PointComponent ( x, y, z, columns[ 2U ] ) );
+    }
+
+    for ( ; i < count; ++i )
+    {
+        GXVec3 result {};
+        transform.MultiplyAsPoint ( result, GXVec3 ( pointX[ i ], pointY[ i ], pointZ[ i ] ) );
+
+        outX[ i ] = result._data[ 0U ];
+        outY[ i ] = result._data[ 1U ];
+        outZ[ i ] = result._data[ 2U ];
+    }
+}
+
+[[maybe_unused]] GXVoid GXCALL GXTransformAABBBatch ( GXAABBSoA<GXFloat> const &out,
+    GXAABBSoA<GXFloat const> const &bounds,
+    std::span<GXMat4 const> transforms
+) noexcept
+{
+    GXFloat* const outMin[] = { out._min._x.data (), out._min._y.data (), out._min._z.data () };
+    GXFloat* const outMax[] = { out._max._x.data (), out._max._y.data (), out._max._z.data () };
+    GXFloat const* inMin[] = { bounds._min._x.data (), bounds._min._y.data (), bounds._min._z.data () };
+    GXFloat const* inMax[] = { bounds._max._x.data (), bounds._max._y.data (), bounds._max._z.data () };
+
+    size_t const count = out._min._x.size ();
+    size_t const vectorCount = count - count % BATCH_LANES;
+    size_t i = 0U;
+
+    for ( ; i < vectorCount; i += BATCH_LANES )
+    {
+        float32x4_t const boundsMin[] =
+        {
+            vld1q_f32 ( inMin[ 0U ] + i ),
+            vld1q_f32 ( inMin[ 1U ] + i ),
+            vld1q_f32 ( inMin[ 2U ] + i )
+        };
+
+        float32x4_t const boundsMax[] =
+        {
+            vld1q_f32 ( inMax[ 0U ] + i ),
+            vld1q_f32 ( inMax[ 1U ] + i ),
+            vld1q_f32 ( inMax[ 2U ] + i )
+        };
+
+        // Row "r" of the four matrices becomes column elements "m[ r ][ c ]" of the four lanes after transposition.
+        GXMat4 const* matrices = transforms.data () + i;
+        float32x4_t columns[ 4U ][ 4U ];
+
+        for ( size_t r = 0U; r < 4U; ++r )
+        {
+            float32x4_t m0 = vld1q_f32 ( matrices[ 0U ]._data[ r ] );
+            float32x4_t m1 = vld1q_f32 ( matrices[ 1U ]._data[ r ] );
+            float32x4_t m2 = vld1q_f32 ( matrices[ 2U ]._data[ r ] );
+            float32x4_t m3 = vld1q_f32 ( matrices[ 3U ]._data[ r ] );
+            Transpose ( m0, m1, m2, m3 );
+
+            columns[ 0U ][ r ] = m0;
+            columns[ 1U ][ r ] = m1;
+            columns[ 2U ][ r ] = m2;
+        }
+
+        for ( size_t c = 0U; c < 3U; ++c )
+        {
+            float32x4_t low;
+            float32x4_t high;
+            BoundsComponent ( low, high, boundsMin, boundsMax, columns[ c ] );
+
+            vst1q_f32 ( outMin[ c ] + i, low );
+            vst1q_f32 ( outMax[ c ] + i, high );
+        }
+    }
+
+    for ( ; i < count; ++i )
+    {
+        GXFloat const low[] = { inMin[ 0U ][ i ], inMin[ 1U ][ i ], inMin[ 2U ][ i ] };
+        GXFloat const high[] = { inMax[ 0U ][ i ], inMax[ 1U ][ i ], inMax[ 2U ][ i ] };
+        auto const &m = transforms[ i ]._data;
+
+        for ( size_t c = 0U; c < 3U; ++c )
+        {
+            GXFloat const x0 = low[ 0U ] * m[ 0U ][ c ];
+            GXFloat const x1 = high[ 0U ] * m[ 0U ][ c ];
+            GXFloat const y0 = low[ 1U ] * m[ 1U ][ c ];
+            GXFloat const y1 = high[ 1U ] * m[ 1U ][ c ];
+            GXFloat const z0 = low[ 2U ] * m[ 2U ][ c ];
+            GXFloat const z1 = high[ 2U ] * m[ 2U ][ c ];
+
+            outMin[ c ][ i ] = std::min ( x0, x1 ) + std::min ( y0, y1 ) + std::min ( z0, z1 ) + m[ 3U ][ c ];
+            outMax[ c ][ i ] = std::max ( x0, x1 ) + std::max ( y0, y1 ) + std::max ( z0, z1 ) + m[ 3U ][ c ];
+        }
+    }
+}
+
+[[maybe_unused]] GXVoid GXCALL GXMultiplyMat4Batch ( std::span<GXMat4> out,
+    std::span<GXMat4 const> a,
+    std::span<GXMat4 const> b
+) noexcept
+{
+    size_t const count = out.size ();
+
+    for ( size_t i = 0U; i < count; ++i )
+        out[ i ].Multiply ( a[ i ], b[ i ] );
+}
+
+[[maybe_unused]] GXVoid GXCALL GXSphericalLinearInterpolationBatch ( GXQuatSoA<GXFloat> const &out,
+    GXQuatSoA<GXFloat const> const &start,
+    GXQuatSoA<GXFloat const> const &finish,
+    GXFloat interpolationFactor
+) noexcept
+{
+    GXFloat* const outData[] = { out._r.data (), out._a.data (), out._b.data (), out._c.data () };
+    GXFloat const* startData[] = { start._r.data (), start._a.data (), start._b.data (), start._c.data () };
+    GXFloat const* finishData[] = { finish._r.data (), finish._a.data (), finish._b.data (), finish._c.data () };
+
+    size_t const count = out._r.size ();
+    size_t const vectorCount = count - count % BATCH_LANES;
+    size_t i = 0U;
+
+    for ( ; i < vectorCount; i += BATCH_LANES )
+    {
+        float32x4_t s[ 4U ];
+        float32x4_t f[ 4U ];
+
+        for ( size_t j = 0U; j < 4U; ++j )
+        {
+            s[ j ] = vld1q_f32 ( startData[ j ] + i );
+            f[ j ] = vld1q_f32 ( finishData[ j ] + i );
+        }
+
+        float32x4_t const rr = vmulq_f32 ( s[ 0U ], f[ 0U ] );
+        float32x4_t const ra = vaddq_f32 ( rr, vmulq_f32 ( s[ 1U ], f[ 1U ] ) );
+        float32x4_t const rab = vaddq_f32 ( ra, vmulq_f32 ( s[ 2U ], f[ 2U ] ) );
+        float32x4_t const cosom = vaddq_f32 ( rab, vmulq_f32 ( s[ 3U ], f[ 3U ] ) );
+
+        // The shortest arc. The finish quaternion is negated in the lanes with negative cosine.
+        uint32x4_t const isNegative = vcltzq_f32 ( cosom );
+
+        float32_t cosoms[ BATCH_LANES ];
+        vst1q_f32 ( cosoms, vbslq_f32 ( isNegative, vnegq_f32 ( cosom ), cosom ) );
+
+        float32_t scales0[ BATCH_LANES ];
+        float32_t scales1[ BATCH_LANES ];
+
+        for ( size_t lane = 0U; lane < BATCH_LANES; ++lane )
+            SlerpScales ( scales0[ lane ], scales1[ lane ], cosoms[ lane ], interpolationFactor );
+
+        float32x4_t const scale0 = vld1q_f32 ( scales0 );
+        float32x4_t const scale1 = vld1q_f32 ( scales1 );
+
+        for ( size_t j = 0U; j < 4U; ++j )
+        {
+            float32x4_t const temp = vbslq_f32 ( isNegative, vnegq_f32 ( f[ j ] ), f[ j ] );
+            vst1q_f32 ( outData[ j ] + i, vaddq_f32 ( vmulq_f32 ( s[ j ], scale0 ), vmulq_f32 ( temp, scale1 ) ) );
+        }
+    }
+
+    for ( ; i < count; ++i )
+    {
+        GXQuat result {};
+
+        result.SphericalLinearInterpolation (
+            GXQuat ( startData[ 0U ][ i ], startData[ 1U ][ i ], startData[ 2U ][ i ], startData[ 3U ][ i ] ),
+            GXQuat ( finishData[ 0U ][ i ], finishData[ 1U ][ i ], finishData[ 2U ][ i ], finishData[ 3U ][ i ] ),
+            interpolationFactor
+        );
+
+        for ( size_t j = 0U; j < 4U; ++j )
+            outData[ j ][ i ] = result._data[ j ];
+    }
+}
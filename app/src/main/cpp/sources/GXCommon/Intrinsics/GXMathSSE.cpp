@@ -0,0 +1,1123 @@
+// version 1.2
+
+#include <precompiled_headers.hpp>
+#include <GXCommon/GXMath.hpp>
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <immintrin.h>
+
+GX_RESTORE_WARNING_STATE
+
+
+// SSE 4.1 backend. The sums go in the same order as in GXMathCPU.cpp. So the results are bit exact with the scalar
+// backend except GXQuat::TransformFast, GXMat4::Inverse and NormalizeFast methods. GXMat4::Multiply processes two
+// rows at once if the translation unit is compiled with AVX support. The batch functions process four elements
+// per iteration. The rest is processed one element at a time. The batch visibility test processes eight boxes with
+// AVX support.
+
+namespace {
+
+constexpr size_t BATCH_LANES = 4U;
+
+// Bits per element of the visibility mask. See GXProjectionClipPlanes::IsVisible.
+constexpr size_t WORD_BITS = 32U;
+
+#ifdef __AVX__
+
+constexpr size_t WIDE_LANES = 8U;
+
+#endif // __AVX__
+
+
+template<int lane>
+[[nodiscard]] __m128 Broadcast ( __m128 v ) noexcept
+{
+    return _mm_shuffle_ps ( v, v, _MM_SHUFFLE ( lane, lane, lane, lane ) );
+}
+
+// Full width load would read beyond the end of the GXVec3. The fourth component is zero.
+[[nodiscard]] __m128 LoadVec3 ( float const* v ) noexcept
+{
+    return _mm_setr_ps ( v[ 0U ], v[ 1U ], v[ 2U ], 0.0F );
+}
+
+void StoreVec3 ( float* out, __m128 v ) noexcept
+{
+    _mm_store_sd ( reinterpret_cast<double*> ( out ), _mm_castps_pd ( v ) );
+    _mm_store_ss ( out + 2U, _mm_movehl_ps ( v, v ) );
+}
+
+// The components are added from left to right like in the scalar backend.
+[[nodiscard]] float SequentialSum ( __m128 v ) noexcept
+{
+    __m128 const s01 = _mm_add_ss ( v, Broadcast<1> ( v ) );
+    __m128 const s012 = _mm_add_ss ( s01, _mm_movehl_ps ( v, v ) );
+    return _mm_cvtss_f32 ( _mm_add_ss ( s012, Broadcast<3> ( v ) ) );
+}
+
+// The estimate has 12 bits. One Newton-Raphson step makes the relative error less than 5.0e-7F.
+[[nodiscard]] float ReciprocalSquareRoot ( float value ) noexcept
+{
+    __m128 const x = _mm_set_ss ( value );
+    __m128 const y = _mm_rsqrt_ss ( x );
+    __m128 const halfXYY = _mm_mul_ss ( _mm_mul_ss ( _mm_mul_ss ( _mm_set_ss ( 0.5F ), x ), y ), y );
+    return _mm_cvtss_f32 ( _mm_mul_ss ( y, _mm_sub_ss ( _mm_set_ss ( 1.5F ), halfXYY ) ) );
+}
+
+// The row vector "r" multiplied by the matrix with rows "m0", "m1", "m2" and "m3".
+[[nodiscard]] __m128 MultiplyRow ( __m128 r, __m128 m0, __m128 m1, __m128 m2, __m128 m3 ) noexcept
+{
+    __m128 const a = _mm_add_ps ( _mm_mul_ps ( Broadcast<0> ( r ), m0 ), _mm_mul_ps ( Broadcast<1> ( r ), m1 ) );
+    __m128 const b = _mm_add_ps ( a, _mm_mul_ps ( Broadcast<2> ( r ), m2 ) );
+    return _mm_add_ps ( b, _mm_mul_ps ( Broadcast<3> ( r ), m3 ) );
+}
+
+// 2x2 row major matrices for GXMat4::Inverse. "A#" is the adjugate matrix of "A".
+// A * B
+[[nodiscard]] __m128 Mat2Multiply ( __m128 a, __m128 b ) noexcept
+{
+    __m128 const alpha = _mm_mul_ps ( a, _mm_shuffle_ps ( b, b, _MM_SHUFFLE ( 3, 0, 3, 0 ) ) );
+    __m128 const beta = _mm_shuffle_ps ( a, a, _MM_SHUFFLE ( 2, 3, 0, 1 ) );
+    return _mm_add_ps ( alpha, _mm_mul_ps ( beta, _mm_shuffle_ps ( b, b, _MM_SHUFFLE ( 1, 2, 1, 2 ) ) ) );
+}
+
+// A# * B
+[[nodiscard]] __m128 Mat2AdjugateMultiply ( __m128 a, __m128 b ) noexcept
+{
+    __m128 const alpha = _mm_mul_ps ( _mm_shuffle_ps ( a, a, _MM_SHUFFLE ( 0, 0, 3, 3 ) ), b );
+    __m128 const beta = _mm_shuffle_ps ( a, a, _MM_SHUFFLE ( 2, 2, 1, 1 ) );
+    return _mm_sub_ps ( alpha, _mm_mul_ps ( beta, _mm_shuffle_ps ( b, b, _MM_SHUFFLE ( 1, 0, 3, 2 ) ) ) );
+}
+
+// A * B#
+[[nodiscard]] __m128 Mat2MultiplyAdjugate ( __m128 a, __m128 b ) noexcept
+{
+    __m128 const alpha = _mm_mul_ps ( a, _mm_shuffle_ps ( b, b, _MM_SHUFFLE ( 0, 3, 0, 3 ) ) );
+    __m128 const beta = _mm_shuffle_ps ( a, a, _MM_SHUFFLE ( 2, 3, 0, 1 ) );
+    return _mm_sub_ps ( alpha, _mm_mul_ps ( beta, _mm_shuffle_ps ( b, b, _MM_SHUFFLE ( 1, 2, 1, 2 ) ) ) );
+}
+
+[[nodiscard]] GXBool AABBIsOverlapped ( __m128 minA, __m128 maxA, __m128 minB, __m128 maxB ) noexcept
+{
+    // The fourth components are zeros. So they always pass the test.
+    __m128 const cmp = _mm_and_ps ( _mm_cmple_ps ( minA, maxB ), _mm_cmple_ps ( minB, maxA ) );
+    return _mm_movemask_ps ( cmp ) == 0b1111;
+}
+
+// One component of the points transformed by GXMat4::MultiplyAsPoint. "column" contains the broadcast elements
+// of the matrix column.
+[[nodiscard]] __m128 PointComponent ( __m128 x, __m128 y, __m128 z, __m128 const* column ) noexcept
+{
+    __m128 const a = _mm_add_ps ( _mm_mul_ps ( x, column[ 0U ] ), _mm_mul_ps ( y, column[ 1U ] ) );
+    return _mm_add_ps ( _mm_add_ps ( a, _mm_mul_ps ( z, column[ 2U ] ) ), column[ 3U ] );
+}
+
+// One component of the transformed bounds. "column" contains the elements of the matrix column for every lane.
+// See GXTransformAABBBatch in GXMathCPU.cpp.
+void BoundsComponent ( __m128 &low,
+    __m128 &high,
+    __m128 const* boundsMin,
+    __m128 const* boundsMax,
+    __m128 const* column
+) noexcept
+{
+    __m128 const x0 = _mm_mul_ps ( boundsMin[ 0U ], column[ 0U ] );
+    __m128 const x1 = _mm_mul_ps ( boundsMax[ 0U ], column[ 0U ] );
+    __m128 const y0 = _mm_mul_ps ( boundsMin[ 1U ], column[ 1U ] );
+    __m128 const y1 = _mm_mul_ps ( boundsMax[ 1U ], column[ 1U ] );
+    __m128 const z0 = _mm_mul_ps ( boundsMin[ 2U ], column[ 2U ] );
+    __m128 const z1 = _mm_mul_ps ( boundsMax[ 2U ], column[ 2U ] );
+
+    __m128 const lowXY = _mm_add_ps ( _mm_min_ps ( x0, x1 ), _mm_min_ps ( y0, y1 ) );
+    low = _mm_add_ps ( _mm_add_ps ( lowXY, _mm_min_ps ( z0, z1 ) ), column[ 3U ] );
+
+    __m128 const highXY = _mm_add_ps ( _mm_max_ps ( x0, x1 ), _mm_max_ps ( y0, y1 ) );
+    high = _mm_add_ps ( _mm_add_ps ( highXY, _mm_max_ps ( z0, z1 ) ), column[ 3U ] );
+}
+
+// The lanes where the corner farthest along the plane normal is behind the plane. Rounding of the sum is monotonic.
+// So the result is the same as the test of all eight corners.
+[[nodiscard]] __m128 PlaneBehind ( __m128 const* low, __m128 const* high, __m128 const* plane ) noexcept
+{
+    auto const term = [ & ] ( size_t axis ) noexcept -> __m128 {
+        __m128 const a = _mm_mul_ps ( plane[ axis ], low[ axis ] );
+        return _mm_max_ps ( a, _mm_mul_ps ( plane[ axis ], high[ axis ] ) );
+    };
+
+    __m128 const xy = _mm_add_ps ( term ( 0U ), term ( 1U ) );
+    __m128 const test = _mm_add_ps ( _mm_add_ps ( xy, term ( 2U ) ), plane[ 3U ] );
+    return _mm_cmplt_ps ( test, _mm_setzero_ps () );
+}
+
+#ifdef __AVX__
+
+[[nodiscard]] __m256 PlaneBehind ( __m256 const* low, __m256 const* high, __m256 const* plane ) noexcept
+{
+    auto const term = [ & ] ( size_t axis ) noexcept -> __m256 {
+        __m256 const a = _mm256_mul_ps ( plane[ axis ], low[ axis ] );
+        return _mm256_max_ps ( a, _mm256_mul_ps ( plane[ axis ], high[ axis ] ) );
+    };
+
+    __m256 const xy = _mm256_add_ps ( term ( 0U ), term ( 1U ) );
+    __m256 const test = _mm256_add_ps ( _mm256_add_ps ( xy, term ( 2U ) ), plane[ 3U ] );
+    return _mm256_cmp_ps ( test, _mm256_setzero_ps (), _CMP_LT_OQ );
+}
+
+#endif // __AVX__
+
+// The interpolation weights of GXQuat::SphericalLinearInterpolation. "cosom" is not negative.
+void SlerpScales ( GXFloat &scale0, GXFloat &scale1, GXFloat cosom, GXFloat interpolationFactor ) noexcept
+{
+    scale0 = 1.0F - interpolationFactor;
+    scale1 = interpolationFactor;
+
+    if ( 1.0F - cosom <= GX_MATH_FLOAT_EPSILON ) [[unlikely]]
+        return;
+
+    GXFloat const omega = std::acos ( cosom );
+    GXFloat const sinom = 1.0F / std::sin ( omega );
+    scale0 = sinom * std::sin ( omega * scale0 );
+    scale1 = sinom * std::sin ( omega * interpolationFactor );
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXVec2::Reverse () noexcept
+{
+    _data[ 0U ] = -_data[ 0U ];
+    _data[ 1U ] = -_data[ 1U ];
+}
+
+[[maybe_unused]] GXVoid GXVec2::CalculateNormalFast ( GXVec2 const &a, GXVec2 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 1U ] - b._data[ 1U ];
+    _data[ 1U ] = b._data[ 0U ] - a._data[ 0U ];
+}
+
+[[maybe_unused]] GXFloat GXVec2::DotProduct ( GXVec2 const &other ) const noexcept
+{
+    return _data[ 0U ] * other._data[ 0U ] + _data[ 1U ] * other._data[ 1U ];
+}
+
+[[maybe_unused]] GXVoid GXVec2::Sum ( GXVec2 const &a, GXVec2 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] + b._data[ 0U ];
+    _data[ 1U ] = a._data[ 1U ] + b._data[ 1U ];
+}
+
+[[maybe_unused]] GXVoid GXVec2::Sum ( GXVec2 const &a, GXFloat bScale, GXVec2 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] + bScale * b._data[ 0U ];
+    _data[ 1U ] = a._data[ 1U ] + bScale * b._data[ 1U ];
+}
+
+[[maybe_unused]] GXVoid GXVec2::Subtract ( GXVec2 const &a, GXVec2 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] - b._data[ 0U ];
+    _data[ 1U ] = a._data[ 1U ] - b._data[ 1U ];
+}
+
+[[maybe_unused]] GXVoid GXVec2::Multiply ( GXVec2 const &a, GXVec2 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] * b._data[ 0U ];
+    _data[ 1U ] = a._data[ 1U ] * b._data[ 1U ];
+}
+
+[[maybe_unused]] GXVoid GXVec2::Multiply ( GXVec2 const &v, GXFloat scale ) noexcept
+{
+    _data[ 0U ] = v._data[ 0U ] * scale;
+    _data[ 1U ] = v._data[ 1U ] * scale;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXVec3::NormalizeFast () noexcept
+{
+    Multiply ( *this, ReciprocalSquareRoot ( DotProduct ( *this ) ) );
+}
+
+[[maybe_unused]] GXVoid GXVec3::Reverse () noexcept
+{
+    _data[ 0U ] = -_data[ 0U ];
+    _data[ 1U ] = -_data[ 1U ];
+    _data[ 2U ] = -_data[ 2U ];
+}
+
+[[maybe_unused]] GXVoid GXVec3::Sum ( GXVec3 const &a, GXVec3 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] + b._data[ 0U ];
+    _data[ 1U ] = a._data[ 1U ] + b._data[ 1U ];
+    _data[ 2U ] = a._data[ 2U ] + b._data[ 2U ];
+}
+
+[[maybe_unused]] GXVoid GXVec3::Sum ( GXVec3 const &a, GXFloat bScale, GXVec3 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] + bScale * b._data[ 0U ];
+    _data[ 1U ] = a._data[ 1U ] + bScale * b._data[ 1U ];
+    _data[ 2U ] = a._data[ 2U ] + bScale * b._data[ 2U ];
+}
+
+[[maybe_unused]] GXVoid GXVec3::Subtract ( GXVec3 const &a, GXVec3 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] - b._data[ 0U ];
+    _data[ 1U ] = a._data[ 1U ] - b._data[ 1U ];
+    _data[ 2U ] = a._data[ 2U ] - b._data[ 2U ];
+}
+
+[[maybe_unused]] GXVoid GXVec3::Multiply ( GXVec3 const &a, GXFloat scale ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] * scale;
+    _data[ 1U ] = a._data[ 1U ] * scale;
+    _data[ 2U ] = a._data[ 2U ] * scale;
+}
+
+[[maybe_unused]] GXVoid GXVec3::Multiply ( GXVec3 const &a, GXVec3 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] * b._data[ 0U ];
+    _data[ 1U ] = a._data[ 1U ] * b._data[ 1U ];
+    _data[ 2U ] = a._data[ 2U ] * b._data[ 2U ];
+}
+
+[[maybe_unused]] GXFloat GXVec3::DotProduct ( GXVec3 const &other ) const noexcept
+{
+    return _data[ 0U ] * other._data[ 0U ] + _data[ 1U ] * other._data[ 1U ] + _data[ 2U ] * other._data[ 2U ];
+}
+
+[[maybe_unused]] GXVoid GXVec3::CrossProduct ( GXVec3 const &a, GXVec3 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 1U ] * b._data[ 2U ] - a._data[ 2U ] * b._data[ 1U ];
+    _data[ 1U ] = a._data[ 2U ] * b._data[ 0U ] - a._data[ 0U ] * b._data[ 2U ];
+    _data[ 2U ] = a._data[ 0U ] * b._data[ 1U ] - a._data[ 1U ] * b._data[ 0U ];
+}
+
+[[maybe_unused]] GXVoid GXVec3::LinearInterpolation ( GXVec3 const &start,
+    GXVec3 const &finish,
+    GXFloat interpolationFactor
+) noexcept
+{
+    GXVec3 difference {};
+    difference.Subtract ( finish, start );
+    Sum ( start, interpolationFactor, difference );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXVec4::Sum ( GXVec4 const &a, GXVec4 const &b ) noexcept
+{
+    _mm_storeu_ps ( _data, _mm_add_ps ( _mm_loadu_ps ( a._data ), _mm_loadu_ps ( b._data ) ) );
+}
+
+[[maybe_unused]] GXVoid GXVec4::Sum ( GXVec4 const &a, GXFloat bScale, GXVec4 const &b ) noexcept
+{
+    __m128 const scaled = _mm_mul_ps ( _mm_set1_ps ( bScale ), _mm_loadu_ps ( b._data ) );
+    _mm_storeu_ps ( _data, _mm_add_ps ( _mm_loadu_ps ( a._data ), scaled ) );
+}
+
+[[maybe_unused]] GXVoid GXVec4::Subtract ( GXVec4 const &a, GXVec4 const &b ) noexcept
+{
+    _mm_storeu_ps ( _data, _mm_sub_ps ( _mm_loadu_ps ( a._data ), _mm_loadu_ps ( b._data ) ) );
+}
+
+[[maybe_unused]] GXFloat GXVec4::DotProduct ( GXVec4 const &other ) const noexcept
+{
+    return SequentialSum ( _mm_mul_ps ( _mm_loadu_ps ( _data ), _mm_loadu_ps ( other._data ) ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXFloat GXVec6::DotProduct ( GXVec6 const &other ) const noexcept
+{
+    return _data[ 0U ] * other._data[ 0U ] +
+        _data[ 1U ] * other._data[ 1U ] +
+        _data[ 2U ] * other._data[ 2U ] +
+        _data[ 3U ] * other._data[ 3U ] +
+        _data[ 4U ] * other._data[ 4U ] +
+        _data[ 5U ] * other._data[ 5U ];
+}
+
+[[maybe_unused]] GXVoid GXVec6::Sum ( GXVec6 const &a, GXVec6 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] + b._data[ 0U ];
+    _data[ 1U ] = a._data[ 1U ] + b._data[ 1U ];
+    _data[ 2U ] = a._data[ 2U ] + b._data[ 2U ];
+    _data[ 3U ] = a._data[ 3U ] + b._data[ 3U ];
+    _data[ 4U ] = a._data[ 4U ] + b._data[ 4U ];
+    _data[ 5U ] = a._data[ 5U ] + b._data[ 5U ];
+}
+
+[[maybe_unused]] GXVoid GXVec6::Sum ( GXVec6 const &a, GXFloat bScale, GXVec6 const &b ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] + bScale * b._data[ 0U ];
+    _data[ 1U ] = a._data[ 1U ] + bScale * b._data[ 1U ];
+    _data[ 2U ] = a._data[ 2U ] + bScale * b._data[ 2U ];
+    _data[ 3U ] = a._data[ 3U ] + bScale * b._data[ 3U ];
+    _data[ 4U ] = a._data[ 4U ] + bScale * b._data[ 4U ];
+    _data[ 5U ] = a._data[ 5U ] + bScale * b._data[ 5U ];
+}
+
+[[maybe_unused]] GXVoid GXVec6::Multiply ( GXVec6 const &a, GXFloat factor ) noexcept
+{
+    _data[ 0U ] = a._data[ 0U ] * factor;
+    _data[ 1U ] = a._data[ 1U ] * factor;
+    _data[ 2U ] = a._data[ 2U ] * factor;
+    _data[ 3U ] = a._data[ 3U ] * factor;
+    _data[ 4U ] = a._data[ 4U ] * factor;
+    _data[ 5U ] = a._data[ 5U ] * factor;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXColorRGB::GXColorRGB ( GXColorUNORM color ) noexcept:
+    _data
+    {
+        static_cast<GXFloat> ( color._data[ 0U ] ) * GX_MATH_UNORM_FACTOR,
+        static_cast<GXFloat> ( color._data[ 1U ] ) * GX_MATH_UNORM_FACTOR,
+        static_cast<GXFloat> ( color._data[ 2U ] ) * GX_MATH_UNORM_FACTOR,
+        static_cast<GXFloat> ( color._data[ 3U ] ) * GX_MATH_UNORM_FACTOR
+    }
+{
+    // NOTHING
+}
+
+[[maybe_unused]] GXVoid GXColorRGB::From ( GXUByte red, GXUByte green, GXUByte blue, GXFloat alpha ) noexcept
+{
+    _data[ 0U ] = static_cast<GXFloat> ( red ) * GX_MATH_UNORM_FACTOR;
+    _data[ 1U ] = static_cast<GXFloat> ( green ) * GX_MATH_UNORM_FACTOR;
+    _data[ 2U ] = static_cast<GXFloat> ( blue ) * GX_MATH_UNORM_FACTOR;
+    _data[ 3U ] = alpha;
+}
+
+[[maybe_unused]] GXVoid GXColorRGB::From ( GXUInt red, GXUInt green, GXUInt blue, GXFloat alpha ) noexcept
+{
+    _data[ 0U ] = static_cast<GXFloat> ( red ) * GX_MATH_UNORM_FACTOR;
+    _data[ 1U ] = static_cast<GXFloat> ( green ) * GX_MATH_UNORM_FACTOR;
+    _data[ 2U ] = static_cast<GXFloat> ( blue ) * GX_MATH_UNORM_FACTOR;
+    _data[ 3U ] = alpha;
+}
+
+[[maybe_unused]] GXColorUNORM GXColorRGB::ToColorUNORM () const noexcept
+{
+    constexpr auto convertFactor = static_cast<float> ( std::numeric_limits<uint8_t>::max () );
+
+    return
+    {
+        static_cast<GXUByte> ( _data[ 0U ] * convertFactor ),
+        static_cast<GXUByte> ( _data[ 1U ] * convertFactor ),
+        static_cast<GXUByte> ( _data[ 2U ] * convertFactor ),
+        static_cast<GXUByte> ( _data[ 3U ] * convertFactor )
+    };
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXQuat::Normalize () noexcept
+{
+    __m128 const q = _mm_loadu_ps ( _data );
+    GXFloat const squaredLength = SequentialSum ( _mm_mul_ps ( q, q ) );
+
+    assert ( squaredLength > GX_MATH_FLOAT_EPSILON );
+
+    _mm_storeu_ps ( _data, _mm_mul_ps ( q, _mm_set1_ps ( 1.0F / std::sqrt ( squaredLength ) ) ) );
+}
+
+[[maybe_unused]] GXVoid GXQuat::NormalizeFast () noexcept
+{
+    __m128 const q = _mm_loadu_ps ( _data );
+    GXFloat const squaredLength = SequentialSum ( _mm_mul_ps ( q, q ) );
+
+    assert ( squaredLength > GX_MATH_FLOAT_EPSILON );
+
+    _mm_storeu_ps ( _data, _mm_mul_ps ( q, _mm_set1_ps ( ReciprocalSquareRoot ( squaredLength ) ) ) );
+}
+
+[[maybe_unused]] GXVoid GXQuat::Inverse ( GXQuat const &q ) noexcept
+{
+    __m128 const v = _mm_loadu_ps ( q._data );
+    GXFloat const squaredLength = SequentialSum ( _mm_mul_ps ( v, v ) );
+
+    assert ( squaredLength > GX_MATH_FLOAT_EPSILON );
+
+    __m128 const conjugate = _mm_xor_ps ( v, _mm_setr_ps ( 0.0F, -0.0F, -0.0F, -0.0F ) );
+    _mm_storeu_ps ( _data, _mm_mul_ps ( conjugate, _mm_set1_ps ( 1.0F / squaredLength ) ) );
+}
+
+[[maybe_unused]] GXVoid GXQuat::FromAxisAngle ( GXFloat x, GXFloat y, GXFloat z, GXFloat angle ) noexcept
+{
+    GXFloat const halfAngle = 0.5F * angle;
+    GXFloat const sinom = std::sin ( halfAngle );
+
+    _data[ 0U ] = std::cos ( halfAngle );
+    _data[ 1U ] = x * sinom;
+    _data[ 2U ] = y * sinom;
+    _data[ 3U ] = z * sinom;
+}
+
+[[maybe_unused]] GXVoid GXQuat::Multiply ( GXQuat const &a, GXQuat const &b ) noexcept
+{
+    // The product is sum of the "b" permutations scaled by the "a" components. The signs are moved to the "a"
+    // components. Negation is exact. So the result matches the scalar backend.
+    __m128 const vA = _mm_loadu_ps ( a._data );
+    __m128 const vB = _mm_loadu_ps ( b._data );
+
+    __m128 const a1 = _mm_xor_ps ( Broadcast<1> ( vA ), _mm_setr_ps ( -0.0F, 0.0F, -0.0F, 0.0F ) );
+    __m128 const a2 = _mm_xor_ps ( Broadcast<2> ( vA ), _mm_setr_ps ( -0.0F, 0.0F, 0.0F, -0.0F ) );
+    __m128 const a3 = _mm_xor_ps ( Broadcast<3> ( vA ), _mm_setr_ps ( -0.0F, -0.0F, 0.0F, 0.0F ) );
+
+    __m128 const t0 = _mm_mul_ps ( Broadcast<0> ( vA ), vB );
+    __m128 const t1 = _mm_mul_ps ( a1, _mm_shuffle_ps ( vB, vB, _MM_SHUFFLE ( 2, 3, 0, 1 ) ) );
+    __m128 const t2 = _mm_mul_ps ( a2, _mm_shuffle_ps ( vB, vB, _MM_SHUFFLE ( 1, 0, 3, 2 ) ) );
+    __m128 const t3 = _mm_mul_ps ( a3, _mm_shuffle_ps ( vB, vB, _MM_SHUFFLE ( 0, 1, 2, 3 ) ) );
+
+    _mm_storeu_ps ( _data, _mm_add_ps ( _mm_add_ps ( _mm_add_ps ( t0, t1 ), t2 ), t3 ) );
+}
+
+[[maybe_unused]] GXVoid GXQuat::Multiply ( GXQuat const &q, GXFloat scale ) noexcept
+{
+    _mm_storeu_ps ( _data, _mm_mul_ps ( _mm_loadu_ps ( q._data ), _mm_set1_ps ( scale ) ) );
+}
+
+[[maybe_unused]] GXVoid GXQuat::Sum ( GXQuat const &a, GXQuat const &b ) noexcept
+{
+    _mm_storeu_ps ( _data, _mm_add_ps ( _mm_loadu_ps ( a._data ), _mm_loadu_ps ( b._data ) ) );
+}
+
+[[maybe_unused]] GXVoid GXQuat::Subtract ( GXQuat const &a, GXQuat const &b ) noexcept
+{
+    _mm_storeu_ps ( _data, _mm_sub_ps ( _mm_loadu_ps ( a._data ), _mm_loadu_ps ( b._data ) ) );
+}
+
+[[maybe_unused]] GXVoid GXQuat::SphericalLinearInterpolation ( GXQuat const &start,
+    GXQuat const &finish,
+    GXFloat interpolationFactor
+) noexcept
+{
+    __m128 const s = _mm_loadu_ps ( start._data );
+    __m128 const f = _mm_loadu_ps ( finish._data );
+    GXFloat cosom = SequentialSum ( _mm_mul_ps ( s, f ) );
+
+    __m128 const casesQuat[] = { f, _mm_xor_ps ( f, _mm_set1_ps ( -0.0F ) ) };
+    float const casesCosom[] = { cosom, -cosom };
+
+    auto const idx = static_cast<size_t> ( cosom < 0.0F );
+    __m128 const temp = casesQuat[ idx ];
+    cosom = casesCosom[ idx ];
+
+    GXFloat scale0 = 1.0F - interpolationFactor;
+    GXFloat scale1 = interpolationFactor;
+
+    if ( 1.0F - cosom > GX_MATH_FLOAT_EPSILON ) [[likely]]
+    {
+        GXFloat const omega = std::acos ( cosom );
+        GXFloat const sinom = 1.0F / std::sin ( omega );
+        scale0 = sinom * std::sin ( omega * scale0 );
+        scale1 = sinom * std::sin ( omega * interpolationFactor );
+    }
+
+    __m128 const alpha = _mm_mul_ps ( s, _mm_set1_ps ( scale0 ) );
+    _mm_storeu_ps ( _data, _mm_add_ps ( alpha, _mm_mul_ps ( temp, _mm_set1_ps ( scale1 ) ) ) );
+}
+
+[[maybe_unused]] GXVoid GXQuat::TransformFast ( GXVec3 &out, GXVec3 const &v ) const noexcept
+{
+    // q * v * q' = ( r * r - u * u ) * v + 2 * ( u * v ) * u + 2 * r * ( u x v ), where "u" is the vector part.
+    // The identity holds for not normalized quaternions too. So the result matches the scalar backend up to rounding.
+    __m128 const q = _mm_loadu_ps ( _data );
+    __m128 const u = _mm_blend_ps ( _mm_shuffle_ps ( q, q, _MM_SHUFFLE ( 0, 3, 2, 1 ) ), _mm_setzero_ps (), 0b1000 );
+    __m128 const vec = LoadVec3 ( v._data );
+
+    __m128 const r = Broadcast<0> ( q );
+    __m128 const uu = _mm_dp_ps ( u, u, 0x7F );
+    __m128 const uv = _mm_dp_ps ( u, vec, 0x7F );
+
+    __m128 const uYZX = _mm_shuffle_ps ( u, u, _MM_SHUFFLE ( 3, 0, 2, 1 ) );
+    __m128 const vYZX = _mm_shuffle_ps ( vec, vec, _MM_SHUFFLE ( 3, 0, 2, 1 ) );
+    __m128 const crossZXY = _mm_sub_ps ( _mm_mul_ps ( u, vYZX ), _mm_mul_ps ( uYZX, vec ) );
+    __m128 const cross = _mm_shuffle_ps ( crossZXY, crossZXY, _MM_SHUFFLE ( 3, 0, 2, 1 ) );
+
+    __m128 const two = _mm_set1_ps ( 2.0F );
+    __m128 const alpha = _mm_mul_ps ( _mm_sub_ps ( _mm_mul_ps ( r, r ), uu ), vec );
+    __m128 const beta = _mm_mul_ps ( _mm_mul_ps ( two, uv ), u );
+    __m128 const gamma = _mm_mul_ps ( _mm_mul_ps ( two, r ), cross );
+
+    StoreVec3 ( out._data, _mm_add_ps ( _mm_add_ps ( alpha, beta ), gamma ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXMat3::Multiply ( GXMat3 const &a, GXMat3 const &b ) noexcept
+{
+    auto const &aData = a._data;
+    auto const &bData = b._data;
+    auto &result = _data;
+
+    result[ 0U ][ 0U ] = aData[ 0U ][ 0U ] * bData[ 0U ][ 0U ] +
+        aData[ 0U ][ 1U ] * bData[ 1U ][ 0U ] +
+        aData[ 0U ][ 2U ] * bData[ 2U ][ 0U ];
+
+    result[ 0U ][ 1U ] = aData[ 0U ][ 0U ] * bData[ 0U ][ 1U ] +
+        aData[ 0U ][ 1U ] * bData[ 1U ][ 1U ] +
+        aData[ 0U ][ 2U ] * bData[ 2U ][ 1U ];
+
+    result[ 0U ][ 2U ] = aData[ 0U ][ 0U ] * bData[ 0U ][ 2U ] +
+        aData[ 0U ][ 1U ] * bData[ 1U ][ 2U ] +
+        aData[ 0U ][ 2U ] * bData[ 2U ][ 2U ];
+
+    result[ 1U ][ 0U ] = aData[ 1U ][ 0U ] * bData[ 0U ][ 0U ] +
+        aData[ 1U ][ 1U ] * bData[ 1U ][ 0U ] +
+        aData[ 1U ][ 2U ] * bData[ 2U ][ 0U ];
+
+    result[ 1U ][ 1U ] = aData[ 1U ][ 0U ] * bData[ 0U ][ 1U ] +
+        aData[ 1U ][ 1U ] * bData[ 1U ][ 1U ] +
+        aData[ 1U ][ 2U ] * bData[ 2U ][ 1U ];
+
+    result[ 1U ][ 2U ] = aData[ 1U ][ 0U ] * bData[ 0U ][ 2U ] +
+        aData[ 1U ][ 1U ] * bData[ 1U ][ 2U ] +
+        aData[ 1U ][ 2U ] * bData[ 2U ][ 2U ];
+
+    result[ 2U ][ 0U ] = aData[ 2U ][ 0U ] * bData[ 0U ][ 0U ] +
+        aData[ 2U ][ 1U ] * bData[ 1U ][ 0U ] +
+        aData[ 2U ][ 2U ] * bData[ 2U ][ 0U ];
+
+    result[ 2U ][ 1U ] = aData[ 2U ][ 0U ] * bData[ 0U ][ 1U ] +
+        aData[ 2U ][ 1U ] * bData[ 1U ][ 1U ] +
+        aData[ 2U ][ 2U ] * bData[ 2U ][ 1U ];
+
+    result[ 2U ][ 2U ] = aData[ 2U ][ 0U ] * bData[ 0U ][ 2U ] +
+        aData[ 2U ][ 1U ] * bData[ 1U ][ 2U ] +
+        aData[ 2U ][ 2U ] * bData[ 2U ][ 2U ];
+}
+
+[[maybe_unused]] GXVoid GXMat3::MultiplyVectorMatrix ( GXVec3 &out, GXVec3 const &v ) const noexcept
+{
+    auto const &m = _data;
+    auto const &vData = v._data;
+    out._data[ 0U ] = vData[ 0U ] * m[ 0U ][ 0U ] + vData[ 1U ] * m[ 1U ][ 0U ] + vData[ 2U ] * m[ 2U ][ 0U ];
+    out._data[ 1U ] = vData[ 0U ] * m[ 0U ][ 1U ] + vData[ 1U ] * m[ 1U ][ 1U ] + vData[ 2U ] * m[ 2U ][ 1U ];
+    out._data[ 2U ] = vData[ 0U ] * m[ 0U ][ 2U ] + vData[ 1U ] * m[ 1U ][ 2U ] + vData[ 2U ] * m[ 2U ][ 2U ];
+}
+
+[[maybe_unused]] GXVoid GXMat3::MultiplyMatrixVector ( GXVec3 &out, GXVec3 const &v ) const noexcept
+{
+    auto const &m = _data;
+    auto const &vData = v._data;
+    out._data[ 0U ] = m[ 0U ][ 0U ] * vData[ 0U ] + m[ 0U ][ 1U ] * vData[ 1U ] + m[ 0U ][ 2U ] * vData[ 2U ];
+    out._data[ 1U ] = m[ 1U ][ 0U ] * vData[ 0U ] + m[ 1U ][ 1U ] * vData[ 1U ] + m[ 1U ][ 2U ] * vData[ 2U ];
+    out._data[ 2U ] = m[ 2U ][ 0U ] * vData[ 0U ] + m[ 2U ][ 1U ] * vData[ 1U ] + m[ 2U ][ 2U ] * vData[ 2U ];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXMat4::Inverse ( GXMat4 const &sourceMatrix ) noexcept
+{
+    // The implementation is based on ideas from
+    // https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+
+    __m128 const r0 = _mm_loadu_ps ( sourceMatrix._data[ 0U ] );
+    __m128 const r1 = _mm_loadu_ps ( sourceMatrix._data[ 1U ] );
+    __m128 const r2 = _mm_loadu_ps ( sourceMatrix._data[ 2U ] );
+    __m128 const r3 = _mm_loadu_ps ( sourceMatrix._data[ 3U ] );
+
+    // Sub-matrices.
+    __m128 const a = _mm_movelh_ps ( r0, r1 );
+    __m128 const b = _mm_movehl_ps ( r1, r0 );
+    __m128 const c = _mm_movelh_ps ( r2, r3 );
+    __m128 const d = _mm_movehl_ps ( r3, r2 );
+
+    // Determinants: |A|, |B|, |C| and |D|.
+    __m128 const alpha = _mm_mul_ps ( _mm_shuffle_ps ( r0, r2, _MM_SHUFFLE ( 2, 0, 2, 0 ) ),
+        _mm_shuffle_ps ( r1, r3, _MM_SHUFFLE ( 3, 1, 3, 1 ) )
+    );
+
+    __m128 const beta = _mm_mul_ps ( _mm_shuffle_ps ( r0, r2, _MM_SHUFFLE ( 3, 1, 3, 1 ) ),
+        _mm_shuffle_ps ( r1, r3, _MM_SHUFFLE ( 2, 0, 2, 0 ) )
+    );
+
+    __m128 const determinants = _mm_sub_ps ( alpha, beta );
+    __m128 const detA = Broadcast<0> ( determinants );
+    __m128 const detB = Broadcast<1> ( determinants );
+    __m128 const detC = Broadcast<2> ( determinants );
+    __m128 const detD = Broadcast<3> ( determinants );
+
+    // Inverse matrix is 1 / |M| * | X  Y |
+    //                             | Z  W |
+    __m128 const dc = Mat2AdjugateMultiply ( d, c );
+    __m128 const ab = Mat2AdjugateMultiply ( a, b );
+
+    // X# = |D| * A - B * ( D# * C )
+    __m128 const x = _mm_sub_ps ( _mm_mul_ps ( detD, a ), Mat2Multiply ( b, dc ) );
+
+    // W# = |A| * D - C * ( A# * B )
+    __m128 const w = _mm_sub_ps ( _mm_mul_ps ( detA, d ), Mat2Multiply ( c, ab ) );
+
+    // Y# = |B| * C - D * ( A# * B )#
+    __m128 const y = _mm_sub_ps ( _mm_mul_ps ( detB, c ), Mat2MultiplyAdjugate ( d, ab ) );
+
+    // Z# = |C| * B - A * ( D# * C )#
+    __m128 const z = _mm_sub_ps ( _mm_mul_ps ( detC, b ), Mat2MultiplyAdjugate ( a, dc ) );
+
+    // |M| = |A| * |D| + |B| * |C| - tr ( ( A# * B ) * ( D# * C ) )
+    __m128 trace = _mm_mul_ps ( ab, _mm_shuffle_ps ( dc, dc, _MM_SHUFFLE ( 3, 1, 2, 0 ) ) );
+    trace = _mm_hadd_ps ( trace, trace );
+    trace = _mm_hadd_ps ( trace, trace );
+
+    __m128 const det = _mm_sub_ps ( _mm_add_ps ( _mm_mul_ps ( detA, detD ), _mm_mul_ps ( detB, detC ) ), trace );
+    __m128 const inverseDeterminant = _mm_div_ps ( _mm_setr_ps ( 1.0F, -1.0F, -1.0F, 1.0F ), det );
+
+    __m128 const xs = _mm_mul_ps ( x, inverseDeterminant );
+    __m128 const ys = _mm_mul_ps ( y, inverseDeterminant );
+    __m128 const zs = _mm_mul_ps ( z, inverseDeterminant );
+    __m128 const ws = _mm_mul_ps ( w, inverseDeterminant );
+
+    // The shuffles apply the adjugate and combine the sub-matrices into rows.
+    _mm_storeu_ps ( _data[ 0U ], _mm_shuffle_ps ( xs, ys, _MM_SHUFFLE ( 1, 3, 1, 3 ) ) );
+    _mm_storeu_ps ( _data[ 1U ], _mm_shuffle_ps ( xs, ys, _MM_SHUFFLE ( 0, 2, 0, 2 ) ) );
+    _mm_storeu_ps ( _data[ 2U ], _mm_shuffle_ps ( zs, ws, _MM_SHUFFLE ( 1, 3, 1, 3 ) ) );
+    _mm_storeu_ps ( _data[ 3U ], _mm_shuffle_ps ( zs, ws, _MM_SHUFFLE ( 0, 2, 0, 2 ) ) );
+}
+
+[[maybe_unused]] GXVoid GXMat4::Multiply ( GXMat4 const &a, GXMat4 const &b ) noexcept
+{
+    // All loads go before the stores. So the matrix could be multiplied in place.
+
+#ifdef __AVX__
+
+    __m128 const b0 = _mm_loadu_ps ( b._data[ 0U ] );
+    __m128 const b1 = _mm_loadu_ps ( b._data[ 1U ] );
+    __m128 const b2 = _mm_loadu_ps ( b._data[ 2U ] );
+    __m128 const b3 = _mm_loadu_ps ( b._data[ 3U ] );
+
+    __m256 const bb0 = _mm256_insertf128_ps ( _mm256_castps128_ps256 ( b0 ), b0, 1 );
+    __m256 const bb1 = _mm256_insertf128_ps ( _mm256_castps128_ps256 ( b1 ), b1, 1 );
+    __m256 const bb2 = _mm256_insertf128_ps ( _mm256_castps128_ps256 ( b2 ), b2, 1 );
+    __m256 const bb3 = _mm256_insertf128_ps ( _mm256_castps128_ps256 ( b3 ), b3, 1 );
+
+    // Two rows of "a" per register.
+    __m256 const a01 = _mm256_loadu_ps ( a._data[ 0U ] );
+    __m256 const a23 = _mm256_loadu_ps ( a._data[ 2U ] );
+
+    auto const rows = [ & ] ( __m256 r ) noexcept -> __m256 {
+        __m256 const alpha = _mm256_add_ps ( _mm256_mul_ps ( _mm256_permute_ps ( r, 0b0000'0000 ), bb0 ),
+            _mm256_mul_ps ( _mm256_permute_ps ( r, 0b0101'0101 ), bb1 )
+        );
+
+        __m256 const beta = _mm256_add_ps ( alpha, _mm256_mul_ps ( _mm256_permute_ps ( r, 0b1010'1010 ), bb2 ) );
+        return _mm256_add_ps ( beta, _mm256_mul_ps ( _mm256_permute_ps ( r, 0b1111'1111 ), bb3 ) );
+    };
+
+    __m256 const c01 = rows ( a01 );
+    __m256 const c23 = rows ( a23 );
+
+    _mm256_storeu_ps ( _data[ 0U ], c01 );
+    _mm256_storeu_ps ( _data[ 2U ], c23 );
+
+#else
+
+    __m128 const b0 = _mm_loadu_ps ( b._data[ 0U ] );
+    __m128 const b1 = _mm_loadu_ps ( b._data[ 1U ] );
+    __m128 const b2 = _mm_loadu_ps ( b._data[ 2U ] );
+    __m128 const b3 = _mm_loadu_ps ( b._data[ 3U ] );
+
+    __m128 const c0 = MultiplyRow ( _mm_loadu_ps ( a._data[ 0U ] ), b0, b1, b2, b3 );
+    __m128 const c1 = MultiplyRow ( _mm_loadu_ps ( a._data[ 1U ] ), b0, b1, b2, b3 );
+    __m128 const c2 = MultiplyRow ( _mm_loadu_ps ( a._data[ 2U ] ), b0, b1, b2, b3 );
+    __m128 const c3 = MultiplyRow ( _mm_loadu_ps ( a._data[ 3U ] ), b0, b1, b2, b3 );
+
+    _mm_storeu_ps ( _data[ 0U ], c0 );
+    _mm_storeu_ps ( _data[ 1U ], c1 );
+    _mm_storeu_ps ( _data[ 2U ], c2 );
+    _mm_storeu_ps ( _data[ 3U ], c3 );
+
+#endif // __AVX__
+}
+
+[[maybe_unused]] GXVoid GXMat4::MultiplyVectorMatrix ( GXVec4 &out, GXVec4 const &v ) const noexcept
+{
+    _mm_storeu_ps ( out._data,
+        MultiplyRow ( _mm_loadu_ps ( v._data ),
+            _mm_loadu_ps ( _data[ 0U ] ),
+            _mm_loadu_ps ( _data[ 1U ] ),
+            _mm_loadu_ps ( _data[ 2U ] ),
+            _mm_loadu_ps ( _data[ 3U ] )
+        )
+    );
+}
+
+[[maybe_unused]] GXVoid GXMat4::MultiplyMatrixVector ( GXVec4 &out, GXVec4 const &v ) const noexcept
+{
+    // M * v is v * transposed M.
+    __m128 m0 = _mm_loadu_ps ( _data[ 0U ] );
+    __m128 m1 = _mm_loadu_ps ( _data[ 1U ] );
+    __m128 m2 = _mm_loadu_ps ( _data[ 2U ] );
+    __m128 m3 = _mm_loadu_ps ( _data[ 3U ] );
+    _MM_TRANSPOSE4_PS ( m0, m1, m2, m3 );
+
+    _mm_storeu_ps ( out._data, MultiplyRow ( _mm_loadu_ps ( v._data ), m0, m1, m2, m3 ) );
+}
+
+[[maybe_unused]] GXVoid GXMat4::MultiplyAsNormal ( GXVec3 &out, GXVec3 const &v ) const noexcept
+{
+    __m128 const a0 = _mm_mul_ps ( _mm_set1_ps ( v._data[ 0U ] ), _mm_loadu_ps ( _data[ 0U ] ) );
+    __m128 const a1 = _mm_mul_ps ( _mm_set1_ps ( v._data[ 1U ] ), _mm_loadu_ps ( _data[ 1U ] ) );
+    __m128 const a2 = _mm_mul_ps ( _mm_set1_ps ( v._data[ 2U ] ), _mm_loadu_ps ( _data[ 2U ] ) );
+
+    StoreVec3 ( out._data, _mm_add_ps ( _mm_add_ps ( a0, a1 ), a2 ) );
+}
+
+[[maybe_unused]] GXVoid GXMat4::MultiplyAsPoint ( GXVec3 &out, GXVec3 const &v ) const noexcept
+{
+    __m128 const a0 = _mm_mul_ps ( _mm_set1_ps ( v._data[ 0U ] ), _mm_loadu_ps ( _data[ 0U ] ) );
+    __m128 const a1 = _mm_mul_ps ( _mm_set1_ps ( v._data[ 1U ] ), _mm_loadu_ps ( _data[ 1U ] ) );
+    __m128 const a2 = _mm_mul_ps ( _mm_set1_ps ( v._data[ 2U ] ), _mm_loadu_ps ( _data[ 2U ] ) );
+
+    __m128 const b = _mm_add_ps ( _mm_add_ps ( a0, a1 ), a2 );
+    StoreVec3 ( out._data, _mm_add_ps ( b, _mm_loadu_ps ( _data[ 3U ] ) ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXBool GXAABB::IsOverlapped ( GXAABB const &other ) const noexcept
+{
+    return AABBIsOverlapped ( LoadVec3 ( _min._data ),
+        LoadVec3 ( _max._data ),
+        LoadVec3 ( other._min._data ),
+        LoadVec3 ( other._max._data )
+    );
+}
+
+[[maybe_unused]] GXBool GXAABB::IsOverlapped ( GXVec3 const &point ) const noexcept
+{
+    __m128 const p = LoadVec3 ( point._data );
+    return AABBIsOverlapped ( LoadVec3 ( _min._data ), LoadVec3 ( _max._data ), p, p );
+}
+
+[[maybe_unused]] GXBool GXAABB::IsOverlapped ( GXFloat x, GXFloat y, GXFloat z ) const noexcept
+{
+    __m128 const p = _mm_setr_ps ( x, y, z, 0.0F );
+    return AABBIsOverlapped ( LoadVec3 ( _min._data ), LoadVec3 ( _max._data ), p, p );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXProjectionClipPlanes::IsVisible ( std::span<GXUInt> visibility,
+    GXAABBSoA<GXFloat const> const &bounds
+) const noexcept
+{
+    GXFloat const* inMin[] = { bounds._min._x.data (), bounds._min._y.data (), bounds._min._z.data () };
+    GXFloat const* inMax[] = { bounds._max._x.data (), bounds._max._y.data (), bounds._max._z.data () };
+
+    size_t const count = bounds._min._x.size ();
+    GXUInt* const words = visibility.data ();
+    std::fill_n ( words, ( count + WORD_BITS - 1U ) / WORD_BITS, 0U );
+    size_t i = 0U;
+
+#ifdef __AVX__
+
+    __m256 wide[ 6U ][ 4U ];
+
+    for ( size_t p = 0U; p < 6U; ++p )
+    {
+        GXPlane const &plane = _planes[ p ];
+        wide[ p ][ 0U ] = _mm256_set1_ps ( plane._a );
+        wide[ p ][ 1U ] = _mm256_set1_ps ( plane._b );
+        wide[ p ][ 2U ] = _mm256_set1_ps ( plane._c );
+        wide[ p ][ 3U ] = _mm256_set1_ps ( plane._d );
+    }
+
+    size_t const wideCount = count - count % WIDE_LANES;
+
+    for ( ; i < wideCount; i += WIDE_LANES )
+    {
+        __m256 const low[] =
+        {
+            _mm256_loadu_ps ( inMin[ 0U ] + i ),
+            _mm256_loadu_ps ( inMin[ 1U ] + i ),
+            _mm256_loadu_ps ( inMin[ 2U ] + i )
+        };
+
+        __m256 const high[] =
+        {
+            _mm256_loadu_ps ( inMax[ 0U ] + i ),
+            _mm256_loadu_ps ( inMax[ 1U ] + i ),
+            _mm256_loadu_ps ( inMax[ 2U ] + i )
+        };
+
+        __m256 behind = _mm256_setzero_ps ();
+
+        for ( auto const &plane : wide )
+            behind = _mm256_or_ps ( behind, PlaneBehind ( low, high, plane ) );
+
+        auto const visible = static_cast<GXUInt> ( ~_mm256_movemask_ps ( behind ) & 0xFF );
+        words[ i / WORD_BITS ] |= visible << ( i % WORD_BITS );
+    }
+
+#endif // __AVX__
+
+    __m128 planes[ 6U ][ 4U ];
+
+    for ( size_t p = 0U; p < 6U; ++p )
+    {
+        GXPlane const &plane = _planes[ p ];
+        planes[ p ][ 0U ] = _mm_set1_ps ( plane._a );
+        planes[ p ][ 1U ] = _mm_set1_ps ( plane._b );
+        planes[ p ][ 2U ] = _mm_set1_ps ( plane._c );
+        planes[ p ][ 3U ] = _mm_set1_ps ( plane._d );
+    }
+
+    size_t const vectorCount = count - count % BATCH_LANES;
+
+    for ( ; i < vectorCount; i += BATCH_LANES )
+    {
+        __m128 const low[] =
+        {
+            _mm_loadu_ps ( inMin[ 0U ] + i ),
+            _mm_loadu_ps ( inMin[ 1U ] + i ),
+            _mm_loadu_ps ( inMin[ 2U ] + i )
+        };
+
+        __m128 const high[] =
+        {
+            _mm_loadu_ps ( inMax[ 0U ] + i ),
+            _mm_loadu_ps ( inMax[ 1U ] + i ),
+            _mm_loadu_ps ( inMax[ 2U ] + i )
+        };
+
+        __m128 behind = _mm_setzero_ps ();
+
+        for ( auto const &plane : planes )
+            behind = _mm_or_ps ( behind, PlaneBehind ( low, high, plane ) );
+
+        auto const visible = static_cast<GXUInt> ( ~_mm_movemask_ps ( behind ) & 0b1111 );
+        words[ i / WORD_BITS ] |= visible << ( i % WORD_BITS );
+    }
+
+    for ( ; i < count; ++i )
+    {
+        GXFloat const low[] = { inMin[ 0U ][ i ], inMin[ 1U ][ i ], inMin[ 2U ][ i ] };
+        GXFloat const high[] = { inMax[ 0U ][ i ], inMax[ 1U ][ i ], inMax[ 2U ][ i ] };
+        bool isVisible = true;
+
+        for ( GXPlane const &plane : _planes )
+        {
+            GXFloat const x = std::max ( plane._a * low[ 0U ], plane._a * high[ 0U ] );
+            GXFloat const y = std::max ( plane._b * low[ 1U ], plane._b * high[ 1U ] );
+            GXFloat const z = std::max ( plane._c * low[ 2U ], plane._c * high[ 2U ] );
+            isVisible &= !( x + y + z + plane._d < 0.0F );
+        }
+
+        words[ i / WORD_BITS ] |= static_cast<GXUInt> ( isVisible ) << ( i % WORD_BITS );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] GXVoid GXCALL GXMultiplyAsPointBatch ( GXVec3SoA<GXFloat> const &out,
+    GXMat4 const &transform,
+    GXVec3SoA<GXFloat const> const &points
+) noexcept
+{
+    auto const &m = transform._data;
+    __m128 columns[ 3U ][ 4U ];
+
+    for ( size_t c = 0U; c < 3U; ++c )
+    {
+        for ( size_t r = 0U; r < 4U; ++r )
+            columns[ c ][ r ] = _mm_set1_ps ( m[ r ][ c ] );
+    }
+
+    GXFloat* const outX = out._x.data ();
+    GXFloat* const outY = out._y.data ();
+    GXFloat* const outZ = out._z.data ();
+
+    GXFloat const* pointX = points._x.data ();
+    GXFloat const* pointY = points._y.data ();
+    GXFloat const* pointZ = points._z.data ();
+
+    size_t const count = out._x.size ();
+    size_t const vectorCount = count - count % BATCH_LANES;
+    size_t i = 0U;
+
+    for ( ; i < vectorCount; i += BATCH_LANES )
+    {
+        __m128 const x = _mm_loadu_ps ( pointX + i );
+        __m128 const y = _mm_loadu_ps ( pointY + i );
+        __m128 const z = _mm_loadu_ps ( pointZ + i );
+
+        _mm_storeu_ps ( outX + i, PointComponent ( x, y, z, columns[ 0U ] ) );
+        _mm_storeu_ps ( outY + i, PointComponent ( x, y, z, columns[ 1U ] ) );
+        _mm_storeu_ps ( outZ + i, PointComponent ( x, y, z, columns[ 2U ] ) );
+    }
+
+    for ( ; i < count; ++i )
+    {
+        GXVec3 result {};
+        transform.MultiplyAsPoint ( result, GXVec3 ( pointX[ i ], pointY[ i ], pointZ[ i ] ) );
+
+        outX[ i ] = result._data[ 0U ];
+        outY[ i ] = result._data[ 1U ];
+        outZ[ i ] = result._data[ 2U ];
+    }
+}
+
+[[maybe_unused]] GXVoid GXCALL GXTransformAABBBatch ( GXAABBSoA<GXFloat> const &out,
+    GXAABBSoA<GXFloat const> const &bounds,
+    std::span<GXMat4 const> transforms
+) noexcept
+{
+    GXFloat* const outMin[] = { out._min._x.data (), out._min._y.data (), out._min._z.data () };
+    GXFloat* const outMax[] = { out._max._x.data (), out._max._y.data (), out._max._z.data () };
+    GXFloat const* inMin[] = { bounds._min._x.data (), bounds._min._y.data (), bounds._min._z.data () };
+    GXFloat const* inMax[] = { bounds._max._x.data (), bounds._max._y.data (), bounds._max._z.data () };
+
+    size_t const count = out._min._x.size ();
+    size_t const vectorCount = count - count % BATCH_LANES;
+    size_t i = 0U;
+
+    for ( ; i < vectorCount; i += BATCH_LANES )
+    {
+        __m128 const boundsMin[] =
+        {
+            _mm_loadu_ps ( inMin[ 0U ] + i ),
+            _mm_loadu_ps ( inMin[ 1U ] + i ),
+            _mm_loadu_ps ( inMin[ 2U ] + i )
+        };
+
+        __m128 const boundsMax[] =
+        {
+            _mm_loadu_ps ( inMax[ 0U ] + i ),
+            _mm_loadu_ps ( inMax[ 1U ] + i ),
+            _mm_loadu_ps ( inMax[ 2U ] + i )
+        };
+
+        // Row "r" of the four matrices becomes column elements "m[ r ][ c ]" of the four lanes after transposition.
+        GXMat4 const* matrices = transforms.data () + i;
+        __m128 columns[ 4U ][ 4U ];
+
+        for ( size_t r = 0U; r < 4U; ++r )
+        {
+            __m128 m0 = _mm_loadu_ps ( matrices[ 0U ]._data[ r ] );
+            __m128 m1 = _mm_loadu_ps ( matrices[ 1U ]._data[ r ] );
+            __m128 m2 = _mm_loadu_ps ( matrices[ 2U ]._data[ r ] );
+            __m128 m3 = _mm_loadu_ps ( matrices[ 3U ]._data[ r ] );
+            _MM_TRANSPOSE4_PS ( m0, m1, m2, m3 );
+
+            columns[ 0U ][ r ] = m0;
+            columns[ 1U ][ r ] = m1;
+            columns[ 2U ][ r ] = m2;
+        }
+
+        for ( size_t c = 0U; c < 3U; ++c )
+        {
+            __m128 low;
+            __m128 high;
+            BoundsComponent ( low, high, boundsMin, boundsMax, columns[ c ] );
+
+            _mm_storeu_ps ( outMin[ c ] + i, low );
+            _mm_storeu_ps ( outMax[ c ] + i, high );
+        }
+    }
+
+    for ( ; i < count; ++i )
+    {
+        GXFloat const low[] = { inMin[ 0U ][ i ], inMin[ 1U ][ i ], inMin[ 2U ][ i ] };
+        GXFloat const high[] = { inMax[ 0U ][ i ], inMax[ 1U ][ i ], inMax[ 2U ][ i ] };
+        auto const &m = transforms[ i ]._data;
+
+        for ( size_t c = 0U; c < 3U; ++c )
+        {
+            GXFloat const x0 = low[ 0U ] * m[ 0U ][ c ];
+            GXFloat const x1 = high[ 0U ] * m[ 0U ][ c ];
+            GXFloat const y0 = low[ 1U ] * m[ 1U ][ c ];
+            GXFloat const y1 = high[ 1U ] * m[ 1U ][ c ];
+            GXFloat const z0 = low[ 2U ] * m[ 2U ][ c ];
+            GXFloat const z1 = high[ 2U ] * m[ 2U ][ c ];
+
+            outMin[ c ][ i ] = std::min ( x0, x1 ) + std::min ( y0, y1 ) + std::min ( z0, z1 ) + m[ 3U ][ c ];
+            outMax[ c ][ i ] = std::max ( x0, x1 ) + std::max ( y0, y1 ) + std::max ( z0, z1 ) + m[ 3U ][ c ];
+        }
+    }
+}
+
+[[maybe_unused]] GXVoid GXCALL GXMultiplyMat4Batch ( std::span<GXMat4> out,
+    std::span<GXMat4 const> a,
+    std::span<GXMat4 const> b
+) noexcept
+{
+    size_t const count = out.size ();
+
+    for ( size_t i = 0U; i < count; ++i )
+        out[ i ].Multiply ( a[ i ], b[ i ] );
+}
+
+[[maybe_unused]] GXVoid GXCALL GXSphericalLinearInterpolationBatch ( GXQuatSoA<GXFloat> const &out,
+    GXQuatSoA<GXFloat const> const &start,
+    GXQuatSoA<GXFloat const> const &finish,
+    GXFloat interpolationFactor
+) noexcept
+{
+    GXFloat* const outData[] = { out._r.data (), out._a.data (), out._b.data (), out._c.data () };
+    GXFloat const* startData[] = { start._r.data (), start._a.data (), start._b.data (), start._c.data () };
+    GXFloat const* finishData[] = { finish._r.data (), finish._a.data (), finish._b.data (), finish._c.data () };
+
+    size_t const count = out._r.size ();
+    size_t const vectorCount = count - count % BATCH_LANES;
+    size_t i = 0U;
+
+    __m128 const signMask = _mm_set1_ps ( -0.0F );
+
+    for ( ; i < vectorCount; i += BATCH_LANES )
+    {
+        __m128 s[ 4U ];
+        __m128 f[ 4U ];
+
+        for ( size_t j = 0U; j < 4U; ++j )
+        {
+            s[ j ] = _mm_loadu_ps ( startData[ j ] + i );
+            f[ j ] = _mm_loadu_ps ( finishData[ j ] + i );
+        }
+
+        __m128 const rr = _mm_mul_ps ( s[ 0U ], f[ 0U ] );
+        __m128 const ra = _mm_add_ps ( rr, _mm_mul_ps ( s[ 1U ], f[ 1U ] ) );
+        __m128 const rab = _mm_add_ps ( ra, _mm_mul_ps ( s[ 2U ], f[ 2U ] ) );
+        __m128 cosom = _mm_add_ps ( rab, _mm_mul_ps ( s[ 3U ], f[ 3U ] ) );
+
+        // The shortest arc. The finish quaternion is negated in the lanes with negative cosine.
+        __m128 const sign = _mm_and_ps ( _mm_cmplt_ps ( cosom, _mm_setzero_ps () ), signMask );
+        cosom = _mm_xor_ps ( cosom, sign );
+
+        alignas ( 16U ) GXFloat cosoms[ BATCH_LANES ];
+        _mm_store_ps ( cosoms, cosom );
+
+        alignas ( 16U ) GXFloat scales0[ BATCH_LANES ];
+        alignas ( 16U ) GXFloat scales1[ BATCH_LANES ];
+
+        for ( size_t lane = 0U; lane < BATCH_LANES; ++lane )
+            SlerpScales ( scales0[ lane ], scales1[ lane ], cosoms[ lane ], interpolationFactor );
+
+        __m128 const scale0 = _mm_load_ps ( scales0 );
+        __m128 const scale1 = _mm_load_ps ( scales1 );
+
+        for ( size_t j = 0U; j < 4U; ++j )
+        {
+            __m128 const alpha = _mm_mul_ps ( s[ j ], scale0 );
+            __m128 const beta = _mm_mul_ps ( _mm_xor_ps ( f[ j ], sign ), scale1 );
+            _mm_storeu_ps ( outData[ j ] + i, _mm_add_ps ( alpha, beta ) );
+        }
+    }
+
+    for ( ; i < count; ++i )
+    {
+        GXQuat result {};
+
+        result.SphericalLinearInterpolation (
+            GXQuat ( startData[ 0U ][ i ], startData[ 1U ][ i ], startData[ 2U ][ i ], startData[ 3U ][ i ] ),
+            GXQuat ( finishData[ 0U ][ i ], finishData[ 1U ][ i ], finishData[ 2U ][ i ], finishData[ 3U ][ i ] ),
+            interpolationFactor
+        );
+
+        for ( size_t j = 0U; j < 4U; ++j )
+            outData[ j ][ i ] = result._data[ j ];
+    }
+}
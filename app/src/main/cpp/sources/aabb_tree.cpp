@@ -0,0 +1,532 @@
+#include <precompiled_headers.hpp>
+#include <aabb_tree.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+constexpr size_t INITIAL_NODES = 1024U;
+constexpr size_t INITIAL_STACK = 64U;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool AABBTree::Node::IsLeaf () const noexcept
+{
+    return _height == 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+AABBTree::AABBTree () noexcept:
+    BroadPhase ( eBroadPhase::AABBTree )
+{
+    _nodes.reserve ( INITIAL_NODES );
+    _stack.reserve ( INITIAL_STACK );
+}
+
+void AABBTree::Insert ( RigidBodyRef const &body ) noexcept
+{
+    RigidBody &b = *body;
+
+    if ( _proxies.contains ( &b ) ) [[unlikely]]
+        return;
+
+    uint32_t const leaf = AllocateNode ();
+    Node &node = _nodes[ leaf ];
+    node._body = body;
+    node._groups = b.GetShape ().GetCollisionGroups ();
+    node._height = 0;
+    ComputeFatBounds ( node._bounds, b, 0.0F );
+
+    InsertLeaf ( leaf );
+    _proxies.emplace ( &b, leaf );
+}
+
+void AABBTree::Remove ( RigidBody const &body ) noexcept
+{
+    auto const findResult = _proxies.find ( &body );
+
+    if ( findResult == _proxies.end () ) [[unlikely]]
+        return;
+
+    uint32_t const leaf = findResult->second;
+    _proxies.erase ( findResult );
+
+    RemoveLeaf ( leaf );
+    FreeNode ( leaf );
+}
+
+void AABBTree::Reset () noexcept
+{
+    _freeList = NULL_NODE;
+    _nodes.clear ();
+    _proxies.clear ();
+    _root = NULL_NODE;
+}
+
+void AABBTree::Update ( float deltaTime ) noexcept
+{
+    // Note the loop goes through indices because reinsertion could reallocate node storage. Nodes which will be
+    // allocated during the loop are always internal nodes. So they will be skipped.
+    size_t const count = _nodes.size ();
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        Node &node = _nodes[ i ];
+
+        if ( !node.IsLeaf () )
+            continue;
+
+        RigidBody &body = *node._body;
+        uint32_t const groups = body.GetShape ().GetCollisionGroups ();
+
+        // Changed collision groups must be propagated to the ancestors. Reinsertion does it.
+        if ( groups == node._groups && !IsRefitNeeded ( node._bounds, body, deltaTime ) )
+            continue;
+
+        auto const leaf = static_cast<uint32_t> ( i );
+        RemoveLeaf ( leaf );
+
+        Node &n = _nodes[ i ];
+        n._groups = groups;
+        ComputeFatBounds ( n._bounds, body, deltaTime );
+
+        InsertLeaf ( leaf );
+    }
+}
+
+void AABBTree::CollectPairs ( Pairs &pairs ) noexcept
+{
+    pairs.clear ();
+
+    if ( _root == NULL_NODE ) [[unlikely]]
+        return;
+
+    Node const* nodes = _nodes.data ();
+    auto const count = static_cast<uint32_t> ( _nodes.size () );
+
+    for ( uint32_t i = 0U; i < count; ++i )
+    {
+        Node const &query = nodes[ i ];
+
+        uint32_t const groups = query._groups;
+
+        if ( !query.IsLeaf () || query._body->IsKinematic () || groups == 0U )
+            continue;
+
+        GXAABB const &bounds = query._bounds;
+        _stack.clear ();
+        _stack.push_back ( _root );
+
+        while ( !_stack.empty () )
+        {
+            uint32_t const idx = _stack.back ();
+            _stack.pop_back ();
+
+            Node const &node = nodes[ idx ];
+
+            if ( !( node._groups & groups ) || !node._bounds.IsOverlapped ( bounds ) )
+                continue;
+
+            if ( !node.IsLeaf () )
+            {
+                _stack.push_back ( node._left );
+                _stack.push_back ( node._right );
+                continue;
+            }
+
+            // Dynamic vs dynamic pair must be reported only once. Kinematic bodies never run queries.
+            if ( idx == i || ( idx < i && !node._body->IsKinematic () ) )
+                continue;
+
+            pairs.emplace_back ( &query._body, &node._body );
+        }
+    }
+}
+
+template<typename T>
+void AABBTree::Traverse ( Bodies &bodies, T const &isOverlapped ) noexcept
+{
+    bodies.clear ();
+
+    if ( _root == NULL_NODE ) [[unlikely]]
+        return;
+
+    Node const* nodes = _nodes.data ();
+    _stack.clear ();
+    _stack.push_back ( _root );
+
+    while ( !_stack.empty () )
+    {
+        uint32_t const idx = _stack.back ();
+        _stack.pop_back ();
+
+        Node const &node = nodes[ idx ];
+
+        if ( !isOverlapped ( node._bounds ) )
+            continue;
+
+        if ( node.IsLeaf () )
+        {
+            bodies.push_back ( &node._body );
+            continue;
+        }
+
+        _stack.push_back ( node._left );
+        _stack.push_back ( node._right );
+    }
+}
+
+void AABBTree::QueryBounds ( Bodies &bodies, GXAABB const &bounds ) noexcept
+{
+    Traverse ( bodies,
+        [ &bounds ] ( GXAABB const &nodeBounds ) noexcept -> bool {
+            return nodeBounds.IsOverlapped ( bounds );
+        }
+    );
+}
+
+void AABBTree::QueryRay ( Bodies &bodies, GXVec3 const &from, GXVec3 const &to ) noexcept
+{
+    GXVec3 direction {};
+    direction.Subtract ( to, from );
+
+    Traverse ( bodies,
+        [ &from, &direction ] ( GXAABB const &nodeBounds ) noexcept -> bool {
+            return IsSegmentOverlapped ( nodeBounds, from, direction );
+        }
+    );
+}
+
+[[maybe_unused]] int32_t AABBTree::GetHeight () const noexcept
+{
+    return _root == NULL_NODE ? 0 : _nodes[ _root ]._height;
+}
+
+uint32_t AABBTree::AllocateNode () noexcept
+{
+    if ( _freeList == NULL_NODE )
+    {
+        auto const idx = static_cast<uint32_t> ( _nodes.size () );
+        _nodes.emplace_back ()._height = 0;
+        return idx;
+    }
+
+    uint32_t const idx = _freeList;
+    Node &node = _nodes[ idx ];
+    _freeList = node._parent;
+
+    node._parent = NULL_NODE;
+    node._left = NULL_NODE;
+    node._right = NULL_NODE;
+    node._height = 0;
+
+    return idx;
+}
+
+void AABBTree::FreeNode ( uint32_t node ) noexcept
+{
+    Node &n = _nodes[ node ];
+    n._body.reset ();
+    n._height = -1;
+    n._parent = _freeList;
+    _freeList = node;
+}
+
+uint32_t AABBTree::Balance ( uint32_t a ) noexcept
+{
+    // Performs left or right rotation if node "a" is imbalanced. Returns the new root index of the subtree.
+    // Naming: node "a" has children "b" and "c". Node "b" has children "d" and "e". Node "c" has children "f" and "g".
+
+    Node &nodeA = _nodes[ a ];
+
+    if ( nodeA.IsLeaf () || nodeA._height < 2 )
+        return a;
+
+    uint32_t const b = nodeA._left;
+    uint32_t const c = nodeA._right;
+
+    Node &nodeB = _nodes[ b ];
+    Node &nodeC = _nodes[ c ];
+
+    int32_t const balance = nodeC._height - nodeB._height;
+
+    auto replaceChild = [ & ] ( uint32_t parent, uint32_t oldChild, uint32_t newChild ) noexcept {
+        if ( parent == NULL_NODE )
+        {
+            _root = newChild;
+            return;
+        }
+
+        Node &p = _nodes[ parent ];
+
+        if ( p._left == oldChild )
+        {
+            p._left = newChild;
+            return;
+        }
+
+        p._right = newChild;
+    };
+
+    if ( balance > 1 )
+    {
+        // Rotate "c" up.
+        uint32_t const f = nodeC._left;
+        uint32_t const g = nodeC._right;
+
+        Node &nodeF = _nodes[ f ];
+        Node &nodeG = _nodes[ g ];
+
+        nodeC._left = a;
+        nodeC._parent = nodeA._parent;
+        nodeA._parent = c;
+        replaceChild ( nodeC._parent, a, c );
+
+        if ( nodeF._height > nodeG._height )
+        {
+            nodeC._right = f;
+            nodeA._right = g;
+            nodeG._parent = a;
+
+            Merge ( nodeA._bounds, nodeB._bounds, nodeG._bounds );
+            Merge ( nodeC._bounds, nodeA._bounds, nodeF._bounds );
+
+            nodeA._groups = nodeB._groups | nodeG._groups;
+            nodeC._groups = nodeA._groups | nodeF._groups;
+
+            nodeA._height = 1 + std::max ( nodeB._height, nodeG._height );
+            nodeC._height = 1 + std::max ( nodeA._height, nodeF._height );
+            return c;
+        }
+
+        nodeC._right = g;
+        nodeA._right = f;
+        nodeF._parent = a;
+
+        Merge ( nodeA._bounds, nodeB._bounds, nodeF._bounds );
+        Merge ( nodeC._bounds, nodeA._bounds, nodeG._bounds );
+
+        nodeA._groups = nodeB._groups | nodeF._groups;
+        nodeC._groups = nodeA._groups | nodeG._groups;
+
+        nodeA._height = 1 + std::max ( nodeB._height, nodeF._height );
+        nodeC._height = 1 + std::max ( nodeA._height, nodeG._height );
+        return c;
+    }
+
+    if ( balance >= -1 )
+        return a;
+
+    // Rotate "b" up.
+    uint32_t const d = nodeB._left;
+    uint32_t const e = nodeB._right;
+
+    Node &nodeD = _nodes[ d ];
+    Node &nodeE = _nodes[ e ];
+
+    nodeB._left = a;
+    nodeB._parent = nodeA._parent;
+    nodeA._parent = b;
+    replaceChild ( nodeB._parent, a, b );
+
+    if ( nodeD._height > nodeE._height )
+    {
+        nodeB._right = d;
+        nodeA._left = e;
+        nodeE._parent = a;
+
+        Merge ( nodeA._bounds, nodeC._bounds, nodeE._bounds );
+        Merge ( nodeB._bounds, nodeA._bounds, nodeD._bounds );
+
+        nodeA._groups = nodeC._groups | nodeE._groups;
+        nodeB._groups = nodeA._groups | nodeD._groups;
+
+        nodeA._height = 1 + std::max ( nodeC._height, nodeE._height );
+        nodeB._height = 1 + std::max ( nodeA._height, nodeD._height );
+        return b;
+    }
+
+    nodeB._right = e;
+    nodeA._left = d;
+    nodeD._parent = a;
+
+    Merge ( nodeA._bounds, nodeC._bounds, nodeD._bounds );
+    Merge ( nodeB._bounds, nodeA._bounds, nodeE._bounds );
+
+    nodeA._groups = nodeC._groups | nodeD._groups;
+    nodeB._groups = nodeA._groups | nodeE._groups;
+
+    nodeA._height = 1 + std::max ( nodeC._height, nodeD._height );
+    nodeB._height = 1 + std::max ( nodeA._height, nodeE._height );
+    return b;
+}
+
+void AABBTree::InsertLeaf ( uint32_t leaf ) noexcept
+{
+    if ( _root == NULL_NODE )
+    {
+        _root = leaf;
+        _nodes[ leaf ]._parent = NULL_NODE;
+        return;
+    }
+
+    // Stage 1: find the best sibling using surface area heuristic. Perimeter is used instead of area.
+    GXAABB const leafBounds = _nodes[ leaf ]._bounds;
+    uint32_t idx = _root;
+    GXAABB combined {};
+
+    auto descendCost = [ & ] ( uint32_t child, float inheritanceCost ) noexcept -> float {
+        Node const &c = _nodes[ child ];
+        Merge ( combined, leafBounds, c._bounds );
+
+        if ( c.IsLeaf () )
+            return GetPerimeter ( combined ) + inheritanceCost;
+
+        return GetPerimeter ( combined ) - GetPerimeter ( c._bounds ) + inheritanceCost;
+    };
+
+    while ( !_nodes[ idx ].IsLeaf () )
+    {
+        Node const &node = _nodes[ idx ];
+        float const area = GetPerimeter ( node._bounds );
+
+        Merge ( combined, node._bounds, leafBounds );
+        float const combinedArea = GetPerimeter ( combined );
+
+        // Cost of creating a new parent for this node and the new leaf.
+        float const cost = 2.0F * combinedArea;
+
+        // Minimum cost of pushing the leaf further down the tree.
+        float const inheritanceCost = 2.0F * ( combinedArea - area );
+
+        uint32_t const left = node._left;
+        uint32_t const right = node._right;
+
+        float const leftCost = descendCost ( left, inheritanceCost );
+        float const rightCost = descendCost ( right, inheritanceCost );
+
+        if ( cost < leftCost && cost < rightCost )
+            break;
+
+        idx = leftCost < rightCost ? left : right;
+    }
+
+    // Stage 2: create a new parent. Note node storage could be reallocated here.
+    uint32_t const sibling = idx;
+    uint32_t const newParent = AllocateNode ();
+
+    Node &sibl = _nodes[ sibling ];
+    Node &parent = _nodes[ newParent ];
+    uint32_t const oldParent = sibl._parent;
+
+    parent._parent = oldParent;
+    Merge ( parent._bounds, leafBounds, sibl._bounds );
+    parent._height = sibl._height + 1;
+    parent._left = sibling;
+    parent._right = leaf;
+
+    sibl._parent = newParent;
+    _nodes[ leaf ]._parent = newParent;
+
+    if ( oldParent == NULL_NODE )
+    {
+        _root = newParent;
+    }
+    else
+    {
+        Node &op = _nodes[ oldParent ];
+
+        if ( op._left == sibling )
+            op._left = newParent;
+        else
+            op._right = newParent;
+    }
+
+    // Stage 3: walk back up the tree refitting bounds and balancing.
+    Refit ( newParent );
+}
+
+void AABBTree::RemoveLeaf ( uint32_t leaf ) noexcept
+{
+    if ( leaf == _root )
+    {
+        _root = NULL_NODE;
+        return;
+    }
+
+    uint32_t const parent = _nodes[ leaf ]._parent;
+    Node const &p = _nodes[ parent ];
+    uint32_t const grandParent = p._parent;
+    uint32_t const sibling = p._left == leaf ? p._right : p._left;
+
+    _nodes[ sibling ]._parent = grandParent;
+    FreeNode ( parent );
+
+    if ( grandParent == NULL_NODE )
+    {
+        _root = sibling;
+        return;
+    }
+
+    Node &gp = _nodes[ grandParent ];
+
+    if ( gp._left == parent )
+        gp._left = sibling;
+    else
+        gp._right = sibling;
+
+    Refit ( grandParent );
+}
+
+void AABBTree::Refit ( uint32_t node ) noexcept
+{
+    uint32_t idx = node;
+
+    while ( idx != NULL_NODE )
+    {
+        idx = Balance ( idx );
+        Node &n = _nodes[ idx ];
+
+        Node const &left = _nodes[ n._left ];
+        Node const &right = _nodes[ n._right ];
+
+        n._height = 1 + std::max ( left._height, right._height );
+        n._groups = left._groups | right._groups;
+        Merge ( n._bounds, left._bounds, right._bounds );
+
+        idx = n._parent;
+    }
+}
+
+float AABBTree::GetPerimeter ( GXAABB const &bounds ) noexcept
+{
+    GXVec3 size {};
+    size.Subtract ( bounds._max, bounds._min );
+    return 2.0F * ( size._data[ 0U ] + size._data[ 1U ] + size._data[ 2U ] );
+}
+
+void AABBTree::Merge ( GXAABB &result, GXAABB const &a, GXAABB const &b ) noexcept
+{
+    auto const &aMin = a._min._data;
+    auto const &aMax = a._max._data;
+    auto const &bMin = b._min._data;
+    auto const &bMax = b._max._data;
+
+    result._vertices = 2U;
+
+    result._min.Init ( std::min ( aMin[ 0U ], bMin[ 0U ] ),
+        std::min ( aMin[ 1U ], bMin[ 1U ] ),
+        std::min ( aMin[ 2U ], bMin[ 2U ] )
+    );
+
+    result._max.Init ( std::max ( aMax[ 0U ], bMax[ 0U ] ),
+        std::max ( aMax[ 1U ], bMax[ 1U ] ),
+        std::max ( aMax[ 2U ], bMax[ 2U ] )
+    );
+}
+
+} // namespace android_vulkan
@@ -0,0 +1,137 @@
+#include <precompiled_headers.hpp>
+#include <broad_phase.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+// Fat bounds margin in meters.
+constexpr float FAT_MARGIN = 0.1F;
+
+// Fat bounds are extended by predicted displacement of the body. The value is in fixed time steps.
+constexpr float DISPLACEMENT_STEPS = 4.0F;
+
+// Segment direction component below the threshold is treated as parallel to the slab.
+constexpr float PARALLEL_EPSILON = 1.0e-7F;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+eBroadPhase BroadPhase::GetType () const noexcept
+{
+    return _type;
+}
+
+BroadPhase::BroadPhase ( eBroadPhase type ) noexcept:
+    _type ( type )
+{
+    // NOTHING
+}
+
+void BroadPhase::ComputeFatBounds ( GXAABB &fat, RigidBody &body, float deltaTime ) noexcept
+{
+    GXAABB const &bounds = body.GetShape ().GetBoundsWorld ();
+    constexpr GXVec3 margin ( FAT_MARGIN, FAT_MARGIN, FAT_MARGIN );
+
+    fat._vertices = 2U;
+    fat._min.Subtract ( bounds._min, margin );
+    fat._max.Sum ( bounds._max, margin );
+
+    GXVec3 displacement {};
+    displacement.Multiply ( body.GetVelocityLinear (), DISPLACEMENT_STEPS * deltaTime );
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        float const d = displacement._data[ i ];
+
+        if ( d < 0.0F )
+        {
+            fat._min._data[ i ] += d;
+            continue;
+        }
+
+        fat._max._data[ i ] += d;
+    }
+}
+
+bool BroadPhase::IsContained ( GXAABB const &outer, GXAABB const &inner ) noexcept
+{
+    auto const &oMin = outer._min._data;
+    auto const &oMax = outer._max._data;
+    auto const &iMin = inner._min._data;
+    auto const &iMax = inner._max._data;
+
+    return oMin[ 0U ] <= iMin[ 0U ] && oMin[ 1U ] <= iMin[ 1U ] && oMin[ 2U ] <= iMin[ 2U ] &&
+        oMax[ 0U ] >= iMax[ 0U ] && oMax[ 1U ] >= iMax[ 1U ] && oMax[ 2U ] >= iMax[ 2U ];
+}
+
+bool BroadPhase::IsRefitNeeded ( GXAABB const &fat, RigidBody &body, float deltaTime ) noexcept
+{
+    GXAABB const &bounds = body.GetShape ().GetBoundsWorld ();
+
+    if ( !body.IsContinuousCollision () )
+        return !IsContained ( fat, bounds );
+
+    GXVec3 displacement {};
+    displacement.Multiply ( body.GetVelocityLinear (), deltaTime );
+
+    GXAABB swept = bounds;
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        float const d = displacement._data[ i ];
+
+        if ( d < 0.0F )
+        {
+            swept._min._data[ i ] += d;
+            continue;
+        }
+
+        swept._max._data[ i ] += d;
+    }
+
+    return !IsContained ( fat, swept );
+}
+
+bool BroadPhase::IsSegmentOverlapped ( GXAABB const &bounds, GXVec3 const &from, GXVec3 const &direction ) noexcept
+{
+    float tMin = 0.0F;
+    float tMax = 1.0F;
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        float const o = from._data[ i ];
+        float const d = direction._data[ i ];
+        float const bMin = bounds._min._data[ i ];
+        float const bMax = bounds._max._data[ i ];
+
+        if ( std::abs ( d ) < PARALLEL_EPSILON )
+        {
+            if ( o < bMin || o > bMax )
+                return false;
+
+            continue;
+        }
+
+        float const invD = 1.0F / d;
+        float t0 = ( bMin - o ) * invD;
+        float t1 = ( bMax - o ) * invD;
+
+        if ( t0 > t1 )
+            std::swap ( t0, t1 );
+
+        tMin = std::max ( tMin, t0 );
+        tMax = std::min ( tMax, t1 );
+
+        if ( tMin > tMax )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace android_vulkan
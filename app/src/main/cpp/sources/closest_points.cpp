@@ -0,0 +1,94 @@
+#include <precompiled_headers.hpp>
+#include <closest_points.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+// Squared length of the segment which is treated as a point.
+constexpr float DEGENERATE_SEGMENT = 1.0e-12F;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+float ClosestPointSegment ( GXVec3 &result, GXVec3 const &point, GXVec3 const &begin, GXVec3 const &end ) noexcept
+{
+    GXVec3 d {};
+    d.Subtract ( end, begin );
+    float const squaredLength = d.SquaredLength ();
+
+    if ( squaredLength < DEGENERATE_SEGMENT )
+    {
+        result = begin;
+        return 0.0F;
+    }
+
+    GXVec3 v {};
+    v.Subtract ( point, begin );
+
+    float const t = std::clamp ( d.DotProduct ( v ) / squaredLength, 0.0F, 1.0F );
+    result.Sum ( begin, t, d );
+    return t;
+}
+
+void ClosestPointsSegments ( GXVec3 &onFirst,
+    GXVec3 &onSecond,
+    GXVec3 const &p0,
+    GXVec3 const &p1,
+    GXVec3 const &q0,
+    GXVec3 const &q1
+) noexcept
+{
+    GXVec3 d1 {};
+    d1.Subtract ( p1, p0 );
+
+    GXVec3 d2 {};
+    d2.Subtract ( q1, q0 );
+
+    GXVec3 r {};
+    r.Subtract ( p0, q0 );
+
+    float const a = d1.SquaredLength ();
+    float const e = d2.SquaredLength ();
+    float const f = d2.DotProduct ( r );
+
+    if ( a < DEGENERATE_SEGMENT )
+    {
+        onFirst = p0;
+        [[maybe_unused]] float const t = ClosestPointSegment ( onSecond, p0, q0, q1 );
+        return;
+    }
+
+    float const c = d1.DotProduct ( r );
+
+    if ( e < DEGENERATE_SEGMENT )
+    {
+        onSecond = q0;
+        onFirst.Sum ( p0, std::clamp ( -c / a, 0.0F, 1.0F ), d1 );
+        return;
+    }
+
+    float const b = d1.DotProduct ( d2 );
+    float const denominator = a * e - b * b;
+
+    float s = denominator > 0.0F ? std::clamp ( ( b * f - c * e ) / denominator, 0.0F, 1.0F ) : 0.0F;
+    float t = ( b * s + f ) / e;
+
+    if ( t < 0.0F )
+    {
+        t = 0.0F;
+        s = std::clamp ( -c / a, 0.0F, 1.0F );
+    }
+    else if ( t > 1.0F )
+    {
+        t = 1.0F;
+        s = std::clamp ( ( b - c ) / a, 0.0F, 1.0F );
+    }
+
+    onFirst.Sum ( p0, s, d1 );
+    onSecond.Sum ( q0, t, d2 );
+}
+
+} // namespace android_vulkan
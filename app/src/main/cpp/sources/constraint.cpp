@@ -0,0 +1,251 @@
+#include <precompiled_headers.hpp>
+#include <constraint.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+constexpr float STABILIZATION_FACTOR = 0.2F;
+
+static_assert ( STABILIZATION_FACTOR >= 0.0F && STABILIZATION_FACTOR <= 1.0F,
+    "The stabilization factor must be in range [0.0F, 1.0F]" );
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+RigidBodyRef const &Constraint::GetBodyA () const noexcept
+{
+    return _bodyA;
+}
+
+RigidBodyRef const &Constraint::GetBodyB () const noexcept
+{
+    return _bodyB;
+}
+
+[[maybe_unused]] eConstraintType Constraint::GetType () const noexcept
+{
+    return _type;
+}
+
+bool Constraint::IsActive () const noexcept
+{
+    auto isActive = [] ( RigidBody const &body ) noexcept -> bool {
+        return !body.IsKinematic () && body.IsAwake ();
+    };
+
+    return isActive ( *_bodyA ) || isActive ( *_bodyB );
+}
+
+void Constraint::Prepare ( float fixedTimeStepInverse ) noexcept
+{
+    auto cache = [] ( RigidBody const &body, float &massInverse, GXMat3 &inertiaTensorInverse ) noexcept {
+        if ( body.IsKinematic () )
+        {
+            massInverse = 0.0F;
+            inertiaTensorInverse.Zeros ();
+            return;
+        }
+
+        massInverse = body.GetMassInverse ();
+        inertiaTensorInverse = body.GetInertiaTensorInverse ();
+    };
+
+    cache ( *_bodyA, _massInverseA, _inertiaTensorInverseA );
+    cache ( *_bodyB, _massInverseB, _inertiaTensorInverseB );
+    OnPrepare ( STABILIZATION_FACTOR * fixedTimeStepInverse );
+}
+
+Constraint::Constraint ( eConstraintType type, RigidBodyRef const &bodyA, RigidBodyRef const &bodyB ) noexcept:
+    _bodyA ( bodyA ),
+    _bodyB ( bodyB ),
+    _type ( type )
+{
+    // NOTHING
+}
+
+void Constraint::ApplyAngularImpulse ( GXVec3 const &impulse ) noexcept
+{
+    constexpr GXVec3 zero ( 0.0F, 0.0F, 0.0F );
+
+    GXVec3 reverse ( impulse );
+    reverse.Reverse ();
+
+    ApplyToBody ( *_bodyA, _massInverseA, _inertiaTensorInverseA, zero, reverse );
+    ApplyToBody ( *_bodyB, _massInverseB, _inertiaTensorInverseB, zero, impulse );
+}
+
+void Constraint::ApplyImpulse ( GXVec3 const &impulse, GXVec3 const &rA, GXVec3 const &rB ) noexcept
+{
+    GXVec3 reverse ( impulse );
+    reverse.Reverse ();
+
+    GXVec3 angularA {};
+    angularA.CrossProduct ( rA, reverse );
+
+    GXVec3 angularB {};
+    angularB.CrossProduct ( rB, impulse );
+
+    ApplyToBody ( *_bodyA, _massInverseA, _inertiaTensorInverseA, reverse, angularA );
+    ApplyToBody ( *_bodyB, _massInverseB, _inertiaTensorInverseB, impulse, angularB );
+}
+
+GXVec3 Constraint::GetRelativeVelocity ( GXVec3 const &rA, GXVec3 const &rB ) const noexcept
+{
+    RigidBody const &a = *_bodyA;
+    RigidBody const &b = *_bodyB;
+
+    GXVec3 rotationA {};
+    rotationA.CrossProduct ( a.GetVelocityAngular (), rA );
+
+    GXVec3 rotationB {};
+    rotationB.CrossProduct ( b.GetVelocityAngular (), rB );
+
+    GXVec3 velocityA {};
+    velocityA.Sum ( a.GetVelocityLinear (), rotationA );
+
+    GXVec3 velocityB {};
+    velocityB.Sum ( b.GetVelocityLinear (), rotationB );
+
+    GXVec3 result {};
+    result.Subtract ( velocityB, velocityA );
+    return result;
+}
+
+GXVec3 Constraint::GetRelativeVelocityAngular () const noexcept
+{
+    GXVec3 result {};
+    result.Subtract ( _bodyB->GetVelocityAngular (), _bodyA->GetVelocityAngular () );
+    return result;
+}
+
+void Constraint::InitPoint ( PointBlock &block, GXVec3 const &anchor ) const noexcept
+{
+    block._anchorA = ToLocalPoint ( *_bodyA, anchor );
+    block._anchorB = ToLocalPoint ( *_bodyB, anchor );
+}
+
+void Constraint::PreparePoint ( PointBlock &block, float stabilization ) noexcept
+{
+    RigidBody const &a = *_bodyA;
+    RigidBody const &b = *_bodyB;
+
+    GXVec3 const &rA = block._rA = ToWorldDirection ( a, block._anchorA );
+    GXVec3 const &rB = block._rB = ToWorldDirection ( b, block._anchorB );
+
+    // The impulse P changes the relative anchor velocity by
+    // ( mA + mB ) * P + ( IA * ( rA x P ) ) x rA + ( IB * ( rB x P ) ) x rB
+    // The columns of the matrix are the responses to the unit impulses along the world axes.
+    // The matrix is symmetric. So the order of indices does not matter.
+    auto response = [] ( GXVec3 &out,
+        GXMat3 const &inertiaTensorInverse,
+        GXVec3 const &r,
+        GXVec3 const &axis
+    ) noexcept {
+        GXVec3 torque {};
+        torque.CrossProduct ( r, axis );
+
+        GXVec3 alpha {};
+        inertiaTensorInverse.MultiplyMatrixVector ( alpha, torque );
+
+        GXVec3 delta {};
+        delta.CrossProduct ( alpha, r );
+        out.Sum ( out, delta );
+    };
+
+    float const massInverse = _massInverseA + _massInverseB;
+    GXMat3 k {};
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        GXVec3 axis ( 0.0F, 0.0F, 0.0F );
+        axis._data[ i ] = 1.0F;
+
+        GXVec3 column {};
+        column.Multiply ( axis, massInverse );
+        response ( column, _inertiaTensorInverseA, rA, axis );
+        response ( column, _inertiaTensorInverseB, rB, axis );
+
+        for ( size_t j = 0U; j < 3U; ++j )
+        {
+            k._data[ j ][ i ] = column._data[ j ];
+        }
+    }
+
+    block._effectiveMass.Inverse ( k );
+
+    GXVec3 anchorA {};
+    anchorA.Sum ( a.GetLocation (), rA );
+
+    GXVec3 anchorB {};
+    anchorB.Sum ( b.GetLocation (), rB );
+
+    GXVec3 error {};
+    error.Subtract ( anchorB, anchorA );
+    block._bias.Multiply ( error, stabilization );
+
+    ApplyImpulse ( block._lambda, rA, rB );
+}
+
+void Constraint::SolvePoint ( PointBlock &block ) noexcept
+{
+    GXVec3 velocity = GetRelativeVelocity ( block._rA, block._rB );
+    velocity.Sum ( velocity, block._bias );
+
+    GXVec3 impulse {};
+    block._effectiveMass.MultiplyMatrixVector ( impulse, velocity );
+    impulse.Reverse ();
+
+    block._lambda.Sum ( block._lambda, impulse );
+    ApplyImpulse ( impulse, block._rA, block._rB );
+}
+
+GXVec3 Constraint::ToLocalDirection ( RigidBody const &body, GXVec3 const &direction ) noexcept
+{
+    // Note the transform has no scale. So the inverse rotation is the transposed rotation.
+    GXMat3 const rotation ( body.GetTransform () );
+
+    GXVec3 result {};
+    rotation.MultiplyMatrixVector ( result, direction );
+    return result;
+}
+
+GXVec3 Constraint::ToLocalPoint ( RigidBody const &body, GXVec3 const &point ) noexcept
+{
+    GXVec3 offset {};
+    offset.Subtract ( point, body.GetLocation () );
+    return ToLocalDirection ( body, offset );
+}
+
+GXVec3 Constraint::ToWorldDirection ( RigidBody const &body, GXVec3 const &direction ) noexcept
+{
+    GXVec3 result {};
+    body.GetTransform ().MultiplyAsNormal ( result, direction );
+    return result;
+}
+
+void Constraint::ApplyToBody ( RigidBody &body,
+    float massInverse,
+    GXMat3 const &inertiaTensorInverse,
+    GXVec3 const &linear,
+    GXVec3 const &angular
+) noexcept
+{
+    if ( body.IsKinematic () )
+        return;
+
+    GXVec3 velocityLinear {};
+    velocityLinear.Sum ( body.GetVelocityLinear (), massInverse, linear );
+
+    GXVec3 alpha {};
+    inertiaTensorInverse.MultiplyMatrixVector ( alpha, angular );
+
+    GXVec3 velocityAngular {};
+    velocityAngular.Sum ( body.GetVelocityAngular (), alpha );
+
+    body.SetVelocities ( GXVec6 ( velocityLinear, velocityAngular ) );
+}
+
+} // namespace android_vulkan
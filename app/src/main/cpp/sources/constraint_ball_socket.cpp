@@ -0,0 +1,26 @@
+#include <precompiled_headers.hpp>
+#include <constraint_ball_socket.hpp>
+
+
+namespace android_vulkan {
+
+[[maybe_unused]] ConstraintBallSocket::ConstraintBallSocket ( RigidBodyRef const &bodyA,
+    RigidBodyRef const &bodyB,
+    GXVec3 const &anchor
+) noexcept:
+    Constraint ( eConstraintType::BallSocket, bodyA, bodyB )
+{
+    InitPoint ( _point, anchor );
+}
+
+void ConstraintBallSocket::Solve () noexcept
+{
+    SolvePoint ( _point );
+}
+
+void ConstraintBallSocket::OnPrepare ( float stabilization ) noexcept
+{
+    PreparePoint ( _point, stabilization );
+}
+
+} // namespace android_vulkan
@@ -0,0 +1,87 @@
+#include <precompiled_headers.hpp>
+#include <constraint_distance.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+constexpr float MIN_LENGTH = 1.0e-4F;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] ConstraintDistance::ConstraintDistance ( RigidBodyRef const &bodyA,
+    RigidBodyRef const &bodyB,
+    GXVec3 const &anchorA,
+    GXVec3 const &anchorB
+) noexcept:
+    Constraint ( eConstraintType::Distance, bodyA, bodyB ),
+    _anchorA ( ToLocalPoint ( *bodyA, anchorA ) ),
+    _anchorB ( ToLocalPoint ( *bodyB, anchorB ) ),
+    _length ( anchorA.Distance ( anchorB ) )
+{
+    // NOTHING
+}
+
+[[maybe_unused]] float ConstraintDistance::GetLength () const noexcept
+{
+    return _length;
+}
+
+void ConstraintDistance::Solve () noexcept
+{
+    float const velocity = GetRelativeVelocity ( _rA, _rB ).DotProduct ( _normal );
+    float const lambda = -_effectiveMass * ( velocity + _bias );
+    _lambda += lambda;
+
+    GXVec3 impulse {};
+    impulse.Multiply ( _normal, lambda );
+    ApplyImpulse ( impulse, _rA, _rB );
+}
+
+void ConstraintDistance::OnPrepare ( float stabilization ) noexcept
+{
+    RigidBody const &a = *_bodyA;
+    RigidBody const &b = *_bodyB;
+
+    _rA = ToWorldDirection ( a, _anchorA );
+    _rB = ToWorldDirection ( b, _anchorB );
+
+    GXVec3 anchorA {};
+    anchorA.Sum ( a.GetLocation (), _rA );
+
+    GXVec3 anchorB {};
+    anchorB.Sum ( b.GetLocation (), _rB );
+
+    GXVec3 delta {};
+    delta.Subtract ( anchorB, anchorA );
+    float const length = delta.Length ();
+
+    // The direction of the previous step is used when the anchors coincide.
+    if ( length > MIN_LENGTH )
+        _normal.Multiply ( delta, 1.0F / length );
+
+    GXVec3 crossA {};
+    crossA.CrossProduct ( _rA, _normal );
+
+    GXVec3 crossB {};
+    crossB.CrossProduct ( _rB, _normal );
+
+    GXVec3 alpha {};
+    _inertiaTensorInverseA.MultiplyMatrixVector ( alpha, crossA );
+
+    GXVec3 beta {};
+    _inertiaTensorInverseB.MultiplyMatrixVector ( beta, crossB );
+
+    float const k = _massInverseA + _massInverseB + crossA.DotProduct ( alpha ) + crossB.DotProduct ( beta );
+    _effectiveMass = k > 0.0F ? 1.0F / k : 0.0F;
+    _bias = stabilization * ( length - _length );
+
+    GXVec3 impulse {};
+    impulse.Multiply ( _normal, _lambda );
+    ApplyImpulse ( impulse, _rA, _rB );
+}
+
+} // namespace android_vulkan
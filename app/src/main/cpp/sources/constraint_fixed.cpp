@@ -0,0 +1,72 @@
+#include <precompiled_headers.hpp>
+#include <constraint_fixed.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+constexpr GXVec3 const AXES[ 3U ] =
+{
+    GXVec3 ( 1.0F, 0.0F, 0.0F ),
+    GXVec3 ( 0.0F, 1.0F, 0.0F ),
+    GXVec3 ( 0.0F, 0.0F, 1.0F )
+};
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] ConstraintFixed::ConstraintFixed ( RigidBodyRef const &bodyA, RigidBodyRef const &bodyB ) noexcept:
+    Constraint ( eConstraintType::Fixed, bodyA, bodyB )
+{
+    InitPoint ( _point, bodyB->GetLocation () );
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        _axesA[ i ] = ToLocalDirection ( *bodyA, ToWorldDirection ( *bodyB, AXES[ i ] ) );
+    }
+}
+
+void ConstraintFixed::Solve () noexcept
+{
+    GXVec3 velocity = GetRelativeVelocityAngular ();
+    velocity.Sum ( velocity, _bias );
+
+    GXVec3 impulse {};
+    _effectiveMass.MultiplyMatrixVector ( impulse, velocity );
+    impulse.Reverse ();
+
+    _lambda.Sum ( _lambda, impulse );
+    ApplyAngularImpulse ( impulse );
+
+    SolvePoint ( _point );
+}
+
+void ConstraintFixed::OnPrepare ( float stabilization ) noexcept
+{
+    PreparePoint ( _point, stabilization );
+
+    GXMat3 k {};
+    k.Sum ( _inertiaTensorInverseA, _inertiaTensorInverseB );
+    _effectiveMass.Inverse ( k );
+
+    // Small rotation "theta" moves the target axis "t" to "t + theta x t". Summing "t x b" over the orthonormal basis
+    // gives "2 * theta". So "theta" is the rotation of the body B from the target orientation.
+    GXVec3 error ( 0.0F, 0.0F, 0.0F );
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        GXVec3 const target = ToWorldDirection ( *_bodyA, _axesA[ i ] );
+        GXVec3 const current = ToWorldDirection ( *_bodyB, AXES[ i ] );
+
+        GXVec3 cross {};
+        cross.CrossProduct ( target, current );
+        error.Sum ( error, cross );
+    }
+
+    _bias.Multiply ( error, 0.5F * stabilization );
+    ApplyAngularImpulse ( _lambda );
+}
+
+} // namespace android_vulkan
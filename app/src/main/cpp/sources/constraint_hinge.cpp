@@ -0,0 +1,87 @@
+#include <precompiled_headers.hpp>
+#include <constraint_hinge.hpp>
+
+
+namespace android_vulkan {
+
+[[maybe_unused]] ConstraintHinge::ConstraintHinge ( RigidBodyRef const &bodyA,
+    RigidBodyRef const &bodyB,
+    GXVec3 const &anchor,
+    GXVec3 const &axis
+) noexcept:
+    Constraint ( eConstraintType::Hinge, bodyA, bodyB ),
+    _axisA ( ToLocalDirection ( *bodyA, axis ) ),
+    _axisB ( ToLocalDirection ( *bodyB, axis ) )
+{
+    InitPoint ( _point, anchor );
+}
+
+void ConstraintHinge::Solve () noexcept
+{
+    GXVec3 const velocity = GetRelativeVelocityAngular ();
+    float const v0 = _directions[ 0U ].DotProduct ( velocity ) + _bias[ 0U ];
+    float const v1 = _directions[ 1U ].DotProduct ( velocity ) + _bias[ 1U ];
+
+    auto const &m = _effectiveMass;
+    float const lambda0 = -( m[ 0U ][ 0U ] * v0 + m[ 0U ][ 1U ] * v1 );
+    float const lambda1 = -( m[ 1U ][ 0U ] * v0 + m[ 1U ][ 1U ] * v1 );
+
+    _lambda[ 0U ] += lambda0;
+    _lambda[ 1U ] += lambda1;
+    ApplyAngularLambda ( lambda0, lambda1 );
+
+    SolvePoint ( _point );
+}
+
+void ConstraintHinge::ApplyAngularLambda ( float lambda0, float lambda1 ) noexcept
+{
+    GXVec3 impulse {};
+    impulse.Multiply ( _directions[ 0U ], lambda0 );
+    impulse.Sum ( impulse, lambda1, _directions[ 1U ] );
+    ApplyAngularImpulse ( impulse );
+}
+
+void ConstraintHinge::OnPrepare ( float stabilization ) noexcept
+{
+    PreparePoint ( _point, stabilization );
+
+    GXVec3 const axisA = ToWorldDirection ( *_bodyA, _axisA );
+    GXVec3 const axisB = ToWorldDirection ( *_bodyB, _axisB );
+
+    GXMat3 basis {};
+    basis.From ( axisA );
+    basis.GetX ( _directions[ 0U ] );
+    basis.GetY ( _directions[ 1U ] );
+
+    GXMat3 inertiaTensorInverse {};
+    inertiaTensorInverse.Sum ( _inertiaTensorInverseA, _inertiaTensorInverseB );
+
+    GXVec3 alpha {};
+    inertiaTensorInverse.MultiplyMatrixVector ( alpha, _directions[ 0U ] );
+
+    GXVec3 beta {};
+    inertiaTensorInverse.MultiplyMatrixVector ( beta, _directions[ 1U ] );
+
+    float const k00 = _directions[ 0U ].DotProduct ( alpha );
+    float const k01 = _directions[ 0U ].DotProduct ( beta );
+    float const k11 = _directions[ 1U ].DotProduct ( beta );
+    float const determinant = k00 * k11 - k01 * k01;
+    float const determinantInverse = determinant > 0.0F ? 1.0F / determinant : 0.0F;
+
+    auto &m = _effectiveMass;
+    m[ 0U ][ 0U ] = k11 * determinantInverse;
+    m[ 0U ][ 1U ] = -k01 * determinantInverse;
+    m[ 1U ][ 0U ] = m[ 0U ][ 1U ];
+    m[ 1U ][ 1U ] = k00 * determinantInverse;
+
+    // For small deviation the cross product of the axes is the rotation of the body B which is perpendicular to
+    // the hinge axis.
+    GXVec3 error {};
+    error.CrossProduct ( axisA, axisB );
+    _bias[ 0U ] = stabilization * _directions[ 0U ].DotProduct ( error );
+    _bias[ 1U ] = stabilization * _directions[ 1U ].DotProduct ( error );
+
+    ApplyAngularLambda ( _lambda[ 0U ], _lambda[ 1U ] );
+}
+
+} // namespace android_vulkan
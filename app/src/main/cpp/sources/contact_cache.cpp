@@ -0,0 +1,191 @@
+#include <precompiled_headers.hpp>
+#include <av_assert.hpp>
+#include <contact_cache.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+constexpr size_t INITIAL_RECORDS = 1024U;
+constexpr size_t INITIAL_SLOTS = INITIAL_RECORDS * 2U;
+
+static_assert ( ( INITIAL_SLOTS & ( INITIAL_SLOTS - 1U ) ) == 0U, "INITIAL_SLOTS must be power of two" );
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+ContactCache::Record const* ContactCache::Find ( RigidBody const* a, RigidBody const* b ) const noexcept
+{
+    if ( _records.empty () )
+        return nullptr;
+
+    uint32_t const record = _slots[ FindSlot ( a, b ) ]._record;
+    return record == EMPTY_SLOT ? nullptr : _records.data () + record;
+}
+
+std::pair<ContactCache::Record*, bool> ContactCache::Obtain ( RigidBody const* a, RigidBody const* b ) noexcept
+{
+    // Load factor is kept below 0.5. So probe sequences stay short.
+    if ( ( _records.size () + 1U ) * 2U > _slots.size () ) [[unlikely]]
+        Grow ();
+
+    size_t const slot = FindSlot ( a, b );
+    uint32_t const record = _slots[ slot ]._record;
+
+    if ( record != EMPTY_SLOT )
+        return std::make_pair ( _records.data () + record, false );
+
+    _slots[ slot ] = Slot
+    {
+        ._bodyA = a,
+        ._bodyB = b,
+        ._record = static_cast<uint32_t> ( _records.size () )
+    };
+
+    Record &r = _records.emplace_back ();
+    r._bodyA = a;
+    r._bodyB = b;
+
+    return std::make_pair ( &r, true );
+}
+
+std::vector<ContactCache::Record> &ContactCache::GetRecords () noexcept
+{
+    return _records;
+}
+
+void ContactCache::RemoveUnused () noexcept
+{
+    for ( size_t i = 0U; i < _records.size (); )
+    {
+        Record &record = _records[ i ];
+
+        if ( record._isUsed )
+        {
+            record._isUsed = false;
+            ++i;
+            continue;
+        }
+
+        RemoveSlot ( FindSlot ( record._bodyA, record._bodyB ) );
+        Record &last = _records.back ();
+
+        if ( &record != &last )
+        {
+            record = last;
+            _slots[ FindSlot ( record._bodyA, record._bodyB ) ]._record = static_cast<uint32_t> ( i );
+        }
+
+        _records.pop_back ();
+    }
+}
+
+size_t ContactCache::FindSlot ( RigidBody const* a, RigidBody const* b ) const noexcept
+{
+    size_t slot = Hash ( a, b ) & _mask;
+
+    for ( ; ; )
+    {
+        Slot const &s = _slots[ slot ];
+
+        if ( s._record == EMPTY_SLOT || IsSame ( s, a, b ) )
+            return slot;
+
+        slot = ( slot + 1U ) & _mask;
+    }
+}
+
+void ContactCache::Grow () noexcept
+{
+    // Note the storage is allocated on the first use. Contact managers of narrowphase workers never use the cache.
+    size_t const slots = std::max ( _slots.size () * 2U, INITIAL_SLOTS );
+    _mask = slots - 1U;
+
+    if ( _records.capacity () < INITIAL_RECORDS ) [[unlikely]]
+        _records.reserve ( INITIAL_RECORDS );
+
+    _slots.clear ();
+    _slots.resize ( slots );
+
+    size_t const records = _records.size ();
+
+    for ( size_t i = 0U; i < records; ++i )
+    {
+        Record const &record = _records[ i ];
+
+        _slots[ FindSlot ( record._bodyA, record._bodyB ) ] = Slot
+        {
+            ._bodyA = record._bodyA,
+            ._bodyB = record._bodyB,
+            ._record = static_cast<uint32_t> ( i )
+        };
+    }
+}
+
+void ContactCache::RemoveSlot ( size_t slot ) noexcept
+{
+    AV_ASSERT ( _slots[ slot ]._record != EMPTY_SLOT )
+
+    // Backward shift deletion. It keeps probe sequences without tombstones.
+    for ( ; ; )
+    {
+        _slots[ slot ]._record = EMPTY_SLOT;
+        size_t next = slot;
+
+        for ( ; ; )
+        {
+            next = ( next + 1U ) & _mask;
+            Slot const &s = _slots[ next ];
+
+            if ( s._record == EMPTY_SLOT )
+                return;
+
+            // The entry must stay if its home slot lies cyclically in ( slot, next ] range.
+            size_t const home = Hash ( s._bodyA, s._bodyB ) & _mask;
+            bool const stay = slot <= next ? slot < home && home <= next : slot < home || home <= next;
+
+            if ( !stay )
+            {
+                break;
+            }
+        }
+
+        _slots[ slot ] = _slots[ next ];
+        slot = next;
+    }
+}
+
+size_t ContactCache::Hash ( RigidBody const* a, RigidBody const* b ) noexcept
+{
+    // Hash function is based on Boost implementation:
+    // https://www.boost.org/doc/libs/1_55_0/doc/html/hash/reference.html#boost.hash_combine
+    // Pointers are sorted. So the hash does not depend on body order.
+
+    constexpr std::less<RigidBody const*> less {};
+
+    if ( less ( b, a ) )
+        std::swap ( a, b );
+
+    constexpr std::hash<void const*> hashServer {};
+    size_t hash = 0U;
+
+    auto hashCombine = [ & ] ( RigidBody const* body ) noexcept
+    {
+        constexpr size_t magic = 0x9E3779B9U;
+        hash ^= hashServer ( body ) + magic + ( hash << 6U ) + ( hash >> 2U );
+    };
+
+    hashCombine ( a );
+    hashCombine ( b );
+
+    return hash;
+}
+
+bool ContactCache::IsSame ( Slot const &slot, RigidBody const* a, RigidBody const* b ) noexcept
+{
+    return ( slot._bodyA == a && slot._bodyB == b ) || ( slot._bodyA == b && slot._bodyB == a );
+}
+
+} // namespace android_vulkan
@@ -1,26 +1,103 @@
 #include <precompiled_headers.hpp>
+#include <closest_points.hpp>
 #include <contact_detector.hpp>
 #include <logger.hpp>
+#include <shape_capsule.hpp>
+#include <shape_convex_hull.hpp>
 
 
 namespace android_vulkan {
 
+class ContactDetector::StaticInitializer final
+{
+    public:
+        StaticInitializer () noexcept;
+
+        StaticInitializer ( StaticInitializer const & ) = delete;
+        StaticInitializer &operator = ( StaticInitializer const & ) = delete;
+
+        StaticInitializer ( StaticInitializer && ) = delete;
+        StaticInitializer &operator = ( StaticInitializer && ) = delete;
+
+        ~StaticInitializer () = default;
+};
+
+ContactDetector::StaticInitializer::StaticInitializer () noexcept
+{
+    constexpr auto sphere = static_cast<size_t> ( eShapeType::Sphere );
+    constexpr auto box = static_cast<size_t> ( eShapeType::Box );
+    constexpr auto convexHull = static_cast<size_t> ( eShapeType::ConvexHull );
+    constexpr auto mesh = static_cast<size_t> ( eShapeType::Mesh );
+    constexpr auto capsule = static_cast<size_t> ( eShapeType::Capsule );
+
+    // Pairs with closed form solution are routed to dedicated routines. GJK and EPA are used for the rest convex
+    // pairs. Mesh versus mesh is not supported.
+    auto &handlers = ContactDetector::_checkHandlers;
+
+    handlers[ sphere ][ sphere ] = &ContactDetector::CheckSphereSphere;
+    handlers[ sphere ][ box ] = &ContactDetector::CheckSphereBox;
+    handlers[ sphere ][ convexHull ] = &ContactDetector::CheckConvex;
+    handlers[ sphere ][ mesh ] = &ContactDetector::CheckMesh;
+    handlers[ sphere ][ capsule ] = &ContactDetector::CheckSwapped<&ContactDetector::CheckCapsuleSphere>;
+
+    handlers[ box ][ sphere ] = &ContactDetector::CheckSwapped<&ContactDetector::CheckSphereBox>;
+    handlers[ box ][ box ] = &ContactDetector::CheckConvex;
+    handlers[ box ][ convexHull ] = &ContactDetector::CheckConvex;
+    handlers[ box ][ mesh ] = &ContactDetector::CheckMesh;
+    handlers[ box ][ capsule ] = &ContactDetector::CheckSwapped<&ContactDetector::CheckCapsuleBox>;
+
+    handlers[ convexHull ][ sphere ] = &ContactDetector::CheckConvex;
+    handlers[ convexHull ][ box ] = &ContactDetector::CheckConvex;
+    handlers[ convexHull ][ convexHull ] = &ContactDetector::CheckConvex;
+    handlers[ convexHull ][ mesh ] = &ContactDetector::CheckMesh;
+    handlers[ convexHull ][ capsule ] = &ContactDetector::CheckConvex;
+
+    handlers[ mesh ][ sphere ] = &ContactDetector::CheckMesh;
+    handlers[ mesh ][ box ] = &ContactDetector::CheckMesh;
+    handlers[ mesh ][ convexHull ] = &ContactDetector::CheckMesh;
+    handlers[ mesh ][ mesh ] = &ContactDetector::CheckStub;
+    handlers[ mesh ][ capsule ] = &ContactDetector::CheckMesh;
+
+    handlers[ capsule ][ sphere ] = &ContactDetector::CheckCapsuleSphere;
+    handlers[ capsule ][ box ] = &ContactDetector::CheckCapsuleBox;
+    handlers[ capsule ][ convexHull ] = &ContactDetector::CheckConvex;
+    handlers[ capsule ][ mesh ] = &ContactDetector::CheckMesh;
+    handlers[ capsule ][ capsule ] = &ContactDetector::CheckCapsuleCapsule;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 namespace {
 
+// Sine of the angle between capsule segment and the other segment or the box face which is treated as parallel.
+constexpr float CAPSULE_PARALLEL_TOLERANCE = 5.0e-2F;
+
+// Distance between the segment and the other shape which does not define the contact normal.
+constexpr float CAPSULE_CORE_EPSILON = 1.0e-6F;
+
 constexpr float COLLINEAR_TOLERANCE = 5.0e-4F;
 constexpr size_t INITIAL_SHAPE_POINTS = 16U;
 constexpr uint16_t RAY_COUNT = 8U;
 constexpr float RAY_DEVIATION_DEGREES = 6.0F;
 constexpr float SAME_POINT_TOLERANCE = 1.0e-3F;
 
+// Relative displacement per step below the threshold can't cause tunneling. Discrete detection handles such pairs.
+constexpr float SPECULATIVE_DISPLACEMENT = 5.0e-2F;
+
+[[maybe_unused]] ContactDetector::StaticInitializer const g_StaticInitializer {};
+
 } // end of anonymous namespace
 
 //----------------------------------------------------------------------------------------------------------------------
 
+ContactDetector::CheckHandler ContactDetector::_checkHandlers[ SHAPE_TYPES ][ SHAPE_TYPES ] = {};
+
 ContactDetector::ContactDetector () noexcept:
     _cyrusBeck {},
     _epa {},
     _gjk {},
+    _meshContactDetector {},
+    _rayCaster {},
     _rays {},
     _shapeAPoints {},
     _shapeBPoints {},
@@ -34,11 +111,8 @@ ContactDetector::ContactDetector () noexcept:
 
 void ContactDetector::Check ( ContactManager &contactManager, RigidBodyRef const &a, RigidBodyRef const &b ) noexcept
 {
-    RigidBody &bodyA = *a;
-    RigidBody &bodyB = *b;
-
-    Shape const &shapeA = bodyA.GetShape ();
-    Shape const &shapeB = bodyB.GetShape ();
+    Shape const &shapeA = a->GetShape ();
+    Shape const &shapeB = b->GetShape ();
 
     if ( !( shapeA.GetCollisionGroups () & shapeB.GetCollisionGroups () ) )
         return;
@@ -46,6 +120,679 @@ void ContactDetector::Check ( ContactManager &contactManager, RigidBodyRef const
     if ( !shapeA.GetBoundsWorld ().IsOverlapped ( shapeB.GetBoundsWorld () ) )
         return;
 
+    float const restitution = shapeA.GetRestitution () * shapeB.GetRestitution ();
+    float const friction = std::min ( shapeA.GetFriction (), shapeB.GetFriction () );
+
+    CheckHandler const handler = _checkHandlers[ static_cast<size_t> ( shapeA.GetType () ) ][
+        static_cast<size_t> ( shapeB.GetType () )
+    ];
+
+    ( this->*handler ) ( contactManager, a, b, friction, restitution );
+}
+
+bool ContactDetector::IsOverlapped ( RigidBodyRef const &a, RigidBodyRef const &b ) noexcept
+{
+    Shape const &shapeA = a->GetShape ();
+    Shape const &shapeB = b->GetShape ();
+
+    if ( !( shapeA.GetCollisionGroups () & shapeB.GetCollisionGroups () ) )
+        return false;
+
+    if ( !shapeA.GetBoundsWorld ().IsOverlapped ( shapeB.GetBoundsWorld () ) )
+        return false;
+
+    eShapeType const typeA = shapeA.GetType ();
+    eShapeType const typeB = shapeB.GetType ();
+    bool const isMeshA = typeA == eShapeType::Mesh;
+
+    if ( !isMeshA && typeB != eShapeType::Mesh )
+    {
+        _gjk.Reset ();
+        return _gjk.Run ( shapeA, shapeB );
+    }
+
+    Shape const &other = isMeshA ? shapeB : shapeA;
+
+    if ( other.GetType () == eShapeType::Mesh )
+        return false;
+
+    auto const &meshShape = static_cast<ShapeMesh const &> ( isMeshA ? shapeA : shapeB );
+    return !_meshContactDetector.Run ( meshShape, other ).empty ();
+}
+
+void ContactDetector::CheckSpeculative ( ContactManager &contactManager,
+    RigidBodyRef const &a,
+    RigidBodyRef const &b,
+    float deltaTime
+) noexcept
+{
+    // The moving body is body B of the manifold. So the hit normal of the obstacle is the contact normal.
+    bool const isMovingA = a->IsContinuousCollision ();
+    RigidBodyRef const &moving = isMovingA ? a : b;
+    RigidBodyRef const &obstacle = isMovingA ? b : a;
+
+    RigidBody &movingBody = *moving;
+    RigidBody &obstacleBody = *obstacle;
+
+    Shape const &movingShape = movingBody.GetShape ();
+    Shape const &obstacleShape = obstacleBody.GetShape ();
+
+    if ( !( movingShape.GetCollisionGroups () & obstacleShape.GetCollisionGroups () ) )
+        return;
+
+    GXVec3 displacement {};
+    displacement.Subtract ( movingBody.GetVelocityLinear (), obstacleBody.GetVelocityLinear () );
+    displacement.Multiply ( displacement, deltaTime );
+
+    if ( displacement.SquaredLength () < SPECULATIVE_DISPLACEMENT * SPECULATIVE_DISPLACEMENT )
+        return;
+
+    GXAABB const &bounds = movingShape.GetBoundsWorld ();
+    GXAABB swept = bounds;
+
+    GXVec3 v {};
+    v.Sum ( bounds._min, displacement );
+    swept.AddVertex ( v );
+
+    v.Sum ( bounds._max, displacement );
+    swept.AddVertex ( v );
+
+    if ( !swept.IsOverlapped ( obstacleShape.GetBoundsWorld () ) )
+        return;
+
+    GXVec3 from {};
+    movingShape.GetTransformWorld ().GetW ( from );
+
+    // The ray is extended by the radius of the bounds. So the hit is reported as soon as any part of the shape could
+    // reach the obstacle. False hits are harmless. They produce contacts with big gap.
+    GXVec3 diagonal {};
+    diagonal.Subtract ( bounds._max, bounds._min );
+
+    GXVec3 direction ( displacement );
+    direction.Normalize ();
+
+    GXVec3 to {};
+    to.Sum ( from, displacement );
+    to.Sum ( to, 0.5F * diagonal.Length (), direction );
+
+    RaycastResult hit {};
+
+    if ( !_rayCaster.Run ( hit, from, to, obstacleShape ) )
+        return;
+
+    // The center is inside the obstacle already. Discrete detection is responsible for such pair.
+    if ( hit._point.SquaredDistance ( from ) < SAME_POINT_TOLERANCE * SAME_POINT_TOLERANCE )
+        return;
+
+    GXVec3 const &normal = hit._normal;
+
+    if ( normal.DotProduct ( displacement ) >= 0.0F )
+        return;
+
+    GXVec3 reverse ( normal );
+    reverse.Reverse ();
+
+    GXVec3 support {};
+    support.Subtract ( movingShape.GetExtremePointWorld ( reverse ), from );
+
+    // The contact point is the center projected onto the support plane. The point of the real shape could be a box
+    // corner. Speculative impulse at the corner would spin the body instead of stopping it.
+    GXVec3 pointB {};
+    pointB.Sum ( from, support.DotProduct ( normal ), normal );
+
+    GXVec3 gapVector {};
+    gapVector.Subtract ( pointB, hit._point );
+    float const gap = std::max ( gapVector.DotProduct ( normal ), 0.0F );
+
+    GXVec3 pointA {};
+    pointA.Sum ( pointB, -gap, normal );
+
+    ContactManifold &manifold = contactManager.AllocateContactManifold ();
+    manifold._bodyA = obstacle;
+    manifold._bodyB = moving;
+
+    AppendContact ( contactManager,
+        manifold,
+        pointA,
+        normal,
+        -gap,
+        MakeContactFeature ( eContactFeature::ReferenceVertex, 0U ),
+        std::min ( movingShape.GetFriction (), obstacleShape.GetFriction () ),
+        movingShape.GetRestitution () * obstacleShape.GetRestitution ()
+    );
+
+    contactManager.Warm ( manifold );
+}
+
+ContactDetector::FirstContactData ContactDetector::AllocateFirstContact ( ContactManager &contactManager,
+    RigidBodyRef const &a,
+    RigidBodyRef const &b,
+    float friction,
+    float restitution
+) const noexcept
+{
+    ContactManifold &manifold = contactManager.AllocateContactManifold ();
+    manifold._bodyA = a;
+    manifold._bodyB = b;
+
+    manifold._epaSteps = _epa.GetSteps ();
+    manifold._gjkSteps = _gjk.GetSteps ();
+
+    Contact &contact = contactManager.AllocateContact ( manifold );
+    contact._friction = friction;
+    contact._restitution = restitution;
+
+    return std::make_pair ( &manifold, &contact );
+}
+
+void ContactDetector::CheckCapsuleBox ( ContactManager &contactManager,
+    RigidBodyRef const &capsule,
+    RigidBodyRef const &box,
+    float friction,
+    float restitution
+) noexcept
+{
+    auto const &capsuleShape = static_cast<ShapeCapsule const &> ( capsule->GetShape () );
+    auto const &boxShape = static_cast<ShapeBox const &> ( box->GetShape () );
+
+    // All computations are done in the box space.
+    GXMat4 const &transform = boxShape.GetTransformWorld ();
+
+    GXMat4 inverse {};
+    inverse.Inverse ( transform );
+
+    GXVec3 p0 {};
+    inverse.MultiplyAsPoint ( p0, capsuleShape.GetSegmentBeginWorld () );
+
+    GXVec3 p1 {};
+    inverse.MultiplyAsPoint ( p1, capsuleShape.GetSegmentEndWorld () );
+
+    GXVec3 d {};
+    d.Subtract ( p1, p0 );
+
+    GXVec3 half {};
+    half.Multiply ( boxShape.GetSize (), 0.5F );
+
+    float const radius = capsuleShape.GetRadius ();
+    float const* h = half._data;
+
+    auto const squaredDistanceToBox = [ h ] ( GXVec3 const &point ) noexcept -> float {
+        float result = 0.0F;
+
+        for ( size_t i = 0U; i < 3U; ++i )
+        {
+            float const excess = std::abs ( point._data[ i ] ) - h[ i ];
+
+            if ( excess > 0.0F )
+                result += excess * excess;
+        }
+
+        return result;
+    };
+
+    // Squared distance between the segment point and the box is piecewise quadratic function of the segment
+    // parameter. The pieces are separated by the parameters where the segment crosses the box slab planes. So the
+    // minimum of every piece is found in closed form.
+    // Unused slots stay at the segment end. They produce empty pieces.
+    std::array<float, 8U> pieces {};
+    pieces.fill ( 1.0F );
+    pieces[ 0U ] = 0.0F;
+    size_t pieceCount = 1U;
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        float const di = d._data[ i ];
+
+        if ( std::abs ( di ) < CAPSULE_CORE_EPSILON )
+            continue;
+
+        for ( float const bound : { -h[ i ], h[ i ] } )
+        {
+            if ( float const t = ( bound - p0._data[ i ] ) / di; t > 0.0F && t < 1.0F )
+                pieces[ pieceCount++ ] = t;
+        }
+    }
+
+    std::sort ( pieces.begin (), pieces.end () );
+
+    float bestT = 0.0F;
+    float bestDistance = std::numeric_limits<float>::max ();
+
+    for ( size_t i = 1U; i < pieces.size (); ++i )
+    {
+        float const ta = pieces[ i - 1U ];
+        float const tb = pieces[ i ];
+        float const middle = 0.5F * ( ta + tb );
+
+        float numerator = 0.0F;
+        float denominator = 0.0F;
+
+        for ( size_t k = 0U; k < 3U; ++k )
+        {
+            float const dk = d._data[ k ];
+            float const pk = p0._data[ k ];
+            float const value = pk + middle * dk;
+
+            if ( std::abs ( value ) <= h[ k ] )
+                continue;
+
+            float const bound = std::copysign ( h[ k ], value );
+            numerator -= dk * ( pk - bound );
+            denominator += dk * dk;
+        }
+
+        float const t = denominator > 0.0F ? std::clamp ( numerator / denominator, ta, tb ) : ta;
+
+        GXVec3 point {};
+        point.Sum ( p0, t, d );
+
+        if ( float const distance = squaredDistanceToBox ( point ); distance < bestDistance )
+        {
+            bestDistance = distance;
+            bestT = t;
+        }
+    }
+
+    if ( bestDistance >= radius * radius )
+        return;
+
+    GXVec3 pointsA[ 2U ] {};
+    float penetrations[ 2U ] {};
+    ContactFeature features[ 2U ] {};
+    size_t count = 0U;
+    GXVec3 normal {};
+
+    float const length = d.Length ();
+    float const distance = std::sqrt ( bestDistance );
+
+    if ( distance > CAPSULE_CORE_EPSILON )
+    {
+        GXVec3 onSegment {};
+        onSegment.Sum ( p0, bestT, d );
+
+        GXVec3 onBox {};
+        size_t clampedAxes = 0U;
+        size_t faceAxis = 0U;
+
+        for ( size_t i = 0U; i < 3U; ++i )
+        {
+            float const value = onSegment._data[ i ];
+            onBox._data[ i ] = std::clamp ( value, -h[ i ], h[ i ] );
+
+            if ( std::abs ( value ) > h[ i ] )
+            {
+                ++clampedAxes;
+                faceAxis = i;
+            }
+        }
+
+        normal.Subtract ( onBox, onSegment );
+        normal.Multiply ( normal, 1.0F / distance );
+
+        if ( clampedAxes == 1U && std::abs ( d._data[ faceAxis ] ) < CAPSULE_PARALLEL_TOLERANCE * length )
+        {
+            // Lying capsule touches the box face by the segment part. The part is clipped by the face rectangle.
+            float t0 = 0.0F;
+            float t1 = 1.0F;
+
+            for ( size_t i = 0U; i < 3U; ++i )
+            {
+                float const di = d._data[ i ];
+
+                if ( i == faceAxis || std::abs ( di ) < CAPSULE_CORE_EPSILON )
+                    continue;
+
+                float const ta = ( -h[ i ] - p0._data[ i ] ) / di;
+                float const tb = ( h[ i ] - p0._data[ i ] ) / di;
+                t0 = std::max ( t0, std::min ( ta, tb ) );
+                t1 = std::min ( t1, std::max ( ta, tb ) );
+            }
+
+            float const side = std::copysign ( 1.0F, onSegment._data[ faceAxis ] );
+            normal = GXVec3 ( 0.0F, 0.0F, 0.0F );
+            normal._data[ faceAxis ] = -side;
+
+            if ( ( t1 - t0 ) * length > SAME_POINT_TOLERANCE )
+            {
+                for ( float const t : { t0, t1 } )
+                {
+                    GXVec3 point {};
+                    point.Sum ( p0, t, d );
+                    float const height = side * point._data[ faceAxis ] - h[ faceAxis ];
+
+                    if ( height >= radius )
+                        continue;
+
+                    pointsA[ count ].Sum ( point, radius, normal );
+                    penetrations[ count ] = radius - height;
+                    features[ count ] = MakeContactFeature ( eContactFeature::IncidentVertex, count );
+                    ++count;
+                }
+            }
+        }
+
+        if ( count == 0U )
+        {
+            pointsA[ 0U ].Sum ( onSegment, radius, normal );
+            penetrations[ 0U ] = radius - distance;
+            features[ 0U ] = MakeContactFeature ( eContactFeature::IncidentVertex, 0U );
+            count = 1U;
+        }
+    }
+    else
+    {
+        // The segment touches the box. Separating axis test chooses the push direction among box face axes and cross
+        // products of the segment with the box edges.
+        GXVec3 axes[ 6U ] {};
+        size_t axisCount = 3U;
+        axes[ 0U ] = GXVec3 ( 1.0F, 0.0F, 0.0F );
+        axes[ 1U ] = GXVec3 ( 0.0F, 1.0F, 0.0F );
+        axes[ 2U ] = GXVec3 ( 0.0F, 0.0F, 1.0F );
+
+        for ( size_t i = 0U; i < 3U; ++i )
+        {
+            GXVec3 &axis = axes[ axisCount ];
+            axis.CrossProduct ( d, axes[ i ] );
+            float const axisLength = axis.Length ();
+
+            if ( axisLength <= CAPSULE_PARALLEL_TOLERANCE * length )
+                continue;
+
+            axis.Multiply ( axis, 1.0F / axisLength );
+            ++axisCount;
+        }
+
+        float depth = std::numeric_limits<float>::max ();
+
+        for ( size_t i = 0U; i < axisCount; ++i )
+        {
+            GXVec3 const &axis = axes[ i ];
+
+            GXVec3 absolute ( std::abs ( axis._data[ 0U ] ), std::abs ( axis._data[ 1U ] ),
+                std::abs ( axis._data[ 2U ] )
+            );
+
+            float const boxRadius = absolute.DotProduct ( half );
+            float const s0 = axis.DotProduct ( p0 );
+            float const s1 = axis.DotProduct ( p1 );
+
+            // Moving the capsule along the axis or against the axis.
+            float const forward = boxRadius + radius - std::min ( s0, s1 );
+            float const backward = boxRadius + radius + std::max ( s0, s1 );
+
+            if ( forward < depth )
+            {
+                depth = forward;
+                normal = axis;
+                normal.Reverse ();
+            }
+
+            if ( backward < depth )
+            {
+                depth = backward;
+                normal = axis;
+            }
+        }
+
+        float const s0 = normal.DotProduct ( p0 );
+        float const s1 = normal.DotProduct ( p1 );
+        bool const isFirst = s0 >= s1;
+
+        pointsA[ 0U ].Sum ( isFirst ? p0 : p1, radius, normal );
+        penetrations[ 0U ] = depth;
+        features[ 0U ] = MakeContactFeature ( eContactFeature::IncidentVertex, isFirst ? 0U : 1U );
+        count = 1U;
+
+        if ( float const another = depth - std::abs ( s0 - s1 ); another > 0.0F )
+        {
+            pointsA[ 1U ].Sum ( isFirst ? p1 : p0, radius, normal );
+            penetrations[ 1U ] = another;
+            features[ 1U ] = MakeContactFeature ( eContactFeature::IncidentVertex, isFirst ? 1U : 0U );
+            count = 2U;
+        }
+    }
+
+    GXVec3 normalWorld {};
+    transform.MultiplyAsNormal ( normalWorld, normal );
+
+    ContactManifold &manifold = contactManager.AllocateContactManifold ();
+    manifold._bodyA = capsule;
+    manifold._bodyB = box;
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        GXVec3 pointA {};
+        transform.MultiplyAsPoint ( pointA, pointsA[ i ] );
+
+        AppendContact ( contactManager,
+            manifold,
+            pointA,
+            normalWorld,
+            penetrations[ i ],
+            features[ i ],
+            friction,
+            restitution
+        );
+    }
+
+    contactManager.Warm ( manifold );
+}
+
+void ContactDetector::CheckCapsuleCapsule ( ContactManager &contactManager,
+    RigidBodyRef const &a,
+    RigidBodyRef const &b,
+    float friction,
+    float restitution
+) noexcept
+{
+    auto const &capsuleA = static_cast<ShapeCapsule const &> ( a->GetShape () );
+    auto const &capsuleB = static_cast<ShapeCapsule const &> ( b->GetShape () );
+
+    GXVec3 const &p0 = capsuleA.GetSegmentBeginWorld ();
+    GXVec3 const &p1 = capsuleA.GetSegmentEndWorld ();
+    GXVec3 const &q0 = capsuleB.GetSegmentBeginWorld ();
+    GXVec3 const &q1 = capsuleB.GetSegmentEndWorld ();
+
+    GXVec3 onA {};
+    GXVec3 onB {};
+    ClosestPointsSegments ( onA, onB, p0, p1, q0, q1 );
+
+    float const radiusA = capsuleA.GetRadius ();
+    float const radiusSum = radiusA + capsuleB.GetRadius ();
+
+    GXVec3 normal {};
+    normal.Subtract ( onB, onA );
+    float const squaredDistance = normal.SquaredLength ();
+
+    if ( squaredDistance >= radiusSum * radiusSum )
+        return;
+
+    GXVec3 dA {};
+    dA.Subtract ( p1, p0 );
+    float const lengthA = dA.Length ();
+
+    GXVec3 dB {};
+    dB.Subtract ( q1, q0 );
+    float const lengthB = dB.Length ();
+
+    float const distance = std::sqrt ( squaredDistance );
+
+    if ( distance > CAPSULE_CORE_EPSILON )
+    {
+        normal.Multiply ( normal, 1.0F / distance );
+    }
+    else
+    {
+        // The segments intersect. Any direction perpendicular to both segments separates them.
+        normal.CrossProduct ( dA, dB );
+
+        if ( normal.SquaredLength () < CAPSULE_CORE_EPSILON )
+        {
+            GXMat3 basis {};
+            basis.From ( lengthA > CAPSULE_CORE_EPSILON ? dA : GXVec3 ( 0.0F, 1.0F, 0.0F ) );
+            basis.GetX ( normal );
+        }
+
+        normal.Normalize ();
+    }
+
+    ContactManifold &manifold = contactManager.AllocateContactManifold ();
+    manifold._bodyA = a;
+    manifold._bodyB = b;
+
+    GXVec3 cross {};
+    cross.CrossProduct ( dA, dB );
+    float const parallel = CAPSULE_PARALLEL_TOLERANCE * lengthA * lengthB;
+
+    if ( lengthA > CAPSULE_CORE_EPSILON && lengthB > CAPSULE_CORE_EPSILON &&
+        cross.SquaredLength () < parallel * parallel )
+    {
+        // Parallel capsules touch each other by the overlapping part of the segments. Both ends of the part produce
+        // contacts.
+        GXVec3 axis {};
+        axis.Multiply ( dA, 1.0F / lengthA );
+
+        GXVec3 alpha {};
+        alpha.Subtract ( q0, p0 );
+        float const t0 = axis.DotProduct ( alpha );
+
+        alpha.Subtract ( q1, p0 );
+        float const t1 = axis.DotProduct ( alpha );
+
+        float const from = std::max ( 0.0F, std::min ( t0, t1 ) );
+        float const to = std::min ( lengthA, std::max ( t0, t1 ) );
+
+        if ( to - from > SAME_POINT_TOLERANCE )
+        {
+            size_t index = 0U;
+
+            for ( float const t : { from, to } )
+            {
+                GXVec3 pointA {};
+                pointA.Sum ( p0, t, axis );
+
+                GXVec3 pointB {};
+                [[maybe_unused]] float const tB = ClosestPointSegment ( pointB, pointA, q0, q1 );
+
+                pointB.Subtract ( pointB, pointA );
+                float const penetration = radiusSum - normal.DotProduct ( pointB );
+
+                if ( penetration > 0.0F )
+                {
+                    pointA.Sum ( pointA, radiusA, normal );
+
+                    AppendContact ( contactManager,
+                        manifold,
+                        pointA,
+                        normal,
+                        penetration,
+                        MakeContactFeature ( eContactFeature::IncidentVertex, index ),
+                        friction,
+                        restitution
+                    );
+                }
+
+                ++index;
+            }
+        }
+    }
+
+    if ( manifold._contactCount == 0U )
+    {
+        GXVec3 pointA {};
+        pointA.Sum ( onA, radiusA, normal );
+
+        AppendContact ( contactManager,
+            manifold,
+            pointA,
+            normal,
+            radiusSum - distance,
+            MakeContactFeature ( eContactFeature::ReferenceEdge, 0U ),
+            friction,
+            restitution
+        );
+    }
+
+    contactManager.Warm ( manifold );
+}
+
+void ContactDetector::CheckCapsuleSphere ( ContactManager &contactManager,
+    RigidBodyRef const &capsule,
+    RigidBodyRef const &sphere,
+    float friction,
+    float restitution
+) noexcept
+{
+    auto const &capsuleShape = static_cast<ShapeCapsule const &> ( capsule->GetShape () );
+    auto const &sphereShape = static_cast<ShapeSphere const &> ( sphere->GetShape () );
+
+    GXVec3 const &begin = capsuleShape.GetSegmentBeginWorld ();
+    GXVec3 const &end = capsuleShape.GetSegmentEndWorld ();
+
+    GXVec3 center {};
+    sphereShape.GetTransformWorld ().GetW ( center );
+
+    GXVec3 onSegment {};
+    [[maybe_unused]] float const t = ClosestPointSegment ( onSegment, center, begin, end );
+
+    float const radiusA = capsuleShape.GetRadius ();
+    float const radiusSum = radiusA + sphereShape.GetRadius ();
+
+    GXVec3 normal {};
+    normal.Subtract ( center, onSegment );
+    float const squaredDistance = normal.SquaredLength ();
+
+    if ( squaredDistance >= radiusSum * radiusSum )
+        return;
+
+    float const distance = std::sqrt ( squaredDistance );
+
+    if ( distance > CAPSULE_CORE_EPSILON )
+    {
+        normal.Multiply ( normal, 1.0F / distance );
+    }
+    else
+    {
+        // Sphere center lies on the segment. Any direction perpendicular to the segment is valid.
+        GXVec3 axis {};
+        axis.Subtract ( end, begin );
+
+        GXMat3 basis {};
+        basis.From ( axis.SquaredLength () > CAPSULE_CORE_EPSILON ? axis : GXVec3 ( 0.0F, 1.0F, 0.0F ) );
+        basis.GetX ( normal );
+        normal.Normalize ();
+    }
+
+    GXVec3 pointA {};
+    pointA.Sum ( onSegment, radiusA, normal );
+
+    ContactManifold &manifold = contactManager.AllocateContactManifold ();
+    manifold._bodyA = capsule;
+    manifold._bodyB = sphere;
+
+    AppendContact ( contactManager,
+        manifold,
+        pointA,
+        normal,
+        radiusSum - distance,
+        MakeContactFeature ( eContactFeature::ReferenceVertex, 0U ),
+        friction,
+        restitution
+    );
+
+    contactManager.Warm ( manifold );
+}
+
+void ContactDetector::CheckConvex ( ContactManager &contactManager,
+    RigidBodyRef const &a,
+    RigidBodyRef const &b,
+    float friction,
+    float restitution
+) noexcept
+{
+    Shape const &shapeA = a->GetShape ();
+    Shape const &shapeB = b->GetShape ();
+
     _gjk.Reset ();
 
     if ( !_gjk.Run ( shapeA, shapeB ) )
@@ -65,9 +812,6 @@ void ContactDetector::Check ( ContactManager &contactManager, RigidBodyRef const
         return;
     }
 
-    float const restitution = shapeA.GetRestitution () * shapeB.GetRestitution ();
-    float const friction = std::min ( shapeA.GetFriction (), shapeB.GetFriction () );
-
     GXMat3 tbn {};
     GXVec3 const n ( _epa.GetNormal () );
     tbn.From ( n );
@@ -133,25 +877,230 @@ void ContactDetector::Check ( ContactManager &contactManager, RigidBodyRef const
     ManifoldFaceFace ( contactManager, a, b, friction, restitution );
 }
 
-ContactDetector::FirstContactData ContactDetector::AllocateFirstContact ( ContactManager &contactManager,
+void ContactDetector::CheckMesh ( ContactManager &contactManager,
     RigidBodyRef const &a,
     RigidBodyRef const &b,
     float friction,
     float restitution
-) const noexcept
+) noexcept
 {
+    // The mesh is always body A of the manifold.
+    bool const isMeshA = a->GetShape ().GetType () == eShapeType::Mesh;
+    RigidBodyRef const &mesh = isMeshA ? a : b;
+    RigidBodyRef const &other = isMeshA ? b : a;
+
+    auto const &meshShape = static_cast<ShapeMesh const &> ( mesh->GetShape () );
+    MeshContactDetector::MeshContacts &contacts = _meshContactDetector.Run ( meshShape, other->GetShape () );
+
+    if ( contacts.empty () )
+        return;
+
+    if ( contacts.size () > ContactManager::MAX_MANIFOLD_CONTACTS )
+    {
+        // The deepest contacts are kept. The contact manager reduces them further.
+        auto const end = contacts.begin () + static_cast<std::ptrdiff_t> ( ContactManager::MAX_MANIFOLD_CONTACTS );
+
+        std::partial_sort ( contacts.begin (),
+            end,
+            contacts.end (),
+
+            [] ( MeshContactDetector::MeshContact const &x, MeshContactDetector::MeshContact const &y ) noexcept {
+                return x._penetration > y._penetration;
+            }
+        );
+
+        contacts.erase ( end, contacts.end () );
+    }
+
+    ContactManifold &manifold = contactManager.AllocateContactManifold ();
+    manifold._bodyA = mesh;
+    manifold._bodyB = other;
+
+    for ( auto const &meshContact : contacts )
+    {
+        AppendContact ( contactManager,
+            manifold,
+            meshContact._pointA,
+            meshContact._normal,
+            meshContact._penetration,
+            meshContact._feature,
+            friction,
+            restitution
+        );
+    }
+
+    contactManager.Warm ( manifold );
+}
+
+void ContactDetector::CheckSphereBox ( ContactManager &contactManager,
+    RigidBodyRef const &sphere,
+    RigidBodyRef const &box,
+    float friction,
+    float restitution
+) noexcept
+{
+    auto const &sphereShape = static_cast<ShapeSphere const &> ( sphere->GetShape () );
+    auto const &boxShape = static_cast<ShapeBox const &> ( box->GetShape () );
+
+    // All computations are done in the box space.
+    GXMat4 const &transform = boxShape.GetTransformWorld ();
+
+    GXMat4 inverse {};
+    inverse.Inverse ( transform );
+
+    GXVec3 centerWorld {};
+    sphereShape.GetTransformWorld ().GetW ( centerWorld );
+
+    GXVec3 center {};
+    inverse.MultiplyAsPoint ( center, centerWorld );
+
+    GXVec3 half {};
+    half.Multiply ( boxShape.GetSize (), 0.5F );
+
+    float const radius = sphereShape.GetRadius ();
+    float const* h = half._data;
+
+    GXVec3 onBox {};
+    bool isInside = true;
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        float const value = center._data[ i ];
+        onBox._data[ i ] = std::clamp ( value, -h[ i ], h[ i ] );
+        isInside &= std::abs ( value ) <= h[ i ];
+    }
+
+    GXVec3 normal {};
+    float penetration;
+
+    if ( isInside )
+    {
+        // The center is inside the box. The sphere is pushed out through the closest face.
+        size_t faceAxis = 0U;
+        float faceDistance = std::numeric_limits<float>::max ();
+
+        for ( size_t i = 0U; i < 3U; ++i )
+        {
+            if ( float const distance = h[ i ] - std::abs ( center._data[ i ] ); distance < faceDistance )
+            {
+                faceDistance = distance;
+                faceAxis = i;
+            }
+        }
+
+        normal = GXVec3 ( 0.0F, 0.0F, 0.0F );
+        normal._data[ faceAxis ] = -std::copysign ( 1.0F, center._data[ faceAxis ] );
+        penetration = radius + faceDistance;
+    }
+    else
+    {
+        normal.Subtract ( onBox, center );
+        float const squaredDistance = normal.SquaredLength ();
+
+        if ( squaredDistance >= radius * radius )
+            return;
+
+        float const distance = std::sqrt ( squaredDistance );
+        normal.Multiply ( normal, 1.0F / distance );
+        penetration = radius - distance;
+    }
+
+    GXVec3 normalWorld {};
+    transform.MultiplyAsNormal ( normalWorld, normal );
+
+    GXVec3 pointA {};
+    pointA.Sum ( centerWorld, radius, normalWorld );
+
+    ContactManifold &manifold = contactManager.AllocateContactManifold ();
+    manifold._bodyA = sphere;
+    manifold._bodyB = box;
+
+    AppendContact ( contactManager,
+        manifold,
+        pointA,
+        normalWorld,
+        penetration,
+        MakeContactFeature ( eContactFeature::ReferenceVertex, 0U ),
+        friction,
+        restitution
+    );
+
+    contactManager.Warm ( manifold );
+}
+
+void ContactDetector::CheckSphereSphere ( ContactManager &contactManager,
+    RigidBodyRef const &a,
+    RigidBodyRef const &b,
+    float friction,
+    float restitution
+) noexcept
+{
+    auto const &sphereA = static_cast<ShapeSphere const &> ( a->GetShape () );
+    auto const &sphereB = static_cast<ShapeSphere const &> ( b->GetShape () );
+
+    GXVec3 centerA {};
+    sphereA.GetTransformWorld ().GetW ( centerA );
+
+    GXVec3 centerB {};
+    sphereB.GetTransformWorld ().GetW ( centerB );
+
+    float const radiusA = sphereA.GetRadius ();
+    float const radiusSum = radiusA + sphereB.GetRadius ();
+
+    GXVec3 normal {};
+    normal.Subtract ( centerB, centerA );
+    float const squaredDistance = normal.SquaredLength ();
+
+    if ( squaredDistance >= radiusSum * radiusSum )
+        return;
+
+    float const distance = std::sqrt ( squaredDistance );
+
+    // Coincident centers do not define the direction. Any direction is valid.
+    if ( distance > CAPSULE_CORE_EPSILON )
+        normal.Multiply ( normal, 1.0F / distance );
+    else
+        normal = GXVec3 ( 0.0F, 1.0F, 0.0F );
+
+    GXVec3 pointA {};
+    pointA.Sum ( centerA, radiusA, normal );
+
     ContactManifold &manifold = contactManager.AllocateContactManifold ();
     manifold._bodyA = a;
     manifold._bodyB = b;
 
-    manifold._epaSteps = _epa.GetSteps ();
-    manifold._gjkSteps = _gjk.GetSteps ();
+    AppendContact ( contactManager,
+        manifold,
+        pointA,
+        normal,
+        radiusSum - distance,
+        MakeContactFeature ( eContactFeature::ReferenceVertex, 0U ),
+        friction,
+        restitution
+    );
 
-    Contact &contact = contactManager.AllocateContact ( manifold );
-    contact._friction = friction;
-    contact._restitution = restitution;
+    contactManager.Warm ( manifold );
+}
 
-    return std::make_pair ( &manifold, &contact );
+void ContactDetector::CheckStub ( ContactManager &/*contactManager*/,
+    RigidBodyRef const &/*a*/,
+    RigidBodyRef const &/*b*/,
+    float /*friction*/,
+    float /*restitution*/
+) noexcept
+{
+    // NOTHING
+}
+
+template<ContactDetector::CheckHandler handler>
+void ContactDetector::CheckSwapped ( ContactManager &contactManager,
+    RigidBodyRef const &a,
+    RigidBodyRef const &b,
+    float friction,
+    float restitution
+) noexcept
+{
+    ( this->*handler ) ( contactManager, b, a, friction, restitution );
 }
 
 void ContactDetector::CollectBackwardExtremePoints ( Vertices &vertices,
@@ -159,6 +1108,14 @@ void ContactDetector::CollectBackwardExtremePoints ( Vertices &vertices,
     GXMat3 const &tbn
 ) noexcept
 {
+    if ( shape.GetType () == eShapeType::ConvexHull )
+    {
+        GXVec3 direction {};
+        tbn.GetZ ( direction );
+        static_cast<ShapeConvexHull const &> ( shape ).CollectFeatureWorld ( vertices, direction );
+        return;
+    }
+
     vertices.clear ();
     auto const end = _rays.crend ();
 
@@ -170,6 +1127,14 @@ void ContactDetector::CollectBackwardExtremePoints ( Vertices &vertices,
 
 void ContactDetector::CollectForwardExtremePoints ( Vertices &vertices, Shape const &shape, GXMat3 const &tbn ) noexcept
 {
+    if ( shape.GetType () == eShapeType::ConvexHull )
+    {
+        GXVec3 direction {};
+        tbn.GetZ ( direction );
+        static_cast<ShapeConvexHull const &> ( shape ).CollectFeatureWorld ( vertices, direction );
+        return;
+    }
+
     vertices.clear ();
 
     for ( auto const &ray : _rays )
@@ -248,6 +1213,7 @@ void ContactDetector::ManifoldEdgeEdge ( ContactManager &contactManager,
         firstContact->_pointA.Sum ( _shapeAPoints[ 0U ], proj._data[ 0U ], aDir );
         firstContact->_pointB.Sum ( firstContact->_pointA, penetration, firstContact->_normal );
         firstContact->_penetration = penetration;
+        firstContact->_feature = MakeContactFeature ( eContactFeature::IncidentVertex, 0U );
 
         if ( std::abs ( proj._data[ 0U ] - proj._data[ 1U ] ) < SAME_POINT_TOLERANCE )
         {
@@ -262,6 +1228,7 @@ void ContactDetector::ManifoldEdgeEdge ( ContactManager &contactManager,
         anotherContact._pointA.Sum ( _shapeAPoints[ 0U ], proj._data[ 1U ], aDir );
         anotherContact._pointB.Sum ( anotherContact._pointA, penetration, firstContact->_normal );
         anotherContact._penetration = penetration;
+        anotherContact._feature = MakeContactFeature ( eContactFeature::IncidentVertex, 1U );
 
         anotherContact._tangent = firstContact->_tangent;
         anotherContact._bitangent = firstContact->_bitangent;
@@ -312,6 +1279,10 @@ void ContactDetector::ManifoldEdgeEdge ( ContactManager &contactManager,
     firstContact->_pointA.Sum ( firstContact->_pointB, penetration, firstContact->_normal );
     firstContact->_penetration = penetration;
 
+    firstContact->_feature = CombineContactFeatures ( MakeContactFeature ( eContactFeature::ReferenceEdge, 0U ),
+        MakeContactFeature ( eContactFeature::IncidentEdge, 0U )
+    );
+
     contactManager.Warm ( *manifold );
 }
 
@@ -366,10 +1337,12 @@ void ContactDetector::ManifoldEdgeFace ( ContactManager &contactManager,
     float penetration = faceNormal.DotProduct ( alpha );
     bool firstContactUsed = false;
 
-    auto write = [ & ] ( Contact &contact, GXVec3 const &v, float penetration ) noexcept {
+    auto write = [ & ] ( Contact &contact, size_t point, float depth ) noexcept {
+        GXVec3 const &v = vertices[ point ];
         contact._pointA = v;
-        contact._pointB.Sum ( v, penetration, faceNormal );
-        contact._penetration = penetration;
+        contact._pointB.Sum ( v, depth, faceNormal );
+        contact._penetration = depth;
+        contact._feature = _cyrusBeck.GetFeature ( point );
 
         GXVec3 &normal = contact._normal;
         normal = faceNormal;
@@ -384,7 +1357,7 @@ void ContactDetector::ManifoldEdgeFace ( ContactManager &contactManager,
 
     if ( penetration > 0.0F && alpha.SquaredLength () > SAME_POINT )
     {
-        write ( *firstContact, vertices[ 0U ], penetration );
+        write ( *firstContact, 0U, penetration );
         firstContactUsed = true;
     }
 
@@ -408,7 +1381,7 @@ void ContactDetector::ManifoldEdgeFace ( ContactManager &contactManager,
 
     targetContact._friction = friction;
     targetContact._restitution = restitution;
-    write ( targetContact, vertices[ 1U ], penetration );
+    write ( targetContact, 1U, penetration );
 
     contactManager.Warm ( *manifold );
 }
@@ -459,13 +1432,14 @@ void ContactDetector::ManifoldFaceFace ( ContactManager &contactManager,
         basis.GetY ( contact._bitangent );
     };
 
-    for ( auto const &[aPoint, bPoint] : result )
+    for ( auto const &[aPoint, bPoint, feature] : result )
     {
         if ( isFirst )
         {
             firstContact->_pointA = aPoint;
             firstContact->_pointB = bPoint;
             firstContact->_penetration = aPoint.Distance ( bPoint );
+            firstContact->_feature = feature;
             makeBasis ( *firstContact, aPoint, bPoint );
             isFirst = false;
             continue;
@@ -477,6 +1451,7 @@ void ContactDetector::ManifoldFaceFace ( ContactManager &contactManager,
         anotherContact._pointA = aPoint;
         anotherContact._pointB = bPoint;
         anotherContact._penetration = aPoint.Distance ( bPoint );
+        anotherContact._feature = feature;
         makeBasis ( anotherContact, aPoint, bPoint );
     }
 
@@ -501,6 +1476,7 @@ void ContactDetector::ManifoldPoint ( ContactManager &contactManager,
     contact->_penetration = _epa.GetDepth ();
     contact->_pointA = vertex;
     contact->_pointB.Sum ( contact->_pointA, -contact->_penetration, contact->_normal );
+    contact->_feature = MakeContactFeature ( eContactFeature::ReferenceVertex, 0U );
     contactManager.Warm ( *manifold );
 }
 
@@ -531,6 +1507,31 @@ R"__(ContactDetector::NotifyEPAFail - Can't find penetration depth and separatio
     );
 }
 
+void ContactDetector::AppendContact ( ContactManager &contactManager,
+    ContactManifold &manifold,
+    GXVec3 const &pointA,
+    GXVec3 const &normal,
+    float penetration,
+    ContactFeature feature,
+    float friction,
+    float restitution
+) noexcept
+{
+    Contact &contact = contactManager.AllocateContact ( manifold );
+    contact._friction = friction;
+    contact._restitution = restitution;
+    contact._pointA = pointA;
+    contact._pointB.Sum ( pointA, -penetration, normal );
+    contact._penetration = penetration;
+    contact._feature = feature;
+    contact._normal = normal;
+
+    GXMat3 basis {};
+    basis.From ( normal );
+    basis.GetX ( contact._tangent );
+    basis.GetY ( contact._bitangent );
+}
+
 void ContactDetector::AppendExtremePoint ( Vertices &vertices,
     Shape const &shape,
     GXMat3 const &tbn,
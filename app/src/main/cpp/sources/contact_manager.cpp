@@ -1,4 +1,5 @@
 #include <precompiled_headers.hpp>
+#include <av_assert.hpp>
 #include <contact_manager.hpp>
 
 
@@ -15,30 +16,38 @@ constexpr float WARM_FINDER_FACTOR = WARM_FINDER_TOLERANCE * WARM_FINDER_TOLERAN
 
 constexpr float WARM_TRANSFER_FACTOR = 0.85F;
 
-} // end of anonymous namespace
-
-//----------------------------------------------------------------------------------------------------------------------
+// The manifold is restored from the contact cache while relative transform of the bodies stays in these limits.
+constexpr float RESTORE_LOCATION_TOLERANCE = 1.0e-3F;
+constexpr float RESTORE_LOCATION_FACTOR = RESTORE_LOCATION_TOLERANCE * RESTORE_LOCATION_TOLERANCE;
+constexpr float RESTORE_ROTATION_TOLERANCE = 1.0e-3F;
 
-size_t ContactManager::Hasher::operator () ( Key const &me ) const noexcept
+[[nodiscard]] bool IsSimilarTransform ( GXMat4 const &a, GXMat4 const &b ) noexcept
 {
-    // Hash function is based on Boost implementation:
-    // https://www.boost.org/doc/libs/1_55_0/doc/html/hash/reference.html#boost.hash_combine
+    auto const &aData = a._data;
+    auto const &bData = b._data;
 
-    size_t hash = 0U;
-
-    auto hashCombine = [ & ] ( RigidBody const* body ) noexcept
+    for ( size_t row = 0U; row < 3U; ++row )
     {
-        constexpr size_t magic = 0x9E3779B9U;
-        hash ^= _hashServer ( body ) + magic + ( hash << 6U ) + ( hash >> 2U );
-    };
+        for ( size_t column = 0U; column < 3U; ++column )
+        {
+            if ( std::abs ( aData[ row ][ column ] - bData[ row ][ column ] ) > RESTORE_ROTATION_TOLERANCE )
+            {
+                return false;
+            }
+        }
+    }
+
+    GXVec3 aOrigin {};
+    a.GetW ( aOrigin );
 
-    auto const [a, b] = me;
-    hashCombine ( a );
-    hashCombine ( b );
+    GXVec3 bOrigin {};
+    b.GetW ( bOrigin );
 
-    return hash;
+    return aOrigin.SquaredDistance ( bOrigin ) <= RESTORE_LOCATION_FACTOR;
 }
 
+} // end of anonymous namespace
+
 //----------------------------------------------------------------------------------------------------------------------
 
 class Grabber final
@@ -49,9 +58,10 @@ class Grabber final
         GXVec3 const    _normal;
 
     private:
-        float const     _penetration;
-        GXVec3 const    _tangent;
-        GXVec3 const    _bitangent;
+        float const             _penetration;
+        ContactFeature const    _feature;
+        GXVec3 const            _tangent;
+        GXVec3 const            _bitangent;
 
     public:
         Grabber () = delete;
@@ -67,6 +77,7 @@ class Grabber final
             _pointB ( contact._pointB ),
             _normal ( contact._normal ),
             _penetration ( contact._penetration ),
+            _feature ( contact._feature ),
             _tangent ( contact._tangent ),
             _bitangent ( contact._bitangent )
         {
@@ -81,6 +92,7 @@ class Grabber final
             target._pointB = _pointB;
             target._normal = _normal;
             target._penetration = _penetration;
+            target._feature = _feature;
             target._tangent = _tangent;
             target._bitangent = _bitangent;
         }
@@ -99,8 +111,21 @@ ContactManager::ContactManager () noexcept
     _indices.reserve ( INITIAL_INDICES );
 }
 
+ContactManager::ContactManager ( size_t initialContactManifolds ) noexcept:
+    _isWarmStartEnabled ( false )
+{
+    for ( auto &[contactManifolds, contacts] : _sets )
+    {
+        contacts.reserve ( initialContactManifolds * MAX_MANIFOLD_CONTACTS );
+        contactManifolds.reserve ( initialContactManifolds );
+    }
+
+    _indices.reserve ( INITIAL_INDICES );
+}
+
 Contact &ContactManager::AllocateContact ( ContactManifold &contactManifold ) noexcept
 {
+    AV_ASSERT ( _sets.front ().second.size () < _sets.front ().second.capacity () )
     Contact &contact = _sets.front ().second.emplace_back ();
 
     if ( !contactManifold._contacts )
@@ -112,115 +137,255 @@ Contact &ContactManager::AllocateContact ( ContactManifold &contactManifold ) no
 
 ContactManifold &ContactManager::AllocateContactManifold () noexcept
 {
-    return _sets.front ().first.emplace_back ();
+    // Note the contact detector keeps raw pointers to the manifold and to its contacts while manifold is being
+    // constructed. So storage is allowed to grow only here, before the next manifold is started.
+    auto &[contactManifolds, contacts] = _sets.front ();
+
+    if ( contactManifolds.size () == contactManifolds.capacity () ) [[unlikely]]
+        GrowContactManifolds ();
+
+    if ( contacts.capacity () - contacts.size () < MAX_MANIFOLD_CONTACTS ) [[unlikely]]
+        GrowContacts ();
+
+    return contactManifolds.emplace_back ();
 }
 
-std::vector<ContactManifold> &ContactManager::GetContactManifolds () noexcept
+void ContactManager::Append ( ContactManifold &contactManifold ) noexcept
 {
-    return _sets.front ().first;
+    ContactManifold &manifold = AllocateContactManifold ();
+    manifold._bodyA = std::move ( contactManifold._bodyA );
+    manifold._bodyB = std::move ( contactManifold._bodyB );
+    manifold._isRestored = contactManifold._isRestored;
+    manifold._epaSteps = contactManifold._epaSteps;
+    manifold._gjkSteps = contactManifold._gjkSteps;
+
+    Contact const* contacts = contactManifold._contacts;
+    size_t const count = contactManifold._contactCount;
+
+    for ( size_t i = 0U; i < count; ++i )
+        AllocateContact ( manifold ) = contacts[ i ];
+
+    Warm ( manifold );
 }
 
-std::vector<ContactManifold> const &ContactManager::GetContactManifolds () const noexcept
+void ContactManager::Advance ( float deltaTime ) noexcept
 {
-    return _sets.front ().first;
+    // Velocities are the ones which were used by the integration. Note the integration already moved the centers of
+    // mass. So the arms are restored relative to the previous locations.
+    auto move = [ deltaTime ] ( GXVec3 &point, RigidBody const &body ) noexcept -> GXVec3 {
+        GXVec3 const &velocityLinear = body.GetVelocityLinear ();
+
+        GXVec3 center {};
+        center.Sum ( body.GetLocation (), -deltaTime, velocityLinear );
+
+        GXVec3 r {};
+        r.Subtract ( point, center );
+
+        GXVec3 rotation {};
+        rotation.CrossProduct ( body.GetVelocityAngular (), r );
+
+        GXVec3 displacement {};
+        displacement.Sum ( velocityLinear, rotation );
+        displacement.Multiply ( displacement, deltaTime );
+
+        point.Sum ( point, displacement );
+        return displacement;
+    };
+
+    for ( auto &manifold : _sets.front ().first )
+    {
+        RigidBody const &bodyA = *manifold._bodyA;
+        RigidBody const &bodyB = *manifold._bodyB;
+        Contact* contacts = manifold._contacts;
+
+        for ( size_t i = 0U; i < manifold._contactCount; ++i )
+        {
+            Contact &contact = contacts[ i ];
+            GXVec3 const displacementA = move ( contact._pointA, bodyA );
+            GXVec3 const displacementB = move ( contact._pointB, bodyB );
+
+            GXVec3 relative {};
+            relative.Subtract ( displacementB, displacementA );
+            contact._penetration -= contact._normal.DotProduct ( relative );
+        }
+    }
 }
 
-void ContactManager::RemoveOutdatedWarmRecords () noexcept
+bool ContactManager::RestoreManifold ( ContactManager &target,
+    RigidBodyRef const &a,
+    RigidBodyRef const &b
+) const noexcept
 {
-    auto const end = _warmStartMapper.end ();
+    ContactCache::Record const* record = _contactCache.Find ( a.get (), b.get () );
+
+    if ( !record || record->_contactCount == 0U )
+        return false;
+
+    bool const isSwapped = record->_bodyA != a.get ();
+    RigidBodyRef const &refA = isSwapped ? b : a;
+    RigidBodyRef const &refB = isSwapped ? a : b;
+
+    RigidBody &bodyA = *refA;
+    RigidBody &bodyB = *refB;
+
+    Shape const &shapeA = bodyA.GetShape ();
+    Shape const &shapeB = bodyB.GetShape ();
+
+    if ( &shapeA != record->_shapeA || &shapeB != record->_shapeB ) [[unlikely]]
+        return false;
+
+    if ( !( shapeA.GetCollisionGroups () & shapeB.GetCollisionGroups () ) ) [[unlikely]]
+        return false;
+
+    GXMat4 const &transformA = bodyA.GetTransform ();
+    GXMat4 const &transformB = bodyB.GetTransform ();
+
+    GXMat4 inverseA {};
+    inverseA.Inverse ( transformA );
+
+    GXMat4 relative {};
+    relative.Multiply ( transformB, inverseA );
 
-    for ( auto i = _warmStartMapper.begin (); i != end; )
+    if ( !IsSimilarTransform ( relative, record->_relative ) )
+        return false;
+
+    size_t const count = record->_contactCount;
+    ContactCache::CachedContact const* cachedContacts = record->_contacts;
+
+    GXVec3 pointsA[ ContactCache::MAX_CONTACTS ];
+    GXVec3 pointsB[ ContactCache::MAX_CONTACTS ];
+    GXVec3 normals[ ContactCache::MAX_CONTACTS ];
+    float penetrations[ ContactCache::MAX_CONTACTS ];
+
+    for ( size_t i = 0U; i < count; ++i )
     {
-        ContactManifold &manifold = *i->second;
+        ContactCache::CachedContact const &cached = cachedContacts[ i ];
+        transformA.MultiplyAsPoint ( pointsA[ i ], cached._localA );
+        transformB.MultiplyAsPoint ( pointsB[ i ], cached._localB );
+        transformA.MultiplyAsNormal ( normals[ i ], cached._normal );
 
-        if ( !manifold._warmStartIsUsed )
+        GXVec3 ba {};
+        ba.Subtract ( pointsA[ i ], pointsB[ i ] );
+        penetrations[ i ] = cached._depthSign * normals[ i ].DotProduct ( ba );
+
+        // The contact point does not penetrate anymore. Narrowphase must decide what happens with the pair.
+        if ( penetrations[ i ] <= 0.0F )
         {
-            i = _warmStartMapper.erase ( i );
-            continue;
+            return false;
         }
+    }
+
+    ContactManifold &manifold = target.AllocateContactManifold ();
+    manifold._bodyA = refA;
+    manifold._bodyB = refB;
+    manifold._isRestored = true;
 
-        manifold._warmStartIsUsed = false;
-        ++i;
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        ContactCache::CachedContact const &cached = cachedContacts[ i ];
+        Contact &contact = target.AllocateContact ( manifold );
+
+        contact._pointA = pointsA[ i ];
+        contact._pointB = pointsB[ i ];
+        contact._penetration = penetrations[ i ];
+        contact._feature = cached._feature;
+        contact._friction = cached._friction;
+        contact._restitution = cached._restitution;
+        contact._normal = normals[ i ];
+        transformA.MultiplyAsNormal ( contact._tangent, cached._tangent );
+        transformA.MultiplyAsNormal ( contact._bitangent, cached._bitangent );
     }
+
+    target.Warm ( manifold );
+    return true;
 }
 
-void ContactManager::Reset () noexcept
+std::vector<ContactManifold> &ContactManager::GetContactManifolds () noexcept
 {
-    SwapSets ();
-    ResetFrontSet ();
-    RemoveOutdatedWarmRecords ();
+    return _sets.front ().first;
 }
 
-void ContactManager::Warm ( ContactManifold &manifold ) noexcept
+std::vector<ContactManifold> const &ContactManager::GetContactManifolds () const noexcept
 {
-    if ( manifold._contactCount > 4U )
-        SimplifyManifold ( manifold );
+    return _sets.front ().first;
+}
 
-    Key const key = std::make_pair ( manifold._bodyA.get (), manifold._bodyB.get () );
-    auto findResult = _warmStartMapper.find ( key );
-    auto const end = _warmStartMapper.end ();
+void ContactManager::GrowContactManifolds () noexcept
+{
+    std::vector<ContactManifold> &contactManifolds = _sets.front ().first;
 
-    if ( findResult == end )
+    std::vector<ContactManifold> grown {};
+    grown.reserve ( std::max ( contactManifolds.capacity () * 2U, INITIAL_CONTACT_MANIFOLDS ) );
+    std::move ( contactManifolds.begin (), contactManifolds.end (), std::back_inserter ( grown ) );
+
+    ContactManifold const* oldBegin = contactManifolds.data ();
+    ContactManifold const* oldEnd = oldBegin + contactManifolds.size ();
+    ContactManifold* newBegin = grown.data ();
+    constexpr std::less<ContactManifold const*> less {};
+
+    // Contact cache records could reference manifolds from current step. Those records must be rebased.
+    for ( ContactCache::Record &record : _contactCache.GetRecords () )
     {
-        findResult = _warmStartMapper.find ( std::make_pair ( key.second, key.first ) );
+        ContactManifold* &manifold = record._manifold;
 
-        if ( findResult == end )
+        if ( !less ( manifold, oldBegin ) && less ( manifold, oldEnd ) )
         {
-            _warmStartMapper.emplace ( key, &manifold );
-            return;
+            manifold = newBegin + ( manifold - oldBegin );
         }
     }
 
-    ContactManifold const &cache = *findResult->second;
-    Contact const* cacheContacts = cache._contacts;
+    contactManifolds.swap ( grown );
+}
 
-    _indices.clear ();
-    _indices.resize ( cache._contactCount );
-    std::iota ( _indices.begin (), _indices.end (), 0U );
+void ContactManager::GrowContacts () noexcept
+{
+    auto &[contactManifolds, contacts] = _sets.front ();
 
-    size_t const contactCount = manifold._contactCount;
-    Contact* contacts = manifold._contacts;
+    std::vector<Contact> grown {};
+    grown.reserve ( std::max ( contacts.capacity () * 2U, INITIAL_CONTACTS ) );
+    grown.assign ( contacts.cbegin (), contacts.cend () );
 
-    for ( size_t i = 0U; i < contactCount; ++i )
-    {
-        Contact &contact = contacts[ i ];
+    Contact const* oldBegin = contacts.data ();
+    Contact* newBegin = grown.data ();
 
-        for ( auto cacheIndex = _indices.begin (); cacheIndex != _indices.end (); )
+    for ( auto &manifold : contactManifolds )
+    {
+        if ( manifold._contacts )
         {
-            size_t &ind = *cacheIndex;
-            Contact const &cacheContact = cacheContacts[ ind ];
+            manifold._contacts = newBegin + ( manifold._contacts - oldBegin );
+        }
+    }
 
-            // Note this is rough approximation. Main assumption that both contact point pairs on previous step and
-            // current step are relatively close to each other but relative far away from another pairs in
-            // the same manifold. So only one distance estimation is enough.
+    contacts.swap ( grown );
+}
 
-            if ( contact._pointA.SquaredDistance ( cacheContact._pointA ) > WARM_FINDER_FACTOR )
-            {
-                ++cacheIndex;
-                continue;
-            }
+void ContactManager::Reset () noexcept
+{
+    SwapSets ();
+    ResetFrontSet ();
+    _contactCache.RemoveUnused ();
+}
 
-            // Note: it seems that the solution is more stable without lambda reprojection to the new basis.
+void ContactManager::Warm ( ContactManifold &manifold ) noexcept
+{
+    if ( manifold._contactCount > 4U )
+        SimplifyManifold ( manifold );
 
-            GXVec3 lambda {};
+    if ( !_isWarmStartEnabled )
+        return;
 
-            lambda.Multiply (
-                GXVec3 ( cacheContact._dataT._lambda, cacheContact._dataB._lambda, cacheContact._dataN._lambda ),
-                WARM_TRANSFER_FACTOR
-            );
+    auto const [record, isNew] = _contactCache.Obtain ( manifold._bodyA.get (), manifold._bodyB.get () );
+    record->_isUsed = true;
 
-            contact._dataT._lambda = lambda._data[ 0U ];
-            contact._dataB._lambda = lambda._data[ 1U ];
-            contact._dataN._lambda = lambda._data[ 2U ];
-            contact._warmStarted = true;
+    // Restored manifold must not refresh the snapshot. Otherwise the bodies could drift away from the last
+    // narrowphase result step by step.
+    if ( !manifold._isRestored )
+        UpdateSnapshot ( *record, manifold );
 
-            ind = _indices.back ();
-            _indices.pop_back ();
-            break;
-        }
-    }
+    if ( !isNew )
+        WarmStart ( manifold, *record->_manifold );
 
-    findResult->second = &manifold;
+    record->_manifold = &manifold;
 }
 
 void ContactManager::ResetFrontSet () noexcept
@@ -375,4 +540,123 @@ void ContactManager::SwapSets () noexcept
     backContacts.swap ( frontContacts );
 }
 
+void ContactManager::WarmStart ( ContactManifold &manifold, ContactManifold const &cache ) noexcept
+{
+    Contact const* cacheContacts = cache._contacts;
+
+    _indices.clear ();
+    _indices.resize ( cache._contactCount );
+    std::iota ( _indices.begin (), _indices.end (), 0U );
+
+    size_t const contactCount = manifold._contactCount;
+    Contact* contacts = manifold._contacts;
+
+    auto transfer = [ & ] ( Contact &contact, std::vector<size_t>::iterator cacheIndex ) noexcept {
+        Contact const &cacheContact = cacheContacts[ *cacheIndex ];
+
+        // Note: it seems that the solution is more stable without lambda reprojection to the new basis.
+
+        GXVec3 lambda {};
+
+        lambda.Multiply (
+            GXVec3 ( cacheContact._dataT._lambda, cacheContact._dataB._lambda, cacheContact._dataN._lambda ),
+            WARM_TRANSFER_FACTOR
+        );
+
+        contact._dataT._lambda = lambda._data[ 0U ];
+        contact._dataB._lambda = lambda._data[ 1U ];
+        contact._dataN._lambda = lambda._data[ 2U ];
+        contact._warmStarted = true;
+
+        *cacheIndex = _indices.back ();
+        _indices.pop_back ();
+    };
+
+    // Feature IDs are exact match. They are stable even if the contact point slides a bit.
+    for ( size_t i = 0U; i < contactCount; ++i )
+    {
+        Contact &contact = contacts[ i ];
+
+        for ( auto cacheIndex = _indices.begin (); cacheIndex != _indices.end (); ++cacheIndex )
+        {
+            if ( cacheContacts[ *cacheIndex ]._feature != contact._feature )
+                continue;
+
+            transfer ( contact, cacheIndex );
+            break;
+        }
+    }
+
+    // The rest of contacts could change features. For example the clipping polygon got another vertex order.
+    for ( size_t i = 0U; i < contactCount && !_indices.empty (); ++i )
+    {
+        Contact &contact = contacts[ i ];
+
+        if ( contact._warmStarted )
+            continue;
+
+        for ( auto cacheIndex = _indices.begin (); cacheIndex != _indices.end (); ++cacheIndex )
+        {
+            // Note this is rough approximation. Main assumption that both contact point pairs on previous step and
+            // current step are relatively close to each other but relative far away from another pairs in
+            // the same manifold. So only one distance estimation is enough.
+
+            if ( contact._pointA.SquaredDistance ( cacheContacts[ *cacheIndex ]._pointA ) > WARM_FINDER_FACTOR )
+                continue;
+
+            transfer ( contact, cacheIndex );
+            break;
+        }
+    }
+}
+
+void ContactManager::UpdateSnapshot ( ContactCache::Record &record, ContactManifold const &manifold ) noexcept
+{
+    AV_ASSERT ( manifold._contactCount <= ContactCache::MAX_CONTACTS )
+
+    RigidBody &bodyA = *manifold._bodyA;
+    RigidBody &bodyB = *manifold._bodyB;
+
+    GXMat4 const &transformA = bodyA.GetTransform ();
+    GXMat4 const &transformB = bodyB.GetTransform ();
+
+    GXMat4 inverseA {};
+    inverseA.Inverse ( transformA );
+
+    GXMat4 inverseB {};
+    inverseB.Inverse ( transformB );
+
+    record._bodyA = &bodyA;
+    record._bodyB = &bodyB;
+    record._shapeA = &bodyA.GetShape ();
+    record._shapeB = &bodyB.GetShape ();
+    record._relative.Multiply ( transformB, inverseA );
+
+    size_t const count = manifold._contactCount;
+    record._contactCount = count;
+    Contact const* contacts = manifold._contacts;
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        Contact const &contact = contacts[ i ];
+        ContactCache::CachedContact &cached = record._contacts[ i ];
+
+        inverseA.MultiplyAsPoint ( cached._localA, contact._pointA );
+        inverseB.MultiplyAsPoint ( cached._localB, contact._pointB );
+        inverseA.MultiplyAsNormal ( cached._tangent, contact._tangent );
+        inverseA.MultiplyAsNormal ( cached._bitangent, contact._bitangent );
+        inverseA.MultiplyAsNormal ( cached._normal, contact._normal );
+
+        // Speculative contact keeps negative depth after restoring. So it's never restored from the cache.
+        GXVec3 ba {};
+        ba.Subtract ( contact._pointA, contact._pointB );
+        bool const isNegative = contact._normal.DotProduct ( ba ) < 0.0F;
+        cached._depthSign = isNegative != ( contact._penetration < 0.0F ) ? -1.0F : 1.0F;
+
+        cached._feature = contact._feature;
+        cached._friction = contact._friction;
+        cached._restitution = contact._restitution;
+    }
+}
+
 } // namespace android_vulkan
@@ -34,6 +34,10 @@ Vertices const &CyrusBeck::Run ( Vertices const &face,
     float start = 0.0F;
     float end = 1.0F;
 
+    ContactFeature const edgeFeature = MakeContactFeature ( eContactFeature::IncidentEdge, 0U );
+    ContactFeature startFeature = MakeContactFeature ( eContactFeature::IncidentVertex, 0U );
+    ContactFeature endFeature = MakeContactFeature ( eContactFeature::IncidentVertex, 1U );
+
     for ( size_t i = 0U; i < facePoints; ++i )
     {
         GXVec3 const &aPoint = face[ i ];
@@ -65,18 +69,34 @@ Vertices const &CyrusBeck::Run ( Vertices const &face,
         //      "gamma" < 0.0: Need to work with the start point and take maximum in range [0.0, p]
         //      "gamma" >= 0.0: Need to work with the end point and take minimum in range [p, 1.0]
 
+        ContactFeature const sideFeature = CombineContactFeatures (
+            MakeContactFeature ( eContactFeature::ReferenceEdge, i ),
+            edgeFeature
+        );
+
         if ( gamma < 0.0F )
         {
-            start = std::max ( start, p );
+            if ( p > start )
+            {
+                start = p;
+                startFeature = sideFeature;
+            }
+
             continue;
         }
 
-        end = std::min ( end, p );
+        if ( p < end )
+        {
+            end = p;
+            endFeature = sideFeature;
+        }
     }
 
     _vertices.clear ();
     alpha.Sum ( edgeOrigin, start, edgeDir );
     _vertices.push_back ( alpha );
+    _features[ 0U ] = startFeature;
+    _features[ 1U ] = endFeature;
 
     if ( end - start < SAME_POINT_TOLERANCE )
     {
@@ -90,4 +110,9 @@ Vertices const &CyrusBeck::Run ( Vertices const &face,
     return _vertices;
 }
 
+ContactFeature CyrusBeck::GetFeature ( size_t point ) const noexcept
+{
+    return _features[ point ];
+}
+
 } // namespace android_vulkan
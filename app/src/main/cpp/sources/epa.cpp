@@ -1,23 +1,18 @@
 #include <precompiled_headers.hpp>
 #include <epa.hpp>
-#include <logger.hpp>
 
 
 namespace android_vulkan {
 
 namespace {
 
-constexpr size_t INITIAL_VERTICES = 1024U;
-constexpr size_t INITIAL_EDGES = INITIAL_VERTICES * 4U;
-constexpr size_t INITIAL_FACES = INITIAL_VERTICES * 4U;
-constexpr uint16_t MAXIMUM_STEPS = 16U;
 constexpr float TOLERANCE = 1.0e-3F;
 
 } // end of anonymous namespace
 
 //----------------------------------------------------------------------------------------------------------------------
 
-Face::Face ( size_t a, size_t b, size_t c, Vertices const &vertices ) noexcept:
+Face::Face ( uint8_t a, uint8_t b, uint8_t c, GXVec3 const* vertices ) noexcept:
     _a ( a ),
     _b ( b ),
     _c ( c ),
@@ -40,14 +35,16 @@ Face::Face ( size_t a, size_t b, size_t c, Vertices const &vertices ) noexcept:
 EPA::EPA () noexcept:
     _depth ( 0.0F ),
     _normal ( 1.0F, 0.0F, 0.0F ),
+    _edgeCount ( 0U ),
+    _faceCount ( 0U ),
+    _vertexCount ( 0U ),
     _edges {},
     _faces {},
     _vertices {},
+    _isApproximate ( false ),
     _steps ( 0U )
 {
-    _edges.reserve ( INITIAL_EDGES );
-    _faces.reserve ( INITIAL_FACES );
-    _vertices.reserve ( INITIAL_VERTICES );
+    // NOTHING
 }
 
 float EPA::GetDepth () const noexcept
@@ -67,24 +64,31 @@ uint16_t EPA::GetSteps () const noexcept
 
 uint16_t EPA::GetEdgeCount () const noexcept
 {
-    return static_cast<uint16_t> ( _edges.size () );
+    return static_cast<uint16_t> ( _edgeCount );
 }
 
 uint16_t EPA::GetFaceCount () const noexcept
 {
-    return static_cast<uint16_t> ( _faces.size () );
+    return static_cast<uint16_t> ( _faceCount );
 }
 
 uint16_t EPA::GetVertexCount () const noexcept
 {
-    return static_cast<uint16_t> ( _vertices.size () );
+    return static_cast<uint16_t> ( _vertexCount );
+}
+
+bool EPA::IsApproximate () const noexcept
+{
+    return _isApproximate;
 }
 
 void EPA::Reset () noexcept
 {
     _steps = 0U;
-    _vertices.clear ();
-    _faces.clear ();
+    _isApproximate = false;
+    _edgeCount = 0U;
+    _faceCount = 0U;
+    _vertexCount = 0U;
 }
 
 bool EPA::Run ( Simplex const &simplex, Shape const &shapeA, Shape const &shapeB ) noexcept
@@ -92,35 +96,36 @@ bool EPA::Run ( Simplex const &simplex, Shape const &shapeA, Shape const &shapeB
     CreatePolytope ( simplex );
     auto [closestFace, distance] = FindClosestFace ();
 
-    for ( ; _steps < MAXIMUM_STEPS; ++_steps )
+    for ( ; ; ++_steps )
     {
         Face const &face = _faces[ closestFace ];
-        GXVec3 const supportPoint = Shape::FindSupportPoint ( face._normal, shapeA, shapeB );
 
-        GXVec3 sp {};
-        sp.Multiply ( supportPoint, 1.0e+3F );
+        // The closest face is the best known estimation. It's reported as is if the polytope can't be expanded.
+        _normal = face._normal;
+        _depth = distance;
+
+        if ( _steps == MAX_STEPS )
+            break;
+
+        GXVec3 const supportPoint = Shape::FindSupportPoint ( face._normal, shapeA, shapeB );
 
         if ( std::abs ( face._normal.DotProduct ( supportPoint ) - distance ) < TOLERANCE )
-        {
-            _normal = face._normal;
-            _depth = distance;
             return true;
-        }
 
         // Note we don't care about unused vertices which could be produced while polytope reconstruction process.
         // So the algorithm is greedy in terms of memory consumption.
         // But same time it doesn't require to remove unused vertices and adjust indices inside Face data structures.
 
-        _edges.clear ();
+        _edgeCount = 0U;
 
         // Optimization: While traversing through all faces we could collect the closest back facing one for free.
         // This will allow to reduce computation amount later. The idea is to find the closest face in the list
         // of new faces. And then to compare this face with the closest back facing one.
 
         distance = FLT_MAX;
-        GXVec3 const removeNormal = face._normal;
+        bool isOverflow = false;
 
-        for ( size_t i = 0U; i < _faces.size (); )
+        for ( size_t i = 0U; i < _faceCount; )
         {
             Face &f = _faces[ i ];
 
@@ -131,15 +136,14 @@ bool EPA::Run ( Simplex const &simplex, Shape const &shapeA, Shape const &shapeB
             {
                 // Front facing face.
 
-                SolveEdge ( f._a, f._b );
-                SolveEdge ( f._b, f._c );
-                SolveEdge ( f._c, f._a );
+                isOverflow |= !SolveEdge ( f._a, f._b );
+                isOverflow |= !SolveEdge ( f._b, f._c );
+                isOverflow |= !SolveEdge ( f._c, f._a );
 
                 // Remove face "f" from "_faces" by moving last face in the "_faces" to place where "f" is.
                 // Note the "i" must not change because target face will be just moved one.
                 // If the face to remove is the last one this algorithm will work as well.
-                f = _faces.back ();
-                _faces.pop_back ();
+                f = _faces[ --_faceCount ];
                 continue;
             }
 
@@ -157,20 +161,32 @@ bool EPA::Run ( Simplex const &simplex, Shape const &shapeA, Shape const &shapeB
         }
 
         // Right now "_faces" contains only back facing faces.
-        size_t backFacingFaces = _faces.size ();
+        size_t const backFacingFaces = _faceCount;
 
         // Also "_edges" contains only edges from which could be safely created new faces with
         // the "supportPoint" vertex.
 
-        size_t const edgeCount = _edges.size ();
+        if ( backFacingFaces + _edgeCount == 0U ) [[unlikely]]
+        {
+            // Degenerate polytope. All faces are visible from the support point and there is no horizon.
+            return false;
+        }
 
-        size_t const idx = _vertices.size ();
-        _vertices.push_back ( supportPoint );
+        if ( isOverflow || backFacingFaces + _edgeCount > MAX_FACES ) [[unlikely]]
+        {
+            // Numerical issues produced non convex horizon. The estimation of the current step is kept.
+            _isApproximate = true;
+            return true;
+        }
+
+        auto const idx = static_cast<uint8_t> ( _vertexCount );
+        _vertices[ _vertexCount++ ] = supportPoint;
+        GXVec3 const* vertices = _vertices.data ();
 
-        for ( size_t i = 0U; i < edgeCount; ++i )
+        for ( size_t i = 0U; i < _edgeCount; ++i )
         {
             Edge const &edge = _edges[ i ];
-            Face const &f = _faces.emplace_back ( edge.first, edge.second, idx, _vertices );
+            Face const &f = _faces[ _faceCount++ ] = Face ( edge.first, edge.second, idx, vertices );
             float const d = f._normal.DotProduct ( _vertices[ f._a ] );
 
             if ( d >= distance )
@@ -182,20 +198,8 @@ bool EPA::Run ( Simplex const &simplex, Shape const &shapeA, Shape const &shapeB
         }
     }
 
-#ifdef AV_DEBUG
-
-    constexpr char const format[] =
-R"__(EPA::Run - Algorithm exceeded maximum steps. Counters:
-    _steps: %hu
-    vertices: %zu
-    faces: %zu
-    edges: %zu)__";
-
-    LogWarning ( format, _steps, _vertices.size (), _faces.size (), _edges.size () );
-
-#endif // AV_DEBUG
-
-    return false;
+    _isApproximate = true;
+    return true;
 }
 
 void EPA::CreatePolytope ( Simplex const &simplex ) noexcept
@@ -214,50 +218,60 @@ void EPA::CreatePolytope ( Simplex const &simplex ) noexcept
     // For example triangle "xyz". "x", "y" and "z" must be specified such way that "xy" x "xz" will give us the normal
     // outside the origin.
 
-    _vertices.push_back ( simplex._supportPoints[ 0U ] );
-    _vertices.push_back ( simplex._supportPoints[ 1U ] );
-    _vertices.push_back ( simplex._supportPoints[ 2U ] );
-    _vertices.push_back ( simplex._supportPoints[ 3U ] );
+    _vertices[ 0U ] = simplex._supportPoints[ 0U ];
+    _vertices[ 1U ] = simplex._supportPoints[ 1U ];
+    _vertices[ 2U ] = simplex._supportPoints[ 2U ];
+    _vertices[ 3U ] = simplex._supportPoints[ 3U ];
+    _vertexCount = 4U;
+
+    GXVec3 const* vertices = _vertices.data ();
 
     // "bdc"
-    _faces.emplace_back ( 1U, 3U, 2U, _vertices );
+    _faces[ 0U ] = Face ( 1U, 3U, 2U, vertices );
 
     // "adb"
-    _faces.emplace_back ( 0U, 3U, 1U, _vertices );
+    _faces[ 1U ] = Face ( 0U, 3U, 1U, vertices );
 
     // "acd"
-    _faces.emplace_back ( 0U, 2U, 3U, _vertices );
+    _faces[ 2U ] = Face ( 0U, 2U, 3U, vertices );
 
     // "abc"
-    _faces.emplace_back ( 0U, 1U, 2U, _vertices );
+    _faces[ 3U ] = Face ( 0U, 1U, 2U, vertices );
+
+    _faceCount = 4U;
 }
 
-void EPA::SolveEdge ( size_t a, size_t b ) noexcept
+bool EPA::SolveEdge ( uint8_t a, uint8_t b ) noexcept
 {
     // The edge "ab" must be appended if there is no "ba" version in the "_edges".
     // Otherwise "ab" edge must be removed from "_edges".
 
-    auto findResult = std::find ( _edges.begin (), _edges.end (), std::make_pair ( b, a ) );
+    auto const begin = _edges.begin ();
+    auto const end = begin + static_cast<std::ptrdiff_t> ( _edgeCount );
+    auto findResult = std::find ( begin, end, std::make_pair ( b, a ) );
 
-    if ( findResult == _edges.end() )
+    if ( findResult == end )
     {
+        if ( _edgeCount == MAX_EDGES ) [[unlikely]]
+            return false;
+
         // There is no "ba" version. So append the edge "ab".
-        _edges.emplace_back ( a, b );
-        return;
+        _edges[ _edgeCount++ ] = std::make_pair ( a, b );
+        return true;
     }
 
     // Edge "ba" was found. Remove it by moving last edge to "ba" place.
     // If "ba" edge is the last one this algorithm will work as well.
-    *findResult = _edges.back ();
-    _edges.pop_back ();
+    *findResult = _edges[ --_edgeCount ];
+    return true;
 }
 
-EPA::FindResult EPA::FindClosestFace () noexcept
+EPA::FindResult EPA::FindClosestFace () const noexcept
 {
     GXVec3 const* vertices = _vertices.data ();
 
     Face const* faces = _faces.data ();
-    size_t const faceCount = _faces.size ();
+    size_t const faceCount = _faceCount;
 
     Face const &firstFace = faces[ 0U ];
 
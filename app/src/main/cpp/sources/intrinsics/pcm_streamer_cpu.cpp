@@ -8,6 +8,18 @@ namespace android_vulkan {
 namespace {
 
 constexpr auto DENOMINATOR = static_cast<int32_t> ( PCMStreamer::INTEGER_DIVISION_SCALE );
+constexpr auto PCM_MAX = static_cast<int32_t> ( std::numeric_limits<PCMStreamer::PCMType>::max () );
+constexpr auto PCM_MIN = static_cast<int32_t> ( std::numeric_limits<PCMStreamer::PCMType>::min () );
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// Several streamers are mixed into the same buffer. The sum is saturated because clipping is much less audible than
+// integer wrap around.
+[[nodiscard]] PCMStreamer::PCMType Accumulate ( PCMStreamer::PCMType target, int32_t sample ) noexcept
+{
+    int32_t const sum = static_cast<int32_t> ( target ) + sample;
+    return static_cast<PCMStreamer::PCMType> ( std::clamp ( sum, PCM_MIN, PCM_MAX ) );
+}
 
 } // end of anonymous namespace
 
@@ -43,8 +55,8 @@ void PCMStreamer::HandleLoopedMono ( std::span<PCMType> buffer,
         size_t const rightIdx = leftIdx + 1U;
 
         auto const sample = static_cast<int32_t> ( pcm[ i ] );
-        target[ leftIdx ] = static_cast<PCMType> ( sample * l / DENOMINATOR );
-        target[ rightIdx ] = static_cast<PCMType> ( sample * r / DENOMINATOR );
+        target[ leftIdx ] = Accumulate ( target[ leftIdx ], sample * l / DENOMINATOR );
+        target[ rightIdx ] = Accumulate ( target[ rightIdx ], sample * r / DENOMINATOR );
     }
 
     _offset = restInPCMSamples;
@@ -80,8 +92,8 @@ void PCMStreamer::HandleLoopedStereo ( std::span<PCMType> buffer,
         auto const leftSample = static_cast<int32_t> ( pcm[ i ] );
         auto const rightSample = static_cast<int32_t> ( pcm[ rightIdx ] );
 
-        target[ i ] = static_cast<PCMType> ( leftSample * l / DENOMINATOR );
-        target[ rightIdx ] = static_cast<PCMType> ( rightSample * r / DENOMINATOR );
+        target[ i ] = Accumulate ( target[ i ], leftSample * l / DENOMINATOR );
+        target[ rightIdx ] = Accumulate ( target[ rightIdx ], rightSample * r / DENOMINATOR );
     }
 
     _offset = rest;
@@ -112,8 +124,8 @@ PCMStreamer::Consume PCMStreamer::HandleMono ( std::span<PCMType> buffer,
 
         auto const sample = static_cast<int32_t> ( pcm[ i ] );
 
-        buffer[ leftIdx ] = static_cast<PCMType> ( sample * l / DENOMINATOR );
-        buffer[ rightIdx ] = static_cast<PCMType> ( sample * r / DENOMINATOR );
+        buffer[ leftIdx ] = Accumulate ( buffer[ leftIdx ], sample * l / DENOMINATOR );
+        buffer[ rightIdx ] = Accumulate ( buffer[ rightIdx ], sample * r / DENOMINATOR );
     }
 
     int32_t const alpha = static_cast<int32_t> ( canRead ) * DENOMINATOR / static_cast<int32_t> ( bufferFrames );
@@ -153,8 +165,8 @@ PCMStreamer::Consume PCMStreamer::HandleStereo ( std::span<PCMType> buffer,
         auto const leftSample = static_cast<int32_t> ( pcm[ i ] );
         auto const rightSample = static_cast<int32_t> ( pcm[ rightIdx ] );
 
-        buffer[ i ] = static_cast<PCMType> ( leftSample * l / DENOMINATOR );
-        buffer[ rightIdx ] = static_cast<PCMType> ( rightSample * r / DENOMINATOR );
+        buffer[ i ] = Accumulate ( buffer[ i ], leftSample * l / DENOMINATOR );
+        buffer[ rightIdx ] = Accumulate ( buffer[ rightIdx ], rightSample * r / DENOMINATOR );
     }
 
     int32_t const alpha = static_cast<int32_t> ( canRead ) * DENOMINATOR / static_cast<int32_t> ( bufferSamples );
@@ -33,8 +33,9 @@ class NeonConverter final
 
         ~NeonConverter () = delete;
 
+        // The methods add the result to the target content with saturation. See PCMStreamer::GetNextBuffer.
         static void Convert ( PCMStreamer::PCMType* target,
-            int32_t* scratchPad,
+            int32_t const* scratchPad,
             int32x4_t const &nominator,
             int32x4_t const &correction
         ) noexcept;
@@ -79,7 +80,7 @@ class NeonConverter final
 };
 
 void NeonConverter::Convert ( PCMStreamer::PCMType* target,
-    int32_t* scratchPad,
+    int32_t const* scratchPad,
     int32x4_t const &nominator,
     int32x4_t const &correction
 ) noexcept
@@ -97,20 +98,18 @@ void NeonConverter::Convert ( PCMStreamer::PCMType* target,
     int32x4_t const t1 = NeonConverter::Divide ( a1, correction );
     int32x4_t const a2 = vmulq_s32 ( s2, nominator );
 
-    vst1q_s32 ( scratchPad, t0 );
+    int16x8_t const m0 = vld1q_s16 ( target );
     int32x4_t const a3 = vmulq_s32 ( s3, nominator );
 
-    vst1q_s32 ( scratchPad + 4U, t1 );
+    int16x8_t const c0 = vcombine_s16 ( vmovn_s32 ( t0 ), vmovn_s32 ( t1 ) );
     int32x4_t const t2 = NeonConverter::Divide ( a2, correction );
 
+    int16x8_t const m1 = vld1q_s16 ( target + 8U );
     int32x4_t const t3 = NeonConverter::Divide ( a3, correction );
-    vst1q_s32 ( scratchPad + 8U, t2 );
-    vst1q_s32 ( scratchPad + 12U, t3 );
 
-    for ( size_t idx = 0U; idx < STEREO_SAMPLES_PER_BATCH; ++idx )
-    {
-        target[ idx ] = static_cast<PCMStreamer::PCMType>( scratchPad[ idx ] );
-    }
+    vst1q_s16 ( target, vqaddq_s16 ( m0, c0 ) );
+    int16x8_t const c1 = vcombine_s16 ( vmovn_s32 ( t2 ), vmovn_s32 ( t3 ) );
+    vst1q_s16 ( target + 8U, vqaddq_s16 ( m1, c1 ) );
 }
 
 void NeonConverter::Convert ( PCMStreamer::PCMType* target,
@@ -130,8 +129,8 @@ void NeonConverter::Convert ( PCMStreamer::PCMType* target,
     int32x2_t const n = vadd_s32 ( vget_high_s32 ( before ), Divide ( alpha, correction ) );
 
     vst1_s32 ( data, NeonConverter::Divide ( vmul_s32 ( s, n ), correction ) );
-    target[ 0U ] = static_cast<PCMStreamer::PCMType> ( data[ 0U ] );
-    target[ 1U ] = static_cast<PCMStreamer::PCMType> ( data[ 1U ] );
+    target[ 0U ] = vqaddh_s16 ( target[ 0U ], static_cast<PCMStreamer::PCMType> ( data[ 0U ] ) );
+    target[ 1U ] = vqaddh_s16 ( target[ 1U ], static_cast<PCMStreamer::PCMType> ( data[ 1U ] ) );
 }
 
 int32x4_t NeonConverter::MakeBeforeFactor ( int32_t leftBefore, int32_t rightBefore ) noexcept
@@ -227,7 +226,7 @@ void PCMStreamer::HandleLoopedMono ( std::span<PCMType> buffer,
     {
         int32x4_t const nominator = NeonConverter::MakeNominator ( before, diff, correction, i * aFactor, restSamples );
 
-        int32_t scratchPad[] =
+        int32_t const scratchPad[] =
         {
             source[ 0U ], source[ 0U ], source[ 1U ], source[ 1U ],
             source[ 2U ], source[ 2U ], source[ 3U ], source[ 3U ],
@@ -279,7 +278,7 @@ void PCMStreamer::HandleLoopedStereo ( std::span<PCMType> buffer,
     {
         int32x4_t const nominator = NeonConverter::MakeNominator ( before, diff, correction, i * aFactor, restSamples );
 
-        int32_t scratchPad[] =
+        int32_t const scratchPad[] =
         {
             source[ 0U ], source[ 1U ], source[ 2U ], source[ 3U ],
             source[ 4U ], source[ 5U ], source[ 6U ], source[ 7U ],
@@ -337,7 +336,7 @@ PCMStreamer::Consume PCMStreamer::HandleMono ( std::span<PCMType> buffer,
     {
         int32x4_t const nominator = NeonConverter::MakeNominator ( before, diff, correction, i * aFactor, s );
 
-        int32_t scratchPad[] =
+        int32_t const scratchPad[] =
         {
             source[ 0U ], source[ 0U ], source[ 1U ], source[ 1U ],
             source[ 2U ], source[ 2U ], source[ 3U ], source[ 3U ],
@@ -394,7 +393,7 @@ PCMStreamer::Consume PCMStreamer::HandleStereo ( std::span<PCMType> buffer,
     {
         int32x4_t const nominator = NeonConverter::MakeNominator ( before, diff, correction, i * aFactor, s );
 
-        int32_t scratchPad[] =
+        int32_t const scratchPad[] =
         {
             source[ 0U ], source[ 1U ], source[ 2U ], source[ 3U ],
             source[ 4U ], source[ 5U ], source[ 6U ], source[ 7U ],
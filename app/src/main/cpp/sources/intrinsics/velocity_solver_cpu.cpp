@@ -0,0 +1,49 @@
+#include <precompiled_headers.hpp>
+#include <velocity_solver.hpp>
+
+
+namespace android_vulkan {
+
+void VelocitySolver::SolveNormalBatch ( NormalBatch &batch,
+    GXVec6 const &vwA,
+    GXVec6 const &vwB,
+    GXVec6 &deltaA,
+    GXVec6 &deltaB
+) noexcept
+{
+    float lambdaDelta[ BATCH_LANES ];
+
+    for ( size_t lane = 0U; lane < BATCH_LANES; ++lane )
+    {
+        float d = 0.0F;
+
+        for ( size_t i = 0U; i < 6U; ++i )
+            d += batch._j[ 0U ][ i ][ lane ] * vwA._data[ i ] + batch._j[ 1U ][ i ][ lane ] * vwB._data[ i ];
+
+        float const b = batch._stabilization[ lane ] +
+            std::max ( batch._restitution[ lane ] * d + batch._restitutionBias[ lane ], 0.0F );
+
+        float const oldLambda = batch._lambda[ lane ];
+        float const lambda = std::max ( 0.0F, oldLambda + batch._effectiveMass[ lane ] * ( d + b ) );
+
+        batch._lambda[ lane ] = lambda;
+        lambdaDelta[ lane ] = lambda - oldLambda;
+    }
+
+    for ( size_t i = 0U; i < 6U; ++i )
+    {
+        float a = 0.0F;
+        float b = 0.0F;
+
+        for ( size_t lane = 0U; lane < BATCH_LANES; ++lane )
+        {
+            a += lambdaDelta[ lane ] * batch._mj[ 0U ][ i ][ lane ];
+            b += lambdaDelta[ lane ] * batch._mj[ 1U ][ i ][ lane ];
+        }
+
+        deltaA._data[ i ] = a;
+        deltaB._data[ i ] = b;
+    }
+}
+
+} // namespace android_vulkan
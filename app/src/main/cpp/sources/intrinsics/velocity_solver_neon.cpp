@@ -0,0 +1,45 @@
+#include <precompiled_headers.hpp>
+#include <velocity_solver.hpp>
+
+
+namespace android_vulkan {
+
+void VelocitySolver::SolveNormalBatch ( NormalBatch &batch,
+    GXVec6 const &vwA,
+    GXVec6 const &vwB,
+    GXVec6 &deltaA,
+    GXVec6 &deltaB
+) noexcept
+{
+    float32x4_t d = vdupq_n_f32 ( 0.0F );
+
+    for ( size_t i = 0U; i < 6U; ++i )
+    {
+        d = vfmaq_n_f32 ( d, vld1q_f32 ( batch._j[ 0U ][ i ] ), vwA._data[ i ] );
+        d = vfmaq_n_f32 ( d, vld1q_f32 ( batch._j[ 1U ][ i ] ), vwB._data[ i ] );
+    }
+
+    float32x4_t const zero = vdupq_n_f32 ( 0.0F );
+
+    float32x4_t const restitution = vfmaq_f32 ( vld1q_f32 ( batch._restitutionBias ),
+        vld1q_f32 ( batch._restitution ),
+        d
+    );
+
+    float32x4_t const b = vaddq_f32 ( vld1q_f32 ( batch._stabilization ), vmaxq_f32 ( restitution, zero ) );
+    float32x4_t const l = vmulq_f32 ( vld1q_f32 ( batch._effectiveMass ), vaddq_f32 ( d, b ) );
+
+    float32x4_t const oldLambda = vld1q_f32 ( batch._lambda );
+    float32x4_t const lambda = vmaxq_f32 ( zero, vaddq_f32 ( oldLambda, l ) );
+    vst1q_f32 ( batch._lambda, lambda );
+
+    float32x4_t const lambdaDelta = vsubq_f32 ( lambda, oldLambda );
+
+    for ( size_t i = 0U; i < 6U; ++i )
+    {
+        deltaA._data[ i ] = vaddvq_f32 ( vmulq_f32 ( lambdaDelta, vld1q_f32 ( batch._mj[ 0U ][ i ] ) ) );
+        deltaB._data[ i ] = vaddvq_f32 ( vmulq_f32 ( lambdaDelta, vld1q_f32 ( batch._mj[ 1U ][ i ] ) ) );
+    }
+}
+
+} // namespace android_vulkan
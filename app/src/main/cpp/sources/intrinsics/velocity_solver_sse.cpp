@@ -0,0 +1,63 @@
+#include <precompiled_headers.hpp>
+#include <velocity_solver.hpp>
+
+GX_DISABLE_COMMON_WARNINGS
+
+#include <xmmintrin.h>
+
+GX_RESTORE_WARNING_STATE
+
+
+namespace android_vulkan {
+
+namespace {
+
+[[nodiscard]] float HorizontalSum ( __m128 v ) noexcept
+{
+    __m128 const high = _mm_movehl_ps ( v, v );
+    __m128 const pair = _mm_add_ps ( v, high );
+    return _mm_cvtss_f32 ( _mm_add_ss ( pair, _mm_shuffle_ps ( pair, pair, _MM_SHUFFLE ( 1, 1, 1, 1 ) ) ) );
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void VelocitySolver::SolveNormalBatch ( NormalBatch &batch,
+    GXVec6 const &vwA,
+    GXVec6 const &vwB,
+    GXVec6 &deltaA,
+    GXVec6 &deltaB
+) noexcept
+{
+    __m128 d = _mm_setzero_ps ();
+
+    for ( size_t i = 0U; i < 6U; ++i )
+    {
+        d = _mm_add_ps ( d, _mm_mul_ps ( _mm_load_ps ( batch._j[ 0U ][ i ] ), _mm_set1_ps ( vwA._data[ i ] ) ) );
+        d = _mm_add_ps ( d, _mm_mul_ps ( _mm_load_ps ( batch._j[ 1U ][ i ] ), _mm_set1_ps ( vwB._data[ i ] ) ) );
+    }
+
+    __m128 const zero = _mm_setzero_ps ();
+
+    __m128 const restitution = _mm_add_ps ( _mm_mul_ps ( _mm_load_ps ( batch._restitution ), d ),
+        _mm_load_ps ( batch._restitutionBias )
+    );
+
+    __m128 const b = _mm_add_ps ( _mm_load_ps ( batch._stabilization ), _mm_max_ps ( restitution, zero ) );
+    __m128 const l = _mm_mul_ps ( _mm_load_ps ( batch._effectiveMass ), _mm_add_ps ( d, b ) );
+
+    __m128 const oldLambda = _mm_load_ps ( batch._lambda );
+    __m128 const lambda = _mm_max_ps ( zero, _mm_add_ps ( oldLambda, l ) );
+    _mm_store_ps ( batch._lambda, lambda );
+
+    __m128 const lambdaDelta = _mm_sub_ps ( lambda, oldLambda );
+
+    for ( size_t i = 0U; i < 6U; ++i )
+    {
+        deltaA._data[ i ] = HorizontalSum ( _mm_mul_ps ( lambdaDelta, _mm_load_ps ( batch._mj[ 0U ][ i ] ) ) );
+        deltaB._data[ i ] = HorizontalSum ( _mm_mul_ps ( lambdaDelta, _mm_load_ps ( batch._mj[ 1U ][ i ] ) ) );
+    }
+}
+
+} // namespace android_vulkan
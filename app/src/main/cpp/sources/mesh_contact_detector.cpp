@@ -0,0 +1,1160 @@
+#include <precompiled_headers.hpp>
+#include <av_assert.hpp>
+#include <closest_points.hpp>
+#include <mesh_contact_detector.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+// Triangle face axis and box or hull face axes are preferred over edge axes if penetrations are almost the same. It
+// keeps contact normals stable while the shape slides over the edges between triangles.
+constexpr float AXIS_ABSOLUTE_TOLERANCE = 5.0e-3F;
+constexpr float AXIS_RELATIVE_TOLERANCE = 0.95F;
+
+// Cosine of the angle between hull separating axis and triangle normal which is treated as internal edge contact.
+constexpr float GHOST_AXIS_COSINE = 0.7F;
+
+// Cross product of almost parallel edges does not produce separating axis.
+constexpr float PARALLEL_EDGES = 1.0e-6F;
+
+constexpr float SAME_NORMAL_COSINE = 0.99F;
+constexpr float SAME_POINT_TOLERANCE = 1.0e-3F;
+
+// Sphere center closer than this to the triangle takes the triangle normal as contact normal.
+constexpr float SPHERE_CENTER_EPSILON = 1.0e-6F;
+
+// Sine of the angle between capsule segment and triangle plane which is treated as lying capsule.
+constexpr float PARALLEL_SEGMENT = 5.0e-2F;
+
+enum class eAxis : uint8_t
+{
+    TriangleFace,
+    ShapeFace,
+    Edges
+};
+
+// Triangle index goes to the upper half of the feature ID. So contacts of different triangles never match.
+[[nodiscard]] constexpr ContactFeature MakeMeshFeature ( uint32_t triangle, ContactFeature feature ) noexcept
+{
+    return ( triangle << 16U ) | ( feature & 0xFFFFU );
+}
+
+// Based on ideas from Christer Ericson, Real-Time Collision Detection, 2005, chapter 5.1.5.
+[[nodiscard]] ContactFeature ClosestPointTriangle ( GXVec3 &result,
+    GXVec3 const &p,
+    ShapeMesh::Triangle const &triangle
+) noexcept
+{
+    GXVec3 const &a = triangle._vertices[ 0U ];
+    GXVec3 const &b = triangle._vertices[ 1U ];
+    GXVec3 const &c = triangle._vertices[ 2U ];
+
+    GXVec3 ab {};
+    ab.Subtract ( b, a );
+
+    GXVec3 ac {};
+    ac.Subtract ( c, a );
+
+    GXVec3 ap {};
+    ap.Subtract ( p, a );
+
+    float const d1 = ab.DotProduct ( ap );
+    float const d2 = ac.DotProduct ( ap );
+
+    if ( d1 <= 0.0F && d2 <= 0.0F )
+    {
+        result = a;
+        return MakeContactFeature ( eContactFeature::ReferenceVertex, 0U );
+    }
+
+    GXVec3 bp {};
+    bp.Subtract ( p, b );
+
+    float const d3 = ab.DotProduct ( bp );
+    float const d4 = ac.DotProduct ( bp );
+
+    if ( d3 >= 0.0F && d4 <= d3 )
+    {
+        result = b;
+        return MakeContactFeature ( eContactFeature::ReferenceVertex, 1U );
+    }
+
+    float const vc = d1 * d4 - d3 * d2;
+
+    if ( vc <= 0.0F && d1 >= 0.0F && d3 <= 0.0F )
+    {
+        result.Sum ( a, d1 / ( d1 - d3 ), ab );
+        return MakeContactFeature ( eContactFeature::ReferenceEdge, 0U );
+    }
+
+    GXVec3 cp {};
+    cp.Subtract ( p, c );
+
+    float const d5 = ab.DotProduct ( cp );
+    float const d6 = ac.DotProduct ( cp );
+
+    if ( d6 >= 0.0F && d5 <= d6 )
+    {
+        result = c;
+        return MakeContactFeature ( eContactFeature::ReferenceVertex, 2U );
+    }
+
+    float const vb = d5 * d2 - d1 * d6;
+
+    if ( vb <= 0.0F && d2 >= 0.0F && d6 <= 0.0F )
+    {
+        result.Sum ( a, d2 / ( d2 - d6 ), ac );
+        return MakeContactFeature ( eContactFeature::ReferenceEdge, 2U );
+    }
+
+    float const va = d3 * d6 - d5 * d4;
+
+    if ( va <= 0.0F && d4 >= d3 && d5 >= d6 )
+    {
+        GXVec3 bc {};
+        bc.Subtract ( c, b );
+        result.Sum ( b, ( d4 - d3 ) / ( ( d4 - d3 ) + ( d5 - d6 ) ), bc );
+        return MakeContactFeature ( eContactFeature::ReferenceEdge, 1U );
+    }
+
+    float const denominator = 1.0F / ( va + vb + vc );
+    result.Sum ( a, vb * denominator, ab );
+    result.Sum ( result, vc * denominator, ac );
+    return MakeContactFeature ( eContactFeature::None, 0U );
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+MeshContactDetector::MeshContacts &MeshContactDetector::Run ( ShapeMesh const &mesh,
+    Shape const &shape
+) noexcept
+{
+    _contacts.clear ();
+    GXAABB const &bounds = shape.GetBoundsWorld ();
+
+    if ( !IsSupported ( shape ) || !mesh.GetBoundsWorld ().IsOverlapped ( bounds ) )
+        return _contacts;
+
+    _triangles.clear ();
+    mesh.CollectTriangles ( _triangles, bounds );
+
+    if ( shape.GetType () == eShapeType::Sphere )
+    {
+        auto const &sphere = static_cast<ShapeSphere const &> ( shape );
+
+        for ( uint32_t const triangle : _triangles )
+            CheckSphere ( mesh.GetTriangleWorld ( triangle ), triangle, sphere );
+
+        ReduceRoundContacts ( sphere.GetRadius () );
+        return _contacts;
+    }
+
+    if ( shape.GetType () == eShapeType::Capsule )
+    {
+        auto const &capsule = static_cast<ShapeCapsule const &> ( shape );
+
+        for ( uint32_t const triangle : _triangles )
+            CheckCapsule ( mesh.GetTriangleWorld ( triangle ), triangle, capsule );
+
+        ReduceRoundContacts ( capsule.GetRadius () );
+        return _contacts;
+    }
+
+    if ( shape.GetType () == eShapeType::ConvexHull )
+    {
+        auto const &hull = static_cast<ShapeConvexHull const &> ( shape );
+        PrepareConvexHull ( hull );
+
+        for ( uint32_t const triangle : _triangles )
+            CheckConvexHull ( mesh.GetTriangleWorld ( triangle ), triangle, hull );
+
+        return _contacts;
+    }
+
+    auto const &shapeBox = static_cast<ShapeBox const &> ( shape );
+    GXMat4 const &transform = shapeBox.GetTransformWorld ();
+    Box box {};
+
+    transform.GetX ( box._axes[ 0U ] );
+    transform.GetY ( box._axes[ 1U ] );
+    transform.GetZ ( box._axes[ 2U ] );
+    transform.GetW ( box._center );
+    box._halfSize.Multiply ( shapeBox.GetSize (), 0.5F );
+
+    for ( uint32_t const triangle : _triangles )
+        CheckBox ( mesh.GetTriangleWorld ( triangle ), triangle, box );
+
+    return _contacts;
+}
+
+bool MeshContactDetector::IsSupported ( Shape const &shape ) noexcept
+{
+    eShapeType const type = shape.GetType ();
+    return type == eShapeType::Sphere || type == eShapeType::Box || type == eShapeType::Capsule ||
+        type == eShapeType::ConvexHull;
+}
+
+void MeshContactDetector::Append ( MeshContact const &contact ) noexcept
+{
+    // Neighbour triangles produce the same contact near the shared edges and vertices.
+    constexpr float samePoint = SAME_POINT_TOLERANCE * SAME_POINT_TOLERANCE;
+
+    for ( MeshContact &existing : _contacts )
+    {
+        if ( existing._pointB.SquaredDistance ( contact._pointB ) > samePoint ||
+            existing._normal.DotProduct ( contact._normal ) < SAME_NORMAL_COSINE )
+        {
+            continue;
+        }
+
+        if ( contact._penetration > existing._penetration )
+            existing = contact;
+
+        return;
+    }
+
+    _contacts.push_back ( contact );
+}
+
+void MeshContactDetector::ReduceRoundContacts ( float radius ) noexcept
+{
+    if ( _contacts.size () < 2U )
+        return;
+
+    // Feature ID breaks ties. So the result does not depend on the order of the candidate triangles.
+    std::sort ( _contacts.begin (),
+        _contacts.end (),
+
+        [] ( MeshContact const &a, MeshContact const &b ) noexcept {
+            if ( a._penetration != b._penetration )
+                return a._penetration > b._penetration;
+
+            return a._feature < b._feature;
+        }
+    );
+
+    // Every triangle near the rounded part of the shape reports own closest point. Points which do not stick out of
+    // the contact plane of the deeper contact of the same sphere are dropped. Otherwise almost parallel contacts push
+    // the shape several times.
+    float const sameSphere = radius * radius;
+    size_t kept = 1U;
+    size_t const count = _contacts.size ();
+
+    for ( size_t i = 1U; i < count; ++i )
+    {
+        MeshContact const &contact = _contacts[ i ];
+
+        GXVec3 center {};
+        center.Sum ( contact._pointB, radius, contact._normal );
+
+        bool isHidden = false;
+
+        for ( size_t j = 0U; j < kept; ++j )
+        {
+            MeshContact const &deeper = _contacts[ j ];
+
+            GXVec3 deeperCenter {};
+            deeperCenter.Sum ( deeper._pointB, radius, deeper._normal );
+
+            if ( center.SquaredDistance ( deeperCenter ) >= sameSphere )
+                continue;
+
+            GXVec3 delta {};
+            delta.Subtract ( contact._pointA, deeper._pointA );
+
+            if ( deeper._normal.DotProduct ( delta ) <= SAME_POINT_TOLERANCE )
+            {
+                isHidden = true;
+                break;
+            }
+        }
+
+        if ( !isHidden )
+            _contacts[ kept++ ] = contact;
+    }
+
+    _contacts.resize ( kept );
+}
+
+void MeshContactDetector::CheckBox ( ShapeMesh::Triangle const &triangle, uint32_t index, Box const &box ) noexcept
+{
+    GXVec3 const* v = triangle._vertices;
+    GXVec3 const* u = box._axes;
+    GXVec3 const &h = box._halfSize;
+
+    float bestDepth = std::numeric_limits<float>::max ();
+    GXVec3 bestAxis {};
+    eAxis bestType = eAxis::TriangleFace;
+    size_t bestBoxAxis = 0U;
+    size_t bestEdge = 0U;
+
+    // The method returns false if the axis separates the shapes.
+    auto const test = [ & ] ( GXVec3 const &axis, eAxis type, size_t boxAxis, size_t edge ) noexcept -> bool {
+        float const c = box._center.DotProduct ( axis );
+
+        float const r = h._data[ 0U ] * std::abs ( u[ 0U ].DotProduct ( axis ) ) +
+            h._data[ 1U ] * std::abs ( u[ 1U ].DotProduct ( axis ) ) +
+            h._data[ 2U ] * std::abs ( u[ 2U ].DotProduct ( axis ) );
+
+        float const t0 = v[ 0U ].DotProduct ( axis );
+        float const t1 = v[ 1U ].DotProduct ( axis );
+        float const t2 = v[ 2U ].DotProduct ( axis );
+
+        // Penetrations along the axis and against the axis. Box is moved in both cases.
+        float const forward = std::max ( std::max ( t0, t1 ), t2 ) - ( c - r );
+        float const backward = ( c + r ) - std::min ( std::min ( t0, t1 ), t2 );
+
+        if ( forward <= 0.0F || backward <= 0.0F )
+            return false;
+
+        float const depth = std::min ( forward, backward );
+
+        if ( type != eAxis::TriangleFace &&
+            depth >= AXIS_RELATIVE_TOLERANCE * bestDepth - AXIS_ABSOLUTE_TOLERANCE )
+        {
+            return true;
+        }
+
+        bestDepth = depth;
+        bestType = type;
+        bestBoxAxis = boxAxis;
+        bestEdge = edge;
+
+        if ( forward <= backward )
+        {
+            bestAxis = axis;
+            return true;
+        }
+
+        bestAxis = axis;
+        bestAxis.Reverse ();
+        return true;
+    };
+
+    if ( !test ( triangle._normal, eAxis::TriangleFace, 0U, 0U ) )
+        return;
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        if ( !test ( u[ i ], eAxis::ShapeFace, i, 0U ) )
+        {
+            return;
+        }
+    }
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        for ( size_t j = 0U; j < 3U; ++j )
+        {
+            GXVec3 edge {};
+            edge.Subtract ( v[ ( j + 1U ) % 3U ], v[ j ] );
+
+            GXVec3 axis {};
+            axis.CrossProduct ( u[ i ], edge );
+            float const length = axis.SquaredLength ();
+
+            if ( length < PARALLEL_EDGES * edge.SquaredLength () )
+                continue;
+
+            axis.Multiply ( axis, 1.0F / std::sqrt ( length ) );
+
+            if ( !test ( axis, eAxis::Edges, i, j ) )
+            {
+                return;
+            }
+        }
+    }
+
+    // Deepest box vertex along the separation axis. It's also fallback contact.
+    GXVec3 const &n = bestAxis;
+    float signs[ 3U ];
+    GXVec3 deepest ( box._center );
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        signs[ i ] = u[ i ].DotProduct ( n ) > 0.0F ? -1.0F : 1.0F;
+        deepest.Sum ( deepest, signs[ i ] * h._data[ i ], u[ i ] );
+    }
+
+    size_t const before = _contacts.size ();
+
+    auto const append = [ & ] ( GXVec3 const &pointB, float penetration, ContactFeature feature ) noexcept {
+        MeshContact contact
+        {
+            ._pointA {},
+            ._pointB = pointB,
+            ._normal = n,
+            ._penetration = penetration,
+            ._feature = MakeMeshFeature ( index, feature )
+        };
+
+        contact._pointA.Sum ( pointB, penetration, n );
+        Append ( contact );
+    };
+
+    switch ( bestType )
+    {
+        case eAxis::TriangleFace:
+        {
+            // Reference face is the triangle. Incident face is the box face which is the most opposite to the normal.
+            size_t k = 0U;
+
+            for ( size_t i = 1U; i < 3U; ++i )
+            {
+                if ( std::abs ( u[ i ].DotProduct ( n ) ) > std::abs ( u[ k ].DotProduct ( n ) ) )
+                {
+                    k = i;
+                }
+            }
+
+            size_t const i = ( k + 1U ) % 3U;
+            size_t const j = ( k + 2U ) % 3U;
+
+            GXVec3 center {};
+            center.Sum ( box._center, signs[ k ] * h._data[ k ], u[ k ] );
+
+            Polygon polygon {};
+            polygon._count = 4U;
+
+            constexpr float const cornerSigns[ 4U ][ 2U ] =
+            {
+                { 1.0F, 1.0F },
+                { -1.0F, 1.0F },
+                { -1.0F, -1.0F },
+                { 1.0F, -1.0F }
+            };
+
+            for ( size_t corner = 0U; corner < 4U; ++corner )
+            {
+                GXVec3 &p = polygon._vertices[ corner ];
+                p.Sum ( center, cornerSigns[ corner ][ 0U ] * h._data[ i ], u[ i ] );
+                p.Sum ( p, cornerSigns[ corner ][ 1U ] * h._data[ j ], u[ j ] );
+                polygon._features[ corner ] = MakeContactFeature ( eContactFeature::IncidentVertex, 4U * k + corner );
+            }
+
+            for ( size_t edge = 0U; edge < 3U && polygon._count > 0U; ++edge )
+            {
+                GXVec3 const &a = v[ edge ];
+
+                GXVec3 e {};
+                e.Subtract ( v[ ( edge + 1U ) % 3U ], a );
+
+                GXVec3 side {};
+                side.CrossProduct ( e, triangle._normal );
+
+                GXVec3 toOpposite {};
+                toOpposite.Subtract ( v[ ( edge + 2U ) % 3U ], a );
+
+                if ( side.DotProduct ( toOpposite ) > 0.0F )
+                    side.Reverse ();
+
+                Clip ( polygon,
+                    side,
+                    side.DotProduct ( a ),
+                    MakeContactFeature ( eContactFeature::ReferenceEdge, edge )
+                );
+            }
+
+            float const plane = v[ 0U ].DotProduct ( n );
+
+            for ( size_t p = 0U; p < polygon._count; ++p )
+            {
+                GXVec3 const &point = polygon._vertices[ p ];
+                float const penetration = plane - point.DotProduct ( n );
+
+                if ( penetration > 0.0F )
+                {
+                    append ( point, penetration, polygon._features[ p ] );
+                }
+            }
+        }
+        break;
+
+        case eAxis::ShapeFace:
+        {
+            // Reference face is the box face. Incident face is the triangle.
+            Polygon polygon {};
+            polygon._count = 3U;
+
+            for ( size_t p = 0U; p < 3U; ++p )
+            {
+                polygon._vertices[ p ] = v[ p ];
+                polygon._features[ p ] = MakeContactFeature ( eContactFeature::IncidentVertex, p );
+            }
+
+            size_t plane = 0U;
+
+            for ( size_t i = 0U; i < 3U && polygon._count > 0U; ++i )
+            {
+                if ( i == bestBoxAxis )
+                    continue;
+
+                float const c = u[ i ].DotProduct ( box._center );
+
+                Clip ( polygon,
+                    u[ i ],
+                    c + h._data[ i ],
+                    MakeContactFeature ( eContactFeature::ReferenceEdge, plane++ )
+                );
+
+                GXVec3 reverse ( u[ i ] );
+                reverse.Reverse ();
+
+                Clip ( polygon,
+                    reverse,
+                    h._data[ i ] - c,
+                    MakeContactFeature ( eContactFeature::ReferenceEdge, plane++ )
+                );
+            }
+
+            float const face = box._center.DotProduct ( n ) - h._data[ bestBoxAxis ];
+
+            for ( size_t p = 0U; p < polygon._count; ++p )
+            {
+                GXVec3 const &point = polygon._vertices[ p ];
+                float const penetration = point.DotProduct ( n ) - face;
+
+                if ( penetration <= 0.0F )
+                    continue;
+
+                GXVec3 pointB {};
+                pointB.Sum ( point, -penetration, n );
+                append ( pointB, penetration, polygon._features[ p ] );
+            }
+        }
+        break;
+
+        case eAxis::Edges:
+        {
+            // Box edge which is the deepest along the normal.
+            GXVec3 const &axis = u[ bestBoxAxis ];
+            GXVec3 middle ( deepest );
+            middle.Sum ( middle, -signs[ bestBoxAxis ] * h._data[ bestBoxAxis ], axis );
+
+            GXVec3 boxA {};
+            boxA.Sum ( middle, -h._data[ bestBoxAxis ], axis );
+
+            GXVec3 boxB {};
+            boxB.Sum ( middle, h._data[ bestBoxAxis ], axis );
+
+            GXVec3 onTriangle {};
+            GXVec3 onBox {};
+            ClosestPointsSegments ( onTriangle, onBox, v[ bestEdge ], v[ ( bestEdge + 1U ) % 3U ], boxA, boxB );
+
+            append ( onBox,
+                bestDepth,
+
+                CombineContactFeatures ( MakeContactFeature ( eContactFeature::ReferenceEdge, bestEdge ),
+                    MakeContactFeature ( eContactFeature::IncidentEdge, bestBoxAxis )
+                )
+            );
+        }
+        break;
+    }
+
+    if ( _contacts.size () == before )
+    {
+        append ( deepest, bestDepth, MakeContactFeature ( eContactFeature::IncidentVertex, 31U ) );
+    }
+}
+
+void MeshContactDetector::CheckCapsule ( ShapeMesh::Triangle const &triangle,
+    uint32_t index,
+    ShapeCapsule const &capsule
+) noexcept
+{
+    GXVec3 const &p0 = capsule.GetSegmentBeginWorld ();
+    GXVec3 const &p1 = capsule.GetSegmentEndWorld ();
+    float const radius = capsule.GetRadius ();
+
+    GXVec3 const* v = triangle._vertices;
+    GXVec3 const &n = triangle._normal;
+
+    GXVec3 d {};
+    d.Subtract ( p1, p0 );
+
+    float const plane = n.DotProduct ( v[ 0U ] );
+    float const h0 = n.DotProduct ( p0 ) - plane;
+    float const h1 = n.DotProduct ( p1 ) - plane;
+
+    auto const append = [ & ] ( GXVec3 const &onSegment, float height, ContactFeature feature ) noexcept {
+        MeshContact contact
+        {
+            ._pointA {},
+            ._pointB {},
+            ._normal = n,
+            ._penetration = radius - height,
+            ._feature = MakeMeshFeature ( index, feature )
+        };
+
+        contact._pointA.Sum ( onSegment, -height, n );
+        contact._pointB.Sum ( onSegment, -radius, n );
+        Append ( contact );
+    };
+
+    // Lying capsule touches the triangle by the whole segment part above it. The segment is clipped by the triangle
+    // side planes. Both ends of the clipped part produce contacts.
+    float const length = d.Length ();
+
+    if ( std::abs ( h1 - h0 ) < PARALLEL_SEGMENT * length && std::min ( h0, h1 ) < radius &&
+        std::max ( h0, h1 ) > -radius )
+    {
+        float t0 = 0.0F;
+        float t1 = 1.0F;
+        ContactFeature features[ 2U ] =
+        {
+            MakeContactFeature ( eContactFeature::IncidentVertex, 0U ),
+            MakeContactFeature ( eContactFeature::IncidentVertex, 1U )
+        };
+
+        for ( size_t edge = 0U; edge < 3U && t0 <= t1; ++edge )
+        {
+            GXVec3 const &a = v[ edge ];
+
+            GXVec3 e {};
+            e.Subtract ( v[ ( edge + 1U ) % 3U ], a );
+
+            GXVec3 side {};
+            side.CrossProduct ( e, n );
+
+            GXVec3 toOpposite {};
+            toOpposite.Subtract ( v[ ( edge + 2U ) % 3U ], a );
+
+            // The side plane normal looks outside of the triangle.
+            if ( side.DotProduct ( toOpposite ) > 0.0F )
+                side.Reverse ();
+
+            float const offset = side.DotProduct ( a );
+            float const s0 = side.DotProduct ( p0 ) - offset;
+            float const s1 = side.DotProduct ( p1 ) - offset;
+
+            if ( s0 > 0.0F && s1 > 0.0F )
+            {
+                t0 = 1.0F;
+                t1 = 0.0F;
+                break;
+            }
+
+            ContactFeature const feature = MakeContactFeature ( eContactFeature::ReferenceEdge, edge );
+
+            if ( s0 > 0.0F )
+            {
+                if ( float const t = s0 / ( s0 - s1 ); t > t0 )
+                {
+                    t0 = t;
+                    features[ 0U ] = feature;
+                }
+            }
+            else if ( s1 > 0.0F )
+            {
+                if ( float const t = s0 / ( s0 - s1 ); t < t1 )
+                {
+                    t1 = t;
+                    features[ 1U ] = feature;
+                }
+            }
+        }
+
+        size_t const before = _contacts.size ();
+
+        if ( t0 <= t1 )
+        {
+            float const ends[ 2U ] = { t0, t1 };
+            size_t const endCount = ( t1 - t0 ) * length > SAME_POINT_TOLERANCE ? 2U : 1U;
+
+            for ( size_t i = 0U; i < endCount; ++i )
+            {
+                GXVec3 q {};
+                q.Sum ( p0, ends[ i ], d );
+                float const height = n.DotProduct ( q ) - plane;
+
+                if ( height < radius )
+                    append ( q, height, features[ i ] );
+            }
+        }
+
+        if ( _contacts.size () != before )
+            return;
+    }
+
+    // The segment pierces the triangle. The capsule is pushed along the triangle normal.
+    if ( ( h0 < 0.0F ) != ( h1 < 0.0F ) )
+    {
+        GXVec3 pierce {};
+        pierce.Sum ( p0, h0 / ( h0 - h1 ), d );
+
+        GXVec3 closest {};
+
+        if ( ClosestPointTriangle ( closest, pierce, triangle ) == MakeContactFeature ( eContactFeature::None, 0U ) )
+        {
+            bool const isFirst = h0 < h1;
+
+            append ( isFirst ? p0 : p1,
+                std::min ( h0, h1 ),
+                MakeContactFeature ( eContactFeature::IncidentVertex, isFirst ? 0U : 1U )
+            );
+
+            return;
+        }
+    }
+
+    // General case: the closest points of the segment and the triangle are on the segment ends or on the triangle
+    // edges.
+    GXVec3 onSegment ( p0 );
+    GXVec3 onTriangle {};
+    ContactFeature feature = ClosestPointTriangle ( onTriangle, p0, triangle );
+    float best = onSegment.SquaredDistance ( onTriangle );
+
+    GXVec3 alpha {};
+    ContactFeature const endFeature = ClosestPointTriangle ( alpha, p1, triangle );
+
+    if ( float const distance = p1.SquaredDistance ( alpha ); distance < best )
+    {
+        best = distance;
+        onSegment = p1;
+        onTriangle = alpha;
+        feature = endFeature;
+    }
+
+    for ( size_t edge = 0U; edge < 3U; ++edge )
+    {
+        GXVec3 beta {};
+        ClosestPointsSegments ( beta, alpha, p0, p1, v[ edge ], v[ ( edge + 1U ) % 3U ] );
+
+        if ( float const distance = beta.SquaredDistance ( alpha ); distance < best )
+        {
+            best = distance;
+            onSegment = beta;
+            onTriangle = alpha;
+            feature = MakeContactFeature ( eContactFeature::ReferenceEdge, edge );
+        }
+    }
+
+    if ( best >= radius * radius )
+        return;
+
+    float const distance = std::sqrt ( best );
+    GXVec3 normal ( n );
+
+    if ( distance > SPHERE_CENTER_EPSILON )
+    {
+        GXVec3 delta {};
+        delta.Subtract ( onSegment, onTriangle );
+        normal.Multiply ( delta, 1.0F / distance );
+    }
+
+    MeshContact contact
+    {
+        ._pointA = onTriangle,
+        ._pointB {},
+        ._normal = normal,
+        ._penetration = radius - distance,
+        ._feature = MakeMeshFeature ( index, feature )
+    };
+
+    contact._pointB.Sum ( onSegment, -radius, normal );
+    Append ( contact );
+}
+
+void MeshContactDetector::CheckConvexHull ( ShapeMesh::Triangle const &triangle,
+    uint32_t index,
+    ShapeConvexHull const &hull
+) noexcept
+{
+    GXVec3 const* v = triangle._vertices;
+
+    // Support function of the hull is hill climbing. So the projection of the hull does not scan all vertices.
+    auto const &shape = static_cast<Shape const &> ( hull );
+
+    float bestDepth = std::numeric_limits<float>::max ();
+    GXVec3 bestAxis {};
+    eAxis bestType = eAxis::TriangleFace;
+    size_t bestHullEdge = 0U;
+    size_t bestEdge = 0U;
+
+    // The method returns false if the axis separates the shapes.
+    auto const test = [ & ] ( GXVec3 const &axis, eAxis type, size_t hullEdge, size_t edge ) noexcept -> bool {
+        GXVec3 reverse ( axis );
+        reverse.Reverse ();
+
+        float const low = shape.GetExtremePointWorld ( reverse ).DotProduct ( axis );
+        float const high = shape.GetExtremePointWorld ( axis ).DotProduct ( axis );
+
+        float const t0 = v[ 0U ].DotProduct ( axis );
+        float const t1 = v[ 1U ].DotProduct ( axis );
+        float const t2 = v[ 2U ].DotProduct ( axis );
+
+        // Penetrations along the axis and against the axis. Hull is moved in both cases.
+        float const forward = std::max ( std::max ( t0, t1 ), t2 ) - low;
+        float const backward = high - std::min ( std::min ( t0, t1 ), t2 );
+
+        if ( forward <= 0.0F || backward <= 0.0F )
+            return false;
+
+        float const depth = std::min ( forward, backward );
+
+        if ( type != eAxis::TriangleFace &&
+            depth >= AXIS_RELATIVE_TOLERANCE * bestDepth - AXIS_ABSOLUTE_TOLERANCE )
+        {
+            return true;
+        }
+
+        bestDepth = depth;
+        bestType = type;
+        bestHullEdge = hullEdge;
+        bestEdge = edge;
+        bestAxis = axis;
+
+        if ( forward > backward )
+            bestAxis.Reverse ();
+
+        return true;
+    };
+
+    if ( !test ( triangle._normal, eAxis::TriangleFace, 0U, 0U ) )
+        return;
+
+    GXVec3 const faceAxis = bestAxis;
+    float const faceDepth = bestDepth;
+
+    for ( GXVec3 const &normal : _hullNormals )
+    {
+        if ( !test ( normal, eAxis::ShapeFace, 0U, 0U ) )
+        {
+            return;
+        }
+    }
+
+    size_t const hullEdges = _hullEdges.size () / 2U;
+
+    for ( size_t i = 0U; i < hullEdges; ++i )
+    {
+        GXVec3 hullEdge {};
+        hullEdge.Subtract ( _hullEdges[ 2U * i + 1U ], _hullEdges[ 2U * i ] );
+
+        for ( size_t j = 0U; j < 3U; ++j )
+        {
+            GXVec3 edge {};
+            edge.Subtract ( v[ ( j + 1U ) % 3U ], v[ j ] );
+
+            GXVec3 axis {};
+            axis.CrossProduct ( hullEdge, edge );
+            float const length = axis.SquaredLength ();
+
+            if ( length < PARALLEL_EDGES * hullEdge.SquaredLength () * edge.SquaredLength () )
+                continue;
+
+            axis.Multiply ( axis, 1.0F / std::sqrt ( length ) );
+
+            if ( !test ( axis, eAxis::Edges, i, j ) )
+            {
+                return;
+            }
+        }
+    }
+
+    GXVec3 const &n = bestAxis;
+
+    GXVec3 reverse ( n );
+    reverse.Reverse ();
+
+    // Near the shared triangle edges and vertices the hull axes separate the hull from the single triangle only. The
+    // mesh has no triangle adjacency. So the axis which is close to the triangle normal is replaced by the normal.
+    // Otherwise the hull resting on the mesh gets tilted normals which push it sideways.
+    if ( bestType != eAxis::TriangleFace && bestAxis.DotProduct ( faceAxis ) >= GHOST_AXIS_COSINE )
+    {
+        bestAxis = faceAxis;
+        bestDepth = faceDepth;
+        bestType = eAxis::TriangleFace;
+        reverse = faceAxis;
+        reverse.Reverse ();
+    }
+
+    size_t const before = _contacts.size ();
+
+    auto const append = [ & ] ( GXVec3 const &pointB, float penetration, ContactFeature feature ) noexcept {
+        MeshContact contact
+        {
+            ._pointA {},
+            ._pointB = pointB,
+            ._normal = n,
+            ._penetration = penetration,
+            ._feature = MakeMeshFeature ( index, feature )
+        };
+
+        contact._pointA.Sum ( pointB, penetration, n );
+        Append ( contact );
+    };
+
+    // Hull face, edge or vertex which is the deepest along the normal.
+    hull.CollectFeatureWorld ( _hullFeature, reverse );
+    size_t const count = _hullFeature.size ();
+
+    switch ( bestType )
+    {
+        case eAxis::TriangleFace:
+        {
+            // Reference face is the triangle. Only the hull feature vertices above the triangle produce contacts. The
+            // neighbour triangles take the rest of the vertices. Intersection points with the shared triangle edges
+            // are skipped. Otherwise a small hull feature gets several close contacts, and the solver overshoots.
+            GXVec3 sides[ 3U ];
+            float offsets[ 3U ];
+
+            for ( size_t edge = 0U; edge < 3U; ++edge )
+            {
+                GXVec3 const &a = v[ edge ];
+
+                GXVec3 e {};
+                e.Subtract ( v[ ( edge + 1U ) % 3U ], a );
+
+                GXVec3 &side = sides[ edge ];
+                side.CrossProduct ( e, triangle._normal );
+
+                GXVec3 toOpposite {};
+                toOpposite.Subtract ( v[ ( edge + 2U ) % 3U ], a );
+
+                if ( side.DotProduct ( toOpposite ) > 0.0F )
+                    side.Reverse ();
+
+                offsets[ edge ] = side.DotProduct ( a );
+            }
+
+            float const plane = v[ 0U ].DotProduct ( n );
+
+            for ( size_t p = 0U; p < count; ++p )
+            {
+                GXVec3 const &point = _hullFeature[ p ];
+
+                if ( sides[ 0U ].DotProduct ( point ) > offsets[ 0U ] ||
+                    sides[ 1U ].DotProduct ( point ) > offsets[ 1U ] ||
+                    sides[ 2U ].DotProduct ( point ) > offsets[ 2U ] )
+                {
+                    continue;
+                }
+
+                float const penetration = plane - point.DotProduct ( n );
+
+                if ( penetration > 0.0F )
+                {
+                    append ( point, penetration, MakeContactFeature ( eContactFeature::IncidentVertex, p ) );
+                }
+            }
+        }
+        break;
+
+        case eAxis::ShapeFace:
+        {
+            // Clipping adds at most one vertex per plane. So the faces which do not fit the polygon fall back to
+            // the single deepest point.
+            if ( count < 3U || count + 3U > MAX_POLYGON_VERTICES )
+                break;
+
+            // Reference face is the hull face. Incident face is the triangle.
+            Polygon polygon {};
+            polygon._count = 3U;
+
+            for ( size_t p = 0U; p < 3U; ++p )
+            {
+                polygon._vertices[ p ] = v[ p ];
+                polygon._features[ p ] = MakeContactFeature ( eContactFeature::IncidentVertex, p );
+            }
+
+            GXVec3 center {};
+
+            for ( GXVec3 const &vertex : _hullFeature )
+                center.Sum ( center, vertex );
+
+            center.Multiply ( center, 1.0F / static_cast<float> ( count ) );
+
+            for ( size_t edge = 0U; edge < count && polygon._count > 0U; ++edge )
+            {
+                GXVec3 const &a = _hullFeature[ edge ];
+
+                GXVec3 e {};
+                e.Subtract ( _hullFeature[ ( edge + 1U ) % count ], a );
+
+                GXVec3 side {};
+                side.CrossProduct ( e, n );
+
+                GXVec3 toCenter {};
+                toCenter.Subtract ( center, a );
+
+                if ( side.DotProduct ( toCenter ) > 0.0F )
+                    side.Reverse ();
+
+                Clip ( polygon,
+                    side,
+                    side.DotProduct ( a ),
+                    MakeContactFeature ( eContactFeature::ReferenceEdge, edge )
+                );
+            }
+
+            float const face = _hullFeature.front ().DotProduct ( n );
+
+            for ( size_t p = 0U; p < polygon._count; ++p )
+            {
+                GXVec3 const &point = polygon._vertices[ p ];
+                float const penetration = point.DotProduct ( n ) - face;
+
+                if ( penetration <= 0.0F )
+                    continue;
+
+                GXVec3 pointB {};
+                pointB.Sum ( point, -penetration, n );
+                append ( pointB, penetration, polygon._features[ p ] );
+            }
+        }
+        break;
+
+        case eAxis::Edges:
+        {
+            // Parallel hull edges produce the same axis. So the edge is taken from the deepest hull feature.
+            if ( count != 2U )
+                break;
+
+            GXVec3 onTriangle {};
+            GXVec3 onHull {};
+
+            ClosestPointsSegments ( onTriangle,
+                onHull,
+                v[ bestEdge ],
+                v[ ( bestEdge + 1U ) % 3U ],
+                _hullFeature[ 0U ],
+                _hullFeature[ 1U ]
+            );
+
+            append ( onHull,
+                bestDepth,
+
+                CombineContactFeatures ( MakeContactFeature ( eContactFeature::ReferenceEdge, bestEdge ),
+                    MakeContactFeature ( eContactFeature::IncidentEdge, bestHullEdge )
+                )
+            );
+        }
+        break;
+    }
+
+    if ( _contacts.size () == before )
+    {
+        append ( shape.GetExtremePointWorld ( reverse ),
+            bestDepth,
+            MakeContactFeature ( eContactFeature::IncidentVertex, 31U )
+        );
+    }
+}
+
+void MeshContactDetector::CheckSphere ( ShapeMesh::Triangle const &triangle,
+    uint32_t index,
+    ShapeSphere const &sphere
+) noexcept
+{
+    GXVec3 center {};
+    sphere.GetTransformWorld ().GetW ( center );
+
+    GXVec3 closest {};
+    ContactFeature const feature = ClosestPointTriangle ( closest, center, triangle );
+
+    GXVec3 delta {};
+    delta.Subtract ( center, closest );
+
+    float const radius = sphere.GetRadius ();
+    float const squaredDistance = delta.SquaredLength ();
+
+    if ( squaredDistance >= radius * radius )
+        return;
+
+    float const distance = std::sqrt ( squaredDistance );
+    GXVec3 normal ( triangle._normal );
+
+    if ( distance > SPHERE_CENTER_EPSILON )
+        normal.Multiply ( delta, 1.0F / distance );
+
+    MeshContact contact
+    {
+        ._pointA = closest,
+        ._pointB {},
+        ._normal = normal,
+        ._penetration = radius - distance,
+        ._feature = MakeMeshFeature ( index, feature )
+    };
+
+    contact._pointB.Sum ( center, -radius, normal );
+    Append ( contact );
+}
+
+void MeshContactDetector::PrepareConvexHull ( ShapeConvexHull const &hull ) noexcept
+{
+    GXMat4 const &transform = hull.GetTransformWorld ();
+    std::vector<GXVec3> const &vertices = hull.GetVertices ();
+    uint32_t const* faceVertices = hull.GetFaceVertices ().data ();
+
+    _hullEdges.clear ();
+    _hullNormals.clear ();
+
+    for ( ShapeConvexHull::Face const &face : hull.GetFaces () )
+    {
+        transform.MultiplyAsNormal ( _hullNormals.emplace_back (), face._normal );
+        uint32_t const* polygon = faceVertices + face._first;
+
+        // Every hull edge is shared by two faces in opposite directions. So the edge is taken once.
+        for ( uint32_t i = 0U; i < face._count; ++i )
+        {
+            uint32_t const a = polygon[ i ];
+            uint32_t const b = polygon[ ( i + 1U ) % face._count ];
+
+            if ( a > b )
+                continue;
+
+            transform.MultiplyAsPoint ( _hullEdges.emplace_back (), vertices[ a ] );
+            transform.MultiplyAsPoint ( _hullEdges.emplace_back (), vertices[ b ] );
+        }
+    }
+}
+
+void MeshContactDetector::Clip ( Polygon &polygon,
+    GXVec3 const &normal,
+    float offset,
+    ContactFeature planeFeature
+) noexcept
+{
+    Polygon result {};
+    size_t const count = polygon._count;
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        GXVec3 const &current = polygon._vertices[ i ];
+        size_t const n = ( i + 1U ) % count;
+        GXVec3 const &next = polygon._vertices[ n ];
+
+        float const dc = normal.DotProduct ( current ) - offset;
+        float const dn = normal.DotProduct ( next ) - offset;
+
+        if ( dc <= 0.0F )
+        {
+            AV_ASSERT ( result._count < MAX_POLYGON_VERTICES )
+            result._vertices[ result._count ] = current;
+            result._features[ result._count++ ] = polygon._features[ i ];
+        }
+
+        if ( ( dc <= 0.0F ) == ( dn <= 0.0F ) )
+            continue;
+
+        GXVec3 edge {};
+        edge.Subtract ( next, current );
+
+        AV_ASSERT ( result._count < MAX_POLYGON_VERTICES )
+        result._vertices[ result._count ].Sum ( current, dc / ( dc - dn ), edge );
+
+        result._features[ result._count++ ] = CombineContactFeatures ( planeFeature,
+            MakeContactFeature ( eContactFeature::IncidentEdge, i )
+        );
+    }
+
+    polygon = result;
+}
+
+} // namespace android_vulkan
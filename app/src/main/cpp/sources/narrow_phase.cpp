@@ -0,0 +1,150 @@
+#include <precompiled_headers.hpp>
+#include <narrow_phase.hpp>
+#include <simulation_islands.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+// Small enough to balance the load and big enough to make atomic operation cost negligible.
+constexpr size_t BATCH_SIZE = 32U;
+
+constexpr size_t WORKER_INITIAL_CONTACT_MANIFOLDS = 64U;
+constexpr size_t WORKER_INITIAL_SENSOR_PAIRS = 16U;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+NarrowPhase::Worker::Worker () noexcept:
+    _contactManager ( WORKER_INITIAL_CONTACT_MANIFOLDS )
+{
+    _sensorPairs.reserve ( WORKER_INITIAL_SENSOR_PAIRS );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void NarrowPhase::Run ( ContactManager &contactManager,
+    BroadPhase::Pairs &sensorPairs,
+    BroadPhase::Pairs const &pairs,
+    float deltaTime,
+    WorkerPool &workerPool
+) noexcept
+{
+    size_t const workers = workerPool.GetWorkerCount ();
+
+    if ( _workerCount != workers )
+    {
+        _workers = std::make_unique<Worker[]> ( workers );
+        _workerCount = workers;
+    }
+
+    for ( size_t i = 0U; i < workers; ++i )
+    {
+        Worker &w = _workers[ i ];
+        w._contactManager.Reset ();
+        w._sensorPairs.clear ();
+    }
+
+    _batches.resize ( ( pairs.size () + BATCH_SIZE - 1U ) / BATCH_SIZE );
+    _nextBatch.store ( 0U, std::memory_order_relaxed );
+    _contactManager = &contactManager;
+    _deltaTime = deltaTime;
+    _pairs = &pairs;
+
+    workerPool.Run ( &NarrowPhase::Job, this );
+    sensorPairs.clear ();
+
+    for ( Batch const &batch : _batches )
+    {
+        Worker &w = _workers[ batch._worker ];
+        std::vector<ContactManifold> &manifolds = w._contactManager.GetContactManifolds ();
+        size_t const end = batch._firstManifold + batch._manifoldCount;
+
+        for ( size_t i = batch._firstManifold; i < end; ++i )
+        {
+            contactManager.Append ( manifolds[ i ] );
+        }
+
+        auto const sensorBegin = w._sensorPairs.cbegin () + static_cast<std::ptrdiff_t> ( batch._firstSensorPair );
+        sensorPairs.insert ( sensorPairs.cend (),
+            sensorBegin,
+            sensorBegin + static_cast<std::ptrdiff_t> ( batch._sensorPairCount )
+        );
+    }
+}
+
+void NarrowPhase::Job ( WorkerPool::Context context, size_t worker ) noexcept
+{
+    auto &narrowPhase = *static_cast<NarrowPhase*> ( context );
+    Worker &w = narrowPhase._workers[ worker ];
+    ContactManager &contactManager = w._contactManager;
+    std::vector<ContactManifold> const &manifolds = contactManager.GetContactManifolds ();
+    BroadPhase::Pairs &sensorPairs = w._sensorPairs;
+    ContactManager const &cache = *narrowPhase._contactManager;
+    float const deltaTime = narrowPhase._deltaTime;
+
+    BroadPhase::Pairs const &pairs = *narrowPhase._pairs;
+    size_t const pairCount = pairs.size ();
+    size_t const batchCount = narrowPhase._batches.size ();
+
+    for ( ; ; )
+    {
+        size_t const batchIndex = narrowPhase._nextBatch.fetch_add ( 1U, std::memory_order_relaxed );
+
+        if ( batchIndex >= batchCount )
+            return;
+
+        size_t const first = manifolds.size ();
+        size_t const firstSensorPair = sensorPairs.size ();
+        size_t const begin = batchIndex * BATCH_SIZE;
+        size_t const end = std::min ( begin + BATCH_SIZE, pairCount );
+
+        for ( size_t i = begin; i < end; ++i )
+        {
+            auto const &[a, b] = pairs[ i ];
+            bool const isSensorA = ( *a )->IsSensor ();
+            bool const isSensorB = ( *b )->IsSensor ();
+
+            if ( isSensorA || isSensorB )
+            {
+                // Sensor stops at the boolean test. It has no manifolds. So the contact cache and the velocity solver
+                // never see it.
+                if ( isSensorA != isSensorB && w._contactDetector.IsOverlapped ( *a, *b ) )
+                    sensorPairs.emplace_back ( isSensorA ? a : b, isSensorA ? b : a );
+
+                continue;
+            }
+
+            // Sleeping islands don't need contacts. Awake body which touches sleeping island will wake it up.
+            if ( !SimulationIslands::IsActive ( **a ) && !SimulationIslands::IsActive ( **b ) )
+                continue;
+
+            if ( cache.RestoreManifold ( contactManager, *a, *b ) )
+                continue;
+
+            size_t const before = manifolds.size ();
+            w._contactDetector.Check ( contactManager, *a, *b );
+
+            if ( manifolds.size () != before )
+                continue;
+
+            if ( ( *a )->IsContinuousCollision () || ( *b )->IsContinuousCollision () )
+            {
+                w._contactDetector.CheckSpeculative ( contactManager, *a, *b, deltaTime );
+            }
+        }
+
+        narrowPhase._batches[ batchIndex ] = Batch
+        {
+            ._worker = worker,
+            ._firstManifold = first,
+            ._manifoldCount = manifolds.size () - first,
+            ._firstSensorPair = firstSensorPair,
+            ._sensorPairCount = sensorPairs.size () - firstSensorPair
+        };
+    }
+}
+
+} // namespace android_vulkan
@@ -0,0 +1,121 @@
+#include <precompiled_headers.hpp>
+#include <av_assert.hpp>
+#include <pcm_mixer.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+// AAudio per process stream limit is 39 on some devices. See docs/aaudio-issues.md
+// The software mixer is limited by CPU time only.
+constexpr size_t MAX_TRACKS = 256U;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+PCMMixer::PCMMixer () noexcept
+{
+    _tracks.reserve ( MAX_TRACKS );
+}
+
+bool PCMMixer::Add ( PCMSource &source, eSoundChannel channel ) noexcept
+{
+    Lock ();
+
+    auto const end = _tracks.cend ();
+
+    auto const findResult = std::find_if ( _tracks.cbegin (),
+        end,
+
+        [ &source ] ( Track const &track ) noexcept -> bool {
+            return track._source == &source;
+        }
+    );
+
+    bool const result = ( findResult == end ) & ( _tracks.size () < MAX_TRACKS );
+
+    if ( result ) [[likely]]
+    {
+        _tracks.push_back (
+            Track
+            {
+                ._source = &source,
+                ._channel = static_cast<size_t> ( channel )
+            }
+        );
+    }
+
+    Unlock ();
+    return result;
+}
+
+bool PCMMixer::Remove ( PCMSource &source ) noexcept
+{
+    Lock ();
+
+    auto const end = _tracks.cend ();
+
+    auto const findResult = std::find_if ( _tracks.cbegin (),
+        end,
+
+        [ &source ] ( Track const &track ) noexcept -> bool {
+            return track._source == &source;
+        }
+    );
+
+    bool const result = findResult != end;
+
+    // Erasing keeps the order of the rest tracks. So the mix result does not depend on removing history.
+    if ( result ) [[likely]]
+        _tracks.erase ( findResult );
+
+    Unlock ();
+    return result;
+}
+
+void PCMMixer::Clear () noexcept
+{
+    Lock ();
+    _tracks.clear ();
+    Unlock ();
+}
+
+size_t PCMMixer::GetSourceCount () noexcept
+{
+    Lock ();
+    size_t const result = _tracks.size ();
+    Unlock ();
+    return result;
+}
+
+void PCMMixer::Mix ( std::span<PCMStreamer::PCMType> buffer,
+    std::span<float const, TOTAL_SOUND_CHANNELS> channelVolume
+) noexcept
+{
+    std::memset ( buffer.data (), 0, buffer.size_bytes () );
+    Lock ();
+
+    for ( auto const &track : _tracks )
+        track._source->FillPCM ( buffer, channelVolume[ track._channel ] );
+
+    Unlock ();
+}
+
+void PCMMixer::Lock () noexcept
+{
+    bool expected = false;
+
+    while ( !_lock.compare_exchange_weak ( expected, true ) )
+        expected = false;
+
+    AV_ASSERT ( !expected )
+}
+
+void PCMMixer::Unlock () noexcept
+{
+    _lock.store ( false );
+}
+
+} // namespace android_vulkan
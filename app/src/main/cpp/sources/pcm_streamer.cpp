@@ -1,8 +1,7 @@
 #include <precompiled_headers.hpp>
 #include <av_assert.hpp>
 #include <logger.hpp>
-#include <pcm_streamer.hpp>
-#include <sound_mixer.hpp>
+#include <pcm_mixer.hpp>
 
 
 namespace android_vulkan {
@@ -66,43 +65,37 @@ void PCMStreamer::HandleNonLooped ( std::span<PCMType> buffer,
     Gain /*rightGain*/
 ) noexcept
 {
-    size_t const bufferSamples = buffer.size ();
-    size_t const rest = bufferSamples - consume._bufferSampleCount;
     _offset += consume._pcmSampleCount;
 
-    if ( rest > 0U )
-    {
-        std::memset ( buffer.data () + ( bufferSamples - rest ), 0, rest * sizeof ( PCMType ) );
-        return;
-    }
-
-    if ( _offset < _sampleCount )
+    // The partially filled buffer means the end of PCM data. The rest of the buffer is left as is. It's silence of
+    // this streamer in the mix. The stop request frees the mixer track.
+    if ( ( consume._bufferSampleCount == buffer.size () ) & ( _offset < _sampleCount ) )
         return;
 
     _offset = 0U;
 
     if ( consume._lastPCMBuffer )
     {
-        _onStopRequest ( _soundEmitter );
+        _onStopRequest ( _source );
     }
 }
 
-PCMStreamer::PCMStreamer ( SoundEmitter &soundEmitter, OnStopRequest callback, bool decompressor ) noexcept:
+PCMStreamer::PCMStreamer ( PCMSource &source, OnStopRequest callback, bool decompressor ) noexcept:
     _decompressor ( decompressor ),
     _onStopRequest ( callback ),
-    _soundEmitter ( soundEmitter )
+    _source ( source )
 {
     // NOTHING
 }
 
 bool PCMStreamer::IsFormatSupported ( std::string_view const file, Info const &info ) noexcept
 {
-    if ( info._sampleRate != static_cast<int32_t> ( SoundMixer::GetSampleRate () ) )
+    if ( info._sampleRate != static_cast<int32_t> ( PCMMixer::GetSampleRate () ) )
     {
         LogError ( "PCMStreamer::IsFormatSupported - Unsupported %" PRIu32 " sample rate. Please re-encode sound as "
                 "16 bit mono|stereo signed with %" PRIi32 " sample rate. File: %s",
             info._sampleRate,
-            SoundMixer::GetSampleRate (),
+            PCMMixer::GetSampleRate (),
             file.data ()
         );
 
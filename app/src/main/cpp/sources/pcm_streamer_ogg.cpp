@@ -57,8 +57,8 @@ VorbisCloser::~VorbisCloser () noexcept
 
 //----------------------------------------------------------------------------------------------------------------------
 
-PCMStreamerOGG::PCMStreamerOGG ( SoundEmitter &soundEmitter, OnStopRequest callback ) noexcept:
-    PCMStreamer ( soundEmitter, callback, true )
+PCMStreamerOGG::PCMStreamerOGG ( PCMSource &source, OnStopRequest callback ) noexcept:
+    PCMStreamer ( source, callback, true )
 {
     // NOTHING
 }
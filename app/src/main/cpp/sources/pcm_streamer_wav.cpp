@@ -35,8 +35,8 @@ struct WAVEHeader final
 
 //----------------------------------------------------------------------------------------------------------------------
 
-PCMStreamerWAV::PCMStreamerWAV ( SoundEmitter &soundEmitter, OnStopRequest callback ) noexcept:
-    PCMStreamer ( soundEmitter, callback, false )
+PCMStreamerWAV::PCMStreamerWAV ( PCMSource &source, OnStopRequest callback ) noexcept:
+    PCMStreamer ( source, callback, false )
 {
     // NOTHING
 }
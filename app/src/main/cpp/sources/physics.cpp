@@ -1,10 +1,10 @@
 #include <precompiled_headers.hpp>
+#include <aabb_tree.hpp>
 #include <av_assert.hpp>
 #include <physics.hpp>
-#include <contact_detector.hpp>
 #include <logger.hpp>
+#include <sweep_and_prune.hpp>
 #include <trace.hpp>
-#include <velocity_solver.hpp>
 
 
 namespace android_vulkan {
@@ -16,16 +16,80 @@ constexpr float DEFAULT_TIME_SPEED = 1.0F;
 constexpr float FIXED_TIME_STEP = DEFAULT_TIME_SPEED / static_cast<float> ( STEPS_PER_SECOND );
 constexpr float FIXED_TIME_STEP_INVERSE = 1.0F / FIXED_TIME_STEP;
 
+constexpr size_t DEFAULT_MAX_STEPS = 8U;
+constexpr size_t DEFAULT_SUBSTEPS = 1U;
+
+constexpr size_t INITIAL_BODY_COMMANDS = 256U;
+constexpr size_t INITIAL_CANDIDATE_PAIRS = 4096U;
+constexpr size_t INITIAL_QUERY_BODIES = 256U;
+constexpr size_t INITIAL_SENSOR_EVENTS = 64U;
+constexpr size_t MAX_WORKER_THREADS = 7U;
+
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max ();
+
 } // end of anonymous namespace
 
 //----------------------------------------------------------------------------------------------------------------------
 
 Physics::Physics () noexcept:
+    _broadPhase ( std::make_unique<AABBTree> () ),
     _fixedTimeStep ( FIXED_TIME_STEP ),
     _fixedTimeStepInverse ( FIXED_TIME_STEP_INVERSE ),
+    _maxSteps ( DEFAULT_MAX_STEPS ),
+    _substeps ( DEFAULT_SUBSTEPS ),
     _timeSpeed ( DEFAULT_TIME_SPEED )
 {
-    // NOTHING
+    _candidatePairs.reserve ( INITIAL_CANDIDATE_PAIRS );
+    _commands.reserve ( INITIAL_BODY_COMMANDS );
+    _commandsToApply.reserve ( INITIAL_BODY_COMMANDS );
+    _queryBodies.reserve ( INITIAL_QUERY_BODIES );
+    _sensorEvents.reserve ( INITIAL_SENSOR_EVENTS );
+
+    // The simulation thread is the worker too.
+    size_t const cores = std::thread::hardware_concurrency ();
+    _workerPool.Start ( std::min ( cores > 1U ? cores - 1U : 0U, MAX_WORKER_THREADS ) );
+}
+
+[[maybe_unused]] bool Physics::AddConstraint ( ConstraintRef const &constraint ) noexcept
+{
+    std::lock_guard const lock ( _mutex );
+
+    if ( std::find ( _constraints.cbegin (), _constraints.cend (), constraint ) != _constraints.cend () )
+    {
+        LogError ( "Physics::AddConstraint - Can't insert constraint. Same one presents already." );
+        return false;
+    }
+
+    ApplyBodyCommands ();
+
+    RigidBodyRef const &bodyA = constraint->GetBodyA ();
+    RigidBodyRef const &bodyB = constraint->GetBodyB ();
+
+    if ( !FindBodies ( *bodyA ) || !FindBodies ( *bodyB ) )
+    {
+        LogError ( "Physics::AddConstraint - Can't insert constraint. The rigid bodies must be registered." );
+        return false;
+    }
+
+    _constraints.push_back ( constraint );
+    bodyA->SetAwake ();
+    bodyB->SetAwake ();
+    return true;
+}
+
+[[maybe_unused]] bool Physics::RemoveConstraint ( ConstraintRef const &constraint ) noexcept
+{
+    std::lock_guard const lock ( _mutex );
+    auto const findResult = std::find ( _constraints.cbegin (), _constraints.cend (), constraint );
+
+    if ( findResult != _constraints.cend () )
+    {
+        _constraints.erase ( findResult );
+        return true;
+    }
+
+    LogError ( "Physics::RemoveConstraint - Can't find the constraint." );
+    return false;
 }
 
 [[maybe_unused]] bool Physics::AddGlobalForce ( GlobalForceRef const &globalForce ) noexcept
@@ -54,7 +118,6 @@ Physics::Physics () noexcept:
 
 [[maybe_unused]] bool Physics::AddRigidBody ( RigidBodyRef const &rigidBody ) noexcept
 {
-    std::lock_guard const lock ( _mutex );
     RigidBody &body = *rigidBody.get ();
 
     if ( !body.HasShape() )
@@ -63,29 +126,23 @@ Physics::Physics () noexcept:
         return false;
     }
 
-    auto const result = body.IsKinematic () ? _kinematics.insert ( rigidBody ) : _dynamics.insert ( rigidBody );
-
-    if ( !result.second )
+    if ( !body.OnRegister ( *this ) )
     {
         LogError ( "Physics::AddRigidBody - Can't insert rigid body. Same one presents already." );
         return false;
     }
 
-    body.OnRegister ( *this );
-    ResolveIntegrationType ( body );
+    PushBodyCommand ( rigidBody, body, eBodyCommand::Add );
     return true;
 }
 
 [[maybe_unused]] bool Physics::RemoveRigidBody ( RigidBodyRef const &rigidBody ) noexcept
 {
-    std::lock_guard const lock ( _mutex );
-
     RigidBody &body = *rigidBody.get ();
-    auto const result = body.IsKinematic () ? _kinematics.erase ( rigidBody ) : _dynamics.erase ( rigidBody );
 
-    if ( result > 0U )
+    if ( body.OnUnregister ( *this ) )
     {
-        body.OnUnregister ();
+        PushBodyCommand ( rigidBody, body, eBodyCommand::Remove );
         return true;
     }
 
@@ -93,11 +150,68 @@ Physics::Physics () noexcept:
     return false;
 }
 
+[[maybe_unused]] eBroadPhase Physics::GetBroadPhase () const noexcept
+{
+    return _broadPhase->GetType ();
+}
+
+[[maybe_unused]] void Physics::SetBroadPhase ( eBroadPhase type ) noexcept
+{
+    std::lock_guard const lock ( _mutex );
+
+    if ( _broadPhase->GetType () == type )
+        return;
+
+    ApplyBodyCommands ();
+
+    switch ( type )
+    {
+        case eBroadPhase::AABBTree:
+            _broadPhase = std::make_unique<AABBTree> ();
+        break;
+
+        case eBroadPhase::SweepAndPrune:
+            _broadPhase = std::make_unique<SweepAndPrune> ();
+        break;
+    }
+
+    for ( auto const &body : _kinematics )
+        _broadPhase->Insert ( body );
+
+    for ( auto const &body : _dynamics )
+        _broadPhase->Insert ( body );
+
+    _boundsDirty.store ( true, std::memory_order_relaxed );
+}
+
 std::vector<ContactManifold> const &Physics::GetContactManifolds () const noexcept
 {
     return _contactManager.GetContactManifolds ();
 }
 
+[[maybe_unused]] size_t Physics::GetWorkerThreads () const noexcept
+{
+    return _workerPool.GetWorkerCount () - 1U;
+}
+
+[[maybe_unused]] void Physics::SetWorkerThreads ( size_t threads ) noexcept
+{
+    std::lock_guard const lock ( _mutex );
+    _workerPool.Start ( threads );
+}
+
+[[maybe_unused]] size_t Physics::GetSubsteps () const noexcept
+{
+    return _substeps;
+}
+
+[[maybe_unused]] void Physics::SetSubsteps ( size_t substeps ) noexcept
+{
+    AV_ASSERT ( substeps > 0U )
+    std::lock_guard const lock ( _mutex );
+    _substeps = substeps;
+}
+
 [[maybe_unused]] float Physics::GetTimeSpeed () const noexcept
 {
     return _timeSpeed;
@@ -111,15 +225,49 @@ std::vector<ContactManifold> const &Physics::GetContactManifolds () const noexce
     _fixedTimeStepInverse = 1.0F / _fixedTimeStep;
 }
 
+[[maybe_unused]] size_t Physics::GetMaxSteps () const noexcept
+{
+    return _maxSteps;
+}
+
+[[maybe_unused]] void Physics::SetMaxSteps ( size_t steps ) noexcept
+{
+    AV_ASSERT ( steps > 0U )
+    std::lock_guard const lock ( _mutex );
+    _maxSteps = steps;
+}
+
+[[maybe_unused]] std::vector<SensorEvent> const &Physics::GetSensorEvents () const noexcept
+{
+    return _sensorEvents;
+}
+
+[[maybe_unused]] PhysicsPhaseTimings const &Physics::GetPhaseTimings () const noexcept
+{
+    return _phaseTimings;
+}
+
+[[maybe_unused]] void Physics::ResetPhaseTimings () noexcept
+{
+    std::lock_guard const lock ( _mutex );
+    _phaseTimings = {};
+}
+
 bool Physics::IsPaused () const noexcept
 {
     return _isPause;
 }
 
+void Physics::OnBoundsChanged () noexcept
+{
+    _boundsDirty.store ( true, std::memory_order_relaxed );
+}
+
 void Physics::OnIntegrationTypeChanged ( RigidBody &rigidBody ) noexcept
 {
-    std::lock_guard const lock ( _mutex );
-    ResolveIntegrationType ( rigidBody );
+    // Note the body does not hold the reference. It's safe because the registered body is referenced by the dense
+    // arrays or by the pending add command. Pending remove command always follows this one.
+    PushBodyCommand ( {}, rigidBody, eBodyCommand::UpdateIntegrationType );
 }
 
 void Physics::Pause () noexcept
@@ -131,84 +279,99 @@ void Physics::PenetrationTest ( std::vector<Penetration> &result,
     EPA &epa,
     ShapeRef const &shape,
     uint32_t groups
-) const noexcept
+) noexcept
 {
     result.clear ();
-    Shape const &s = *shape;
 
-    auto check = [ &result, &epa, &s, groups ] ( std::unordered_set<RigidBodyRef> const &set ) noexcept {
-        GJK gjk {};
+    std::lock_guard const lock ( _mutex );
+    PrepareQuery ();
+    QueryPenetration ( result, epa, *shape, groups );
+}
 
-        for ( auto &body : set )
-        {
-            Shape const &bodyShape = body->GetShape ();
-            gjk.Reset ();
+[[maybe_unused]] void Physics::PenetrationTestBatch ( std::vector<Penetration> &result,
+    std::vector<size_t> &offsets,
+    EPA &epa,
+    std::span<ShapeQuery const> queries
+) noexcept
+{
+    result.clear ();
+    offsets.clear ();
+    offsets.reserve ( queries.size () + 1U );
 
-            if ( !( bodyShape.GetCollisionGroups () & groups ) || !gjk.Run ( bodyShape, s ) )
-                continue;
+    std::lock_guard const lock ( _mutex );
+    PrepareQuery ();
 
-            epa.Reset ();
+    for ( auto const &query : queries )
+    {
+        offsets.push_back ( result.size () );
+        QueryPenetration ( result, epa, *query._shape, query._groups );
+    }
 
-            if ( !epa.Run ( gjk.GetSimplex (), bodyShape, s ) )
-                continue;
+    offsets.push_back ( result.size () );
+}
 
-            result.emplace_back (
-                Penetration {
-                    ._body = body,
-                    ._depth = epa.GetDepth (),
-                    ._normal = epa.GetNormal ()
-                }
-            );
-        }
-    };
+bool Physics::Raycast ( RaycastResult &result, GXVec3 const &from, GXVec3 const &to, uint32_t groups ) noexcept
+{
+    RayCaster rayCaster {};
 
-    check ( _kinematics );
-    check ( _dynamics );
+    std::lock_guard const lock ( _mutex );
+    PrepareQuery ();
+    return QueryRay ( result, rayCaster, from, to, groups );
 }
 
-bool Physics::Raycast ( RaycastResult &result, GXVec3 const &from, GXVec3 const &to, uint32_t groups ) const noexcept
+[[maybe_unused]] void Physics::RaycastBatch ( std::vector<RaycastResult> &result,
+    std::span<RaycastQuery const> queries
+) noexcept
 {
-    float dist = std::numeric_limits<float>::max ();
+    size_t const count = queries.size ();
+    result.resize ( count );
 
-    bool isHit = false;
     RayCaster rayCaster {};
-    RaycastResult current {};
-
-    auto check = [ & ] ( std::unordered_set<RigidBodyRef> const &set ) noexcept {
-        for ( auto &body : set )
-        {
-            Shape const &shape = body->GetShape ();
-
-            if ( !( shape.GetCollisionGroups () & groups ) || !rayCaster.Run ( current, from, to, shape ) )
-                continue;
+    RaycastQuery const* q = queries.data ();
+    RaycastResult* r = result.data ();
 
-            float const d = current._point.SquaredDistance ( from );
+    std::lock_guard const lock ( _mutex );
+    PrepareQuery ();
 
-            if ( d >= dist )
-                continue;
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        RaycastQuery const &query = q[ i ];
+        RaycastResult &hit = r[ i ];
 
-            dist = d;
-            result._point = current._point;
-            result._normal = current._normal;
-            result._body = body;
-            isHit = true;
+        if ( !QueryRay ( hit, rayCaster, query._from, query._to, query._groups ) )
+        {
+            hit._body.reset ();
         }
-    };
-
-    check ( _kinematics );
-    check ( _dynamics );
-
-    return isHit;
+    }
 }
 
 void Physics::Reset () noexcept
 {
     std::lock_guard const lock ( _mutex );
+    ApplyBodyCommands ();
+
+    auto unregister = [ this ] ( std::vector<RigidBodyRef> &bodies ) noexcept {
+        for ( auto const &body : bodies )
+        {
+            body->SetPhysicsIndex ( INVALID_INDEX );
+            [[maybe_unused]] bool const result = body->OnUnregister ( *this );
+        }
+
+        bodies.clear ();
+    };
 
+    _broadPhase->Reset ();
+    _constraints.clear ();
     _contactManager.Reset ();
-    _dynamics.clear ();
+    unregister ( _dynamics );
     _globalForces.clear ();
-    _kinematics.clear ();
+    unregister ( _kinematics );
+
+    _sensorEvents.clear ();
+    _sensorKeysPrevious.clear ();
+    _sensorOverlaps.clear ();
+    _sensorPairs.clear ();
+    _boundsDirty.store ( true, std::memory_order_relaxed );
 }
 
 void Physics::Resume () noexcept
@@ -224,6 +387,10 @@ void Physics::Simulate ( float deltaTime ) noexcept
 {
     AV_TRACE ( "Physics simulation" )
 
+    // The events are filled under the mutex. See UpdateSensorEvents.
+    std::lock_guard const lock ( _mutex );
+    _sensorEvents.clear ();
+
     if ( _isPause )
     {
         if ( _debugRun )
@@ -235,16 +402,56 @@ void Physics::Simulate ( float deltaTime ) noexcept
         return;
     }
 
-    std::lock_guard const lock ( _mutex );
-    _accumulator += deltaTime * _timeSpeed;
+    ApplyBodyCommands ();
+
+    // The frame time above the limit is dropped. So the simulation slows down instead of falling into the spiral of
+    // death when the frame hitches.
+    float const maxAccumulator = static_cast<float> ( _maxSteps ) * _fixedTimeStep;
+    _accumulator = std::min ( _accumulator + deltaTime * _timeSpeed, maxAccumulator );
+
+    float const substepTime = _fixedTimeStep / static_cast<float> ( _substeps );
 
     while ( _accumulator >= _fixedTimeStep )
     {
         CollectContacts ();
-        VelocitySolver::Run ( _contactManager, _fixedTimeStepInverse );
-        Integrate ();
+        auto const islandsStart = std::chrono::steady_clock::now ();
+
+        _simulationIslands.Build ( _dynamics, _contactManager.GetContactManifolds (), _constraints );
+        CollectActiveConstraints ();
+        _phaseTimings._solve += std::chrono::steady_clock::now () - islandsStart;
+
+        for ( size_t substep = 0U; substep < _substeps; ++substep )
+        {
+            auto const solveStart = std::chrono::steady_clock::now ();
+
+            // Collision detection runs once per step. The contacts follow the bodies between the substeps.
+            if ( substep > 0U )
+                _contactManager.Advance ( substepTime );
+
+            _velocitySolver.Run ( _contactManager,
+                _activeConstraints,
+                _fixedTimeStepInverse,
+                _substeps,
+                _dynamics.size (),
+                _workerPool
+            );
+
+            auto const integrateStart = std::chrono::steady_clock::now ();
+            Integrate ( substepTime );
+
+            _phaseTimings._solve += integrateStart - solveStart;
+            _phaseTimings._integrate += std::chrono::steady_clock::now () - integrateStart;
+        }
+
+        auto const sleepStart = std::chrono::steady_clock::now ();
+        _simulationIslands.UpdateSleep ();
+        _phaseTimings._integrate += std::chrono::steady_clock::now () - sleepStart;
+        ++_phaseTimings._steps;
 
         _accumulator -= _fixedTimeStep;
+
+        // The bodies moved after the broadphase update of the step.
+        _boundsDirty.store ( true, std::memory_order_relaxed );
     }
 }
 
@@ -252,24 +459,30 @@ void Physics::SweepTest ( std::vector<RigidBodyRef> &result, ShapeRef const &swe
 {
     result.clear ();
 
-    auto check = [ &result, groups ] ( Shape const &sweep, std::unordered_set<RigidBodyRef> const &set ) noexcept {
-        GJK gjk {};
+    std::lock_guard const lock ( _mutex );
+    PrepareQuery ();
+    QuerySweep ( result, *sweepShape, groups );
+}
 
-        for ( auto &body : set )
-        {
-            Shape const &bodyShape = body->GetShape ();
-            gjk.Reset ();
+[[maybe_unused]] void Physics::SweepTestBatch ( std::vector<RigidBodyRef> &result,
+    std::vector<size_t> &offsets,
+    std::span<ShapeQuery const> queries
+) noexcept
+{
+    result.clear ();
+    offsets.clear ();
+    offsets.reserve ( queries.size () + 1U );
 
-            if ( ( bodyShape.GetCollisionGroups () & groups ) && gjk.Run ( sweep, bodyShape ) )
-            {
-                result.emplace_back ( body );
-            }
-        }
-    };
+    std::lock_guard const lock ( _mutex );
+    PrepareQuery ();
+
+    for ( auto const &query : queries )
+    {
+        offsets.push_back ( result.size () );
+        QuerySweep ( result, *query._shape, query._groups );
+    }
 
-    Shape const &sweep = *sweepShape;
-    check ( sweep, _kinematics );
-    check ( sweep, _dynamics );
+    offsets.push_back ( result.size () );
 }
 
 void Physics::OnDebugRun () noexcept
@@ -277,63 +490,414 @@ void Physics::OnDebugRun () noexcept
     _debugRun = true;
 }
 
-void Physics::CollectContacts () noexcept
+void Physics::ApplyBodyCommands () noexcept
 {
-    _contactManager.Reset ();
-    auto end = _dynamics.end ();
+    LockCommands ();
+    _commandsToApply.swap ( _commands );
+    UnlockCommands ();
 
-    for ( auto i = _dynamics.begin (); i != end; ++i )
+    if ( !_commandsToApply.empty () )
+        _boundsDirty.store ( true, std::memory_order_relaxed );
+
+    for ( auto &command : _commandsToApply )
     {
-        for ( auto &kinematic : _kinematics )
-            _contactDetector.Check ( _contactManager, *i, kinematic );
+        RigidBody &body = *command._body;
+
+        switch ( command._type )
+        {
+            case eBodyCommand::Add:
+                AppendBody ( body.IsKinematic () ? _kinematics : _dynamics, command._ref );
+                _broadPhase->Insert ( command._ref );
+            break;
+
+            case eBodyCommand::Remove:
+            {
+                std::vector<RigidBodyRef>* bodies = FindBodies ( body );
+
+                if ( !bodies ) [[unlikely]]
+                    break;
+
+                EraseBody ( *bodies, body.GetPhysicsIndex () );
 
-        for ( auto j = i; ++j != end; )
+                std::erase_if ( _constraints,
+
+                    [ &body ] ( ConstraintRef const &constraint ) noexcept -> bool {
+                        return constraint->GetBodyA ().get () == &body || constraint->GetBodyB ().get () == &body;
+                    }
+                );
+
+                _broadPhase->Remove ( body );
+            }
+            break;
+
+            case eBodyCommand::UpdateIntegrationType:
+                ResolveIntegrationType ( body );
+            break;
+        }
+    }
+
+    _commandsToApply.clear ();
+}
+
+void Physics::CollectActiveConstraints () noexcept
+{
+    _activeConstraints.clear ();
+
+    for ( auto const &constraint : _constraints )
+    {
+        if ( constraint->IsActive () )
         {
-            _contactDetector.Check ( _contactManager, *i, *j );
+            _activeConstraints.push_back ( constraint.get () );
         }
     }
 }
 
-void Physics::Integrate () noexcept
+void Physics::CollectContacts () noexcept
+{
+    _contactManager.Reset ();
+
+    // Broadphase: only bodies with overlapped fat bounds go to the narrowphase.
+    auto const broadPhaseStart = std::chrono::steady_clock::now ();
+    _broadPhase->Update ( _fixedTimeStep );
+    _broadPhase->CollectPairs ( _candidatePairs );
+
+    auto const narrowPhaseStart = std::chrono::steady_clock::now ();
+    _narrowPhase.Run ( _contactManager, _sensorPairs, _candidatePairs, _fixedTimeStep, _workerPool );
+    UpdateSensorEvents ();
+
+    _phaseTimings._broadPhase += narrowPhaseStart - broadPhaseStart;
+    _phaseTimings._narrowPhase += std::chrono::steady_clock::now () - narrowPhaseStart;
+}
+
+void Physics::Integrate ( float deltaTime ) noexcept
 {
     for ( auto &kinematic : _kinematics )
-        kinematic->UpdatePositionAndRotation ( _fixedTimeStep );
+        kinematic->UpdatePositionAndRotation ( deltaTime );
 
     for ( auto &dynamic : _dynamics )
     {
         for ( auto const &globalForce : _globalForces )
             globalForce->Apply ( dynamic );
 
-        dynamic->Integrate ( _fixedTimeStep );
+        dynamic->Integrate ( deltaTime );
     }
 }
 
-void Physics::ResolveIntegrationType ( RigidBody &rigidBody ) noexcept
+void Physics::UpdateSensorEvents () noexcept
 {
-    auto resolve = [ & ] ( auto &targetSet, auto &otherSet ) noexcept {
-        auto end = otherSet.end ();
+    if ( _sensorPairs.empty () && _sensorOverlaps.empty () )
+        return;
+
+    auto const toKey = [] ( RigidBodyRef const &sensor, RigidBodyRef const &other ) noexcept -> SensorKey {
+        return std::make_pair ( sensor.get (), other.get () );
+    };
+
+    _sensorKeys.clear ();
+
+    for ( auto const &[sensor, other] : _sensorPairs )
+        _sensorKeys.push_back ( toKey ( *sensor, *other ) );
+
+    std::sort ( _sensorKeys.begin (), _sensorKeys.end () );
 
-        auto findResult = std::find_if ( otherSet.begin (),
-            end,
-            [ & ] ( RigidBodyRef const &body ) noexcept -> bool {
-                return body.get () == &rigidBody;
+    // The keys are used for lookup only. The events follow deterministic order of the pairs.
+    for ( auto const &[sensor, other] : _sensorPairs )
+    {
+        bool const isStay = std::binary_search ( _sensorKeysPrevious.cbegin (),
+            _sensorKeysPrevious.cend (),
+            toKey ( *sensor, *other )
+        );
+
+        _sensorEvents.push_back (
+            SensorEvent
+            {
+                ._sensor = *sensor,
+                ._other = *other,
+                ._type = isStay ? eSensorEvent::Stay : eSensorEvent::Enter
             }
         );
+    }
 
-        if ( findResult == end )
-            return;
+    for ( SensorOverlap &overlap : _sensorOverlaps )
+    {
+        SensorKey const key = toKey ( overlap._sensor, overlap._other );
+
+        if ( std::binary_search ( _sensorKeys.cbegin (), _sensorKeys.cend (), key ) )
+            continue;
+
+        _sensorEvents.push_back (
+            SensorEvent
+            {
+                ._sensor = std::move ( overlap._sensor ),
+                ._other = std::move ( overlap._other ),
+                ._type = eSensorEvent::Exit
+            }
+        );
+    }
+
+    _sensorOverlaps.clear ();
+
+    for ( auto const &[sensor, other] : _sensorPairs )
+    {
+        _sensorOverlaps.push_back (
+            SensorOverlap
+            {
+                ._sensor = *sensor,
+                ._other = *other
+            }
+        );
+    }
+
+    std::swap ( _sensorKeys, _sensorKeysPrevious );
+}
+
+void Physics::QueryPenetration ( std::vector<Penetration> &result,
+    EPA &epa,
+    Shape const &shape,
+    uint32_t groups
+) noexcept
+{
+    GXAABB const &bounds = shape.GetBoundsWorld ();
+    _broadPhase->QueryBounds ( _queryBodies, bounds );
+    GJK gjk {};
+
+    for ( RigidBodyRef const* body : _queryBodies )
+    {
+        Shape const &bodyShape = ( *body )->GetShape ();
+
+        if ( !( bodyShape.GetCollisionGroups () & groups ) || !bodyShape.GetBoundsWorld ().IsOverlapped ( bounds ) )
+            continue;
+
+        if ( bodyShape.GetType () == eShapeType::Mesh )
+        {
+            // The deepest triangle contact represents the mesh.
+            auto const &contacts = _meshContactDetector.Run ( static_cast<ShapeMesh const &> ( bodyShape ), shape );
+
+            auto const deepest = std::max_element ( contacts.cbegin (),
+                contacts.cend (),
+
+                [] ( MeshContactDetector::MeshContact const &a, MeshContactDetector::MeshContact const &b ) noexcept {
+                    return a._penetration < b._penetration;
+                }
+            );
+
+            if ( deepest == contacts.cend () )
+                continue;
+
+            result.emplace_back (
+                Penetration {
+                    ._body = *body,
+                    ._depth = deepest->_penetration,
+                    ._normal = deepest->_normal
+                }
+            );
+
+            continue;
+        }
+
+        gjk.Reset ();
+
+        if ( !gjk.Run ( bodyShape, shape ) )
+            continue;
+
+        epa.Reset ();
+
+        if ( !epa.Run ( gjk.GetSimplex (), bodyShape, shape ) )
+            continue;
+
+        result.emplace_back (
+            Penetration {
+                ._body = *body,
+                ._depth = epa.GetDepth (),
+                ._normal = epa.GetNormal ()
+            }
+        );
+    }
+}
+
+bool Physics::QueryRay ( RaycastResult &result,
+    RayCaster &rayCaster,
+    GXVec3 const &from,
+    GXVec3 const &to,
+    uint32_t groups
+) noexcept
+{
+    _broadPhase->QueryRay ( _queryBodies, from, to );
 
-        targetSet.insert ( *findResult );
-        otherSet.erase ( findResult );
+    float dist = std::numeric_limits<float>::max ();
+    bool isHit = false;
+    RaycastResult current {};
+
+    for ( RigidBodyRef const* body : _queryBodies )
+    {
+        Shape const &shape = ( *body )->GetShape ();
+
+        if ( !( shape.GetCollisionGroups () & groups ) || !rayCaster.Run ( current, from, to, shape ) )
+            continue;
+
+        float const d = current._point.SquaredDistance ( from );
+
+        if ( d >= dist )
+            continue;
+
+        dist = d;
+        result._point = current._point;
+        result._normal = current._normal;
+        result._body = *body;
+        isHit = true;
+    }
+
+    return isHit;
+}
+
+void Physics::QuerySweep ( std::vector<RigidBodyRef> &result, Shape const &sweep, uint32_t groups ) noexcept
+{
+    GXAABB const &bounds = sweep.GetBoundsWorld ();
+    _broadPhase->QueryBounds ( _queryBodies, bounds );
+    GJK gjk {};
+
+    for ( RigidBodyRef const* body : _queryBodies )
+    {
+        Shape const &bodyShape = ( *body )->GetShape ();
+
+        if ( !( bodyShape.GetCollisionGroups () & groups ) || !bodyShape.GetBoundsWorld ().IsOverlapped ( bounds ) )
+            continue;
+
+        if ( bodyShape.GetType () == eShapeType::Mesh )
+        {
+            if ( !_meshContactDetector.Run ( static_cast<ShapeMesh const &> ( bodyShape ), sweep ).empty () )
+                result.emplace_back ( *body );
+
+            continue;
+        }
+
+        gjk.Reset ();
+
+        if ( gjk.Run ( sweep, bodyShape ) )
+        {
+            result.emplace_back ( *body );
+        }
+    }
+}
+
+void Physics::PrepareQuery () noexcept
+{
+    ApplyBodyCommands ();
+
+    // The refit is O(n). So a script which casts many single rays per frame pays for it once.
+    if ( _boundsDirty.exchange ( false, std::memory_order_relaxed ) )
+    {
+        _broadPhase->Update ( _fixedTimeStep );
+    }
+}
+
+void Physics::PushBodyCommand ( RigidBodyRef const &ref, RigidBody &body, eBodyCommand type ) noexcept
+{
+    BodyCommand command
+    {
+        ._ref = ref,
+        ._body = &body,
+        ._type = type
     };
 
-    if ( rigidBody.IsKinematic () )
+    for ( ; ; )
     {
-        resolve ( _kinematics, _dynamics );
+        LockCommands ();
+        size_t const capacity = _commands.capacity ();
+
+        if ( _commands.size () < capacity ) [[likely]]
+        {
+            _commands.push_back ( std::move ( command ) );
+            UnlockCommands ();
+            return;
+        }
+
+        UnlockCommands ();
+
+        // The queue is full. The heap allocation happens outside of the lock. So the other registering threads and
+        // the step boundary never spin through it.
+        std::vector<BodyCommand> grown {};
+        grown.reserve ( std::max ( capacity * 2U, INITIAL_BODY_COMMANDS ) );
+
+        LockCommands ();
+
+        // Other thread could grow the queue meanwhile. The old storage is freed outside of the lock too.
+        if ( _commands.capacity () == capacity )
+        {
+            grown.assign ( std::make_move_iterator ( _commands.begin () ),
+                std::make_move_iterator ( _commands.end () )
+            );
+
+            _commands.swap ( grown );
+        }
+
+        UnlockCommands ();
+    }
+}
+
+void Physics::LockCommands () noexcept
+{
+    bool expected = false;
+
+    while ( !_commandLock.compare_exchange_weak ( expected, true ) )
+        expected = false;
+
+    AV_ASSERT ( !expected )
+}
+
+void Physics::UnlockCommands () noexcept
+{
+    _commandLock.store ( false );
+}
+
+void Physics::ResolveIntegrationType ( RigidBody &rigidBody ) noexcept
+{
+    std::vector<RigidBodyRef>* source = FindBodies ( rigidBody );
+    std::vector<RigidBodyRef> &target = rigidBody.IsKinematic () ? _kinematics : _dynamics;
+
+    // The body was not added yet or it's already in the right array.
+    if ( !source || source == &target )
         return;
+
+    uint32_t const index = rigidBody.GetPhysicsIndex ();
+    RigidBodyRef const body = ( *source )[ index ];
+    EraseBody ( *source, index );
+    AppendBody ( target, body );
+}
+
+std::vector<RigidBodyRef>* Physics::FindBodies ( RigidBody const &rigidBody ) noexcept
+{
+    // Note the integration type could be changed after the body was put to the array. So both arrays are checked.
+    uint32_t const index = rigidBody.GetPhysicsIndex ();
+
+    for ( std::vector<RigidBodyRef>* bodies : { &_dynamics, &_kinematics } )
+    {
+        if ( index < bodies->size () && ( *bodies )[ index ].get () == &rigidBody )
+        {
+            return bodies;
+        }
+    }
+
+    return nullptr;
+}
+
+void Physics::AppendBody ( std::vector<RigidBodyRef> &bodies, RigidBodyRef const &body ) noexcept
+{
+    body->SetPhysicsIndex ( static_cast<uint32_t> ( bodies.size () ) );
+    bodies.push_back ( body );
+}
+
+void Physics::EraseBody ( std::vector<RigidBodyRef> &bodies, uint32_t index ) noexcept
+{
+    bodies[ index ]->SetPhysicsIndex ( INVALID_INDEX );
+    RigidBodyRef &last = bodies.back ();
+
+    if ( bodies[ index ] != last )
+    {
+        last->SetPhysicsIndex ( index );
+        bodies[ index ] = std::move ( last );
     }
 
-    resolve ( _dynamics, _kinematics );
+    bodies.pop_back ();
 }
 
 } // namespace android_vulkan
@@ -1,5 +1,7 @@
 #include <precompiled_headers.hpp>
+#include <android_vulkan_sdk/mesh2.hpp>
 #include <av_assert.hpp>
+#include <file.hpp>
 #include <guid_generator.hpp>
 #include <logger.hpp>
 #include <pbr/coordinate_system.hpp>
@@ -10,6 +12,8 @@
 #include <platform/android/pbr/rigid_body_component.hpp>
 #include <physics.hpp>
 #include <shape_box.hpp>
+#include <shape_capsule.hpp>
+#include <shape_mesh.hpp>
 #include <shape_sphere.hpp>
 
 GX_DISABLE_COMMON_WARNINGS
@@ -29,6 +33,7 @@ namespace {
 
 [[maybe_unused]] constexpr uint32_t RIGID_BODY_COMPONENT_DESC_FORMAT_VERSION = 1U;
 [[maybe_unused]] constexpr uint32_t BOX_SHAPE_DESC_FORMAT_VERSION = 1U;
+constexpr uint32_t MESH_INDEX16_LIMIT = 1U << 16U;
 
 } // end of anonymous namespace
 
@@ -204,10 +209,22 @@ bool RigidBodyComponent::Init ( lua_State &vm ) noexcept
             .name = "av_RigidBodyComponentSetLocation",
             .func = &RigidBodyComponent::OnSetLocation
         },
+        {
+            .name = "av_RigidBodyComponentSetSensor",
+            .func = &RigidBodyComponent::OnSetSensor
+        },
         {
             .name = "av_RigidBodyComponentSetShapeBox",
             .func = &RigidBodyComponent::OnSetShapeBox
         },
+        {
+            .name = "av_RigidBodyComponentSetShapeCapsule",
+            .func = &RigidBodyComponent::OnSetShapeCapsule
+        },
+        {
+            .name = "av_RigidBodyComponentSetShapeMesh",
+            .func = &RigidBodyComponent::OnSetShapeMesh
+        },
         {
             .name = "av_RigidBodyComponentSetShapeSphere",
             .func = &RigidBodyComponent::OnSetShapeSphere
@@ -333,6 +350,19 @@ int RigidBodyComponent::OnGetLocation ( lua_State* state )
     return 0;
 }
 
+int RigidBodyComponent::OnSetSensor ( lua_State* state )
+{
+    auto &self = *static_cast<RigidBodyComponent*> ( lua_touserdata ( state, 1 ) );
+    android_vulkan::RigidBody &body = *self._rigidBody;
+
+    if ( lua_toboolean ( state, 2 ) )
+        body.EnableSensor ();
+    else
+        body.DisableSensor ();
+
+    return 0;
+}
+
 int RigidBodyComponent::OnSetShapeBox ( lua_State* state )
 {
     auto &self = *static_cast<RigidBodyComponent*> ( lua_touserdata ( state, 1 ) );
@@ -345,6 +375,77 @@ int RigidBodyComponent::OnSetShapeBox ( lua_State* state )
     return 0;
 }
 
+int RigidBodyComponent::OnSetShapeCapsule ( lua_State* state )
+{
+    auto &self = *static_cast<RigidBodyComponent*> ( lua_touserdata ( state, 1 ) );
+
+    android_vulkan::ShapeRef shape = std::make_shared<android_vulkan::ShapeCapsule> (
+        static_cast<float> ( lua_tonumber ( state, 2 ) ),
+        static_cast<float> ( lua_tonumber ( state, 3 ) )
+    );
+
+    self.Setup ( shape, lua_toboolean ( state, 4 ) );
+    return 0;
+}
+
+int RigidBodyComponent::OnSetShapeMesh ( lua_State* state )
+{
+    auto &self = *static_cast<RigidBodyComponent*> ( lua_touserdata ( state, 1 ) );
+    char const* meshFile = lua_tostring ( state, 2 );
+
+    if ( !meshFile ) [[unlikely]]
+    {
+        android_vulkan::LogWarning ( "pbr::RigidBodyComponent::OnSetShapeMesh - Mesh file is not specified." );
+        return 0;
+    }
+
+    android_vulkan::File file ( meshFile );
+
+    if ( !file.LoadContent () ) [[unlikely]]
+        return 0;
+
+    std::vector<uint8_t> const &content = file.GetContent ();
+    uint8_t const* rawData = content.data ();
+    auto const &header = *reinterpret_cast<android_vulkan::Mesh2Header const*> ( rawData );
+
+    auto const* positions = reinterpret_cast<android_vulkan::Mesh2Position const*> (
+        rawData + static_cast<size_t> ( header._positionDataOffset )
+    );
+
+    // Render geometry is stored in renderer units. Physics works in meters.
+    std::vector<GXVec3> vertices {};
+    vertices.reserve ( static_cast<size_t> ( header._vertexCount ) );
+
+    for ( uint32_t i = 0U; i < header._vertexCount; ++i )
+    {
+        android_vulkan::Mesh2Position const &p = positions[ i ];
+        GXVec3 &v = vertices.emplace_back ( p[ 0U ], p[ 1U ], p[ 2U ] );
+        v.Multiply ( v, METERS_IN_UNIT );
+    }
+
+    uint8_t const* indexData = rawData + static_cast<size_t> ( header._indexDataOffset );
+    std::vector<uint32_t> indices {};
+    indices.reserve ( static_cast<size_t> ( header._indexCount ) );
+
+    if ( header._indexCount < MESH_INDEX16_LIMIT )
+    {
+        auto const* source = reinterpret_cast<android_vulkan::Mesh2Index16 const*> ( indexData );
+        indices.insert ( indices.end (), source, source + header._indexCount );
+    }
+    else
+    {
+        auto const* source = reinterpret_cast<android_vulkan::Mesh2Index32 const*> ( indexData );
+        indices.insert ( indices.end (), source, source + header._indexCount );
+    }
+
+    android_vulkan::ShapeRef shape = std::make_shared<android_vulkan::ShapeMesh> ( vertices, indices );
+
+    // Triangle mesh has no volume. So it's static level geometry only.
+    self._rigidBody->EnableKinematic ();
+    self.Setup ( shape, lua_toboolean ( state, 3 ) );
+    return 0;
+}
+
 int RigidBodyComponent::OnSetShapeSphere ( lua_State* state )
 {
     auto &self = *static_cast<RigidBodyComponent*> ( lua_touserdata ( state, 1 ) );
@@ -175,10 +175,18 @@ bool Scene::OnInitDevice ( android_vulkan::Renderer &renderer,
             .name = "av_SceneGetPenetrationBox",
             .func = &Scene::OnGetPenetrationBox
         },
+        {
+            .name = "av_SceneGetPenetrationBoxBatch",
+            .func = &Scene::OnGetPenetrationBoxBatch
+        },
         {
             .name = "av_SceneGetPhysicsToRendererScaleFactor",
             .func = &Scene::OnGetPhysicsToRendererScaleFactor
         },
+        {
+            .name = "av_SceneGetSensorEvents",
+            .func = &Scene::OnGetSensorEvents
+        },
         {
             .name = "av_SceneGetRendererToPhysicsScaleFactor",
             .func = &Scene::OnGetRendererToPhysicsScaleFactor
@@ -207,6 +215,10 @@ bool Scene::OnInitDevice ( android_vulkan::Renderer &renderer,
             .name = "av_SceneRaycast",
             .func = &Scene::OnRaycast
         },
+        {
+            .name = "av_SceneRaycastBatch",
+            .func = &Scene::OnRaycastBatch
+        },
         {
             .name = "av_SceneSetActiveCamera",
             .func = &Scene::OnSetActiveCamera
@@ -289,12 +301,13 @@ bool Scene::OnInitDevice ( android_vulkan::Renderer &renderer,
         return false;
 
     return _scriptablePenetration.Init ( *_vm ) && _scriptableRaycastResult.Init ( *_vm ) &&
-        ScriptableSweepTestResult::Init ( *_vm ) && _gamepad.Init ( *_vm );
+        ScriptableSensorEvents::Init ( *_vm ) && ScriptableSweepTestResult::Init ( *_vm ) && _gamepad.Init ( *_vm );
 }
 
 void Scene::OnDestroyDevice () noexcept
 {
     ScriptableSweepTestResult::Destroy ( *_vm );
+    ScriptableSensorEvents::Destroy ( *_vm );
     _scriptableRaycastResult.Destroy ( *_vm );
     _scriptablePenetration.Destroy ( *_vm );
 
@@ -308,9 +321,24 @@ void Scene::OnDestroyDevice () noexcept
     _penetrations.clear ();
     _penetrations.shrink_to_fit ();
 
+    _penetrationOffsets.clear ();
+    _penetrationOffsets.shrink_to_fit ();
+
+    _raycastQueries.clear ();
+    _raycastQueries.shrink_to_fit ();
+
+    _raycastResults.clear ();
+    _raycastResults.shrink_to_fit ();
+
     _sweepTestResult.clear ();
     _sweepTestResult.shrink_to_fit ();
 
+    _shapeQueries.clear ();
+    _shapeQueries.shrink_to_fit ();
+
+    _batchShapes.clear ();
+    _batchShapes.shrink_to_fit ();
+
     _shapeBoxes[ 0U ] = nullptr;
     _shapeBoxes[ 1U ] = nullptr;
 
@@ -631,6 +659,58 @@ int Scene::DoPenetrationBox ( lua_State &vm, GXMat4 const &local, GXVec3 const &
     return static_cast<int> ( _scriptablePenetration.PublishResult ( vm, _penetrations ) );
 }
 
+int Scene::DoPenetrationBoxBatch ( lua_State &vm, int localIdx, int sizeIdx, size_t count, uint32_t groups ) noexcept
+{
+    if ( !lua_checkstack ( &vm, 2 ) ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "pbr::Scene::DoPenetrationBoxBatch - Stack is too small." );
+        return 0;
+    }
+
+    while ( _batchShapes.size () < count )
+        _batchShapes.push_back ( std::make_shared<android_vulkan::ShapeBox> ( 1.0F, 1.0F, 1.0F ) );
+
+    _shapeQueries.clear ();
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        auto const item = static_cast<lua_Integer> ( i + 1U );
+
+        // Both array items must be pushed to the stack. So bitwise "and" is used.
+        bool const isTables = ( lua_rawgeti ( &vm, localIdx, item ) == LUA_TTABLE ) &
+            ( lua_rawgeti ( &vm, sizeIdx, item ) == LUA_TTABLE );
+
+        auto const local = isTables ? ScriptableGXMat4::ExtractFromLua ( vm, -2 ) : std::nullopt;
+        auto const size = isTables ? ScriptableGXVec3::ExtractFromLua ( vm, -1 ) : std::nullopt;
+        lua_pop ( &vm, 2 );
+
+        if ( !local || !size ) [[unlikely]]
+        {
+            android_vulkan::LogError ( "pbr::Scene::DoPenetrationBoxBatch - Query %zu is not valid.", i + 1U );
+            return 0;
+        }
+
+        android_vulkan::Shape &shape = *_batchShapes[ i ];
+
+        // NOLINTNEXTLINE - downcast.
+        auto &boxShape = static_cast<android_vulkan::ShapeBox &> ( shape );
+
+        boxShape.Resize ( **size );
+        boxShape.UpdateCacheData ( **local );
+
+        _shapeQueries.push_back (
+            android_vulkan::ShapeQuery
+            {
+                ._shape = &shape,
+                ._groups = groups
+            }
+        );
+    }
+
+    _physics->PenetrationTestBatch ( _penetrations, _penetrationOffsets, _epa, _shapeQueries );
+    return static_cast<int> ( _scriptablePenetration.PublishBatchResult ( vm, _penetrations, _penetrationOffsets ) );
+}
+
 int Scene::DoRaycast ( lua_State &vm, GXVec3 const &from, GXVec3 const &to, uint32_t groups ) noexcept
 {
     android_vulkan::RaycastResult result {};
@@ -644,6 +724,48 @@ int Scene::DoRaycast ( lua_State &vm, GXVec3 const &from, GXVec3 const &to, uint
     return static_cast<int> ( _scriptableRaycastResult.PublishResult ( vm, result ) );
 }
 
+int Scene::DoRaycastBatch ( lua_State &vm, int fromIdx, int toIdx, size_t count, uint32_t groups ) noexcept
+{
+    if ( !lua_checkstack ( &vm, 2 ) ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "pbr::Scene::DoRaycastBatch - Stack is too small." );
+        return 0;
+    }
+
+    _raycastQueries.clear ();
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        auto const item = static_cast<lua_Integer> ( i + 1U );
+
+        // Both array items must be pushed to the stack. So bitwise "and" is used.
+        bool const isTables = ( lua_rawgeti ( &vm, fromIdx, item ) == LUA_TTABLE ) &
+            ( lua_rawgeti ( &vm, toIdx, item ) == LUA_TTABLE );
+
+        auto const from = isTables ? ScriptableGXVec3::ExtractFromLua ( vm, -2 ) : std::nullopt;
+        auto const to = isTables ? ScriptableGXVec3::ExtractFromLua ( vm, -1 ) : std::nullopt;
+        lua_pop ( &vm, 2 );
+
+        if ( !from || !to ) [[unlikely]]
+        {
+            android_vulkan::LogError ( "pbr::Scene::DoRaycastBatch - Ray %zu is not valid.", i + 1U );
+            return 0;
+        }
+
+        _raycastQueries.push_back (
+            android_vulkan::RaycastQuery
+            {
+                ._from = **from,
+                ._to = **to,
+                ._groups = groups
+            }
+        );
+    }
+
+    _physics->RaycastBatch ( _raycastResults, _raycastQueries );
+    return static_cast<int> ( _scriptableRaycastResult.PublishBatchResult ( vm, _raycastResults ) );
+}
+
 int Scene::DoSweepTestBox ( lua_State &vm, GXMat4 const &local, GXVec3 const &size, uint32_t groups ) noexcept
 {
     android_vulkan::ShapeRef &shape = _shapeBoxes[ 0U ];
@@ -780,6 +902,18 @@ int Scene::OnGetPenetrationBox ( lua_State* state )
     );
 }
 
+int Scene::OnGetPenetrationBoxBatch ( lua_State* state )
+{
+    auto &self = *static_cast<Scene*> ( lua_touserdata ( state, 1 ) );
+
+    return self.DoPenetrationBoxBatch ( *state,
+        2,
+        3,
+        static_cast<size_t> ( lua_tointeger ( state, 4 ) ),
+        BitField::Extract ( state, 5 )
+    );
+}
+
 int Scene::OnGetPhysicsToRendererScaleFactor ( lua_State* state )
 {
     if ( lua_checkstack ( state, 1 ) ) [[likely]]
@@ -793,6 +927,12 @@ int Scene::OnGetPhysicsToRendererScaleFactor ( lua_State* state )
     return 0;
 }
 
+int Scene::OnGetSensorEvents ( lua_State* state )
+{
+    auto const &self = *static_cast<Scene const*> ( lua_touserdata ( state, 1 ) );
+    return static_cast<int> ( ScriptableSensorEvents::PublishResult ( *state, self._physics->GetSensorEvents () ) );
+}
+
 int Scene::OnGetRendererToPhysicsScaleFactor ( lua_State* state )
 {
     if ( lua_checkstack ( state, 1 ) ) [[likely]]
@@ -874,6 +1014,18 @@ int Scene::OnRaycast ( lua_State* state )
     );
 }
 
+int Scene::OnRaycastBatch ( lua_State* state )
+{
+    auto &self = *static_cast<Scene*> ( lua_touserdata ( state, 1 ) );
+
+    return self.DoRaycastBatch ( *state,
+        2,
+        3,
+        static_cast<size_t> ( lua_tointeger ( state, 4 ) ),
+        BitField::Extract ( state, 5 )
+    );
+}
+
 int Scene::OnSetActiveCamera ( lua_State* state )
 {
     auto &self = *static_cast<Scene*> ( lua_touserdata ( state, 1 ) );
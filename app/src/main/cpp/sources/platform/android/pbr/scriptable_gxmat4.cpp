@@ -174,6 +174,31 @@ GXMat4 &ScriptableGXMat4::Extract ( lua_State* state, int idx ) noexcept
     return item._matrix;
 }
 
+std::optional<GXMat4*> ScriptableGXMat4::ExtractFromLua ( lua_State &vm, int idx ) noexcept
+{
+    if ( !lua_checkstack ( &vm, 2 ) ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "pbr::ScriptableGXMat4::ExtractFromLua - Stack is too small." );
+        return std::nullopt;
+    }
+
+    lua_pushvalue ( &vm, idx );
+
+    constexpr std::string_view fieldHandle = "_handle";
+    lua_pushlstring ( &vm, fieldHandle.data (), fieldHandle.size () );
+
+    if ( lua_rawget ( &vm, -2 ) != LUA_TLIGHTUSERDATA ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "pbr::ScriptableGXMat4::ExtractFromLua - Can't find GXMat4 handle." );
+        lua_pop ( &vm, 2 );
+        return std::nullopt;
+    }
+
+    auto &item = *static_cast<Item*> ( lua_touserdata ( &vm, -1 ) );
+    lua_pop ( &vm, 2 );
+    return &item._matrix;
+}
+
 void ScriptableGXMat4::Insert ( Item* item, Item* &list ) noexcept
 {
     item->_previous = nullptr;
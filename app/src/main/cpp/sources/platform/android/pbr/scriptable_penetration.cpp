@@ -13,8 +13,10 @@ namespace {
 constexpr std::string_view FIELD_BODY = "_body";
 constexpr std::string_view FIELD_COUNT = "_count";
 constexpr std::string_view FIELD_DEPTH = "_depth";
+constexpr std::string_view FIELD_OFFSETS = "_offsets";
 constexpr std::string_view FIELD_PENETRATIONS = "_penetrations";
 constexpr std::string_view FIELD_NORMAL = "_normal";
+constexpr std::string_view FIELD_QUERY_COUNT = "_queryCount";
 
 constexpr char const GLOBAL_TABLE[] = "av_scriptablePenetration";
 
@@ -32,7 +34,7 @@ bool ScriptablePenetration::Init ( lua_State &vm ) noexcept
         return false;
     }
 
-    lua_createtable ( &vm, 0, 2 );
+    lua_createtable ( &vm, 0, 4 );
     lua_setglobal ( &vm, GLOBAL_TABLE );
     lua_getglobal ( &vm, GLOBAL_TABLE );
 
@@ -40,6 +42,14 @@ bool ScriptablePenetration::Init ( lua_State &vm ) noexcept
     lua_pushinteger ( &vm, 0 );
     lua_rawset ( &vm, -3 );
 
+    lua_pushlstring ( &vm, FIELD_QUERY_COUNT.data (), FIELD_QUERY_COUNT.size () );
+    lua_pushinteger ( &vm, 0 );
+    lua_rawset ( &vm, -3 );
+
+    lua_pushlstring ( &vm, FIELD_OFFSETS.data (), FIELD_OFFSETS.size () );
+    lua_createtable ( &vm, INITIAL_CAPACITY, 0 );
+    lua_rawset ( &vm, -3 );
+
     lua_pushlstring ( &vm, FIELD_PENETRATIONS.data (), FIELD_PENETRATIONS.size () );
     lua_createtable ( &vm, INITIAL_CAPACITY, 0 );
     lua_rawset ( &vm, -3 );
@@ -225,6 +235,42 @@ bool ScriptablePenetration::PublishResult ( lua_State &vm,
     return true;
 }
 
+bool ScriptablePenetration::PublishBatchResult ( lua_State &vm,
+    std::vector<android_vulkan::Penetration> const &penetrations,
+    std::vector<size_t> const &offsets
+) noexcept
+{
+    // Note the method leaves the global table on the stack.
+    if ( !PublishResult ( vm, penetrations ) ) [[unlikely]]
+        return false;
+
+    if ( !lua_checkstack ( &vm, 3 ) ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "pbr::ScriptablePenetration::PublishBatchResult - Stack is too small." );
+        lua_pop ( &vm, 1 );
+        return false;
+    }
+
+    size_t const count = offsets.size ();
+
+    lua_pushlstring ( &vm, FIELD_QUERY_COUNT.data (), FIELD_QUERY_COUNT.size () );
+    lua_pushinteger ( &vm, static_cast<lua_Integer> ( count > 0U ? count - 1U : 0U ) );
+    lua_rawset ( &vm, -3 );
+
+    lua_pushlstring ( &vm, FIELD_OFFSETS.data (), FIELD_OFFSETS.size () );
+    lua_rawget ( &vm, -2 );
+
+    // Lua arrays start from 1.
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        lua_pushinteger ( &vm, static_cast<lua_Integer> ( offsets[ i ] + 1U ) );
+        lua_rawseti ( &vm, -2, static_cast<lua_Integer> ( i + 1U ) );
+    }
+
+    lua_pop ( &vm, 1 );
+    return true;
+}
+
 bool ScriptablePenetration::Append ( lua_State &vm,
     int errorHandlerIdx,
     int vec3Constructor,
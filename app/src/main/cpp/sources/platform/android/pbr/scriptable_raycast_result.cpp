@@ -11,10 +11,16 @@ namespace pbr {
 namespace {
 
 constexpr std::string_view FIELD_BODY = "_body";
+constexpr std::string_view FIELD_COUNT = "_count";
+constexpr std::string_view FIELD_HITS = "_hits";
+constexpr std::string_view FIELD_IS_HIT = "_isHit";
 constexpr std::string_view FIELD_POINT = "_point";
 constexpr std::string_view FIELD_NORMAL = "_normal";
 
 constexpr char const GLOBAL_TABLE[] = "av_scriptableRaycastResult";
+constexpr char const GLOBAL_BATCH_TABLE[] = "av_scriptableRaycastBatchResult";
+
+constexpr int INITIAL_BATCH_CAPACITY = 32;
 
 } // end of anonymous namespace
 
@@ -71,12 +77,40 @@ bool ScriptableRaycastResult::Init ( lua_State &vm ) noexcept
     if ( !connect ( _normal, FIELD_NORMAL ) || !connect ( _point, FIELD_POINT ) ) [[unlikely]]
         return false;
 
-    lua_pop ( &vm, 2 );
+    lua_createtable ( &vm, 0, 2 );
+    lua_setglobal ( &vm, GLOBAL_BATCH_TABLE );
+    lua_getglobal ( &vm, GLOBAL_BATCH_TABLE );
+
+    lua_pushlstring ( &vm, FIELD_COUNT.data (), FIELD_COUNT.size () );
+    lua_pushinteger ( &vm, 0 );
+    lua_rawset ( &vm, -3 );
+
+    lua_pushlstring ( &vm, FIELD_HITS.data (), FIELD_HITS.size () );
+    lua_createtable ( &vm, INITIAL_BATCH_CAPACITY, 0 );
+    lua_rawset ( &vm, -3 );
+
+    lua_pushlstring ( &vm, FIELD_HITS.data (), FIELD_HITS.size () );
+    lua_rawget ( &vm, -2 );
+    int const hitsIdx = lua_gettop ( &vm );
+    _batch.reserve ( static_cast<size_t> ( INITIAL_BATCH_CAPACITY ) );
+
+    for ( int i = 0; i < INITIAL_BATCH_CAPACITY; ++i )
+    {
+        if ( !AppendBatchItem ( vm, ScriptEngine::GetErrorHandlerIndex (), vec3ConstructorIdx, hitsIdx ) ) [[unlikely]]
+        {
+            lua_pop ( &vm, 4 );
+            return false;
+        }
+    }
+
+    lua_pop ( &vm, 4 );
     return true;
 }
 
 void ScriptableRaycastResult::Destroy ( lua_State &vm ) noexcept
 {
+    _batch.clear ();
+    _batch.shrink_to_fit ();
     _normal = nullptr;
     _point = nullptr;
 
@@ -88,6 +122,9 @@ void ScriptableRaycastResult::Destroy ( lua_State &vm ) noexcept
 
     lua_pushnil ( &vm );
     lua_setglobal ( &vm, GLOBAL_TABLE );
+
+    lua_pushnil ( &vm );
+    lua_setglobal ( &vm, GLOBAL_BATCH_TABLE );
 }
 
 bool ScriptableRaycastResult::PublishResult ( lua_State &vm, android_vulkan::RaycastResult const &result ) noexcept
@@ -125,4 +162,147 @@ bool ScriptableRaycastResult::PublishResult ( lua_State &vm, android_vulkan::Ray
     return true;
 }
 
+bool ScriptableRaycastResult::PublishBatchResult ( lua_State &vm,
+    std::span<android_vulkan::RaycastResult const> results
+) noexcept
+{
+    if ( !lua_checkstack ( &vm, 9 ) ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "pbr::ScriptableRaycastResult::PublishBatchResult - Stack is too small." );
+        return false;
+    }
+
+    int const errorHandlerIdx = ScriptEngine::PushErrorHandlerToStack ( vm );
+    size_t const count = results.size ();
+
+    lua_getglobal ( &vm, GLOBAL_BATCH_TABLE );
+    lua_pushlstring ( &vm, FIELD_COUNT.data (), FIELD_COUNT.size () );
+    lua_pushinteger ( &vm, static_cast<lua_Integer> ( count ) );
+    lua_rawset ( &vm, -3 );
+
+    lua_pushlstring ( &vm, FIELD_HITS.data (), FIELD_HITS.size () );
+    lua_rawget ( &vm, -2 );
+    int const hitsIdx = lua_gettop ( &vm );
+
+    if ( !ScriptableGXVec3::PrepareLuaConstructor ( vm ) ) [[unlikely]]
+    {
+        lua_pop ( &vm, 3 );
+        return false;
+    }
+
+    int const vec3Constructor = lua_gettop ( &vm );
+
+    if ( !RigidBodyComponent::PrepareLuaFindRigidBodyComponent ( vm ) ) [[unlikely]]
+    {
+        lua_pop ( &vm, 4 );
+        return false;
+    }
+
+    int const findRigidBodyIdx = lua_gettop ( &vm );
+    android_vulkan::RaycastResult const* r = results.data ();
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        if ( i == _batch.size () && !AppendBatchItem ( vm, errorHandlerIdx, vec3Constructor, hitsIdx ) ) [[unlikely]]
+        {
+            lua_pop ( &vm, 5 );
+            return false;
+        }
+
+        lua_rawgeti ( &vm, hitsIdx, static_cast<lua_Integer> ( i + 1U ) );
+
+        android_vulkan::RaycastResult const &result = r[ i ];
+        android_vulkan::RigidBody* const body = result._body.get ();
+
+        lua_pushlstring ( &vm, FIELD_IS_HIT.data (), FIELD_IS_HIT.size () );
+        lua_pushboolean ( &vm, static_cast<int> ( body != nullptr ) );
+        lua_rawset ( &vm, -3 );
+
+        if ( !body )
+        {
+            lua_pop ( &vm, 1 );
+            continue;
+        }
+
+        lua_pushlstring ( &vm, FIELD_BODY.data (), FIELD_BODY.size () );
+        lua_pushvalue ( &vm, findRigidBodyIdx );
+        lua_pushlightuserdata ( &vm, body );
+
+        if ( lua_pcall ( &vm, 1, 1, errorHandlerIdx ) != LUA_OK ) [[unlikely]]
+        {
+            lua_pop ( &vm, 8 );
+            return false;
+        }
+
+        lua_rawset ( &vm, -3 );
+        lua_pop ( &vm, 1 );
+
+        BatchItem const &item = _batch[ i ];
+        *item._point = result._point;
+        *item._normal = result._normal;
+    }
+
+    // Only the batch table must stay on the stack.
+    lua_pop ( &vm, 3 );
+    lua_replace ( &vm, -2 );
+    return true;
+}
+
+bool ScriptableRaycastResult::AppendBatchItem ( lua_State &vm,
+    int errorHandlerIdx,
+    int vec3Constructor,
+    int hitsIdx
+) noexcept
+{
+    if ( !lua_checkstack ( &vm, 4 ) ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "pbr::ScriptableRaycastResult::AppendBatchItem - Stack is too small." );
+        return false;
+    }
+
+    lua_createtable ( &vm, 0, 4 );
+
+    lua_pushlstring ( &vm, FIELD_IS_HIT.data (), FIELD_IS_HIT.size () );
+    lua_pushboolean ( &vm, static_cast<int> ( false ) );
+    lua_rawset ( &vm, -3 );
+
+    // Don't care about actual value. Main task is to allocate internal Lua table with something.
+    lua_pushlstring ( &vm, FIELD_BODY.data (), FIELD_BODY.size () );
+    constexpr lua_Integer proxyRigidBody = 777;
+    lua_pushinteger ( &vm, proxyRigidBody );
+    lua_rawset ( &vm, -3 );
+
+    BatchItem item {};
+
+    auto const connect = [ & ] ( GXVec3* &target, std::string_view const &field ) noexcept -> bool {
+        lua_pushlstring ( &vm, field.data (), field.size () );
+        lua_pushvalue ( &vm, vec3Constructor );
+
+        if ( lua_pcall ( &vm, 0, 1, errorHandlerIdx ) != LUA_OK ) [[unlikely]]
+        {
+            lua_pop ( &vm, 3 );
+            return false;
+        }
+
+        auto probe = ScriptableGXVec3::ExtractFromLua ( vm, -1 );
+
+        if ( !probe ) [[unlikely]]
+        {
+            lua_pop ( &vm, 3 );
+            return false;
+        }
+
+        target = *probe;
+        lua_rawset ( &vm, -3 );
+        return true;
+    };
+
+    if ( !connect ( item._normal, FIELD_NORMAL ) || !connect ( item._point, FIELD_POINT ) ) [[unlikely]]
+        return false;
+
+    lua_rawseti ( &vm, hitsIdx, static_cast<lua_Integer> ( _batch.size () + 1U ) );
+    _batch.push_back ( item );
+    return true;
+}
+
 } // namespace pbr
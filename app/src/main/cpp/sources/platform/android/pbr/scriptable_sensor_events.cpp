@@ -0,0 +1,146 @@
+#include <precompiled_headers.hpp>
+#include <logger.hpp>
+#include <platform/android/pbr/scriptable_sensor_events.hpp>
+#include <platform/android/pbr/script_engine.hpp>
+
+
+namespace pbr {
+
+namespace {
+
+constexpr std::string_view FIELD_COUNT = "_count";
+constexpr std::string_view FIELD_OTHERS = "_others";
+constexpr std::string_view FIELD_SENSORS = "_sensors";
+constexpr std::string_view FIELD_TYPES = "_types";
+
+constexpr char const GLOBAL_FUNCTION[] = "FindRigidBodyComponent";
+constexpr char const GLOBAL_TABLE[] = "av_scriptableSensorEvents";
+
+constexpr int INITIAL_CAPACITY = 32;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+bool ScriptableSensorEvents::Init ( lua_State &vm ) noexcept
+{
+    if ( !lua_checkstack ( &vm, 4 ) ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "pbr::ScriptableSensorEvents::Init - Stack is too small." );
+        return false;
+    }
+
+    lua_createtable ( &vm, 0, 4 );
+    lua_setglobal ( &vm, GLOBAL_TABLE );
+    lua_getglobal ( &vm, GLOBAL_TABLE );
+
+    lua_pushlstring ( &vm, FIELD_COUNT.data (), FIELD_COUNT.size () );
+    lua_pushinteger ( &vm, 0 );
+    lua_rawset ( &vm, -3 );
+
+    // Don't care about actual value. Main task is to allocate internal Lua arrays with something.
+    constexpr lua_Integer proxyValue = 777;
+
+    for ( std::string_view const &field : { FIELD_SENSORS, FIELD_OTHERS, FIELD_TYPES } )
+    {
+        lua_pushlstring ( &vm, field.data (), field.size () );
+        lua_createtable ( &vm, INITIAL_CAPACITY, 0 );
+
+        for ( int i = 1; i <= INITIAL_CAPACITY; ++i )
+        {
+            lua_pushinteger ( &vm, proxyValue );
+            lua_rawseti ( &vm, -2, i );
+        }
+
+        lua_rawset ( &vm, -3 );
+    }
+
+    lua_pop ( &vm, 1 );
+    return true;
+}
+
+void ScriptableSensorEvents::Destroy ( lua_State &vm ) noexcept
+{
+    if ( !lua_checkstack ( &vm, 1 ) ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "pbr::ScriptableSensorEvents::Destroy - Stack is too small." );
+        return;
+    }
+
+    lua_pushnil ( &vm );
+    lua_setglobal ( &vm, GLOBAL_TABLE );
+}
+
+bool ScriptableSensorEvents::PublishResult ( lua_State &vm,
+    std::vector<android_vulkan::SensorEvent> const &events
+) noexcept
+{
+    if ( !lua_checkstack ( &vm, 8 ) ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "pbr::ScriptableSensorEvents::PublishResult - Stack is too small." );
+        return false;
+    }
+
+    size_t const count = events.size ();
+
+    lua_getglobal ( &vm, GLOBAL_TABLE );
+    lua_pushlstring ( &vm, FIELD_COUNT.data (), FIELD_COUNT.size () );
+    lua_pushinteger ( &vm, static_cast<lua_Integer> ( count ) );
+    lua_rawset ( &vm, -3 );
+
+    if ( count == 0U )
+        return true;
+
+    lua_pushlstring ( &vm, FIELD_SENSORS.data (), FIELD_SENSORS.size () );
+    lua_rawget ( &vm, -2 );
+    int const sensorsIdx = lua_gettop ( &vm );
+
+    lua_pushlstring ( &vm, FIELD_OTHERS.data (), FIELD_OTHERS.size () );
+    lua_rawget ( &vm, -3 );
+    int const othersIdx = lua_gettop ( &vm );
+
+    lua_pushlstring ( &vm, FIELD_TYPES.data (), FIELD_TYPES.size () );
+    lua_rawget ( &vm, -4 );
+    int const typesIdx = lua_gettop ( &vm );
+
+    lua_getglobal ( &vm, GLOBAL_FUNCTION );
+    int const findIdx = lua_gettop ( &vm );
+
+    auto const publishBody = [ & ] ( int arrayIdx,
+        lua_Integer item,
+        android_vulkan::RigidBody* body
+    ) noexcept -> bool {
+        lua_pushvalue ( &vm, findIdx );
+        lua_pushlightuserdata ( &vm, body );
+
+        if ( lua_pcall ( &vm, 1, 1, ScriptEngine::GetErrorHandlerIndex () ) != LUA_OK ) [[unlikely]]
+        {
+            lua_pop ( &vm, 6 );
+            return false;
+        }
+
+        lua_rawseti ( &vm, arrayIdx, item );
+        return true;
+    };
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        android_vulkan::SensorEvent const &event = events[ i ];
+        auto const item = static_cast<lua_Integer> ( i + 1U );
+
+        if ( !publishBody ( sensorsIdx, item, event._sensor.get () ) ) [[unlikely]]
+            return false;
+
+        if ( !publishBody ( othersIdx, item, event._other.get () ) ) [[unlikely]]
+            return false;
+
+        lua_pushinteger ( &vm, static_cast<lua_Integer> ( event._type ) );
+        lua_rawseti ( &vm, typesIdx, item );
+    }
+
+    // Only the result table must stay on the stack.
+    lua_pop ( &vm, 4 );
+    return true;
+}
+
+} // namespace pbr
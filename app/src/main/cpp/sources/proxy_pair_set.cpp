@@ -0,0 +1,181 @@
+#include <precompiled_headers.hpp>
+#include <av_assert.hpp>
+#include <proxy_pair_set.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+constexpr size_t INITIAL_PAIRS = 4096U;
+constexpr size_t INITIAL_SLOTS = INITIAL_PAIRS * 2U;
+
+static_assert ( ( INITIAL_SLOTS & ( INITIAL_SLOTS - 1U ) ) == 0U, "INITIAL_SLOTS must be power of two" );
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void ProxyPairSet::Add ( uint32_t a, uint32_t b ) noexcept
+{
+    // Load factor is kept below 0.5. So probe sequences stay short.
+    if ( ( _pairs.size () + 1U ) * 2U > _slots.size () ) [[unlikely]]
+        Grow ();
+
+    Pair const pair = MakePair ( a, b );
+    uint32_t &slot = _slots[ FindSlot ( pair ) ];
+
+    if ( slot != EMPTY_SLOT )
+        return;
+
+    slot = static_cast<uint32_t> ( _pairs.size () );
+    _pairs.push_back ( pair );
+}
+
+void ProxyPairSet::Remove ( uint32_t a, uint32_t b ) noexcept
+{
+    if ( _pairs.empty () )
+        return;
+
+    uint32_t const index = _slots[ FindSlot ( MakePair ( a, b ) ) ];
+
+    if ( index != EMPTY_SLOT )
+    {
+        Erase ( index );
+    }
+}
+
+void ProxyPairSet::RemoveProxy ( uint32_t proxy ) noexcept
+{
+    for ( size_t i = 0U; i < _pairs.size (); )
+    {
+        Pair const &pair = _pairs[ i ];
+
+        // The last pair takes the place of the erased one. So the index is not advanced.
+        if ( pair._a == proxy || pair._b == proxy )
+        {
+            Erase ( i );
+            continue;
+        }
+
+        ++i;
+    }
+}
+
+void ProxyPairSet::Reset () noexcept
+{
+    _pairs.clear ();
+    std::fill ( _slots.begin (), _slots.end (), EMPTY_SLOT );
+}
+
+std::span<ProxyPairSet::Pair const> ProxyPairSet::GetPairs () const noexcept
+{
+    return _pairs;
+}
+
+void ProxyPairSet::Erase ( size_t index ) noexcept
+{
+    RemoveSlot ( FindSlot ( _pairs[ index ] ) );
+    Pair const &last = _pairs.back ();
+
+    if ( index + 1U != _pairs.size () )
+    {
+        _pairs[ index ] = last;
+        _slots[ FindSlot ( last ) ] = static_cast<uint32_t> ( index );
+    }
+
+    _pairs.pop_back ();
+}
+
+size_t ProxyPairSet::FindSlot ( Pair const &pair ) const noexcept
+{
+    size_t slot = Hash ( pair ) & _mask;
+
+    for ( ; ; )
+    {
+        uint32_t const index = _slots[ slot ];
+
+        if ( index == EMPTY_SLOT )
+            return slot;
+
+        Pair const &p = _pairs[ index ];
+
+        if ( p._a == pair._a && p._b == pair._b )
+            return slot;
+
+        slot = ( slot + 1U ) & _mask;
+    }
+}
+
+void ProxyPairSet::Grow () noexcept
+{
+    size_t const slots = std::max ( _slots.size () * 2U, INITIAL_SLOTS );
+    _mask = slots - 1U;
+
+    if ( _pairs.capacity () < INITIAL_PAIRS ) [[unlikely]]
+        _pairs.reserve ( INITIAL_PAIRS );
+
+    _slots.clear ();
+    _slots.resize ( slots, EMPTY_SLOT );
+
+    size_t const pairs = _pairs.size ();
+
+    for ( size_t i = 0U; i < pairs; ++i )
+    {
+        _slots[ FindSlot ( _pairs[ i ] ) ] = static_cast<uint32_t> ( i );
+    }
+}
+
+void ProxyPairSet::RemoveSlot ( size_t slot ) noexcept
+{
+    AV_ASSERT ( _slots[ slot ] != EMPTY_SLOT )
+
+    // Backward shift deletion. It keeps probe sequences without tombstones. See ContactCache::RemoveSlot.
+    for ( ; ; )
+    {
+        _slots[ slot ] = EMPTY_SLOT;
+        size_t next = slot;
+
+        for ( ; ; )
+        {
+            next = ( next + 1U ) & _mask;
+            uint32_t const index = _slots[ next ];
+
+            if ( index == EMPTY_SLOT )
+                return;
+
+            // The entry must stay if its home slot lies cyclically in ( slot, next ] range.
+            size_t const home = Hash ( _pairs[ index ] ) & _mask;
+            bool const stay = slot <= next ? slot < home && home <= next : slot < home || home <= next;
+
+            if ( !stay )
+            {
+                break;
+            }
+        }
+
+        _slots[ slot ] = _slots[ next ];
+        slot = next;
+    }
+}
+
+size_t ProxyPairSet::Hash ( Pair const &pair ) noexcept
+{
+    // Fibonacci hashing. High bits of the product depend on all bits of the key.
+    constexpr uint64_t magic = 0x9E37'79B9'7F4A'7C15ULL;
+    uint64_t const key = ( static_cast<uint64_t> ( pair._a ) << 32U ) | static_cast<uint64_t> ( pair._b );
+    return static_cast<size_t> ( ( key * magic ) >> 32U );
+}
+
+ProxyPairSet::Pair ProxyPairSet::MakePair ( uint32_t a, uint32_t b ) noexcept
+{
+    AV_ASSERT ( a != b )
+
+    return Pair
+    {
+        ._a = std::min ( a, b ),
+        ._b = std::max ( a, b )
+    };
+}
+
+} // namespace android_vulkan
@@ -1,6 +1,7 @@
 #include <precompiled_headers.hpp>
 #include <ray_caster.hpp>
 #include <logger.hpp>
+#include <shape_mesh.hpp>
 #include <simplex.hpp>
 
 
@@ -18,6 +19,9 @@ constexpr float THRESHOLD = 1.0e-3F;
 
 bool RayCaster::Run ( RaycastResult &result, GXVec3 const &from, GXVec3 const &to, Shape const &shape ) noexcept
 {
+    if ( shape.GetType () == eShapeType::Mesh )
+        return static_cast<ShapeMesh const &> ( shape ).Raycast ( result._point, result._normal, from, to );
+
     constexpr GXVec3 const initialDirection ( 1.0F, 0.0F, 0.0F );
     ResetInternal ();
 
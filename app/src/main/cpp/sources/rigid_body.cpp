@@ -39,11 +39,15 @@ RigidBody::RigidBody () noexcept:
     _inertiaTensorInverse {},
     _isAwake ( true ),
     _isCanSleep ( true ),
+    _isContinuousCollision ( false ),
     _isKinematic ( false ),
+    _isSensor ( false ),
+    _islandIndex ( 0U ),
     _location ( DEFAULT_LOCATION ),
     _mass ( DEFAULT_MASS ),
     _massInverse ( DEFAULT_MASS_INVERSE ),
     _physics ( nullptr ),
+    _physicsIndex ( std::numeric_limits<uint32_t>::max () ),
     _rotation {},
     _shape {},
     _sleepTimeout ( 0.0F ),
@@ -222,6 +226,36 @@ void RigidBody::EnableSleep () noexcept
     return _isCanSleep;
 }
 
+[[maybe_unused]] void RigidBody::DisableContinuousCollision () noexcept
+{
+    _isContinuousCollision = false;
+}
+
+[[maybe_unused]] void RigidBody::EnableContinuousCollision () noexcept
+{
+    _isContinuousCollision = true;
+}
+
+bool RigidBody::IsContinuousCollision () const noexcept
+{
+    return _isContinuousCollision;
+}
+
+[[maybe_unused]] void RigidBody::DisableSensor () noexcept
+{
+    _isSensor = false;
+}
+
+[[maybe_unused]] void RigidBody::EnableSensor () noexcept
+{
+    _isSensor = true;
+}
+
+bool RigidBody::IsSensor () const noexcept
+{
+    return _isSensor;
+}
+
 [[nodiscard]] RigidBody::Context RigidBody::GetContext () const noexcept
 {
     return _context;
@@ -272,6 +306,12 @@ void RigidBody::SetLocation ( GXVec3 const &location, bool forceAwake ) noexcept
         return;
 
     UpdateCacheData ();
+
+    // Teleport. The broadphase must be refitted before the next query.
+    if ( _physics )
+    {
+        _physics->OnBoundsChanged ();
+    }
 }
 
 void RigidBody::SetLocation ( float x, float y, float z, bool forceAwake ) noexcept
@@ -287,6 +327,11 @@ void RigidBody::SetLocation ( float x, float y, float z, bool forceAwake ) noexc
         return;
 
     UpdateCacheData ();
+
+    if ( _physics )
+    {
+        _physics->OnBoundsChanged ();
+    }
 }
 
 float RigidBody::GetMass () const noexcept
@@ -327,6 +372,11 @@ void RigidBody::SetRotation ( GXQuat const &rotation, bool forceAwake ) noexcept
         return;
 
     UpdateCacheData ();
+
+    if ( _physics )
+    {
+        _physics->OnBoundsChanged ();
+    }
 }
 
 Shape &RigidBody::GetShape () noexcept
@@ -350,6 +400,11 @@ bool RigidBody::HasShape () const noexcept
 
     _shape->CalculateInertiaTensor ( _mass );
     UpdateCacheData ();
+
+    if ( _physics )
+    {
+        _physics->OnBoundsChanged ();
+    }
 }
 
 [[maybe_unused]] std::string const &RigidBody::GetTag () const noexcept
@@ -421,7 +476,7 @@ void RigidBody::Integrate ( float deltaTime ) noexcept
     }
 }
 
-[[maybe_unused]] bool RigidBody::IsAwake () const noexcept
+bool RigidBody::IsAwake () const noexcept
 {
     return _isAwake;
 }
@@ -432,16 +487,58 @@ void RigidBody::SetAwake () noexcept
     _sleepTimeout = 0.0F;
 }
 
-void RigidBody::OnRegister ( Physics &physics ) noexcept
+bool RigidBody::IsReadyToSleep () const noexcept
+{
+    return _isCanSleep && _sleepTimeout > SLEEP_TIMEOUT;
+}
+
+void RigidBody::Sleep () noexcept
+{
+    _isAwake = false;
+    _velocityAngular = ZERO;
+    _velocityLinear = ZERO;
+}
+
+uint32_t RigidBody::GetIslandIndex () const noexcept
+{
+    return _islandIndex;
+}
+
+void RigidBody::SetIslandIndex ( uint32_t index ) noexcept
+{
+    _islandIndex = index;
+}
+
+uint32_t RigidBody::GetPhysicsIndex () const noexcept
+{
+    return _physicsIndex;
+}
+
+void RigidBody::SetPhysicsIndex ( uint32_t index ) noexcept
+{
+    _physicsIndex = index;
+}
+
+bool RigidBody::OnRegister ( Physics &physics ) noexcept
 {
     std::lock_guard const lock ( _mutex );
+
+    if ( _physics )
+        return false;
+
     _physics = &physics;
+    return true;
 }
 
-void RigidBody::OnUnregister () noexcept
+bool RigidBody::OnUnregister ( Physics const &physics ) noexcept
 {
     std::lock_guard const lock ( _mutex );
+
+    if ( _physics != &physics )
+        return false;
+
     _physics = nullptr;
+    return true;
 }
 
 void RigidBody::UpdatePositionAndRotation ( float deltaTime ) noexcept
@@ -492,17 +589,14 @@ void RigidBody::RunSleepLogic ( float deltaTime ) noexcept
         return;
     }
 
+    // Note the body is not put to sleep here. All bodies of the simulation island must be ready to sleep.
     _sleepTimeout += deltaTime;
-
-    if ( _sleepTimeout > SLEEP_TIMEOUT )
-    {
-        _isAwake = false;
-    }
 }
 
 void RigidBody::UpdateCacheData () noexcept
 {
-    _rotation.Normalize ();
+    // The rotation only drifts a little per step. So the approximate normalization is enough.
+    _rotation.NormalizeFast ();
     _transform.FromFast ( _rotation, _location );
 
     GXMat3 const alpha ( _transform );
@@ -0,0 +1,104 @@
+#include <precompiled_headers.hpp>
+#include <shape_capsule.hpp>
+
+
+namespace android_vulkan {
+
+[[maybe_unused]] ShapeCapsule::ShapeCapsule ( float radius, float height ) noexcept:
+    Shape ( eShapeType::Capsule ),
+    _halfHeight ( 0.5F * height ),
+    _radius ( radius ),
+    _segmentWorld { GXVec3 ( 0.0F, -_halfHeight, 0.0F ), GXVec3 ( 0.0F, _halfHeight, 0.0F ) }
+{
+    GXVec3 r ( radius, _halfHeight + radius, radius );
+    _boundsLocal.AddVertex ( r );
+
+    r.Reverse ();
+    _boundsLocal.AddVertex ( r );
+
+    _boundsWorld = _boundsLocal;
+}
+
+[[maybe_unused]] float ShapeCapsule::GetHeight () const noexcept
+{
+    return _halfHeight + _halfHeight;
+}
+
+float ShapeCapsule::GetRadius () const noexcept
+{
+    return _radius;
+}
+
+GXVec3 const &ShapeCapsule::GetSegmentBeginWorld () const noexcept
+{
+    return _segmentWorld[ 0U ];
+}
+
+GXVec3 const &ShapeCapsule::GetSegmentEndWorld () const noexcept
+{
+    return _segmentWorld[ 1U ];
+}
+
+void ShapeCapsule::CalculateInertiaTensor ( float mass ) noexcept
+{
+    // The mass is split between the cylinder and the caps proportionally to the volumes. Caps are shifted from the
+    // center of mass by the parallel axis theorem.
+    // https://en.wikipedia.org/wiki/List_of_moments_of_inertia
+    float const height = _halfHeight + _halfHeight;
+    float const squaredRadius = _radius * _radius;
+
+    float const cylinderMass = mass * height / ( height + 1.3333333F * _radius );
+    float const capsMass = mass - cylinderMass;
+
+    float const axial = cylinderMass * 0.5F * squaredRadius + capsMass * 0.4F * squaredRadius;
+
+    float const lateral = cylinderMass * ( 8.3333e-2F * height * height + 0.25F * squaredRadius ) +
+        capsMass * ( 0.4F * squaredRadius + 0.25F * height * height + 0.375F * height * _radius );
+
+    auto &m = _inertiaTensorInverse._data;
+
+    m[ 0U ][ 0U ] = 1.0F / lateral;
+    m[ 1U ][ 1U ] = 1.0F / axial;
+    m[ 2U ][ 2U ] = 1.0F / lateral;
+
+    m[ 0U ][ 1U ] = 0.0F;
+    m[ 0U ][ 2U ] = 0.0F;
+    m[ 1U ][ 0U ] = 0.0F;
+    m[ 1U ][ 2U ] = 0.0F;
+    m[ 2U ][ 0U ] = 0.0F;
+    m[ 2U ][ 1U ] = 0.0F;
+}
+
+GXVec3 ShapeCapsule::GetExtremePointWorld ( GXVec3 const &direction ) const noexcept
+{
+    GXVec3 const &begin = _segmentWorld[ 0U ];
+    GXVec3 const &end = _segmentWorld[ 1U ];
+
+    GXVec3 dir ( direction );
+    dir.Normalize ();
+
+    GXVec3 result {};
+    result.Sum ( dir.DotProduct ( begin ) > dir.DotProduct ( end ) ? begin : end, _radius, dir );
+    return result;
+}
+
+void ShapeCapsule::UpdateBounds () noexcept
+{
+    _transformWorld.MultiplyAsPoint ( _segmentWorld[ 0U ], GXVec3 ( 0.0F, -_halfHeight, 0.0F ) );
+    _transformWorld.MultiplyAsPoint ( _segmentWorld[ 1U ], GXVec3 ( 0.0F, _halfHeight, 0.0F ) );
+
+    GXVec3 const r ( _radius, _radius, _radius );
+    _boundsWorld.Empty ();
+
+    for ( GXVec3 const &point : _segmentWorld )
+    {
+        GXVec3 v {};
+        v.Sum ( point, r );
+        _boundsWorld.AddVertex ( v );
+
+        v.Subtract ( point, r );
+        _boundsWorld.AddVertex ( v );
+    }
+}
+
+} // namespace android_vulkan
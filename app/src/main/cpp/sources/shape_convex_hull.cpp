@@ -0,0 +1,713 @@
+#include <precompiled_headers.hpp>
+#include <av_assert.hpp>
+#include <logger.hpp>
+#include <shape_convex_hull.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+// Distance tolerance of the hull construction relative to the size of the point cloud.
+constexpr float DISTANCE_TOLERANCE = 1.0e-5F;
+
+// Adjacent hull triangles are merged into single face if their normals are closer than this.
+constexpr float COPLANAR_COSINE = 0.9999F;
+
+// Same tolerance as ray deviation in the contact detector: 6 degrees.
+constexpr float FACE_COSINE = 0.994522F;
+constexpr float EDGE_SINE = 0.104528F;
+
+// Degenerate point cloud is replaced by bounding box with this minimum half thickness in meters.
+constexpr float MIN_HALF_THICKNESS = 1.0e-3F;
+
+constexpr size_t MAX_PLATEAU_VERTICES = 64U;
+
+struct Triangle final
+{
+    uint32_t        _vertices[ 3U ];
+    GXVec3          _normal;
+    float           _offset;
+    bool            _isAlive;
+};
+
+[[nodiscard]] Triangle MakeTriangle ( std::span<GXVec3 const> points, uint32_t a, uint32_t b, uint32_t c ) noexcept
+{
+    GXVec3 ab {};
+    ab.Subtract ( points[ b ], points[ a ] );
+
+    GXVec3 ac {};
+    ac.Subtract ( points[ c ], points[ a ] );
+
+    Triangle triangle
+    {
+        ._vertices = { a, b, c },
+        ._normal {},
+        ._offset = 0.0F,
+        ._isAlive = true
+    };
+
+    triangle._normal.CrossProduct ( ab, ac );
+    triangle._normal.Normalize ();
+    triangle._offset = triangle._normal.DotProduct ( points[ a ] );
+    return triangle;
+}
+
+[[nodiscard]] constexpr uint64_t MakeEdgeKey ( uint32_t from, uint32_t to ) noexcept
+{
+    return ( static_cast<uint64_t> ( from ) << 32U ) | static_cast<uint64_t> ( to );
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] ShapeConvexHull::ShapeConvexHull ( std::span<GXVec3 const> points ) noexcept:
+    Shape ( eShapeType::ConvexHull )
+{
+    if ( Build ( points ) ) [[likely]]
+        return;
+
+    LogWarning ( "ShapeConvexHull::ShapeConvexHull - Points do not form volume. Bounding box is used instead." );
+
+    GXAABB bounds {};
+
+    for ( auto const &point : points )
+        bounds.AddVertex ( point );
+
+    if ( points.empty () ) [[unlikely]]
+    {
+        bounds.AddVertex ( 0.0F, 0.0F, 0.0F );
+    }
+
+    GXVec3 center {};
+    center.Sum ( bounds._min, bounds._max );
+    center.Multiply ( center, 0.5F );
+
+    GXVec3 half {};
+    half.Subtract ( bounds._max, center );
+
+    for ( float &h : half._data )
+        h = std::max ( h, MIN_HALF_THICKNESS );
+
+    GXVec3 corners[ 8U ];
+
+    for ( size_t i = 0U; i < 8U; ++i )
+    {
+        corners[ i ].Init ( i & 1U ? half._data[ 0U ] : -half._data[ 0U ],
+            i & 2U ? half._data[ 1U ] : -half._data[ 1U ],
+            i & 4U ? half._data[ 2U ] : -half._data[ 2U ]
+        );
+
+        corners[ i ].Sum ( corners[ i ], center );
+    }
+
+    [[maybe_unused]] bool const result = Build ( corners );
+    AV_ASSERT ( result )
+}
+
+[[maybe_unused]] std::vector<uint32_t> const &ShapeConvexHull::GetFaceVertices () const noexcept
+{
+    return _faceVertices;
+}
+
+[[maybe_unused]] std::vector<ShapeConvexHull::Face> const &ShapeConvexHull::GetFaces () const noexcept
+{
+    return _faces;
+}
+
+[[maybe_unused]] std::vector<GXVec3> const &ShapeConvexHull::GetVertices () const noexcept
+{
+    return _vertices;
+}
+
+void ShapeConvexHull::CollectFeatureWorld ( Vertices &vertices, GXVec3 const &directionWorld ) const noexcept
+{
+    vertices.clear ();
+
+    GXVec3 const d = ToLocalDirection ( directionWorld );
+    uint32_t const support = FindSupport ( d );
+
+    auto const append = [ & ] ( uint32_t vertex ) noexcept {
+        _transformWorld.MultiplyAsPoint ( vertices.emplace_back (), _vertices[ vertex ] );
+    };
+
+    // Only faces and edges around the support vertex could be extreme.
+    uint32_t const* vertexFaces = _vertexFaces.data ();
+    float bestFaceCosine = -1.0F;
+    Face const* bestFace = nullptr;
+
+    for ( uint32_t i = _vertexFaceOffsets[ support ]; i < _vertexFaceOffsets[ support + 1U ]; ++i )
+    {
+        Face const &face = _faces[ vertexFaces[ i ] ];
+        float const cosine = face._normal.DotProduct ( d );
+
+        if ( cosine <= bestFaceCosine )
+            continue;
+
+        bestFaceCosine = cosine;
+        bestFace = &face;
+    }
+
+    if ( bestFace && bestFaceCosine >= FACE_COSINE )
+    {
+        uint32_t const* faceVertices = _faceVertices.data () + bestFace->_first;
+
+        for ( uint32_t i = 0U; i < bestFace->_count; ++i )
+            append ( faceVertices[ i ] );
+
+        return;
+    }
+
+    GXVec3 const &s = _vertices[ support ];
+    float bestEdgeSine = EDGE_SINE;
+    uint32_t bestNeighbour = support;
+
+    for ( uint32_t i = _adjacencyOffsets[ support ]; i < _adjacencyOffsets[ support + 1U ]; ++i )
+    {
+        uint32_t const neighbour = _adjacency[ i ];
+
+        GXVec3 edge {};
+        edge.Subtract ( _vertices[ neighbour ], s );
+        edge.Normalize ();
+
+        float const sine = std::abs ( edge.DotProduct ( d ) );
+
+        if ( sine > bestEdgeSine )
+            continue;
+
+        bestEdgeSine = sine;
+        bestNeighbour = neighbour;
+    }
+
+    append ( support );
+
+    if ( bestNeighbour != support )
+    {
+        append ( bestNeighbour );
+    }
+}
+
+void ShapeConvexHull::CalculateInertiaTensor ( float mass ) noexcept
+{
+    // Inertia tensor is "trace ( C ) * I - C" where "C" is covariance of the mass distribution.
+    // https://en.wikipedia.org/wiki/Moment_of_inertia#Inertia_tensor
+
+    GXMat3 covariance {};
+    covariance.Multiply ( _covariance, mass / _volume );
+
+    auto const &c = covariance._data;
+    float const trace = c[ 0U ][ 0U ] + c[ 1U ][ 1U ] + c[ 2U ][ 2U ];
+
+    GXMat3 inertia {};
+    inertia.Identity ();
+    inertia.Multiply ( inertia, trace );
+    inertia.Subtract ( inertia, covariance );
+
+    _inertiaTensorInverse.Inverse ( inertia );
+}
+
+GXVec3 ShapeConvexHull::GetExtremePointWorld ( GXVec3 const &direction ) const noexcept
+{
+    GXVec3 result {};
+    _transformWorld.MultiplyAsPoint ( result, _vertices[ FindSupport ( ToLocalDirection ( direction ) ) ] );
+    return result;
+}
+
+void ShapeConvexHull::UpdateBounds () noexcept
+{
+    _boundsLocal.Transform ( _boundsWorld, _transformWorld );
+}
+
+bool ShapeConvexHull::Build ( std::span<GXVec3 const> points ) noexcept
+{
+    // Incremental construction. The point is added to the hull if it's in front of at least one hull triangle.
+    // The triangles which see the point are replaced by the fan of triangles from the horizon edges to the point.
+    size_t const count = points.size ();
+
+    if ( count < 4U )
+        return false;
+
+    GXAABB cloud {};
+
+    for ( auto const &point : points )
+        cloud.AddVertex ( point );
+
+    float const tolerance = DISTANCE_TOLERANCE * cloud._min.Distance ( cloud._max );
+
+    // Initial tetrahedron.
+    uint32_t const i0 = 0U;
+    uint32_t i1 = i0;
+    float best = 0.0F;
+
+    for ( uint32_t i = 1U; i < count; ++i )
+    {
+        float const d = points[ i ].SquaredDistance ( points[ i0 ] );
+
+        if ( d <= best )
+            continue;
+
+        best = d;
+        i1 = i;
+    }
+
+    if ( std::sqrt ( best ) <= tolerance )
+        return false;
+
+    GXVec3 axis {};
+    axis.Subtract ( points[ i1 ], points[ i0 ] );
+    axis.Normalize ();
+
+    uint32_t i2 = i0;
+    best = 0.0F;
+
+    for ( uint32_t i = 1U; i < count; ++i )
+    {
+        GXVec3 v {};
+        v.Subtract ( points[ i ], points[ i0 ] );
+
+        GXVec3 cross {};
+        cross.CrossProduct ( v, axis );
+        float const d = cross.SquaredLength ();
+
+        if ( d <= best )
+            continue;
+
+        best = d;
+        i2 = i;
+    }
+
+    if ( std::sqrt ( best ) <= tolerance )
+        return false;
+
+    Triangle const base = MakeTriangle ( points, i0, i1, i2 );
+    uint32_t i3 = i0;
+    best = 0.0F;
+
+    for ( uint32_t i = 1U; i < count; ++i )
+    {
+        float const d = std::abs ( base._normal.DotProduct ( points[ i ] ) - base._offset );
+
+        if ( d <= best )
+            continue;
+
+        best = d;
+        i3 = i;
+    }
+
+    if ( best <= tolerance )
+        return false;
+
+    std::vector<Triangle> hull {};
+    hull.reserve ( 4U * count );
+
+    // Every triangle must see the opposite vertex of the tetrahedron from behind.
+    auto const addTetrahedronFace = [ & ] ( uint32_t a, uint32_t b, uint32_t c, uint32_t opposite ) noexcept {
+        Triangle triangle = MakeTriangle ( points, a, b, c );
+
+        if ( triangle._normal.DotProduct ( points[ opposite ] ) - triangle._offset > 0.0F )
+            triangle = MakeTriangle ( points, a, c, b );
+
+        hull.push_back ( triangle );
+    };
+
+    addTetrahedronFace ( i0, i1, i2, i3 );
+    addTetrahedronFace ( i0, i1, i3, i2 );
+    addTetrahedronFace ( i0, i2, i3, i1 );
+    addTetrahedronFace ( i1, i2, i3, i0 );
+
+    std::vector<uint64_t> visibleEdges {};
+    std::vector<std::pair<uint32_t, uint32_t>> horizon {};
+
+    for ( uint32_t p = 0U; p < count; ++p )
+    {
+        if ( p == i0 || p == i1 || p == i2 || p == i3 )
+            continue;
+
+        GXVec3 const &point = points[ p ];
+        visibleEdges.clear ();
+
+        for ( auto &triangle : hull )
+        {
+            if ( triangle._normal.DotProduct ( point ) - triangle._offset <= tolerance )
+                continue;
+
+            triangle._isAlive = false;
+            uint32_t const* v = triangle._vertices;
+
+            visibleEdges.push_back ( MakeEdgeKey ( v[ 0U ], v[ 1U ] ) );
+            visibleEdges.push_back ( MakeEdgeKey ( v[ 1U ], v[ 2U ] ) );
+            visibleEdges.push_back ( MakeEdgeKey ( v[ 2U ], v[ 0U ] ) );
+        }
+
+        if ( visibleEdges.empty () )
+            continue;
+
+        // Horizon edge belongs to single visible triangle. The twin edge belongs to the triangle which stays.
+        horizon.clear ();
+
+        for ( uint64_t const edge : visibleEdges )
+        {
+            auto const from = static_cast<uint32_t> ( edge >> 32U );
+            auto const to = static_cast<uint32_t> ( edge & 0xFFFFFFFFU );
+
+            if ( std::find ( visibleEdges.cbegin (), visibleEdges.cend (), MakeEdgeKey ( to, from ) ) ==
+                visibleEdges.cend () )
+            {
+                horizon.emplace_back ( from, to );
+            }
+        }
+
+        std::erase_if ( hull,
+            [] ( Triangle const &triangle ) noexcept -> bool {
+                return !triangle._isAlive;
+            }
+        );
+
+        for ( auto const &[ from, to ] : horizon )
+        {
+            hull.push_back ( MakeTriangle ( points, from, to, p ) );
+        }
+    }
+
+    // Compacting vertex indices.
+    std::vector<uint32_t> remap ( count, std::numeric_limits<uint32_t>::max () );
+    std::vector<uint32_t> triangles {};
+    triangles.reserve ( hull.size () * 3U );
+
+    _vertices.clear ();
+    _boundsLocal.Empty ();
+
+    for ( auto const &triangle : hull )
+    {
+        for ( uint32_t const v : triangle._vertices )
+        {
+            uint32_t &index = remap[ v ];
+
+            if ( index == std::numeric_limits<uint32_t>::max () )
+            {
+                index = static_cast<uint32_t> ( _vertices.size () );
+                _vertices.push_back ( points[ v ] );
+                _boundsLocal.AddVertex ( points[ v ] );
+            }
+
+            triangles.push_back ( index );
+        }
+    }
+
+    _boundsWorld = _boundsLocal;
+    _lastSupport.store ( 0U, std::memory_order_relaxed );
+
+    BuildTopology ( triangles );
+    BuildFaces ( triangles );
+    BuildMassProperties ( triangles );
+    return true;
+}
+
+void ShapeConvexHull::BuildFaces ( std::vector<uint32_t> const &triangles ) noexcept
+{
+    size_t const triangleCount = triangles.size () / 3U;
+    uint32_t const* t = triangles.data ();
+
+    std::unordered_map<uint64_t, uint32_t> edgeOwners {};
+    edgeOwners.reserve ( triangles.size () );
+
+    std::vector<GXVec3> normals ( triangleCount );
+
+    for ( size_t i = 0U; i < triangleCount; ++i )
+    {
+        uint32_t const* v = t + 3U * i;
+
+        for ( size_t j = 0U; j < 3U; ++j )
+            edgeOwners.emplace ( MakeEdgeKey ( v[ j ], v[ ( j + 1U ) % 3U ] ), static_cast<uint32_t> ( i ) );
+
+        GXVec3 ab {};
+        ab.Subtract ( _vertices[ v[ 1U ] ], _vertices[ v[ 0U ] ] );
+
+        GXVec3 ac {};
+        ac.Subtract ( _vertices[ v[ 2U ] ], _vertices[ v[ 0U ] ] );
+
+        // Note the normal is not normalized. Its length is double area of the triangle.
+        normals[ i ].CrossProduct ( ab, ac );
+    }
+
+    constexpr uint32_t noFace = std::numeric_limits<uint32_t>::max ();
+    std::vector<uint32_t> triangleFaces ( triangleCount, noFace );
+    std::vector<uint32_t> group {};
+    std::unordered_map<uint32_t, uint32_t> boundary {};
+
+    _faces.clear ();
+    _faceVertices.clear ();
+
+    for ( size_t seed = 0U; seed < triangleCount; ++seed )
+    {
+        if ( triangleFaces[ seed ] != noFace )
+            continue;
+
+        auto const face = static_cast<uint32_t> ( _faces.size () );
+        GXVec3 seedNormal ( normals[ seed ] );
+        seedNormal.Normalize ();
+
+        // Flood fill over the neighbour triangles with almost the same normal.
+        group.clear ();
+        group.push_back ( static_cast<uint32_t> ( seed ) );
+        triangleFaces[ seed ] = face;
+
+        for ( size_t i = 0U; i < group.size (); ++i )
+        {
+            uint32_t const* v = t + 3U * group[ i ];
+
+            for ( size_t j = 0U; j < 3U; ++j )
+            {
+                uint32_t const neighbour = edgeOwners[ MakeEdgeKey ( v[ ( j + 1U ) % 3U ], v[ j ] ) ];
+
+                if ( triangleFaces[ neighbour ] != noFace )
+                    continue;
+
+                GXVec3 n ( normals[ neighbour ] );
+                n.Normalize ();
+
+                if ( n.DotProduct ( seedNormal ) < COPLANAR_COSINE )
+                    continue;
+
+                triangleFaces[ neighbour ] = face;
+                group.push_back ( neighbour );
+            }
+        }
+
+        // Boundary edges of the group form counterclockwise loop around the face normal.
+        boundary.clear ();
+        GXVec3 normal ( 0.0F, 0.0F, 0.0F );
+
+        for ( uint32_t const triangle : group )
+        {
+            normal.Sum ( normal, normals[ triangle ] );
+            uint32_t const* v = t + 3U * triangle;
+
+            for ( size_t j = 0U; j < 3U; ++j )
+            {
+                uint32_t const from = v[ j ];
+                uint32_t const to = v[ ( j + 1U ) % 3U ];
+
+                if ( triangleFaces[ edgeOwners[ MakeEdgeKey ( to, from ) ] ] != face )
+                {
+                    boundary.emplace ( from, to );
+                }
+            }
+        }
+
+        normal.Normalize ();
+        auto const first = static_cast<uint32_t> ( _faceVertices.size () );
+        uint32_t const start = boundary.begin ()->first;
+        uint32_t current = start;
+
+        do
+        {
+            _faceVertices.push_back ( current );
+            current = boundary[ current ];
+        }
+        while ( current != start && _faceVertices.size () - first <= boundary.size () );
+
+        // Vertices in the middle of straight boundary are not needed for the face polygon.
+        for ( size_t i = first; i < _faceVertices.size () && _faceVertices.size () - first > 3U; )
+        {
+            size_t const last = _faceVertices.size () - 1U;
+            GXVec3 const &prev = _vertices[ _faceVertices[ i == first ? last : i - 1U ] ];
+            GXVec3 const &curr = _vertices[ _faceVertices[ i ] ];
+            GXVec3 const &next = _vertices[ _faceVertices[ i == last ? first : i + 1U ] ];
+
+            GXVec3 a {};
+            a.Subtract ( curr, prev );
+            a.Normalize ();
+
+            GXVec3 b {};
+            b.Subtract ( next, curr );
+            b.Normalize ();
+
+            GXVec3 cross {};
+            cross.CrossProduct ( a, b );
+
+            if ( cross.Length () > DISTANCE_TOLERANCE )
+            {
+                ++i;
+                continue;
+            }
+
+            _faceVertices.erase ( _faceVertices.begin () + static_cast<std::ptrdiff_t> ( i ) );
+        }
+
+        _faces.push_back (
+            Face
+            {
+                ._normal = normal,
+                ._first = first,
+                ._count = static_cast<uint32_t> ( _faceVertices.size () - first )
+            }
+        );
+    }
+
+    // Vertex to face references.
+    size_t const vertexCount = _vertices.size ();
+    _vertexFaceOffsets.assign ( vertexCount + 1U, 0U );
+
+    for ( uint32_t const v : _faceVertices )
+        ++_vertexFaceOffsets[ v + 1U ];
+
+    for ( size_t i = 0U; i < vertexCount; ++i )
+        _vertexFaceOffsets[ i + 1U ] += _vertexFaceOffsets[ i ];
+
+    _vertexFaces.resize ( _faceVertices.size () );
+    std::vector<uint32_t> cursor ( _vertexFaceOffsets.cbegin (), _vertexFaceOffsets.cend () - 1 );
+    auto const faceCount = static_cast<uint32_t> ( _faces.size () );
+
+    for ( uint32_t face = 0U; face < faceCount; ++face )
+    {
+        Face const &f = _faces[ face ];
+
+        for ( uint32_t i = 0U; i < f._count; ++i )
+        {
+            _vertexFaces[ cursor[ _faceVertices[ f._first + i ] ]++ ] = face;
+        }
+    }
+}
+
+void ShapeConvexHull::BuildMassProperties ( std::vector<uint32_t> const &triangles ) noexcept
+{
+    // Every hull triangle forms tetrahedron with the origin. Signed volumes make the result valid even if the origin
+    // is outside of the hull. Covariance of the tetrahedron with vertices "0, a, b, c" is
+    // "det / 120 * ( a * aT + b * bT + c * cT + s * sT )" where "s = a + b + c" and "det = a * ( b x c )".
+    // https://en.wikipedia.org/wiki/Tetrahedron#Volume
+    // Jonathan Blow, Atman J Binstock, How to find the inertia tensor (or other mass properties) of a 3D solid body
+    // represented by a triangle mesh, 2004
+
+    _volume = 0.0F;
+    _covariance.Zeros ();
+    auto &c = _covariance._data;
+    size_t const count = triangles.size ();
+
+    for ( size_t i = 0U; i < count; i += 3U )
+    {
+        GXVec3 const &a = _vertices[ triangles[ i ] ];
+        GXVec3 const &b = _vertices[ triangles[ i + 1U ] ];
+        GXVec3 const &d = _vertices[ triangles[ i + 2U ] ];
+
+        GXVec3 bd {};
+        bd.CrossProduct ( b, d );
+        float const det = a.DotProduct ( bd );
+        _volume += det * ( 1.0F / 6.0F );
+
+        GXVec3 s {};
+        s.Sum ( a, b );
+        s.Sum ( s, d );
+
+        float const factor = det * ( 1.0F / 120.0F );
+
+        for ( size_t row = 0U; row < 3U; ++row )
+        {
+            for ( size_t column = 0U; column < 3U; ++column )
+            {
+                c[ row ][ column ] += factor * ( a._data[ row ] * a._data[ column ] +
+                    b._data[ row ] * b._data[ column ] + d._data[ row ] * d._data[ column ] +
+                    s._data[ row ] * s._data[ column ] );
+            }
+        }
+    }
+}
+
+void ShapeConvexHull::BuildTopology ( std::vector<uint32_t> const &triangles ) noexcept
+{
+    // Every hull edge is met twice in opposite directions. So the vertex gets every neighbour exactly once if only
+    // edge end is appended.
+    size_t const vertexCount = _vertices.size ();
+    size_t const count = triangles.size ();
+    _adjacencyOffsets.assign ( vertexCount + 1U, 0U );
+
+    for ( size_t i = 0U; i < count; ++i )
+        ++_adjacencyOffsets[ triangles[ i ] + 1U ];
+
+    for ( size_t i = 0U; i < vertexCount; ++i )
+        _adjacencyOffsets[ i + 1U ] += _adjacencyOffsets[ i ];
+
+    _adjacency.resize ( count );
+    std::vector<uint32_t> cursor ( _adjacencyOffsets.cbegin (), _adjacencyOffsets.cend () - 1 );
+
+    for ( size_t i = 0U; i < count; i += 3U )
+    {
+        for ( size_t j = 0U; j < 3U; ++j )
+        {
+            _adjacency[ cursor[ triangles[ i + j ] ]++ ] = triangles[ i + ( j + 1U ) % 3U ];
+        }
+    }
+}
+
+uint32_t ShapeConvexHull::FindSupport ( GXVec3 const &directionLocal ) const noexcept
+{
+    uint32_t const* adjacency = _adjacency.data ();
+    uint32_t const* offsets = _adjacencyOffsets.data ();
+    GXVec3 const* vertices = _vertices.data ();
+
+    uint32_t current = _lastSupport.load ( std::memory_order_relaxed );
+    float best = directionLocal.DotProduct ( vertices[ current ] );
+
+    // Local maximum of the convex hull is the global maximum.
+    for ( uint32_t previous = std::numeric_limits<uint32_t>::max (); previous != current; )
+    {
+        previous = current;
+
+        for ( uint32_t i = offsets[ previous ]; i < offsets[ previous + 1U ]; ++i )
+        {
+            uint32_t const neighbour = adjacency[ i ];
+            float const dot = directionLocal.DotProduct ( vertices[ neighbour ] );
+
+            if ( dot <= best )
+                continue;
+
+            best = dot;
+            current = neighbour;
+        }
+    }
+
+    // The direction could be perpendicular to the face or to the edge. In that case all vertices of the plateau are
+    // support points. The vertex with the smallest index is selected. So the result does not depend on the start
+    // vertex and the simulation stays deterministic.
+    uint32_t plateau[ MAX_PLATEAU_VERTICES ];
+    plateau[ 0U ] = current;
+    size_t plateauSize = 1U;
+    uint32_t result = current;
+
+    for ( size_t p = 0U; p < plateauSize; ++p )
+    {
+        uint32_t const vertex = plateau[ p ];
+
+        for ( uint32_t i = offsets[ vertex ]; i < offsets[ vertex + 1U ]; ++i )
+        {
+            uint32_t const neighbour = adjacency[ i ];
+
+            if ( directionLocal.DotProduct ( vertices[ neighbour ] ) != best || plateauSize == MAX_PLATEAU_VERTICES )
+                continue;
+
+            auto const end = plateau + plateauSize;
+
+            if ( std::find ( plateau, end, neighbour ) != end )
+                continue;
+
+            plateau[ plateauSize++ ] = neighbour;
+            result = std::min ( result, neighbour );
+        }
+    }
+
+    _lastSupport.store ( result, std::memory_order_relaxed );
+    return result;
+}
+
+GXVec3 ShapeConvexHull::ToLocalDirection ( GXVec3 const &directionWorld ) const noexcept
+{
+    // Transform uses row vectors. So inverse rotation is multiplication by the rotation rows.
+    GXMat3 const rotation ( _transformWorld );
+
+    GXVec3 result {};
+    rotation.MultiplyMatrixVector ( result, directionWorld );
+    return result;
+}
+
+} // namespace android_vulkan
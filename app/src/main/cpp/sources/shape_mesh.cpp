@@ -0,0 +1,469 @@
+#include <precompiled_headers.hpp>
+#include <shape_mesh.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+constexpr float QUANTIZATION_LEVELS = 65535.0F;
+
+// Twice triangle area below the threshold means degenerate triangle. The value is in square meters.
+constexpr float DEGENERATE_TRIANGLE = 1.0e-8F;
+
+// Segment direction component below the threshold is treated as parallel to the slab.
+constexpr float PARALLEL_EPSILON = 1.0e-7F;
+
+// The segment is in the triangle plane if the determinant is below the threshold.
+constexpr float RAY_TRIANGLE_EPSILON = 1.0e-9F;
+
+struct Segment final
+{
+    GXVec3      _from;
+    GXVec3      _inverseDirection;
+    bool        _isParallel[ 3U ];
+};
+
+[[nodiscard]] Segment MakeSegment ( GXVec3 const &from, GXVec3 const &direction ) noexcept
+{
+    Segment segment {};
+    segment._from = from;
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        float const d = direction._data[ i ];
+        bool const isParallel = std::abs ( d ) < PARALLEL_EPSILON;
+        segment._isParallel[ i ] = isParallel;
+        segment._inverseDirection._data[ i ] = isParallel ? 0.0F : 1.0F / d;
+    }
+
+    return segment;
+}
+
+[[nodiscard]] bool IsSegmentOverlapped ( Segment const &segment,
+    GXVec3 const &bMin,
+    GXVec3 const &bMax,
+    float length
+) noexcept
+{
+    float tMin = 0.0F;
+    float tMax = length;
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        float const o = segment._from._data[ i ];
+        float const lo = bMin._data[ i ];
+        float const hi = bMax._data[ i ];
+
+        if ( segment._isParallel[ i ] )
+        {
+            if ( o < lo || o > hi )
+                return false;
+
+            continue;
+        }
+
+        float const invD = segment._inverseDirection._data[ i ];
+        float t0 = ( lo - o ) * invD;
+        float t1 = ( hi - o ) * invD;
+
+        if ( t0 > t1 )
+            std::swap ( t0, t1 );
+
+        tMin = std::max ( tMin, t0 );
+        tMax = std::min ( tMax, t1 );
+
+        if ( tMin > tMax )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Möller–Trumbore algorithm. Both triangle sides are hit.
+// https://en.wikipedia.org/wiki/M%C3%B6ller%E2%80%93Trumbore_intersection_algorithm
+[[nodiscard]] bool IntersectTriangle ( float &t,
+    ShapeMesh::Triangle const &triangle,
+    GXVec3 const &from,
+    GXVec3 const &direction
+) noexcept
+{
+    GXVec3 const &a = triangle._vertices[ 0U ];
+
+    GXVec3 ab {};
+    ab.Subtract ( triangle._vertices[ 1U ], a );
+
+    GXVec3 ac {};
+    ac.Subtract ( triangle._vertices[ 2U ], a );
+
+    GXVec3 p {};
+    p.CrossProduct ( direction, ac );
+    float const det = ab.DotProduct ( p );
+
+    if ( std::abs ( det ) < RAY_TRIANGLE_EPSILON )
+        return false;
+
+    float const invDet = 1.0F / det;
+
+    GXVec3 s {};
+    s.Subtract ( from, a );
+    float const u = s.DotProduct ( p ) * invDet;
+
+    if ( u < 0.0F || u > 1.0F )
+        return false;
+
+    GXVec3 q {};
+    q.CrossProduct ( s, ab );
+    float const v = direction.DotProduct ( q ) * invDet;
+
+    if ( v < 0.0F || u + v > 1.0F )
+        return false;
+
+    t = ac.DotProduct ( q ) * invDet;
+    return t >= 0.0F;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[maybe_unused]] ShapeMesh::ShapeMesh ( std::span<GXVec3 const> vertices, std::span<uint32_t const> indices ) noexcept:
+    Shape ( eShapeType::Mesh ),
+    _vertices ( vertices.begin (), vertices.end () )
+{
+    size_t const indexCount = indices.size () - indices.size () % 3U;
+    std::vector<GXAABB> triangleBounds {};
+    triangleBounds.reserve ( indexCount / 3U );
+
+    std::vector<GXVec3> centers {};
+    centers.reserve ( indexCount / 3U );
+
+    std::vector<uint32_t> valid {};
+    valid.reserve ( indexCount );
+
+    for ( size_t i = 0U; i < indexCount; i += 3U )
+    {
+        GXVec3 const &a = vertices[ indices[ i ] ];
+        GXVec3 const &b = vertices[ indices[ i + 1U ] ];
+        GXVec3 const &c = vertices[ indices[ i + 2U ] ];
+
+        GXVec3 ab {};
+        ab.Subtract ( b, a );
+
+        GXVec3 ac {};
+        ac.Subtract ( c, a );
+
+        GXVec3 n {};
+        n.CrossProduct ( ab, ac );
+
+        if ( n.SquaredLength () < DEGENERATE_TRIANGLE * DEGENERATE_TRIANGLE )
+            continue;
+
+        valid.insert ( valid.end (), indices.begin () + static_cast<std::ptrdiff_t> ( i ),
+            indices.begin () + static_cast<std::ptrdiff_t> ( i + 3U )
+        );
+
+        GXAABB &bounds = triangleBounds.emplace_back ();
+        bounds.AddVertex ( a );
+        bounds.AddVertex ( b );
+        bounds.AddVertex ( c );
+
+        _boundsLocal.AddVertex ( bounds._min );
+        _boundsLocal.AddVertex ( bounds._max );
+
+        GXVec3 &center = centers.emplace_back ();
+        center.Sum ( bounds._min, bounds._max );
+        center.Multiply ( center, 0.5F );
+    }
+
+    if ( valid.empty () ) [[unlikely]]
+        _boundsLocal.AddVertex ( 0.0F, 0.0F, 0.0F );
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        float const extent = _boundsLocal._max._data[ i ] - _boundsLocal._min._data[ i ];
+
+        // Flat mesh gets zero scale. So every node covers the whole axis range which has zero length.
+        _quantizationScale._data[ i ] = extent > 0.0F ? QUANTIZATION_LEVELS / extent : 0.0F;
+    }
+
+    auto const triangleCount = static_cast<uint32_t> ( valid.size () / 3U );
+
+    if ( triangleCount > 0U ) [[likely]]
+    {
+        std::vector<uint32_t> order ( triangleCount );
+        std::iota ( order.begin (), order.end (), 0U );
+
+        _nodes.reserve ( 2U * static_cast<size_t> ( triangleCount ) - 1U );
+        BuildNode ( order, triangleBounds, centers );
+    }
+
+    // Triangles are stored in leaf order. So neighbour leaves refer to neighbour triangles in memory.
+    _indices.reserve ( valid.size () );
+    uint32_t triangle = 0U;
+
+    for ( Node &node : _nodes )
+    {
+        if ( !( node._index & LEAF_FLAG ) )
+            continue;
+
+        uint32_t const* v = valid.data () + 3U * static_cast<size_t> ( node._index & ~LEAF_FLAG );
+        _indices.insert ( _indices.end (), v, v + 3U );
+        node._index = triangle++ | LEAF_FLAG;
+    }
+
+    _trianglesWorld.resize ( triangleCount );
+    UpdateBounds ();
+}
+
+void ShapeMesh::CollectTriangles ( std::vector<uint32_t> &triangles, GXAABB const &boundsWorld ) const noexcept
+{
+    GXAABB boundsLocal {};
+    boundsWorld.Transform ( boundsLocal, _transformWorldInverse );
+    QuantizedBounds const q = Quantize ( boundsLocal );
+
+    Node const* nodes = _nodes.data ();
+    auto const count = static_cast<uint32_t> ( _nodes.size () );
+
+    for ( uint32_t i = 0U; i < count; )
+    {
+        Node const &node = nodes[ i ];
+
+        bool const isOverlapped = node._min[ 0U ] <= q._max[ 0U ] && node._max[ 0U ] >= q._min[ 0U ] &&
+            node._min[ 1U ] <= q._max[ 1U ] && node._max[ 1U ] >= q._min[ 1U ] &&
+            node._min[ 2U ] <= q._max[ 2U ] && node._max[ 2U ] >= q._min[ 2U ];
+
+        bool const isLeaf = ( node._index & LEAF_FLAG ) != 0U;
+
+        if ( isLeaf & isOverlapped )
+            triangles.push_back ( node._index & ~LEAF_FLAG );
+
+        i = isLeaf | isOverlapped ? i + 1U : node._index;
+    }
+}
+
+ShapeMesh::Triangle const &ShapeMesh::GetTriangleWorld ( uint32_t triangle ) const noexcept
+{
+    return _trianglesWorld[ triangle ];
+}
+
+[[maybe_unused]] size_t ShapeMesh::GetTriangleCount () const noexcept
+{
+    return _trianglesWorld.size ();
+}
+
+bool ShapeMesh::Raycast ( GXVec3 &point, GXVec3 &normal, GXVec3 const &from, GXVec3 const &to ) const noexcept
+{
+    // Hierarchy is traversed in local space. Triangles are tested in world space. The segment parameter is
+    // the same in both spaces because the transform is rigid.
+    GXVec3 fromLocal {};
+    _transformWorldInverse.MultiplyAsPoint ( fromLocal, from );
+
+    GXVec3 toLocal {};
+    _transformWorldInverse.MultiplyAsPoint ( toLocal, to );
+
+    GXVec3 directionLocal {};
+    directionLocal.Subtract ( toLocal, fromLocal );
+    Segment const segment = MakeSegment ( fromLocal, directionLocal );
+
+    GXVec3 direction {};
+    direction.Subtract ( to, from );
+
+    GXVec3 const &origin = _boundsLocal._min;
+    GXVec3 step {};
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        float const scale = _quantizationScale._data[ i ];
+        step._data[ i ] = scale > 0.0F ? 1.0F / scale : 0.0F;
+    }
+
+    Node const* nodes = _nodes.data ();
+    auto const count = static_cast<uint32_t> ( _nodes.size () );
+    Triangle const* triangles = _trianglesWorld.data ();
+
+    float closest = 1.0F;
+    Triangle const* hit = nullptr;
+
+    for ( uint32_t i = 0U; i < count; )
+    {
+        Node const &node = nodes[ i ];
+
+        GXVec3 const bMin ( origin._data[ 0U ] + static_cast<float> ( node._min[ 0U ] ) * step._data[ 0U ],
+            origin._data[ 1U ] + static_cast<float> ( node._min[ 1U ] ) * step._data[ 1U ],
+            origin._data[ 2U ] + static_cast<float> ( node._min[ 2U ] ) * step._data[ 2U ]
+        );
+
+        GXVec3 const bMax ( origin._data[ 0U ] + static_cast<float> ( node._max[ 0U ] ) * step._data[ 0U ],
+            origin._data[ 1U ] + static_cast<float> ( node._max[ 1U ] ) * step._data[ 1U ],
+            origin._data[ 2U ] + static_cast<float> ( node._max[ 2U ] ) * step._data[ 2U ]
+        );
+
+        bool const isOverlapped = IsSegmentOverlapped ( segment, bMin, bMax, closest );
+        bool const isLeaf = ( node._index & LEAF_FLAG ) != 0U;
+
+        if ( isLeaf & isOverlapped )
+        {
+            Triangle const &triangle = triangles[ node._index & ~LEAF_FLAG ];
+            float t;
+
+            if ( IntersectTriangle ( t, triangle, from, direction ) && t <= closest )
+            {
+                closest = t;
+                hit = &triangle;
+            }
+        }
+
+        i = isLeaf | isOverlapped ? i + 1U : node._index;
+    }
+
+    if ( !hit )
+        return false;
+
+    point.Sum ( from, closest, direction );
+    normal = hit->_normal;
+
+    if ( normal.DotProduct ( direction ) > 0.0F )
+        normal.Reverse ();
+
+    return true;
+}
+
+void ShapeMesh::CalculateInertiaTensor ( float /*mass*/ ) noexcept
+{
+    // Static geometry does not rotate.
+    _inertiaTensorInverse.Zeros ();
+}
+
+GXVec3 ShapeMesh::GetExtremePointWorld ( GXVec3 const &direction ) const noexcept
+{
+    // Transform uses row vectors. So inverse rotation is multiplication by the rotation rows.
+    GXMat3 const rotation ( _transformWorld );
+
+    GXVec3 d {};
+    rotation.MultiplyMatrixVector ( d, direction );
+
+    GXVec3 const* extreme = _vertices.data ();
+    float best = -std::numeric_limits<float>::max ();
+
+    for ( GXVec3 const &v : _vertices )
+    {
+        float const dot = d.DotProduct ( v );
+
+        if ( dot <= best )
+            continue;
+
+        best = dot;
+        extreme = &v;
+    }
+
+    GXVec3 result {};
+    _transformWorld.MultiplyAsPoint ( result, *extreme );
+    return result;
+}
+
+void ShapeMesh::UpdateBounds () noexcept
+{
+    _boundsLocal.Transform ( _boundsWorld, _transformWorld );
+    _transformWorldInverse.Inverse ( _transformWorld );
+
+    uint32_t const* indices = _indices.data ();
+    GXVec3 const* vertices = _vertices.data ();
+
+    for ( Triangle &triangle : _trianglesWorld )
+    {
+        GXVec3* v = triangle._vertices;
+        _transformWorld.MultiplyAsPoint ( v[ 0U ], vertices[ indices[ 0U ] ] );
+        _transformWorld.MultiplyAsPoint ( v[ 1U ], vertices[ indices[ 1U ] ] );
+        _transformWorld.MultiplyAsPoint ( v[ 2U ], vertices[ indices[ 2U ] ] );
+        indices += 3U;
+
+        GXVec3 ab {};
+        ab.Subtract ( v[ 1U ], v[ 0U ] );
+
+        GXVec3 ac {};
+        ac.Subtract ( v[ 2U ], v[ 0U ] );
+
+        triangle._normal.CrossProduct ( ab, ac );
+        triangle._normal.Normalize ();
+    }
+}
+
+void ShapeMesh::BuildNode ( std::span<uint32_t> order,
+    std::vector<GXAABB> const &triangleBounds,
+    std::vector<GXVec3> const &centers
+) noexcept
+{
+    // Top down construction. The triangles are split by median of bounds centers along the longest axis.
+    // So the hierarchy is balanced and the recursion depth is logarithmic.
+    size_t const nodeIndex = _nodes.size ();
+    GXAABB bounds {};
+    GXAABB centerBounds {};
+
+    for ( uint32_t const triangle : order )
+    {
+        GXAABB const &b = triangleBounds[ triangle ];
+        bounds.AddVertex ( b._min );
+        bounds.AddVertex ( b._max );
+        centerBounds.AddVertex ( centers[ triangle ] );
+    }
+
+    QuantizedBounds const q = Quantize ( bounds );
+
+    _nodes.push_back (
+        Node
+        {
+            ._min = { q._min[ 0U ], q._min[ 1U ], q._min[ 2U ] },
+            ._max = { q._max[ 0U ], q._max[ 1U ], q._max[ 2U ] },
+            ._index = order.front () | LEAF_FLAG
+        }
+    );
+
+    if ( order.size () == 1U )
+        return;
+
+    GXVec3 extent {};
+    extent.Subtract ( centerBounds._max, centerBounds._min );
+    size_t axis = extent._data[ 1U ] > extent._data[ 0U ] ? 1U : 0U;
+
+    if ( extent._data[ 2U ] > extent._data[ axis ] )
+        axis = 2U;
+
+    size_t const half = order.size () / 2U;
+
+    std::nth_element ( order.begin (),
+        order.begin () + static_cast<std::ptrdiff_t> ( half ),
+        order.end (),
+
+        [ & ] ( uint32_t a, uint32_t b ) noexcept -> bool {
+            return centers[ a ]._data[ axis ] < centers[ b ]._data[ axis ];
+        }
+    );
+
+    BuildNode ( order.first ( half ), triangleBounds, centers );
+    BuildNode ( order.subspan ( half ), triangleBounds, centers );
+    _nodes[ nodeIndex ]._index = static_cast<uint32_t> ( _nodes.size () );
+}
+
+ShapeMesh::QuantizedBounds ShapeMesh::Quantize ( GXAABB const &bounds ) const noexcept
+{
+    // Minimum is rounded down and maximum is rounded up. So quantized bounds always contain the original bounds.
+    QuantizedBounds result {};
+    GXVec3 const &origin = _boundsLocal._min;
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        float const scale = _quantizationScale._data[ i ];
+        float const lo = std::floor ( ( bounds._min._data[ i ] - origin._data[ i ] ) * scale );
+        float const hi = std::ceil ( ( bounds._max._data[ i ] - origin._data[ i ] ) * scale );
+
+        result._min[ i ] = static_cast<uint16_t> ( std::clamp ( lo, 0.0F, QUANTIZATION_LEVELS ) );
+        result._max[ i ] = static_cast<uint16_t> ( std::clamp ( hi, 0.0F, QUANTIZATION_LEVELS ) );
+    }
+
+    return result;
+}
+
+} // namespace android_vulkan
@@ -0,0 +1,163 @@
+#include <precompiled_headers.hpp>
+#include <simulation_islands.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+constexpr size_t INITIAL_BODIES = 1024U;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+SimulationIslands::SimulationIslands () noexcept
+{
+    _bodies.reserve ( INITIAL_BODIES );
+    _islands.reserve ( INITIAL_BODIES );
+    _parents.reserve ( INITIAL_BODIES );
+    _sizes.reserve ( INITIAL_BODIES );
+}
+
+void SimulationIslands::Build ( std::vector<RigidBodyRef> const &dynamics,
+    std::vector<ContactManifold> const &manifolds,
+    std::vector<ConstraintRef> const &constraints
+) noexcept
+{
+    size_t const count = dynamics.size ();
+
+    _bodies.clear ();
+    _islands.clear ();
+    _islands.resize ( count );
+    _parents.resize ( count );
+    _sizes.clear ();
+    _sizes.resize ( count, 1U );
+
+    for ( auto const &dynamic : dynamics )
+    {
+        RigidBody &body = *dynamic;
+        auto const idx = static_cast<uint32_t> ( _bodies.size () );
+
+        body.SetIslandIndex ( idx );
+        _parents[ idx ] = idx;
+        _bodies.push_back ( &body );
+    }
+
+    for ( auto const &manifold : manifolds )
+        Connect ( *manifold._bodyA, *manifold._bodyB );
+
+    for ( auto const &constraint : constraints )
+        Connect ( *constraint->GetBodyA (), *constraint->GetBodyB () );
+
+    // Propagating node flags to the island roots. Note the parent of every node becomes the island root here.
+    for ( uint32_t i = 0U; i < static_cast<uint32_t> ( count ); ++i )
+    {
+        uint32_t const root = Find ( i );
+        _parents[ i ] = root;
+
+        RigidBody const &body = *_bodies[ i ];
+        Island const node = _islands[ i ];
+        Island &island = _islands[ root ];
+
+        island._hasAwake |= node._hasAwake | body.IsAwake ();
+        island._isReadyToSleep &= node._isReadyToSleep;
+    }
+
+    for ( uint32_t i = 0U; i < static_cast<uint32_t> ( count ); ++i )
+    {
+        RigidBody &body = *_bodies[ i ];
+
+        if ( !body.IsAwake () && _islands[ _parents[ i ] ]._hasAwake )
+        {
+            body.SetAwake ();
+        }
+    }
+}
+
+void SimulationIslands::UpdateSleep () noexcept
+{
+    auto const count = static_cast<uint32_t> ( _bodies.size () );
+
+    for ( uint32_t i = 0U; i < count; ++i )
+    {
+        Island &island = _islands[ _parents[ i ] ];
+        island._isReadyToSleep &= _bodies[ i ]->IsReadyToSleep ();
+    }
+
+    for ( uint32_t i = 0U; i < count; ++i )
+    {
+        RigidBody &body = *_bodies[ i ];
+
+        if ( body.IsAwake () && _islands[ _parents[ i ] ]._isReadyToSleep )
+        {
+            body.Sleep ();
+        }
+    }
+}
+
+bool SimulationIslands::IsActive ( RigidBody const &body ) noexcept
+{
+    if ( !body.IsKinematic () )
+        return body.IsAwake ();
+
+    return body.GetVelocityLinear ().SquaredLength () > 0.0F || body.GetVelocityAngular ().SquaredLength () > 0.0F;
+}
+
+void SimulationIslands::Connect ( RigidBody const &a, RigidBody const &b ) noexcept
+{
+    bool const isKinematicA = a.IsKinematic ();
+    bool const isKinematicB = b.IsKinematic ();
+
+    if ( !isKinematicA && !isKinematicB )
+    {
+        Unite ( a.GetIslandIndex (), b.GetIslandIndex () );
+        return;
+    }
+
+    if ( isKinematicA && isKinematicB )
+        return;
+
+    // Moving kinematic body keeps the island awake. Note the island root is unknown yet.
+    RigidBody const &kinematic = isKinematicA ? a : b;
+
+    if ( !IsActive ( kinematic ) )
+        return;
+
+    RigidBody const &dynamic = isKinematicA ? b : a;
+    Island &island = _islands[ dynamic.GetIslandIndex () ];
+    island._hasAwake = true;
+    island._isReadyToSleep = false;
+}
+
+uint32_t SimulationIslands::Find ( uint32_t node ) noexcept
+{
+    // Path halving.
+    uint32_t* parents = _parents.data ();
+
+    while ( parents[ node ] != node )
+    {
+        parents[ node ] = parents[ parents[ node ] ];
+        node = parents[ node ];
+    }
+
+    return node;
+}
+
+void SimulationIslands::Unite ( uint32_t a, uint32_t b ) noexcept
+{
+    uint32_t rootA = Find ( a );
+    uint32_t rootB = Find ( b );
+
+    if ( rootA == rootB )
+        return;
+
+    // Union by size.
+    if ( _sizes[ rootA ] < _sizes[ rootB ] )
+        std::swap ( rootA, rootB );
+
+    _parents[ rootB ] = rootA;
+    _sizes[ rootA ] += _sizes[ rootB ];
+}
+
+} // namespace android_vulkan
@@ -164,8 +164,10 @@ SoundEmitter::eStreamerType SoundEmitter::GetStreamerType ( std::string_view con
     return eStreamerType::UNKNOWN;
 }
 
-void SoundEmitter::OnStopRequested ( SoundEmitter &soundEmitter ) noexcept
+void SoundEmitter::OnStopRequested ( PCMSource &source ) noexcept
 {
+    auto &soundEmitter = static_cast<SoundEmitter &> ( source );
+
     std::thread thread (
         [ &soundEmitter ] () noexcept {
             if ( !soundEmitter.Stop () ) [[unlikely]]
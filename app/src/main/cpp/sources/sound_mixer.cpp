@@ -9,7 +9,6 @@ namespace android_vulkan {
 namespace {
 
 constexpr float CHANNEL_VOLUME = 1.0F;
-constexpr size_t MAX_HARDWARE_STREAM_CAP = 32U;
 constexpr double TRIM_TIMEOUT_SECONDS = 5.0;
 constexpr auto WORKER_TIMEOUT = std::chrono::microseconds ( 1U );
 
@@ -71,62 +70,20 @@ StreamCloser::~StreamCloser () noexcept
 
 //----------------------------------------------------------------------------------------------------------------------
 
-SoundMixer::StreamInfo::StreamInfo ( SoundMixer &mixer, StreamList::iterator used ) noexcept:
-    _mixer ( &mixer ),
-    _used ( used )
-{
-    // NOTHING
-}
-
-bool SoundMixer::StreamInfo::LockAndReturnFillSilence () noexcept
-{
-    auto &fillLock = *_fillLock;
-    bool expected = false;
-
-    while ( !fillLock.compare_exchange_weak ( expected, true ) )
-        expected = false;
-
-    AV_ASSERT ( !expected )
-    return _fillSilence;
-}
-
-void SoundMixer::StreamInfo::Release () noexcept
-{
-    _fillLock->store ( false );
-}
-
-void SoundMixer::StreamInfo::Modify ( bool fillSilence ) noexcept
-{
-    auto &fillLock = *_fillLock;
-    bool expected = false;
-
-    while ( !fillLock.compare_exchange_weak ( expected, true ) )
-        expected = false;
-
-    AV_ASSERT ( !expected )
-    _fillSilence = fillSilence;
-    fillLock.store ( false );
-}
-
-//----------------------------------------------------------------------------------------------------------------------
-
 void SoundMixer::CheckMemoryLeaks () noexcept
 {
 
 #ifdef AV_DEBUG
 
-    if ( !_streamMap.empty () )
+    if ( !_emitters.empty () )
     {
         constexpr char const format[] = R"__(SoundMixer::Destroy - Memory leak detected: %zu
 >>>)__";
 
-        LogError ( format, _streamMap.size () );
+        LogError ( format, _emitters.size () );
 
-        for ( auto const &record : _streamMap )
-        {
-            StreamInfo const &si = *record.second;
-            LogError ( "    %s", si._emitter->GetFile ().c_str () );
-        }
+        for ( auto const* emitter : _emitters )
+            LogError ( "    %s", emitter->GetFile ().c_str () );
 
         LogError ( "<<<" );
 
@@ -140,7 +97,8 @@ void SoundMixer::CheckMemoryLeaks () noexcept
 
 #endif // AV_DEBUG
 
-    _streamMap.clear ();
+    _emitters.clear ();
+    _pcmMixer.Clear ();
 }
 
 bool SoundMixer::Init () noexcept
@@ -185,13 +143,28 @@ bool SoundMixer::Init () noexcept
         return false;
     }
 
-    if ( !CreateHardwareStreams () ) [[unlikely]]
+    auto const engineStream = CreateStream ();
+
+    if ( !engineStream ) [[unlikely]]
     {
         Destroy ();
         return false;
     }
 
-    PrintStreamInfo ( *_streamInfo.front ()._stream, "Engine parameters" );
+    _stream = *engineStream;
+    PrintStreamInfo ( *_stream, "Engine parameters" );
+
+    // The stream plays all the time. Silence is mixed if there is no playing emitters.
+    _isPaused = false;
+
+    _actionQueue.emplace_back (
+        ActionInfo
+        {
+            ._handler = &SoundMixer::ExecutePlay,
+            ._stream = _stream
+        }
+    );
+
     _workerFlag = true;
 
     _workerThread = std::thread (
@@ -225,28 +198,6 @@ bool SoundMixer::Init () noexcept
 
                 _actionQueue.clear ();
 
-                for ( auto i = _stopping.begin (); i != _stopping.end (); )
-                {
-                    StreamInfo* si = *i++;
-                    aaudio_stream_state_t state;
-
-                    aaudio_result_t const result = CheckAAudioResult (
-                        AAudioStream_waitForStateChange ( si->_stream,
-                            AAUDIO_STREAM_STATE_STOPPING,
-                            &state,
-                            0
-                        ),
-
-                        "SoundMixer::Init::_thread",
-                        "Can't update state of stopping stream"
-                    );
-
-                    if ( !result | ( state != AAUDIO_STREAM_STATE_STOPPED ) )
-                        continue;
-
-                    _free.splice ( _free.cbegin (), _stopping, si->_used );
-                }
-
                 auto const now = std::chrono::system_clock::now ();
                 std::chrono::duration<double> const delta = now - last;
 
@@ -272,21 +223,19 @@ void SoundMixer::Destroy () noexcept
 
     std::lock_guard const lock ( _mutex );
 
-    for ( auto &si : _streamInfo )
+    if ( _stream )
     {
-        SoundMixer::CheckAAudioResult ( AAudioStream_close ( si._stream ),
+        SoundMixer::CheckAAudioResult ( AAudioStream_close ( _stream ),
             "SoundMixer::Destroy",
             "Can't close stream"
         );
-    }
 
-    _free.clear ();
-    _stopping.clear ();
-    _used.clear ();
+        _stream = nullptr;
+    }
 
-    _streamMap.clear ();
-    _streamInfo.clear ();
-    _streamToResume.clear ();
+    _actionQueue.clear ();
+    _emitters.clear ();
+    _pcmMixer.Clear ();
 
     if ( !_builder ) [[unlikely]]
         return;
@@ -368,154 +317,64 @@ void SoundMixer::Pause () noexcept
 {
     std::lock_guard const lock ( _mutex );
 
-    if ( IsOffline () ) [[unlikely]]
+    if ( IsOffline () | _isPaused ) [[unlikely]]
         return;
 
-    for ( auto &record : _streamMap )
-    {
-        StreamInfo const &si = *record.second;
+    _isPaused = true;
 
-        if ( si._emitter->IsPlaying () )
+    _actionQueue.emplace_back (
+        ActionInfo
         {
-            AAudioStream* stream = si._stream;
-
-            _actionQueue.emplace_back (
-                ActionInfo
-                {
-                    ._handler = &SoundMixer::ExecutePause,
-                    ._stream = stream
-                }
-            );
-
-            _streamToResume.push_back ( stream );
+            ._handler = &SoundMixer::ExecutePause,
+            ._stream = _stream
         }
-    }
+    );
 }
 
 void SoundMixer::Resume () noexcept
 {
     std::lock_guard const lock ( _mutex );
 
-    if ( IsOffline () ) [[unlikely]]
+    if ( IsOffline () | !_isPaused ) [[unlikely]]
         return;
 
-    for ( auto* stream : _streamToResume )
-    {
-        _actionQueue.emplace_back (
-            ActionInfo
-            {
-                ._handler = &SoundMixer::ExecutePlay,
-                ._stream = stream
-            }
-        );
-    }
-
-    _streamToResume.clear ();
-}
-
-bool SoundMixer::RequestPause ( SoundEmitter &emitter ) noexcept
-{
-    std::lock_guard const lock ( _mutex );
-
-    if ( IsOffline () ) [[unlikely]]
-        return true;
-
-    auto findResult = _streamMap.find ( &emitter );
-
-    if ( findResult == _streamMap.end () ) [[unlikely]]
-    {
-        LogWarning ( "SoundMixer::RequestPause - Can't find emitter. Abort..." );
-        AV_ASSERT ( false )
-        return false;
-    }
-
-    StreamInfo &si = *findResult->second;
-    si.Modify ( true );
-
-    _free.splice ( _free.cbegin (), _used, si._used );
-    _streamMap.erase ( findResult );
+    _isPaused = false;
 
     _actionQueue.emplace_back (
         ActionInfo
         {
-            ._handler = &SoundMixer::ExecutePause,
-            ._stream = si._stream
+            ._handler = &SoundMixer::ExecutePlay,
+            ._stream = _stream
         }
     );
+}
 
-    return true;
+bool SoundMixer::RequestPause ( SoundEmitter &emitter ) noexcept
+{
+    return RemoveEmitter ( emitter, "SoundMixer::RequestPause" );
 }
 
 bool SoundMixer::RequestPlay ( SoundEmitter &emitter ) noexcept
 {
-    std::lock_guard const lock ( _mutex );
-
     if ( IsOffline () ) [[unlikely]]
         return true;
 
-    if ( _free.empty () ) [[unlikely]]
+    // Note the main mutex is not held here. The mix thread could wait for the decompressor under the mixer lock. And
+    // the decompressor needs the main mutex.
+    if ( !_pcmMixer.Add ( emitter, emitter.GetSoundChannel () ) ) [[unlikely]]
     {
-        LogWarning ( "SoundMixer::RequestPlay - No more free streams. Abort..." );
+        LogWarning ( "SoundMixer::RequestPlay - No more free tracks. Abort..." );
         return false;
     }
 
-    _used.splice ( _used.cbegin (), _free, _free.cbegin () );
-
-    StreamInfo &si = *_used.front ();
-    si.Modify ( false );
-
-    si._emitter = &emitter;
-    si._used = _used.begin ();
-    _streamMap.emplace ( &emitter, &si );
-
-    _actionQueue.emplace_back (
-        ActionInfo
-        {
-            ._handler = &SoundMixer::ExecutePlay,
-            ._stream = si._stream
-        }
-    );
-
+    std::lock_guard const lock ( _mutex );
+    _emitters.insert ( &emitter );
     return true;
 }
 
 bool SoundMixer::RequestStop ( SoundEmitter &emitter ) noexcept
 {
-    std::lock_guard const lock ( _mutex );
-
-    if ( IsOffline () ) [[unlikely]]
-        return true;
-
-    auto findResult = _streamMap.find ( &emitter );
-
-    if ( findResult == _streamMap.end () ) [[unlikely]]
-    {
-        LogWarning ( "SoundMixer::RequestStop - Can't find emitter. Abort..." );
-        AV_ASSERT ( false )
-        return false;
-    }
-
-    if ( IsOffline () ) [[unlikely]]
-    {
-        _streamMap.erase ( findResult );
-        return true;
-    }
-
-    StreamInfo &si = *findResult->second;
-    si.Modify ( true );
-
-    _stopping.splice ( _stopping.cbegin (), _used, si._used );
-    _streamMap.erase ( findResult );
-
-    _actionQueue.emplace_back (
-        ActionInfo
-        {
-            ._handler = &SoundMixer::ExecuteStop,
-            ._stream = si._stream
-        }
-    );
-
-    return true;
+    return RemoveEmitter ( emitter, "SoundMixer::RequestStop" );
 }
 
 void SoundMixer::RegisterDecompressor ( PCMStreamer &streamer ) noexcept
@@ -555,48 +414,9 @@ bool SoundMixer::CheckAAudioResult ( aaudio_result_t result, char const* from, c
     return false;
 }
 
-bool SoundMixer::CreateHardwareStreams () noexcept
+std::optional<AAudioStream*> SoundMixer::CreateStream () noexcept
 {
-    _streamInfo.reserve ( MAX_HARDWARE_STREAM_CAP );
-    size_t counter = 0U;
-
-    for ( ; counter < MAX_HARDWARE_STREAM_CAP; ++counter )
-    {
-        StreamInfo &si = _streamInfo.emplace_back ( *this, _used.end () );
-        AAudioStreamBuilder_setDataCallback ( _builder, &SoundMixer::PCMCallback, &si );
-
-        if ( AAudioStreamBuilder_openStream ( _builder, &si._stream ) != AAUDIO_OK ) [[unlikely]]
-        {
-            _streamInfo.pop_back ();
-            break;
-        }
-
-        if ( !SetStreamBufferSize ( *si._stream, "SoundMixer::CreateHardwareStreams" ) ) [[unlikely]]
-        {
-            AV_ASSERT ( false )
-            return false;
-        }
-
-        if ( !ValidateStream ( *si._stream ) ) [[unlikely]]
-            return false;
-
-        _free.push_back ( &si );
-    }
-
-    if ( counter < 1U ) [[unlikely]]
-    {
-        LogError ( "SoundMixer::CreateHardwareStreams - No available hardware streams!" );
-        AV_ASSERT ( false )
-        return false;
-    }
-
-    LogInfo ( "SoundMixer::CreateHardwareStreams - Hardware streams: %zu.", counter );
-    return true;
-}
-
-std::optional<AAudioStream*> SoundMixer::CreateStream ( StreamInfo &streamInfo ) noexcept
-{
-    AAudioStreamBuilder_setDataCallback ( _builder, &SoundMixer::PCMCallback, &streamInfo );
+    AAudioStreamBuilder_setDataCallback ( _builder, &SoundMixer::PCMCallback, this );
 
     AAudioStream* stream = nullptr;
     aaudio_result_t const result = AAudioStreamBuilder_openStream ( _builder, &stream );
@@ -620,38 +440,60 @@ void SoundMixer::RecreateSoundStream ( AAudioStream &stream ) noexcept
             std::lock_guard const lock ( _mutex );
 
             StreamCloser const closer ( stream );
-            StreamInfo* targetStreamInfo = nullptr;
-
-            for ( auto &si : _streamInfo )
-            {
-                if ( si._stream == &stream )
-                {
-                    targetStreamInfo = &si;
-                    break;
-                }
-            }
 
-            if ( !targetStreamInfo ) [[unlikely]]
+            if ( _stream != &stream ) [[unlikely]]
             {
                 LogError ( "SoundMixer::RecreateSoundStream - Can't find stream." );
                 AV_ASSERT ( false )
                 return;
             }
 
-            if ( auto result = CreateStream ( *targetStreamInfo ); result != std::nullopt ) [[likely]]
+            _stream = nullptr;
+            auto const result = CreateStream ();
+
+            if ( !result ) [[unlikely]]
             {
-                targetStreamInfo->_stream = *result;
+                LogError ( "SoundMixer::RecreateSoundStream - Can't create new AAudioStream." );
+                AV_ASSERT ( false )
                 return;
             }
 
-            LogError ( "SoundMixer::RecreateSoundStream - Can't create new AAudioStream." );
-            AV_ASSERT ( false )
+            _stream = *result;
+
+            if ( _isPaused )
+                return;
+
+            _actionQueue.emplace_back (
+                ActionInfo
+                {
+                    ._handler = &SoundMixer::ExecutePlay,
+                    ._stream = _stream
+                }
+            );
         }
     );
 
     thread.detach ();
 }
 
+bool SoundMixer::RemoveEmitter ( SoundEmitter &emitter, char const* where ) noexcept
+{
+    if ( IsOffline () ) [[unlikely]]
+        return true;
+
+    // See comment in RequestPlay.
+    if ( !_pcmMixer.Remove ( emitter ) ) [[unlikely]]
+    {
+        LogWarning ( "%s - Can't find emitter. Abort...", where );
+        AV_ASSERT ( false )
+        return false;
+    }
+
+    std::lock_guard const lock ( _mutex );
+    _emitters.erase ( &emitter );
+    return true;
+}
+
 bool SoundMixer::ResolveBufferSize () noexcept
 {
     AAudioStream* probe = nullptr;
@@ -818,33 +660,19 @@ aaudio_data_callback_result_t SoundMixer::PCMCallback ( AAudioStream* /*stream*/
     int32_t numFrames
 )
 {
-    auto &si = *static_cast<StreamInfo*> ( userData );
-    constexpr auto sizeFactor = static_cast<size_t> ( GetChannelCount () ) * sizeof ( PCMStreamer::PCMType );
+    auto &mixer = *static_cast<SoundMixer*> ( userData );
 
-    if ( si._mixer->IsOffline () ) [[unlikely]]
-    {
-        std::memset ( audioData, 0, static_cast<size_t> ( numFrames * sizeFactor ) );
-        return AAUDIO_CALLBACK_RESULT_STOP;
-    }
+    std::span const buffer ( static_cast<PCMStreamer::PCMType*> ( audioData ),
+        static_cast<size_t> ( numFrames * GetChannelCount () )
+    );
 
-    if ( si.LockAndReturnFillSilence () )
+    if ( mixer.IsOffline () ) [[unlikely]]
     {
-        std::memset ( audioData, 0,  static_cast<size_t> ( numFrames * sizeFactor ) );
-        si.Release ();
-        return AAUDIO_CALLBACK_RESULT_CONTINUE;
+        std::memset ( buffer.data (), 0, buffer.size_bytes () );
+        return AAUDIO_CALLBACK_RESULT_STOP;
     }
 
-    SoundMixer* mixer = si._mixer;
-
-    si._emitter->FillPCM (
-        std::span ( static_cast<PCMStreamer::PCMType*> ( audioData ),
-            static_cast<size_t> ( numFrames * GetChannelCount () )
-        ),
-
-        mixer->_effectiveChannelVolume[ static_cast<size_t> ( si._emitter->GetSoundChannel () ) ]
-    );
-
-    si.Release ();
+    mixer._pcmMixer.Mix ( buffer, mixer._effectiveChannelVolume );
     return AAUDIO_CALLBACK_RESULT_CONTINUE;
 }
 
@@ -16,9 +16,11 @@ constexpr float MINIMUM_PENETRATION = 1.0e-4F;
 
 SutherlandHodgman::SutherlandHodgman () noexcept
 {
+    _clipFeatures.reserve ( DEFAULT_CAPACITY );
     _clipPoints.reserve ( DEFAULT_CAPACITY );
     _result.reserve ( DEFAULT_CAPACITY );
     _windowPoints.reserve ( DEFAULT_CAPACITY );
+    _workingFeatures.reserve ( DEFAULT_CAPACITY );
     _workingPoints.reserve ( DEFAULT_CAPACITY );
 }
 
@@ -38,6 +40,20 @@ SutherlandHodgmanResult const &SutherlandHodgman::Run ( Vertices const &shapeAPo
     Project ( _windowPoints, shapeAPoints, xAxis, yAxis );
     Project ( _clipPoints, shapeBPoints, xAxis, yAxis );
 
+    size_t const clipPoints = _clipPoints.size ();
+    _clipFeatures.clear ();
+
+    for ( size_t i = 0U; i < clipPoints; ++i )
+    {
+        _clipFeatures.push_back (
+            ClipFeature
+            {
+                ._point = MakeContactFeature ( eContactFeature::IncidentVertex, i ),
+                ._edge = MakeContactFeature ( eContactFeature::IncidentEdge, i )
+            }
+        );
+    }
+
     size_t const windowPoints = _windowPoints.size ();
 
     for ( size_t i = 0U; i < windowPoints; ++i )
@@ -45,6 +61,10 @@ SutherlandHodgmanResult const &SutherlandHodgman::Run ( Vertices const &shapeAPo
         _workingPoints.swap ( _clipPoints );
         _clipPoints.clear ();
 
+        _workingFeatures.swap ( _clipFeatures );
+        _clipFeatures.clear ();
+
+        ContactFeature const clipEdgeFeature = MakeContactFeature ( eContactFeature::ReferenceEdge, i );
         GXVec2 const &clipEdgeOrigin = _windowPoints[ i ];
         GXVec2 clipEdge {};
         clipEdge.Subtract ( _windowPoints[ ( i + 1 ) % windowPoints ], clipEdgeOrigin );
@@ -70,7 +90,12 @@ SutherlandHodgmanResult const &SutherlandHodgman::Run ( Vertices const &shapeAPo
             float const baTest = clipNormal.DotProduct ( ab );
             float const acTest = clipNormal.DotProduct ( ac );
 
-            auto addIntersection = [ & ] () noexcept {
+            ContactFeature const currentEdgeFeature = _workingFeatures[ j ]._edge;
+
+            // The intersection point lies on the clipping edge and on the current polygon edge. The polygon edge
+            // which starts from the intersection point is the current edge on entering and the clipping edge
+            // on leaving.
+            auto addIntersection = [ & ] ( ContactFeature edgeFeature ) noexcept {
                 GXVec2 edge {};
                 edge.Subtract ( next, current );
 
@@ -78,21 +103,30 @@ SutherlandHodgmanResult const &SutherlandHodgman::Run ( Vertices const &shapeAPo
                 GXVec2 alpha {};
                 alpha.Sum ( current, baTest / clipNormal.DotProduct ( edge ), edge );
                 _clipPoints.push_back ( alpha );
+
+                _clipFeatures.push_back (
+                    ClipFeature
+                    {
+                        ._point = CombineContactFeatures ( clipEdgeFeature, currentEdgeFeature ),
+                        ._edge = edgeFeature
+                    }
+                );
             };
 
             if ( acTest >= 0.0F )
             {
                 if ( baTest > 0.0F )
-                    addIntersection ();
+                    addIntersection ( currentEdgeFeature );
 
                 _clipPoints.push_back ( next );
+                _clipFeatures.push_back ( _workingFeatures[ ( j + 1U ) % vertexCount ] );
                 continue;
             }
 
             if ( baTest > 0.0F )
                 continue;
 
-            addIntersection ();
+            addIntersection ( clipEdgeFeature );
         }
     }
 
@@ -105,9 +139,12 @@ SutherlandHodgmanResult const &SutherlandHodgman::Run ( Vertices const &shapeAPo
     originAOffset.Multiply ( shapeANormal, shapeANormal.DotProduct ( shapeAPoints[ 0U ] ) );
 
     GXVec3 const &b0 = shapeBPoints[ 0U ];
+    size_t const resultPoints = _clipPoints.size ();
 
-    for ( auto const &v : _clipPoints )
+    for ( size_t i = 0U; i < resultPoints; ++i )
     {
+        GXVec2 const &v = _clipPoints[ i ];
+
         // Restoring 3D point on shape A...
         GXVec3 alpha {};
         alpha.Sum ( originAOffset, v._data[ 0U ], xAxis );
@@ -127,7 +164,7 @@ SutherlandHodgmanResult const &SutherlandHodgman::Run ( Vertices const &shapeAPo
 
         GXVec3 gamma {};
         gamma.Sum ( alpha, dot, shapeBNormal );
-        _result.emplace_back ( alpha, gamma );
+        _result.emplace_back ( alpha, gamma, _clipFeatures[ i ]._point );
     }
 
     return _result;
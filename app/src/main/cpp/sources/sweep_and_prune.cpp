@@ -0,0 +1,365 @@
+#include <precompiled_headers.hpp>
+#include <sweep_and_prune.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+constexpr uint32_t MAX_ENDPOINT_FLAG = 1U;
+constexpr size_t INITIAL_PROXIES = 1024U;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+SweepAndPrune::SweepAndPrune () noexcept:
+    BroadPhase ( eBroadPhase::SweepAndPrune )
+{
+    for ( auto &endpoints : _endpoints )
+        endpoints.reserve ( INITIAL_PROXIES * 2U );
+
+    _proxies.reserve ( INITIAL_PROXIES );
+}
+
+void SweepAndPrune::Insert ( RigidBodyRef const &body ) noexcept
+{
+    RigidBody &b = *body;
+
+    if ( _proxyMap.contains ( &b ) ) [[unlikely]]
+        return;
+
+    uint32_t idx = _freeList;
+
+    if ( idx == NULL_PROXY )
+    {
+        idx = static_cast<uint32_t> ( _proxies.size () );
+        _proxies.emplace_back ();
+    }
+    else
+    {
+        _freeList = _proxies[ idx ]._nextFree;
+    }
+
+    Proxy &proxy = _proxies[ idx ];
+    proxy._body = body;
+    proxy._groups = b.GetShape ().GetCollisionGroups ();
+    proxy._nextFree = NULL_PROXY;
+    ComputeFatBounds ( proxy._bounds, b, 0.0F );
+
+    // Endpoint arrays must stay sorted. So new endpoints are inserted at proper positions.
+    auto insert = [ & ] ( std::vector<Endpoint> &endpoints, float value, uint32_t flag ) noexcept {
+        Endpoint const endpoint
+        {
+            ._value = value,
+            ._data = ( idx << 1U ) | flag
+        };
+
+        endpoints.insert ( std::upper_bound ( endpoints.cbegin (), endpoints.cend (), endpoint, &IsLess ),
+            endpoint
+        );
+    };
+
+    for ( size_t axis = 0U; axis < 3U; ++axis )
+    {
+        std::vector<Endpoint> &endpoints = _endpoints[ axis ];
+        insert ( endpoints, proxy._bounds._min._data[ axis ], 0U );
+        insert ( endpoints, proxy._bounds._max._data[ axis ], MAX_ENDPOINT_FLAG );
+    }
+
+    GXAABB const &bounds = proxy._bounds;
+
+    Scan ( bounds,
+        [ & ] ( uint32_t other ) noexcept {
+            if ( other != idx && _proxies[ other ]._bounds.IsOverlapped ( bounds ) )
+            {
+                _pairs.Add ( idx, other );
+            }
+        }
+    );
+
+    _proxyMap.emplace ( &b, idx );
+}
+
+void SweepAndPrune::Remove ( RigidBody const &body ) noexcept
+{
+    auto const findResult = _proxyMap.find ( &body );
+
+    if ( findResult == _proxyMap.end () ) [[unlikely]]
+        return;
+
+    uint32_t const idx = findResult->second;
+    _proxyMap.erase ( findResult );
+
+    for ( auto &endpoints : _endpoints )
+    {
+        std::erase_if ( endpoints,
+            [ idx ] ( Endpoint const &endpoint ) noexcept -> bool {
+                return ( endpoint._data >> 1U ) == idx;
+            }
+        );
+    }
+
+    _pairs.RemoveProxy ( idx );
+
+    Proxy &proxy = _proxies[ idx ];
+    proxy._body.reset ();
+    proxy._nextFree = _freeList;
+    _freeList = idx;
+}
+
+void SweepAndPrune::Reset () noexcept
+{
+    _axis = 0U;
+
+    for ( auto &endpoints : _endpoints )
+        endpoints.clear ();
+
+    _freeList = NULL_PROXY;
+    _pairs.Reset ();
+    _proxyMap.clear ();
+    _proxies.clear ();
+}
+
+void SweepAndPrune::Update ( float deltaTime ) noexcept
+{
+    for ( auto &proxy : _proxies )
+    {
+        if ( !proxy._body )
+            continue;
+
+        RigidBody &body = *proxy._body;
+        proxy._groups = body.GetShape ().GetCollisionGroups ();
+
+        if ( IsRefitNeeded ( proxy._bounds, body, deltaTime ) )
+        {
+            ComputeFatBounds ( proxy._bounds, body, deltaTime );
+        }
+    }
+
+    // All bounds must be updated before sorting. The overlap test on a swap uses bounds along all axes.
+    for ( uint8_t axis = 0U; axis < 3U; ++axis )
+    {
+        UpdateEndpointValues ( axis );
+        SortEndpoints ( axis );
+    }
+
+    // All axes are sorted. So switching the query axis costs nothing.
+    _axis = FindQueryAxis ();
+}
+
+void SweepAndPrune::CollectPairs ( Pairs &pairs ) noexcept
+{
+    pairs.clear ();
+
+    for ( auto const &pair : _pairs.GetPairs () )
+    {
+        Proxy const &a = _proxies[ pair._a ];
+        Proxy const &b = _proxies[ pair._b ];
+
+        // The groups and the integration type could be changed by the user at any moment. So they are checked here.
+        if ( !( a._groups & b._groups ) )
+            continue;
+
+        bool const isKinematicA = a._body->IsKinematic ();
+
+        if ( isKinematicA )
+        {
+            if ( !b._body->IsKinematic () )
+                pairs.emplace_back ( &b._body, &a._body );
+
+            continue;
+        }
+
+        pairs.emplace_back ( &a._body, &b._body );
+    }
+}
+
+void SweepAndPrune::QueryBounds ( Bodies &bodies, GXAABB const &bounds ) noexcept
+{
+    bodies.clear ();
+
+    Scan ( bounds,
+        [ & ] ( uint32_t idx ) noexcept {
+            Proxy const &proxy = _proxies[ idx ];
+
+            if ( proxy._bounds.IsOverlapped ( bounds ) )
+            {
+                bodies.push_back ( &proxy._body );
+            }
+        }
+    );
+}
+
+void SweepAndPrune::QueryRay ( Bodies &bodies, GXVec3 const &from, GXVec3 const &to ) noexcept
+{
+    bodies.clear ();
+
+    GXAABB bounds {};
+    bounds.AddVertex ( from );
+    bounds.AddVertex ( to );
+
+    GXVec3 direction {};
+    direction.Subtract ( to, from );
+
+    Scan ( bounds,
+        [ & ] ( uint32_t idx ) noexcept {
+            Proxy const &proxy = _proxies[ idx ];
+
+            if ( proxy._bounds.IsOverlapped ( bounds ) && IsSegmentOverlapped ( proxy._bounds, from, direction ) )
+            {
+                bodies.push_back ( &proxy._body );
+            }
+        }
+    );
+}
+
+uint8_t SweepAndPrune::FindQueryAxis () const noexcept
+{
+    GXVec3 sum ( 0.0F, 0.0F, 0.0F );
+    GXVec3 sumSquared ( 0.0F, 0.0F, 0.0F );
+    size_t count = 0U;
+
+    for ( auto const &proxy : _proxies )
+    {
+        if ( !proxy._body )
+            continue;
+
+        GXVec3 center {};
+        center.Sum ( proxy._bounds._min, proxy._bounds._max );
+        center.Multiply ( center, 0.5F );
+
+        GXVec3 squared {};
+        squared.Init ( center._data[ 0U ] * center._data[ 0U ],
+            center._data[ 1U ] * center._data[ 1U ],
+            center._data[ 2U ] * center._data[ 2U ]
+        );
+
+        sum.Sum ( sum, center );
+        sumSquared.Sum ( sumSquared, squared );
+        ++count;
+    }
+
+    if ( count < 2U )
+        return _axis;
+
+    float const invCount = 1.0F / static_cast<float> ( count );
+    float variance[ 3U ];
+
+    for ( size_t i = 0U; i < 3U; ++i )
+    {
+        float const mean = sum._data[ i ] * invCount;
+        variance[ i ] = sumSquared._data[ i ] * invCount - mean * mean;
+    }
+
+    uint8_t best = 0U;
+
+    for ( uint8_t i = 1U; i < 3U; ++i )
+    {
+        if ( variance[ i ] > variance[ best ] )
+        {
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+void SweepAndPrune::SortEndpoints ( uint8_t axis ) noexcept
+{
+    // Insertion sort. It's almost O(n) for the almost sorted data.
+    Endpoint* endpoints = _endpoints[ axis ].data ();
+    size_t const count = _endpoints[ axis ].size ();
+
+    for ( size_t i = 1U; i < count; ++i )
+    {
+        Endpoint const key = endpoints[ i ];
+        uint32_t const keyProxy = key._data >> 1U;
+        uint32_t const keyFlag = key._data & MAX_ENDPOINT_FLAG;
+        size_t j = i;
+
+        while ( j > 0U && IsLess ( key, endpoints[ j - 1U ] ) )
+        {
+            Endpoint const other = endpoints[ j - 1U ];
+
+            if ( ( other._data & MAX_ENDPOINT_FLAG ) != keyFlag )
+            {
+                uint32_t const otherProxy = other._data >> 1U;
+
+                if ( keyFlag )
+                {
+                    // Maximum endpoint went in front of minimum endpoint. The bounds are separated along the axis.
+                    _pairs.Remove ( keyProxy, otherProxy );
+                }
+                else if ( _proxies[ keyProxy ]._bounds.IsOverlapped ( _proxies[ otherProxy ]._bounds ) )
+                {
+                    // Minimum endpoint went in front of maximum endpoint. The bounds could overlap along all axes now.
+                    _pairs.Add ( keyProxy, otherProxy );
+                }
+            }
+
+            endpoints[ j ] = other;
+            --j;
+        }
+
+        endpoints[ j ] = key;
+    }
+}
+
+void SweepAndPrune::UpdateEndpointValues ( uint8_t axis ) noexcept
+{
+    for ( auto &endpoint : _endpoints[ axis ] )
+    {
+        GXAABB const &bounds = _proxies[ endpoint._data >> 1U ]._bounds;
+        endpoint._value = endpoint._data & MAX_ENDPOINT_FLAG ? bounds._max._data[ axis ] : bounds._min._data[ axis ];
+    }
+}
+
+template<typename T>
+void SweepAndPrune::Scan ( GXAABB const &bounds, T const &visitor ) const noexcept
+{
+    float const low = bounds._min._data[ _axis ];
+    float const high = bounds._max._data[ _axis ];
+
+    std::vector<Endpoint> const &endpoints = _endpoints[ _axis ];
+    auto const begin = endpoints.cbegin ();
+    auto const end = endpoints.cend ();
+
+    auto const first = std::lower_bound ( begin, end, low,
+        [] ( Endpoint const &endpoint, float value ) noexcept -> bool {
+            return endpoint._value < value;
+        }
+    );
+
+    auto const last = std::upper_bound ( first, end, high,
+        [] ( float value, Endpoint const &endpoint ) noexcept -> bool {
+            return value < endpoint._value;
+        }
+    );
+
+    // Overlapped proxy has minimum endpoint in front of the range end and maximum endpoint behind the range start.
+    // The shorter of two scans is used.
+    bool const isPrefix = last - begin <= end - first;
+    auto const scanBegin = isPrefix ? begin : first;
+    auto const scanEnd = isPrefix ? last : end;
+    uint32_t const skipFlag = isPrefix ? MAX_ENDPOINT_FLAG : 0U;
+
+    for ( auto it = scanBegin; it != scanEnd; ++it )
+    {
+        if ( ( it->_data & MAX_ENDPOINT_FLAG ) != skipFlag )
+        {
+            visitor ( it->_data >> 1U );
+        }
+    }
+}
+
+bool SweepAndPrune::IsLess ( Endpoint const &a, Endpoint const &b ) noexcept
+{
+    // Minimum endpoint goes first if values are equal. So touching bounds are reported as overlapped.
+    if ( a._value != b._value )
+        return a._value < b._value;
+
+    return ( a._data & MAX_ENDPOINT_FLAG ) < ( b._data & MAX_ENDPOINT_FLAG );
+}
+
+} // namespace android_vulkan
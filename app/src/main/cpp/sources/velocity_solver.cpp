@@ -20,97 +20,214 @@ static_assert ( STABILIZATION_FACTOR >= 0.0F && STABILIZATION_FACTOR <= 1.0F,
 
 //----------------------------------------------------------------------------------------------------------------------
 
-void VelocitySolver::Run ( ContactManager &contactManager, float fixedTimeStepInverse ) noexcept
+void VelocitySolver::Run ( ContactManager &contactManager,
+    std::span<Constraint* const> constraints,
+    float fixedTimeStepInverse,
+    size_t substeps,
+    size_t dynamicBodies,
+    WorkerPool &workerPool
+) noexcept
 {
     //DebugContactInManifold ( contactManager );
     //DebugWarmStart ( contactManager );
 
-    float const stabilizationFactor = -STABILIZATION_FACTOR * fixedTimeStepInverse;
     auto &manifolds = contactManager.GetContactManifolds ();
+    ColorManifolds ( manifolds, dynamicBodies );
+
+    _constraints = constraints;
+    _manifolds = manifolds.data ();
+    _normalBatches.resize ( manifolds.size () );
+    _fixedTimeStepInverse = fixedTimeStepInverse;
+    _iterations = static_cast<uint16_t> ( std::max ( ( ITERATIONS + substeps - 1U ) / substeps, size_t { 1U } ) );
+
+    // Baumgarte feedback keeps the rate of the fixed step. Contacts are only approximated between the collision
+    // detections. So stiffer feedback of the substeps overshoots and the stacks start to jump.
+    _stabilizationFactor = -STABILIZATION_FACTOR * fixedTimeStepInverse;
+    _substepTimeInverse = fixedTimeStepInverse * static_cast<float> ( substeps );
+    _workerPool = &workerPool;
+
+    workerPool.Run ( &VelocitySolver::Job, this );
+}
+
+void VelocitySolver::ColorManifolds ( std::vector<ContactManifold> &manifolds, size_t dynamicBodies ) noexcept
+{
+    size_t const count = manifolds.size ();
 
-    for ( auto &manifold : manifolds )
+    _bodyColors.clear ();
+    _bodyColors.resize ( dynamicBodies, 0U );
+    _colors.resize ( count );
+    _colorOffsets.fill ( 0U );
+    _colorCount = 0U;
+
+    for ( size_t i = 0U; i < count; ++i )
     {
-        if ( manifold._bodyA->IsKinematic () )
-        {
-            SwapBodies ( manifold );
-            PrepareSingle ( manifold );
-            continue;
-        }
+        ContactManifold const &manifold = manifolds[ i ];
+        RigidBody const &bodyA = *manifold._bodyA;
+        RigidBody const &bodyB = *manifold._bodyB;
+
+        // Kinematic bodies are not changed by the solver. So they don't restrict the color.
+        uint64_t* colorsA = bodyA.IsKinematic () ? nullptr : &_bodyColors[ bodyA.GetIslandIndex () ];
+        uint64_t* colorsB = bodyB.IsKinematic () ? nullptr : &_bodyColors[ bodyB.GetIslandIndex () ];
 
-        if ( manifold._bodyB->IsKinematic () )
+        uint64_t const used = ( colorsA ? *colorsA : 0U ) | ( colorsB ? *colorsB : 0U );
+        size_t color = OVERFLOW_COLOR;
+
+        if ( used != std::numeric_limits<uint64_t>::max () )
         {
-            PrepareSingle ( manifold );
-            continue;
+            color = static_cast<size_t> ( std::countr_one ( used ) );
+            uint64_t const bit = uint64_t { 1U } << color;
+
+            if ( colorsA )
+                *colorsA |= bit;
+
+            if ( colorsB )
+                *colorsB |= bit;
         }
 
-        PreparePair ( manifold );
+        _colors[ i ] = static_cast<uint8_t> ( color );
+        ++_colorOffsets[ color + 1U ];
+        _colorCount = std::max ( _colorCount, color + 1U );
     }
 
-    // Sequential impulse algorithm:
-    // The order is based on idea from Bullet: Solving normal impulses first. Then solving frictional impulses.
+    for ( size_t i = 1U; i < _colorOffsets.size (); ++i )
+        _colorOffsets[ i ] += _colorOffsets[ i - 1U ];
+
+    // Stable counting sort. Manifolds keep the original order inside the color.
+    std::array<size_t, MAX_COLORS + 2U> cursors = _colorOffsets;
+    _order.resize ( count );
+
+    for ( size_t i = 0U; i < count; ++i )
+        _order[ cursors[ _colors[ i ] ]++ ] = static_cast<uint32_t> ( i );
+}
+
+void VelocitySolver::SolveColor ( size_t color, size_t worker, eStage stage ) noexcept
+{
+    size_t begin = _colorOffsets[ color ];
+    size_t end = _colorOffsets[ color + 1U ];
+
+    if ( color == OVERFLOW_COLOR )
+    {
+        if ( worker != 0U )
+            return;
+    }
+    else
+    {
+        size_t const workers = _workerPool->GetWorkerCount ();
+        size_t const chunk = ( end - begin + workers - 1U ) / workers;
+        begin = std::min ( begin + worker * chunk, end );
+        end = std::min ( begin + chunk, end );
+    }
+
+    float const stabilizationFactor = _stabilizationFactor;
+    float const substepTimeInverse = _substepTimeInverse;
 
-    for ( uint16_t i = 0U; i < ITERATIONS; ++i )
+    for ( size_t i = begin; i < end; ++i )
     {
-        // Solving normal impulses.
+        uint32_t const index = _order[ i ];
+        ContactManifold &manifold = _manifolds[ index ];
+        NormalBatch &batch = _normalBatches[ index ];
 
-        for ( auto &manifold : manifolds )
+        switch ( stage )
         {
+            case eStage::Prepare:
+                if ( manifold._bodyA->IsKinematic () )
+                {
+                    SwapBodies ( manifold );
+                    PrepareSingle ( manifold );
+                }
+                else if ( manifold._bodyB->IsKinematic () )
+                {
+                    PrepareSingle ( manifold );
+                }
+                else
+                {
+                    PreparePair ( manifold );
+                }
+
+                PackNormalBatch ( batch, manifold, stabilizationFactor, substepTimeInverse );
+            break;
+
             // Note after preprocessing only B could be kinematic object.
-            if ( manifold._bodyB->IsKinematic () )
-            {
-                SolveSingleNormal ( manifold, stabilizationFactor );
-                continue;
-            }
 
-            SolvePairNormal ( manifold, stabilizationFactor );
+            case eStage::Normal:
+                if ( manifold._bodyB->IsKinematic () )
+                    SolveSingleNormal ( manifold, batch );
+                else
+                    SolvePairNormal ( manifold, batch );
+            break;
+
+            case eStage::Friction:
+                if ( manifold._bodyB->IsKinematic () )
+                    SolveSingleFriction ( manifold );
+                else
+                    SolvePairFriction ( manifold );
+            break;
+
+            case eStage::Joint:
+                // NOTHING
+            break;
         }
+    }
+}
 
-        // Solving friction impulses
+void VelocitySolver::SolveConstraints ( size_t worker, eStage stage ) noexcept
+{
+    if ( worker != 0U )
+        return;
 
-        for ( auto &manifold : manifolds )
-        {
-            // Note after preprocessing only B could be kinematic object.
-            if ( manifold._bodyB->IsKinematic () )
-            {
-                SolveSingleFriction ( manifold );
-                continue;
-            }
+    if ( stage == eStage::Prepare )
+    {
+        float const fixedTimeStepInverse = _fixedTimeStepInverse;
 
-            SolvePairFriction ( manifold );
-        }
+        for ( Constraint* constraint : _constraints )
+            constraint->Prepare ( fixedTimeStepInverse );
+
+        return;
+    }
+
+    for ( Constraint* constraint : _constraints )
+    {
+        constraint->Solve ();
     }
 }
 
-float VelocitySolver::ComputeBaumgarteTerm ( GXVec3 const &wA,
-    GXVec3 const &wB,
-    GXVec3 const &cmA,
-    GXVec3 const &cmB,
-    GXVec3 const &dV,
-    Contact const &contact,
-    float stabilizationFactor
-) noexcept
+void VelocitySolver::Job ( WorkerPool::Context context, size_t worker ) noexcept
 {
-    GXVec3 rA {};
-    rA.Subtract ( contact._pointA, cmA );
+    auto &solver = *static_cast<VelocitySolver*> ( context );
+    WorkerPool &workerPool = *solver._workerPool;
+    size_t const colors = solver._colorCount;
+    bool const hasConstraints = !solver._constraints.empty ();
 
-    GXVec3 rB {};
-    rB.Subtract ( contact._pointB, cmB );
+    auto run = [ & ] ( eStage stage ) noexcept {
+        for ( size_t color = 0U; color < colors; ++color )
+        {
+            solver.SolveColor ( color, worker, stage );
+            workerPool.Barrier ();
+        }
+    };
+
+    auto runConstraints = [ & ] ( eStage stage ) noexcept {
+        if ( !hasConstraints )
+            return;
 
-    // The operands are swapped to get negative vector. It will be used later for "b" calculation.
-    GXVec3 rotA {};
-    rotA.CrossProduct ( rA, wA );
+        solver.SolveConstraints ( worker, stage );
+        workerPool.Barrier ();
+    };
 
-    GXVec3 rotB {};
-    rotB.CrossProduct ( wB, rB );
+    run ( eStage::Prepare );
+    runConstraints ( eStage::Prepare );
 
-    GXVec3 alpha {};
-    alpha.Sum ( rotA, rotB );
+    // Sequential impulse algorithm:
+    // The order is based on idea from Bullet: Solving normal impulses first. Then solving frictional impulses.
 
-    GXVec3 vClosing {};
-    vClosing.Sum ( alpha, dV );
+    uint16_t const iterations = solver._iterations;
 
-    return stabilizationFactor * std::max ( contact._penetration - PENETRATION_SLOPE, 0.0F ) +
-        contact._restitution * std::max ( vClosing.DotProduct ( contact._normal ) - RESTITUTION_SLOPE, 0.0F );
+    for ( uint16_t i = 0U; i < iterations; ++i )
+    {
+        runConstraints ( eStage::Joint );
+        run ( eStage::Normal );
+        run ( eStage::Friction );
+    }
 }
 
 [[maybe_unused]] void VelocitySolver::DebugContactInManifold ( ContactManager const &contactManager ) noexcept
@@ -185,6 +302,52 @@ R"__(Warm starting:
     );
 }
 
+void VelocitySolver::PackNormalBatch ( NormalBatch &batch,
+    ContactManifold const &manifold,
+    float stabilizationFactor,
+    float substepTimeInverse
+) noexcept
+{
+    AV_ASSERT ( manifold._contactCount <= BATCH_LANES )
+    batch = {};
+
+    // Kinematic body B is not changed by the solver. So its "_mj" lanes stay zero.
+    size_t const bodies = manifold._bodyB->IsKinematic () ? 1U : 2U;
+
+    for ( size_t lane = 0U; lane < manifold._contactCount; ++lane )
+    {
+        Contact const &contact = manifold._contacts[ lane ];
+        VelocitySolverData const &data = contact._dataN;
+
+        for ( size_t i = 0U; i < 6U; ++i )
+        {
+            batch._j[ 0U ][ i ][ lane ] = data._j[ 0U ]._data[ i ];
+            batch._j[ 1U ][ i ][ lane ] = data._j[ 1U ]._data[ i ];
+        }
+
+        for ( size_t body = 0U; body < bodies; ++body )
+        {
+            for ( size_t i = 0U; i < 6U; ++i )
+            {
+                batch._mj[ body ][ i ][ lane ] = data._mj[ body ]._data[ i ];
+            }
+        }
+
+        batch._effectiveMass[ lane ] = data._effectiveMass;
+        batch._lambda[ lane ] = data._lambda;
+
+        // Negative penetration is the gap of the speculative contact.
+        float const penetration = contact._penetration;
+
+        batch._stabilization[ lane ] = penetration < 0.0F ?
+            -penetration * substepTimeInverse :
+            stabilizationFactor * std::max ( penetration - PENETRATION_SLOPE, 0.0F );
+
+        batch._restitution[ lane ] = contact._restitution;
+        batch._restitutionBias[ lane ] = -contact._restitution * RESTITUTION_SLOPE;
+    }
+}
+
 void VelocitySolver::PreparePair ( ContactManifold &manifold ) noexcept
 {
     RigidBody &bodyA = *manifold._bodyA.get ();
@@ -379,7 +542,7 @@ void VelocitySolver::SolvePairFriction ( ContactManifold &manifold ) noexcept
     }
 }
 
-void VelocitySolver::SolvePairNormal ( ContactManifold &manifold, float stabilizationFactor ) noexcept
+void VelocitySolver::SolvePairNormal ( ContactManifold &manifold, NormalBatch &batch ) noexcept
 {
     RigidBody &bodyA = *manifold._bodyA.get ();
     RigidBody &bodyB = *manifold._bodyB.get ();
@@ -387,38 +550,15 @@ void VelocitySolver::SolvePairNormal ( ContactManifold &manifold, float stabiliz
     GXVec6 const vw1A = bodyA.GetVelocities ();
     GXVec6 const vw1B = bodyB.GetVelocities ();
 
-    GXVec3 const &wA = bodyA.GetVelocityAngular ();
-    GXVec3 const &wB = bodyB.GetVelocityAngular ();
-
-    GXVec3 const &cmA = bodyA.GetLocation ();
-    GXVec3 const &cmB = bodyB.GetLocation ();
-
-    GXVec6 vwADelta ( 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F );
-    GXVec6 vwBDelta ( 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F );
-
-    GXVec3 deltaVelocityLinear {};
-    deltaVelocityLinear.Subtract ( bodyB.GetVelocityLinear (), bodyA.GetVelocityLinear () );
-
-    auto solve = [ & ] ( Contact &contact ) noexcept {
-        VelocitySolverData &data = contact._dataN;
-        data._b = ComputeBaumgarteTerm ( wA, wB, cmA, cmB, deltaVelocityLinear, contact, stabilizationFactor );
-
-        float const d0 = data._j[ 0U ].DotProduct ( vw1A );
-        float const d1 = data._j[ 1U ].DotProduct ( vw1B );
-
-        float l = data._effectiveMass * ( d0 + d1 + data._b );
-        float const oldLambda = data._lambda;
-        data._lambda = std::max ( 0.0F, data._lambda + l );
-        l = data._lambda - oldLambda;
-
-        vwADelta.Sum ( vwADelta, l, data._mj[ 0U ] );
-        vwBDelta.Sum ( vwBDelta, l, data._mj[ 1U ] );
-    };
+    GXVec6 vwADelta {};
+    GXVec6 vwBDelta {};
+    SolveNormalBatch ( batch, vw1A, vw1B, vwADelta, vwBDelta );
 
+    // Friction limits and warm start cache use the normal impulses of the contacts.
     Contact* contacts = manifold._contacts;
 
     for ( size_t i = 0U; i < manifold._contactCount; ++i )
-        solve ( contacts[ i ] );
+        contacts[ i ]._dataN._lambda = batch._lambda[ i ];
 
     GXVec6 vw2A {};
     vw2A.Sum ( vw1A, vwADelta );
@@ -466,52 +606,22 @@ void VelocitySolver::SolveSingleFriction ( ContactManifold &manifold ) noexcept
     }
 }
 
-void VelocitySolver::SolveSingleNormal ( ContactManifold &manifold, float stabilizationFactor ) noexcept
+void VelocitySolver::SolveSingleNormal ( ContactManifold &manifold, NormalBatch &batch ) noexcept
 {
     RigidBody &bodyDynamic = *manifold._bodyA.get ();
     RigidBody const &bodyKinematic = *manifold._bodyB.get ();
 
-    GXVec6 const vwKinematic = bodyKinematic.GetVelocities ();
     GXVec6 const vwDynamic = bodyDynamic.GetVelocities ();
 
-    GXVec3 const &wDynamic = bodyDynamic.GetVelocityAngular ();
-    GXVec3 const &wKinematic = bodyKinematic.GetVelocityAngular ();
-
-    GXVec3 const &cmDynamic = bodyDynamic.GetLocation ();
-    GXVec3 const &cmKinematic = bodyKinematic.GetLocation ();
-
-    GXVec6 vwDelta ( 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F );
-
-    GXVec3 deltaVelocityLinear {};
-    deltaVelocityLinear.Subtract ( bodyKinematic.GetVelocityLinear (), bodyDynamic.GetVelocityLinear () );
-
-    auto solve = [ & ] ( Contact &contact ) noexcept {
-        VelocitySolverData &data = contact._dataN;
-
-        data._b = ComputeBaumgarteTerm ( wDynamic,
-            wKinematic,
-            cmDynamic,
-            cmKinematic,
-            deltaVelocityLinear,
-            contact,
-            stabilizationFactor
-        );
-
-        float const d0 = data._j[ 0U ].DotProduct ( vwDynamic );
-        float const d1 = data._j[ 1U ].DotProduct ( vwKinematic );
-
-        float l = data._effectiveMass * ( d0 + d1 + data._b );
-        float const oldLambda = data._lambda;
-        data._lambda = std::max ( 0.0F, data._lambda + l );
-        l = data._lambda - oldLambda;
-
-        vwDelta.Sum ( vwDelta, l, data._mj[ 0U ] );
-    };
+    // Kinematic delta is zero because the batch has zero "_mj[ 1U ]" lanes.
+    GXVec6 vwDelta {};
+    GXVec6 vwKinematicDelta {};
+    SolveNormalBatch ( batch, vwDynamic, bodyKinematic.GetVelocities (), vwDelta, vwKinematicDelta );
 
     Contact* contacts = manifold._contacts;
 
     for ( size_t i = 0U; i < manifold._contactCount; ++i )
-        solve ( contacts[ i ] );
+        contacts[ i ]._dataN._lambda = batch._lambda[ i ];
 
     GXVec6 vw2 {};
     vw2.Sum ( vwDynamic, vwDelta );
@@ -0,0 +1,153 @@
+#include <precompiled_headers.hpp>
+#include <worker_pool.hpp>
+
+
+namespace android_vulkan {
+
+namespace {
+
+constexpr size_t SPIN_ITERATIONS = 4096U;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+WorkerPool::~WorkerPool ()
+{
+    Stop ();
+}
+
+void WorkerPool::Barrier () noexcept
+{
+    if ( _threads.empty () )
+        return;
+
+    uint32_t const phase = _barrierPhase.load ( std::memory_order_acquire );
+
+    if ( _barrierCount.fetch_add ( 1U, std::memory_order_acq_rel ) + 1U == _threads.size () + 1U )
+    {
+        // The last worker releases the others. Note the counter must be reset before the phase is changed.
+        _barrierCount.store ( 0U, std::memory_order_relaxed );
+        _barrierPhase.fetch_add ( 1U, std::memory_order_release );
+        return;
+    }
+
+    while ( _barrierPhase.load ( std::memory_order_acquire ) == phase )
+    {
+        std::this_thread::yield ();
+    }
+}
+
+size_t WorkerPool::GetWorkerCount () const noexcept
+{
+    return _threads.size () + 1U;
+}
+
+void WorkerPool::Run ( Job job, Context context ) noexcept
+{
+    if ( _threads.empty () )
+    {
+        job ( context, 0U );
+        return;
+    }
+
+    {
+        std::lock_guard const lock ( _mutex );
+        _job = job;
+        _context = context;
+        _busy.store ( _threads.size (), std::memory_order_relaxed );
+        _generation.fetch_add ( 1U, std::memory_order_release );
+    }
+
+    _condition.notify_all ();
+    job ( context, 0U );
+
+    while ( _busy.load ( std::memory_order_acquire ) != 0U )
+    {
+        std::this_thread::yield ();
+    }
+}
+
+void WorkerPool::Start ( size_t threads ) noexcept
+{
+    Stop ();
+
+    if ( threads == 0U )
+        return;
+
+    _isRunning.store ( true, std::memory_order_relaxed );
+    _threads.reserve ( threads );
+
+    // Note the generation must be captured here. Otherwise the thread could miss the job which was issued before
+    // the thread started.
+    uint32_t const generation = _generation.load ( std::memory_order_relaxed );
+
+    for ( size_t i = 0U; i < threads; ++i )
+    {
+        _threads.emplace_back (
+            [ this, i, generation ] () noexcept {
+                Work ( i + 1U, generation );
+            }
+        );
+    }
+}
+
+void WorkerPool::Stop () noexcept
+{
+    if ( _threads.empty () )
+        return;
+
+    {
+        std::lock_guard const lock ( _mutex );
+        _isRunning.store ( false, std::memory_order_relaxed );
+    }
+
+    _condition.notify_all ();
+
+    for ( auto &thread : _threads )
+        thread.join ();
+
+    _threads.clear ();
+}
+
+void WorkerPool::Work ( size_t worker, uint32_t generationSeen ) noexcept
+{
+    uint32_t seen = generationSeen;
+
+    for ( ; ; )
+    {
+        uint32_t generation = _generation.load ( std::memory_order_acquire );
+
+        for ( size_t i = 0U; i < SPIN_ITERATIONS && generation == seen; ++i )
+        {
+            if ( !_isRunning.load ( std::memory_order_relaxed ) ) [[unlikely]]
+                return;
+
+            std::this_thread::yield ();
+            generation = _generation.load ( std::memory_order_acquire );
+        }
+
+        if ( generation == seen )
+        {
+            std::unique_lock lock ( _mutex );
+
+            _condition.wait ( lock,
+                [ this, seen ] () noexcept -> bool {
+                    return !_isRunning.load ( std::memory_order_relaxed ) ||
+                        _generation.load ( std::memory_order_relaxed ) != seen;
+                }
+            );
+
+            if ( !_isRunning.load ( std::memory_order_relaxed ) )
+                return;
+
+            generation = _generation.load ( std::memory_order_relaxed );
+        }
+
+        seen = generation;
+        _job ( _context, worker );
+        _busy.fetch_sub ( 1U, std::memory_order_release );
+    }
+}
+
+} // namespace android_vulkan
@@ -0,0 +1,13 @@
+#include <precompiled_headers.hpp>
+#include "kernels.hpp"
+
+// The tested backend is compiled into the same translation unit as the kernels like the reference in reference.cpp.
+// So the compiler has the same inlining opportunities for both. The file is selected by CMakeLists.txt.
+#include AV_GXMATH_BACKEND
+
+
+namespace backend {
+
+#include "kernels.ipp"
+
+} // namespace backend
@@ -0,0 +1,66 @@
+#ifndef GXMATH_BENCHMARK_KERNELS_HPP
+#define GXMATH_BENCHMARK_KERNELS_HPP
+
+
+// Every kernel processes "count" cases. The arguments and the result of the case "i" start at "i * KERNEL_STRIDE"
+// float. The kernel unpacks the arguments to the math types, calls the tested method and packs the result. Both kernel
+// sets are compiled from kernels.ipp. So the backend and the reference pay the same price for the packing.
+//
+// Batch kernels call the batch function once for all cases. Vectors, quaternions and boxes are passed as component
+// arrays: component "k" of the case "i" is at "k * count + i" float. Matrices keep the case layout. It's the same
+// as GXMat4 array.
+
+// Enough for GXMat4.
+constexpr size_t KERNEL_STRIDE = 16U;
+
+namespace backend {
+
+void AABBIsOverlapped ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void BatchIsVisible ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void BatchMultiplyAsPoint ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void BatchMultiplyMat4 ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void BatchSphericalLinearInterpolation ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void BatchTransformAABB ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4Inverse ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4Multiply ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4MultiplyAsNormal ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4MultiplyAsPoint ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4MultiplyMatrixVector ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4MultiplyVectorMatrix ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void QuatInverse ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void QuatMultiply ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void QuatNormalize ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void QuatNormalizeFast ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void QuatTransformFast ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Vec3NormalizeFast ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Vec4DotProduct ( float* out, float const* a, float const* b, size_t count ) noexcept;
+
+} // namespace backend
+
+// GXMathCPU.cpp compiled with renamed types. See reference.cpp.
+namespace reference {
+
+void AABBIsOverlapped ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void BatchIsVisible ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void BatchMultiplyAsPoint ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void BatchMultiplyMat4 ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void BatchSphericalLinearInterpolation ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void BatchTransformAABB ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4Inverse ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4Multiply ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4MultiplyAsNormal ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4MultiplyAsPoint ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4MultiplyMatrixVector ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Mat4MultiplyVectorMatrix ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void QuatInverse ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void QuatMultiply ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void QuatNormalize ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void QuatNormalizeFast ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void QuatTransformFast ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Vec3NormalizeFast ( float* out, float const* a, float const* b, size_t count ) noexcept;
+void Vec4DotProduct ( float* out, float const* a, float const* b, size_t count ) noexcept;
+
+} // namespace reference
+
+
+#endif // GXMATH_BENCHMARK_KERNELS_HPP
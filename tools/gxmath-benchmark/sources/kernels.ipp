@@ -0,0 +1,269 @@
+// The file is included inside the kernel namespace. See backend.cpp and reference.cpp.
+
+void AABBIsOverlapped ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXAABB alpha {};
+        std::memcpy ( alpha._min._data, a + i, sizeof ( alpha._min._data ) );
+        std::memcpy ( alpha._max._data, a + i + 3U, sizeof ( alpha._max._data ) );
+
+        GXAABB beta {};
+        std::memcpy ( beta._min._data, b + i, sizeof ( beta._min._data ) );
+        std::memcpy ( beta._max._data, b + i + 3U, sizeof ( beta._max._data ) );
+
+        out[ i ] = alpha.IsOverlapped ( beta ) ? 1.0F : 0.0F;
+    }
+}
+
+template<typename T>
+[[nodiscard]] GXVec3SoA<T> Vec3View ( T* data, size_t count ) noexcept
+{
+    return { { data, count }, { data + count, count }, { data + 2U * count, count } };
+}
+
+template<typename T>
+[[nodiscard]] GXQuatSoA<T> QuatView ( T* data, size_t count ) noexcept
+{
+    return { { data, count }, { data + count, count }, { data + 2U * count, count }, { data + 3U * count, count } };
+}
+
+void BatchIsVisible ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    // The planes are the first six cases of "b". The class has no setter for the planes. So they are copied as is.
+    float planeData[ 24U ];
+
+    for ( size_t i = 0U; i < 6U; ++i )
+    {
+        for ( size_t k = 0U; k < 4U; ++k )
+            planeData[ i * 4U + k ] = b[ k * count + i ];
+    }
+
+    GXProjectionClipPlanes planes {};
+    static_assert ( sizeof ( planes ) == sizeof ( planeData ) );
+    std::memcpy ( &planes, planeData, sizeof ( planeData ) );
+
+    static std::vector<GXUInt> visibility {};
+    visibility.resize ( ( count + 31U ) / 32U );
+    planes.IsVisible ( visibility, { Vec3View ( a, count ), Vec3View ( a + 3U * count, count ) } );
+
+    for ( size_t i = 0U; i < count; ++i )
+        out[ i ] = static_cast<float> ( ( visibility[ i / 32U ] >> ( i % 32U ) ) & 1U );
+}
+
+void BatchMultiplyAsPoint ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    // The matrix of the first case transforms all points.
+    GXMat4 transform {};
+    std::memcpy ( transform._data, a, sizeof ( transform._data ) );
+    GXMultiplyAsPointBatch ( Vec3View ( out, count ), transform, Vec3View ( b, count ) );
+}
+
+void BatchMultiplyMat4 ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    GXMultiplyMat4Batch ( { reinterpret_cast<GXMat4*> ( out ), count },
+        { reinterpret_cast<GXMat4 const*> ( a ), count },
+        { reinterpret_cast<GXMat4 const*> ( b ), count }
+    );
+}
+
+void BatchSphericalLinearInterpolation ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    GXSphericalLinearInterpolationBatch ( QuatView ( out, count ), QuatView ( a, count ), QuatView ( b, count ), 0.3F );
+}
+
+void BatchTransformAABB ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    GXTransformAABBBatch ( { Vec3View ( out, count ), Vec3View ( out + 3U * count, count ) },
+        { Vec3View ( a, count ), Vec3View ( a + 3U * count, count ) },
+        { reinterpret_cast<GXMat4 const*> ( b ), count }
+    );
+}
+
+void Mat4Inverse ( float* out, float const* a, float const* /*b*/, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXMat4 m {};
+        std::memcpy ( m._data, a + i, sizeof ( m._data ) );
+
+        GXMat4 result {};
+        result.Inverse ( m );
+        std::memcpy ( out + i, result._data, sizeof ( result._data ) );
+    }
+}
+
+void Mat4Multiply ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXMat4 alpha {};
+        std::memcpy ( alpha._data, a + i, sizeof ( alpha._data ) );
+
+        GXMat4 beta {};
+        std::memcpy ( beta._data, b + i, sizeof ( beta._data ) );
+
+        GXMat4 result {};
+        result.Multiply ( alpha, beta );
+        std::memcpy ( out + i, result._data, sizeof ( result._data ) );
+    }
+}
+
+void Mat4MultiplyAsNormal ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXMat4 m {};
+        std::memcpy ( m._data, a + i, sizeof ( m._data ) );
+
+        GXVec3 v {};
+        std::memcpy ( v._data, b + i, sizeof ( v._data ) );
+
+        GXVec3 result {};
+        m.MultiplyAsNormal ( result, v );
+        std::memcpy ( out + i, result._data, sizeof ( result._data ) );
+    }
+}
+
+void Mat4MultiplyAsPoint ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXMat4 m {};
+        std::memcpy ( m._data, a + i, sizeof ( m._data ) );
+
+        GXVec3 v {};
+        std::memcpy ( v._data, b + i, sizeof ( v._data ) );
+
+        GXVec3 result {};
+        m.MultiplyAsPoint ( result, v );
+        std::memcpy ( out + i, result._data, sizeof ( result._data ) );
+    }
+}
+
+void Mat4MultiplyMatrixVector ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXMat4 m {};
+        std::memcpy ( m._data, a + i, sizeof ( m._data ) );
+
+        GXVec4 v {};
+        std::memcpy ( v._data, b + i, sizeof ( v._data ) );
+
+        GXVec4 result {};
+        m.MultiplyMatrixVector ( result, v );
+        std::memcpy ( out + i, result._data, sizeof ( result._data ) );
+    }
+}
+
+void Mat4MultiplyVectorMatrix ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXMat4 m {};
+        std::memcpy ( m._data, a + i, sizeof ( m._data ) );
+
+        GXVec4 v {};
+        std::memcpy ( v._data, b + i, sizeof ( v._data ) );
+
+        GXVec4 result {};
+        m.MultiplyVectorMatrix ( result, v );
+        std::memcpy ( out + i, result._data, sizeof ( result._data ) );
+    }
+}
+
+void QuatInverse ( float* out, float const* a, float const* /*b*/, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXQuat q {};
+        std::memcpy ( q._data, a + i, sizeof ( q._data ) );
+
+        GXQuat result {};
+        result.Inverse ( q );
+        std::memcpy ( out + i, result._data, sizeof ( result._data ) );
+    }
+}
+
+void QuatMultiply ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXQuat alpha {};
+        std::memcpy ( alpha._data, a + i, sizeof ( alpha._data ) );
+
+        GXQuat beta {};
+        std::memcpy ( beta._data, b + i, sizeof ( beta._data ) );
+
+        GXQuat result {};
+        result.Multiply ( alpha, beta );
+        std::memcpy ( out + i, result._data, sizeof ( result._data ) );
+    }
+}
+
+void QuatNormalize ( float* out, float const* a, float const* /*b*/, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXQuat q {};
+        std::memcpy ( q._data, a + i, sizeof ( q._data ) );
+
+        q.Normalize ();
+        std::memcpy ( out + i, q._data, sizeof ( q._data ) );
+    }
+}
+
+void QuatNormalizeFast ( float* out, float const* a, float const* /*b*/, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXQuat q {};
+        std::memcpy ( q._data, a + i, sizeof ( q._data ) );
+
+        q.NormalizeFast ();
+        std::memcpy ( out + i, q._data, sizeof ( q._data ) );
+    }
+}
+
+void QuatTransformFast ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXQuat q {};
+        std::memcpy ( q._data, a + i, sizeof ( q._data ) );
+
+        GXVec3 v {};
+        std::memcpy ( v._data, b + i, sizeof ( v._data ) );
+
+        GXVec3 result {};
+        q.TransformFast ( result, v );
+        std::memcpy ( out + i, result._data, sizeof ( result._data ) );
+    }
+}
+
+void Vec3NormalizeFast ( float* out, float const* a, float const* /*b*/, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXVec3 v {};
+        std::memcpy ( v._data, a + i, sizeof ( v._data ) );
+
+        v.NormalizeFast ();
+        std::memcpy ( out + i, v._data, sizeof ( v._data ) );
+    }
+}
+
+void Vec4DotProduct ( float* out, float const* a, float const* b, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count * KERNEL_STRIDE; i += KERNEL_STRIDE )
+    {
+        GXVec4 alpha {};
+        std::memcpy ( alpha._data, a + i, sizeof ( alpha._data ) );
+
+        GXVec4 beta {};
+        std::memcpy ( beta._data, b + i, sizeof ( beta._data ) );
+
+        out[ i ] = alpha.DotProduct ( beta );
+    }
+}
@@ -0,0 +1,395 @@
+#include <precompiled_headers.hpp>
+#include <logger.hpp>
+#include "kernels.hpp"
+
+
+namespace {
+
+using Kernel = void ( * ) ( float* out, float const* a, float const* b, size_t count ) noexcept;
+
+enum class eInput : uint8_t
+{
+    Box,
+    Matrix,
+    None,
+    Plane,
+    Quaternion,
+    Vector
+};
+
+struct Function final
+{
+    std::string_view    _name;
+    Kernel              _backend;
+    Kernel              _reference;
+    eInput              _a;
+    eInput              _b;
+    size_t              _outputs;
+
+    // Vectors, quaternions, boxes and non matrix results are in component layout. See kernels.hpp.
+    bool                _isBatch = false;
+};
+
+constexpr Function const FUNCTIONS[] =
+{
+    {
+        ._name = "GXAABB::IsOverlapped",
+        ._backend = &backend::AABBIsOverlapped,
+        ._reference = &reference::AABBIsOverlapped,
+        ._a = eInput::Box,
+        ._b = eInput::Box,
+        ._outputs = 1U
+    },
+    {
+        ._name = "GXMat4::Inverse",
+        ._backend = &backend::Mat4Inverse,
+        ._reference = &reference::Mat4Inverse,
+        ._a = eInput::Matrix,
+        ._b = eInput::None,
+        ._outputs = 16U
+    },
+    {
+        ._name = "GXMat4::Multiply",
+        ._backend = &backend::Mat4Multiply,
+        ._reference = &reference::Mat4Multiply,
+        ._a = eInput::Matrix,
+        ._b = eInput::Matrix,
+        ._outputs = 16U
+    },
+    {
+        ._name = "GXMat4::MultiplyAsNormal",
+        ._backend = &backend::Mat4MultiplyAsNormal,
+        ._reference = &reference::Mat4MultiplyAsNormal,
+        ._a = eInput::Matrix,
+        ._b = eInput::Vector,
+        ._outputs = 3U
+    },
+    {
+        ._name = "GXMat4::MultiplyAsPoint",
+        ._backend = &backend::Mat4MultiplyAsPoint,
+        ._reference = &reference::Mat4MultiplyAsPoint,
+        ._a = eInput::Matrix,
+        ._b = eInput::Vector,
+        ._outputs = 3U
+    },
+    {
+        ._name = "GXMat4::MultiplyMatrixVector",
+        ._backend = &backend::Mat4MultiplyMatrixVector,
+        ._reference = &reference::Mat4MultiplyMatrixVector,
+        ._a = eInput::Matrix,
+        ._b = eInput::Vector,
+        ._outputs = 4U
+    },
+    {
+        ._name = "GXMat4::MultiplyVectorMatrix",
+        ._backend = &backend::Mat4MultiplyVectorMatrix,
+        ._reference = &reference::Mat4MultiplyVectorMatrix,
+        ._a = eInput::Matrix,
+        ._b = eInput::Vector,
+        ._outputs = 4U
+    },
+    {
+        ._name = "GXQuat::Inverse",
+        ._backend = &backend::QuatInverse,
+        ._reference = &reference::QuatInverse,
+        ._a = eInput::Quaternion,
+        ._b = eInput::None,
+        ._outputs = 4U
+    },
+    {
+        ._name = "GXQuat::Multiply",
+        ._backend = &backend::QuatMultiply,
+        ._reference = &reference::QuatMultiply,
+        ._a = eInput::Quaternion,
+        ._b = eInput::Quaternion,
+        ._outputs = 4U
+    },
+    {
+        ._name = "GXQuat::Normalize",
+        ._backend = &backend::QuatNormalize,
+        ._reference = &reference::QuatNormalize,
+        ._a = eInput::Quaternion,
+        ._b = eInput::None,
+        ._outputs = 4U
+    },
+    {
+        ._name = "GXQuat::NormalizeFast",
+        ._backend = &backend::QuatNormalizeFast,
+        ._reference = &reference::QuatNormalizeFast,
+        ._a = eInput::Quaternion,
+        ._b = eInput::None,
+        ._outputs = 4U
+    },
+    {
+        ._name = "GXQuat::TransformFast",
+        ._backend = &backend::QuatTransformFast,
+        ._reference = &reference::QuatTransformFast,
+        ._a = eInput::Quaternion,
+        ._b = eInput::Vector,
+        ._outputs = 3U
+    },
+    {
+        ._name = "GXVec3::NormalizeFast",
+        ._backend = &backend::Vec3NormalizeFast,
+        ._reference = &reference::Vec3NormalizeFast,
+        ._a = eInput::Vector,
+        ._b = eInput::None,
+        ._outputs = 3U
+    },
+    {
+        ._name = "GXVec4::DotProduct",
+        ._backend = &backend::Vec4DotProduct,
+        ._reference = &reference::Vec4DotProduct,
+        ._a = eInput::Vector,
+        ._b = eInput::Vector,
+        ._outputs = 1U
+    },
+    {
+        ._name = "GXMultiplyAsPointBatch",
+        ._backend = &backend::BatchMultiplyAsPoint,
+        ._reference = &reference::BatchMultiplyAsPoint,
+        ._a = eInput::Matrix,
+        ._b = eInput::Vector,
+        ._outputs = 3U,
+        ._isBatch = true
+    },
+    {
+        ._name = "GXMultiplyMat4Batch",
+        ._backend = &backend::BatchMultiplyMat4,
+        ._reference = &reference::BatchMultiplyMat4,
+        ._a = eInput::Matrix,
+        ._b = eInput::Matrix,
+        ._outputs = 16U,
+        ._isBatch = true
+    },
+    {
+        ._name = "GXProjectionClipPlanes::IsVisible",
+        ._backend = &backend::BatchIsVisible,
+        ._reference = &reference::BatchIsVisible,
+        ._a = eInput::Box,
+        ._b = eInput::Plane,
+        ._outputs = 1U,
+        ._isBatch = true
+    },
+    {
+        ._name = "GXSphericalLinearInterpolationBatch",
+        ._backend = &backend::BatchSphericalLinearInterpolation,
+        ._reference = &reference::BatchSphericalLinearInterpolation,
+        ._a = eInput::Quaternion,
+        ._b = eInput::Quaternion,
+        ._outputs = 4U,
+        ._isBatch = true
+    },
+    {
+        ._name = "GXTransformAABBBatch",
+        ._backend = &backend::BatchTransformAABB,
+        ._reference = &reference::BatchTransformAABB,
+        ._a = eInput::Box,
+        ._b = eInput::Matrix,
+        ._outputs = 6U,
+        ._isBatch = true
+    }
+};
+
+constexpr size_t DEFAULT_CASES = 256U;
+constexpr size_t DEFAULT_CALLS = 1U << 24U;
+
+// The error is the largest component difference divided by the largest reference component but not less than one.
+// Backends reorder the sums and the quaternion transform uses other formula. So the results differ in rounding.
+constexpr float TOLERANCE = 1.0e-5F;
+
+// Linear congruential generator from Numerical Recipes. Same as in physics benchmark.
+constexpr uint32_t RANDOM_MULTIPLIER = 1664525U;
+constexpr uint32_t RANDOM_INCREMENT = 1013904223U;
+constexpr uint32_t RANDOM_SEED = 0x6A09'E667U;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[nodiscard]] static float NextRandom ( uint32_t &state, float from, float to ) noexcept
+{
+    state = state * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+
+    // 24 upper bits fit the float mantissa exactly.
+    constexpr float scale = 1.0F / static_cast<float> ( 1U << 24U );
+    return from + ( to - from ) * static_cast<float> ( state >> 8U ) * scale;
+}
+
+static void Generate ( float* out, eInput input, uint32_t &random ) noexcept
+{
+    switch ( input )
+    {
+        case eInput::Box:
+            for ( size_t i = 0U; i < 3U; ++i )
+            {
+                float const center = NextRandom ( random, -2.0F, 2.0F );
+                float const extent = NextRandom ( random, 0.0F, 1.5F );
+                out[ i ] = center - extent;
+                out[ i + 3U ] = center + extent;
+            }
+        break;
+
+        case eInput::Matrix:
+            // Diagonally dominant matrix is well conditioned. So the inverse is stable.
+            for ( size_t i = 0U; i < KERNEL_STRIDE; ++i )
+                out[ i ] = NextRandom ( random, -1.0F, 1.0F );
+
+            for ( size_t i = 0U; i < 4U; ++i )
+                out[ i * 5U ] += 4.0F;
+        break;
+
+        case eInput::Plane:
+            // Not normalized. Six random planes cull roughly one third of the random boxes.
+            for ( size_t i = 0U; i < 3U; ++i )
+                out[ i ] = NextRandom ( random, -1.0F, 1.0F );
+
+            out[ 3U ] = NextRandom ( random, -1.0F, 1.0F );
+        break;
+
+        case eInput::Quaternion:
+            // Not normalized on purpose. GXQuat::TransformFast must handle it like the scalar backend.
+            out[ 0U ] = NextRandom ( random, 0.5F, 1.0F );
+
+            for ( size_t i = 1U; i < 4U; ++i )
+                out[ i ] = NextRandom ( random, -1.0F, 1.0F );
+        break;
+
+        case eInput::Vector:
+            for ( size_t i = 0U; i < 4U; ++i )
+                out[ i ] = NextRandom ( random, -10.0F, 10.0F );
+        break;
+
+        case eInput::None:
+            // NOTHING
+        break;
+    }
+}
+
+// Component "k" of the case "i" moves from "i * KERNEL_STRIDE + k" to "k * cases + i" float.
+static void ToComponentLayout ( std::vector<float> &data, std::vector<float> &scratch, size_t cases ) noexcept
+{
+    for ( size_t i = 0U; i < cases; ++i )
+    {
+        for ( size_t k = 0U; k < KERNEL_STRIDE; ++k )
+            scratch[ k * cases + i ] = data[ i * KERNEL_STRIDE + k ];
+    }
+
+    data.swap ( scratch );
+}
+
+static void ToCaseLayout ( std::vector<float> &data, std::vector<float> &scratch, size_t cases ) noexcept
+{
+    for ( size_t i = 0U; i < cases; ++i )
+    {
+        for ( size_t k = 0U; k < KERNEL_STRIDE; ++k )
+            scratch[ i * KERNEL_STRIDE + k ] = data[ k * cases + i ];
+    }
+
+    data.swap ( scratch );
+}
+
+[[nodiscard]] static float Measure ( Kernel kernel,
+    std::vector<float> &out,
+    std::vector<float> const &a,
+    std::vector<float> const &b,
+    size_t cases,
+    size_t calls
+) noexcept
+{
+    size_t const rounds = std::max<size_t> ( 1U, calls / cases );
+    auto const start = std::chrono::steady_clock::now ();
+
+    for ( size_t i = 0U; i < rounds; ++i )
+        kernel ( out.data (), a.data (), b.data (), cases );
+
+    std::chrono::duration<double, std::nano> const elapsed = std::chrono::steady_clock::now () - start;
+    return static_cast<float> ( elapsed.count () / static_cast<double> ( rounds * cases ) );
+}
+
+[[nodiscard]] int main ( int argc, char* argv[] )
+{
+    size_t const cases = argc > 1 ? std::max<size_t> ( 1U, std::strtoull ( argv[ 1U ], nullptr, 10 ) ) : DEFAULT_CASES;
+    size_t const calls = argc > 2 ? std::strtoull ( argv[ 2U ], nullptr, 10 ) : DEFAULT_CALLS;
+
+    size_t const floats = cases * KERNEL_STRIDE;
+    std::vector<float> a ( floats, 0.0F );
+    std::vector<float> b ( floats, 0.0F );
+    std::vector<float> backendOut ( floats, 0.0F );
+    std::vector<float> referenceOut ( floats, 0.0F );
+    std::vector<float> scratch ( floats, 0.0F );
+
+    bool isPassed = true;
+
+    for ( Function const &function : FUNCTIONS )
+    {
+        uint32_t random = RANDOM_SEED;
+
+        for ( size_t i = 0U; i < floats; i += KERNEL_STRIDE )
+        {
+            Generate ( a.data () + i, function._a, random );
+            Generate ( b.data () + i, function._b, random );
+        }
+
+        // Matrices and matrix results keep the case layout.
+        bool const isComponentResult = function._isBatch && function._outputs < KERNEL_STRIDE;
+
+        if ( function._isBatch && function._a != eInput::Matrix )
+            ToComponentLayout ( a, scratch, cases );
+
+        if ( function._isBatch && function._b != eInput::Matrix )
+            ToComponentLayout ( b, scratch, cases );
+
+        function._backend ( backendOut.data (), a.data (), b.data (), cases );
+        function._reference ( referenceOut.data (), a.data (), b.data (), cases );
+
+        if ( isComponentResult )
+        {
+            ToCaseLayout ( backendOut, scratch, cases );
+            ToCaseLayout ( referenceOut, scratch, cases );
+        }
+
+        float error = 0.0F;
+
+        for ( size_t i = 0U; i < floats; i += KERNEL_STRIDE )
+        {
+            float const* backendResult = backendOut.data () + i;
+            float const* referenceResult = referenceOut.data () + i;
+
+            float difference = 0.0F;
+            float magnitude = 1.0F;
+
+            for ( size_t j = 0U; j < function._outputs; ++j )
+            {
+                difference = std::max ( difference, std::abs ( backendResult[ j ] - referenceResult[ j ] ) );
+                magnitude = std::max ( magnitude, std::abs ( referenceResult[ j ] ) );
+            }
+
+            error = std::max ( error, difference / magnitude );
+        }
+
+        float const backendTime = Measure ( function._backend, backendOut, a, b, cases, calls );
+        float const referenceTime = Measure ( function._reference, referenceOut, a, b, cases, calls );
+
+        android_vulkan::LogInfo ( "%-36s error %.3g, backend %.2f ns, reference %.2f ns, speedup x%.2f",
+            function._name.data (),
+            static_cast<double> ( error ),
+            static_cast<double> ( backendTime ),
+            static_cast<double> ( referenceTime ),
+            static_cast<double> ( referenceTime / backendTime )
+        );
+
+        if ( error <= TOLERANCE )
+            continue;
+
+        android_vulkan::LogError ( "%s: error %.3g exceeds tolerance %.3g.",
+            function._name.data (),
+            static_cast<double> ( error ),
+            static_cast<double> ( TOLERANCE )
+        );
+
+        isPassed = false;
+    }
+
+    return isPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
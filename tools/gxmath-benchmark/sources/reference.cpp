@@ -0,0 +1,32 @@
+#include <precompiled_headers.hpp>
+#include "kernels.hpp"
+
+// The scalar backend is compiled one more time with renamed types. So the tested backend and the reference live
+// in the same executable.
+#define GXAABB RefAABB
+#define GXAABBSoA RefAABBSoA
+#define GXColorHSV RefColorHSV
+#define GXColorRGB RefColorRGB
+#define GXColorUNORM RefColorUNORM
+#define GXEuler RefEuler
+#define GXMat3 RefMat3
+#define GXMat4 RefMat4
+#define GXPlane RefPlane
+#define GXPreciseComplex RefPreciseComplex
+#define GXProjectionClipPlanes RefProjectionClipPlanes
+#define GXQuat RefQuat
+#define GXQuatSoA RefQuatSoA
+#define GXVec2 RefVec2
+#define GXVec3 RefVec3
+#define GXVec3SoA RefVec3SoA
+#define GXVec4 RefVec4
+#define GXVec6 RefVec6
+
+#include "../../../app/src/main/cpp/sources/GXCommon/Intrinsics/GXMathCPU.cpp"
+
+
+namespace reference {
+
+#include "kernels.ipp"
+
+} // namespace reference
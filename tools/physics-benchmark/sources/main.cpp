@@ -0,0 +1,377 @@
+#include <precompiled_headers.hpp>
+#include <global_force_gravity.hpp>
+#include <logger.hpp>
+#include <physics.hpp>
+#include <shape_box.hpp>
+#include <shape_sphere.hpp>
+
+
+namespace {
+
+enum class eScenario : uint8_t
+{
+    BoxStack,
+    RaycastStorm,
+    SphereRain
+};
+
+struct Scenario final
+{
+    std::string_view    _name;
+    eScenario           _type;
+};
+
+constexpr Scenario const SCENARIOS[] =
+{
+    { ._name = "box_stack", ._type = eScenario::BoxStack },
+    { ._name = "raycast_storm", ._type = eScenario::RaycastStorm },
+    { ._name = "sphere_rain", ._type = eScenario::SphereRain }
+};
+
+constexpr size_t DEFAULT_BODIES = 5000U;
+constexpr size_t DEFAULT_STEPS = 600U;
+constexpr std::string_view SWEEP_AND_PRUNE = "sap";
+
+constexpr float FIXED_TIME_STEP = 1.0F / 60.0F;
+constexpr GXVec3 FREE_FALL_ACCELERATION ( 0.0F, -9.81F, 0.0F );
+constexpr float FLOOR_HEIGHT = 0.5F;
+
+// Same cube stack as pbr::box_stack::BoxStack demo.
+constexpr size_t CUBES_PER_STACK = 6U;
+constexpr GXVec3 CUBE_SIZE ( 0.6F, 0.3F, 0.7F );
+constexpr float CUBE_MASS = 7.77F;
+constexpr float STACK_SPACING = 1.5F;
+
+// Spheres are spawned in layers above the floor. The grid cells are jittered by the deterministic generator.
+constexpr size_t SPHERE_LAYER_SIDE = 32U;
+constexpr float SPHERE_LAYER_SPACING = 1.0F;
+constexpr float SPHERE_MASS = 1.0F;
+constexpr float SPHERE_RADIUS_MAX = 0.35F;
+constexpr float SPHERE_RADIUS_MIN = 0.15F;
+constexpr float SPHERE_SPACING = 1.0F;
+constexpr float SPHERE_START_HEIGHT = 2.0F;
+
+// Rays cross the box stacks from the ring around the field. The ring rotates every step.
+constexpr size_t RAYS_PER_STEP = 1024U;
+constexpr float RAY_HEIGHT_MAX = 2.0F;
+constexpr float RAY_HEIGHT_MIN = 0.05F;
+constexpr float RAY_RING_ROTATION = 1.0e-2F;
+
+// Linear congruential generator from Numerical Recipes. Standard distributions are not portable between standard
+// library implementations. So the generator is implemented explicitly.
+constexpr uint32_t RANDOM_MULTIPLIER = 1664525U;
+constexpr uint32_t RANDOM_INCREMENT = 1013904223U;
+constexpr uint32_t RANDOM_SEED = 0x2F6B'9A11U;
+
+// FNV-1a.
+constexpr uint64_t HASH_OFFSET = 14695981039346656037ULL;
+constexpr uint64_t HASH_PRIME = 1099511628211ULL;
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[nodiscard]] static float NextRandom ( uint32_t &state ) noexcept
+{
+    state = state * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+
+    // 24 upper bits fit the float mantissa exactly. Result is in range [0.0F, 1.0F).
+    constexpr float scale = 1.0F / static_cast<float> ( 1U << 24U );
+    return static_cast<float> ( state >> 8U ) * scale;
+}
+
+static void Hash ( uint64_t &hash, float const* values, size_t count ) noexcept
+{
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        auto const bits = std::bit_cast<uint32_t> ( values[ i ] );
+
+        for ( uint32_t shift = 0U; shift < 32U; shift += 8U )
+        {
+            hash = ( hash ^ ( ( bits >> shift ) & 0xFFU ) ) * HASH_PRIME;
+        }
+    }
+}
+
+[[nodiscard]] static bool AppendBody ( android_vulkan::Physics &physics,
+    std::vector<android_vulkan::RigidBodyRef> &bodies,
+    GXVec3 const &location,
+    android_vulkan::ShapeRef &&shape,
+    float mass
+) noexcept
+{
+    android_vulkan::RigidBodyRef &body = bodies.emplace_back ( std::make_shared<android_vulkan::RigidBody> () );
+    android_vulkan::RigidBody &b = *body;
+    b.SetLocation ( location, true );
+
+    bool const isKinematic = mass == 0.0F;
+
+    if ( isKinematic )
+        b.EnableKinematic ();
+    else
+        b.DisableKinematic ( true );
+
+    b.EnableSleep ();
+    b.SetShape ( shape, true );
+
+    if ( !isKinematic )
+        b.SetMass ( mass, true );
+
+    return physics.AddRigidBody ( body );
+}
+
+[[nodiscard]] static bool AppendFloor ( android_vulkan::Physics &physics,
+    std::vector<android_vulkan::RigidBodyRef> &bodies,
+    float floorSize
+) noexcept
+{
+    return AppendBody ( physics,
+        bodies,
+        GXVec3 ( 0.0F, -0.5F * FLOOR_HEIGHT, 0.0F ),
+        std::make_shared<android_vulkan::ShapeBox> ( floorSize, FLOOR_HEIGHT, floorSize ),
+        0.0F
+    );
+}
+
+[[nodiscard]] static bool CreateBoxStacks ( android_vulkan::Physics &physics,
+    std::vector<android_vulkan::RigidBodyRef> &bodies,
+    float &floorSize,
+    size_t bodyCount
+) noexcept
+{
+    size_t const stacks = ( bodyCount + CUBES_PER_STACK - 1U ) / CUBES_PER_STACK;
+    auto const side = static_cast<size_t> ( std::ceil ( std::sqrt ( static_cast<float> ( stacks ) ) ) );
+    floorSize = static_cast<float> ( side + 1U ) * STACK_SPACING;
+    float const origin = -0.5F * static_cast<float> ( side - 1U ) * STACK_SPACING;
+
+    bodies.reserve ( bodyCount + 1U );
+
+    if ( !AppendFloor ( physics, bodies, floorSize ) ) [[unlikely]]
+        return false;
+
+    float const halfHeight = 0.5F * CUBE_SIZE._data[ 1U ];
+
+    for ( size_t i = 0U; i < bodyCount; ++i )
+    {
+        size_t const stack = i / CUBES_PER_STACK;
+        size_t const level = i % CUBES_PER_STACK;
+
+        GXVec3 const location ( origin + static_cast<float> ( stack % side ) * STACK_SPACING,
+            halfHeight + static_cast<float> ( level ) * CUBE_SIZE._data[ 1U ],
+            origin + static_cast<float> ( stack / side ) * STACK_SPACING
+        );
+
+        android_vulkan::ShapeRef shape = std::make_shared<android_vulkan::ShapeBox> ( CUBE_SIZE );
+
+        if ( !AppendBody ( physics, bodies, location, std::move ( shape ), CUBE_MASS ) ) [[unlikely]]
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+[[nodiscard]] static bool CreateSphereRain ( android_vulkan::Physics &physics,
+    std::vector<android_vulkan::RigidBodyRef> &bodies,
+    float &floorSize,
+    size_t bodyCount
+) noexcept
+{
+    auto const side = std::min ( SPHERE_LAYER_SIDE,
+        static_cast<size_t> ( std::ceil ( std::sqrt ( static_cast<float> ( bodyCount ) ) ) )
+    );
+
+    size_t const perLayer = side * side;
+    floorSize = 2.0F * static_cast<float> ( side + 1U ) * SPHERE_SPACING;
+    float const origin = -0.5F * static_cast<float> ( side - 1U ) * SPHERE_SPACING;
+
+    constexpr float jitter = SPHERE_SPACING - 2.0F * SPHERE_RADIUS_MAX;
+    uint32_t random = RANDOM_SEED;
+
+    bodies.reserve ( bodyCount + 1U );
+
+    if ( !AppendFloor ( physics, bodies, floorSize ) ) [[unlikely]]
+        return false;
+
+    for ( size_t i = 0U; i < bodyCount; ++i )
+    {
+        size_t const layer = i / perLayer;
+        size_t const cell = i % perLayer;
+
+        float const x = origin + static_cast<float> ( cell % side ) * SPHERE_SPACING +
+            jitter * ( NextRandom ( random ) - 0.5F );
+
+        float const z = origin + static_cast<float> ( cell / side ) * SPHERE_SPACING +
+            jitter * ( NextRandom ( random ) - 0.5F );
+
+        float const y = SPHERE_START_HEIGHT + static_cast<float> ( layer ) * SPHERE_LAYER_SPACING;
+        float const radius = SPHERE_RADIUS_MIN + ( SPHERE_RADIUS_MAX - SPHERE_RADIUS_MIN ) * NextRandom ( random );
+
+        android_vulkan::ShapeRef shape = std::make_shared<android_vulkan::ShapeSphere> ( radius );
+
+        if ( !AppendBody ( physics, bodies, GXVec3 ( x, y, z ), std::move ( shape ), SPHERE_MASS ) ) [[unlikely]]
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void CreateRays ( std::vector<android_vulkan::RaycastQuery> &rays, float floorSize, size_t step ) noexcept
+{
+    float const radius = 0.5F * floorSize;
+    float const rotation = RAY_RING_ROTATION * static_cast<float> ( step );
+    constexpr float angleStep = GX_MATH_DOUBLE_PI / static_cast<float> ( RAYS_PER_STEP );
+    constexpr float heightStep = ( RAY_HEIGHT_MAX - RAY_HEIGHT_MIN ) / static_cast<float> ( RAYS_PER_STEP );
+
+    rays.resize ( RAYS_PER_STEP );
+
+    for ( size_t i = 0U; i < RAYS_PER_STEP; ++i )
+    {
+        float const angle = rotation + angleStep * static_cast<float> ( i );
+        float const x = radius * std::cos ( angle );
+        float const z = radius * std::sin ( angle );
+
+        // Every ray goes down across the field. Rays of the neighbour angles differ by height.
+        float const height = RAY_HEIGHT_MIN + heightStep * static_cast<float> ( ( i * 7U ) % RAYS_PER_STEP );
+
+        rays[ i ] =
+        {
+            ._from = GXVec3 ( x, RAY_HEIGHT_MAX, z ),
+            ._to = GXVec3 ( -x, height, -z ),
+            ._groups = std::numeric_limits<uint32_t>::max ()
+        };
+    }
+}
+
+[[nodiscard]] int main ( int argc, char* argv[] )
+{
+    std::string_view const name = argc > 1 ? argv[ 1U ] : SCENARIOS[ 0U ]._name;
+
+    auto const scenario = std::find_if ( std::cbegin ( SCENARIOS ),
+        std::cend ( SCENARIOS ),
+
+        [ name ] ( Scenario const &s ) noexcept -> bool {
+            return s._name == name;
+        }
+    );
+
+    if ( scenario == std::cend ( SCENARIOS ) )
+    {
+        android_vulkan::LogError ( "Unknown scenario '%s'. Supported: box_stack, raycast_storm, sphere_rain.",
+            argv[ 1U ]
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    size_t const bodyCount = argc > 2 ? std::strtoull ( argv[ 2U ], nullptr, 10 ) : DEFAULT_BODIES;
+    size_t const steps = argc > 3 ? std::strtoull ( argv[ 3U ], nullptr, 10 ) : DEFAULT_STEPS;
+
+    android_vulkan::eBroadPhase const broadPhase = argc > 4 && SWEEP_AND_PRUNE == argv[ 4U ] ?
+        android_vulkan::eBroadPhase::SweepAndPrune :
+        android_vulkan::eBroadPhase::AABBTree;
+
+    android_vulkan::Physics physics {};
+    physics.SetBroadPhase ( broadPhase );
+
+    if ( argc > 5 )
+        physics.SetWorkerThreads ( std::strtoull ( argv[ 5U ], nullptr, 10 ) );
+
+    if ( !physics.AddGlobalForce ( std::make_shared<android_vulkan::GlobalForceGravity> ( FREE_FALL_ACCELERATION ) ) )
+    {
+        [[unlikely]]
+        return EXIT_FAILURE;
+    }
+
+    std::vector<android_vulkan::RigidBodyRef> bodies {};
+    float floorSize = 0.0F;
+
+    bool const isCreated = scenario->_type == eScenario::SphereRain ?
+        CreateSphereRain ( physics, bodies, floorSize, bodyCount ) :
+        CreateBoxStacks ( physics, bodies, floorSize, bodyCount );
+
+    if ( !isCreated ) [[unlikely]]
+        return EXIT_FAILURE;
+
+    std::vector<android_vulkan::RaycastQuery> rays {};
+    std::vector<android_vulkan::RaycastResult> hits {};
+    std::chrono::nanoseconds raycast {};
+    uint64_t hash = HASH_OFFSET;
+
+    physics.Resume ();
+    physics.ResetPhaseTimings ();
+
+    size_t contacts = 0U;
+    auto const start = std::chrono::steady_clock::now ();
+
+    for ( size_t i = 0U; i < steps; ++i )
+    {
+        physics.Simulate ( FIXED_TIME_STEP );
+
+        for ( auto const &manifold : physics.GetContactManifolds () )
+            contacts += manifold._contactCount;
+
+        if ( scenario->_type != eScenario::RaycastStorm )
+            continue;
+
+        CreateRays ( rays, floorSize, i );
+
+        auto const raycastStart = std::chrono::steady_clock::now ();
+        physics.RaycastBatch ( hits, rays );
+        raycast += std::chrono::steady_clock::now () - raycastStart;
+
+        for ( auto const &hit : hits )
+        {
+            if ( hit._body )
+            {
+                Hash ( hash, hit._point._data, std::size ( hit._point._data ) );
+            }
+        }
+    }
+
+    std::chrono::duration<double, std::milli> const total = std::chrono::steady_clock::now () - start;
+
+    for ( auto const &body : bodies )
+    {
+        Hash ( hash, body->GetLocation ()._data, std::size ( body->GetLocation ()._data ) );
+        Hash ( hash, body->GetRotation ()._data, std::size ( body->GetRotation ()._data ) );
+    }
+
+    double const stepScale = steps > 0U ? 1.0 / static_cast<double> ( steps ) : 0.0;
+
+    auto perStep = [ stepScale ] ( std::chrono::nanoseconds time ) noexcept -> double {
+        return stepScale * std::chrono::duration<double, std::milli> ( time ).count ();
+    };
+
+    constexpr char const format[] =
+        "%s (%s, %zu worker threads): %zu bodies, %zu steps, total %.3f ms, %.3f ms per step, "
+        "%.1f contacts per step";
+
+    android_vulkan::LogInfo ( format,
+        scenario->_name.data (),
+        broadPhase == android_vulkan::eBroadPhase::SweepAndPrune ? "sweep and prune" : "AABB tree",
+        physics.GetWorkerThreads (),
+        bodyCount,
+        steps,
+        total.count (),
+        stepScale * total.count (),
+        stepScale * static_cast<double> ( contacts )
+    );
+
+    android_vulkan::PhysicsPhaseTimings const &timings = physics.GetPhaseTimings ();
+
+    android_vulkan::LogInfo ( "Per step: broadphase %.3f ms, narrowphase %.3f ms, solve %.3f ms, integrate %.3f ms, "
+        "raycast %.3f ms",
+        perStep ( timings._broadPhase ),
+        perStep ( timings._narrowPhase ),
+        perStep ( timings._solve ),
+        perStep ( timings._integrate ),
+        perStep ( raycast )
+    );
+
+    android_vulkan::LogInfo ( "State hash: %016" PRIx64, hash );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,432 @@
+#include <precompiled_headers.hpp>
+#include <GXCommon/GXMath.hpp>
+#include <logger.hpp>
+#include <pcm_mixer.hpp>
+#include <pcm_streamer_wav.hpp>
+
+
+namespace {
+
+struct Asset final
+{
+    std::string_view    _name;
+    uint16_t            _channels;
+    uint32_t            _frames;
+    bool                _looped;
+
+    // Zero frequency means white noise.
+    float               _frequency;
+};
+
+// The frame counts are not multiple of the burst size. So the loop and the end of sound handlers are involved.
+constexpr Asset const ASSETS[] =
+{
+    { ._name = "mono_loop.wav", ._channels = 1U, ._frames = 44100U, ._looped = true, ._frequency = 440.0F },
+    { ._name = "stereo_loop.wav", ._channels = 2U, ._frames = 30011U, ._looped = true, ._frequency = 261.63F },
+    { ._name = "mono_shot.wav", ._channels = 1U, ._frames = 9001U, ._looped = false, ._frequency = 0.0F },
+    { ._name = "stereo_shot.wav", ._channels = 2U, ._frames = 7919U, ._looped = false, ._frequency = 0.0F }
+};
+
+// The amplitude is high enough to saturate the mix of several dozens sources.
+constexpr float AMPLITUDE = 4000.0F;
+
+constexpr size_t DEFAULT_SOURCES = 64U;
+constexpr size_t DEFAULT_BURSTS = 20000U;
+constexpr size_t DEFAULT_FRAMES = 192U;
+
+constexpr float CHANNEL_VOLUME[ android_vulkan::PCMMixer::TOTAL_SOUND_CHANNELS ] = { 1.0F, 0.8F, 0.6F, 0.9F };
+
+// Periods of the volume change and the pause-play churn in bursts. Prime numbers to not synchronize with anything.
+constexpr size_t VOLUME_PERIOD = 61U;
+constexpr size_t CHURN_PERIOD = 97U;
+
+// Linear congruential generator from Numerical Recipes. The same as in physics benchmark.
+constexpr uint32_t RANDOM_MULTIPLIER = 1664525U;
+constexpr uint32_t RANDOM_INCREMENT = 1013904223U;
+constexpr uint32_t RANDOM_SEED = 0x5D1C'03E7U;
+
+// FNV-1a.
+constexpr uint64_t HASH_OFFSET = 14695981039346656037ULL;
+constexpr uint64_t HASH_PRIME = 1099511628211ULL;
+
+#pragma pack ( push, 1 )
+
+// See WAVEHeader in pcm_streamer_wav.cpp
+struct WAVEHeader final
+{
+    char                _chunkId[ 4U ];
+    uint32_t            _chunkSize;
+
+    char                _format[ 4U ];
+    char                _fmtChunkId[ 4U ];
+    uint32_t            _fmtChunkSize;
+
+    uint16_t            _audioFormat;
+    uint16_t            _numChannels;
+    uint32_t            _sampleRate;
+    uint32_t            _byteRate;
+    uint16_t            _blockAlign;
+    uint16_t            _bitsPerSample;
+
+    char                _dataChunkId[ 4U ];
+    uint32_t            _dataChunkSize;
+};
+
+#pragma pack ( pop )
+
+//----------------------------------------------------------------------------------------------------------------------
+
+class ToneSource final : public android_vulkan::PCMSource
+{
+    private:
+        android_vulkan::eSoundChannel                   _channel;
+        float                                           _leftBefore = 0.0F;
+        float                                           _pan;
+        float                                           _rightBefore = 0.0F;
+        size_t                                          _stops = 0U;
+        std::unique_ptr<android_vulkan::PCMStreamer>    _streamer {};
+        float                                           _volume;
+
+    public:
+        ToneSource () = delete;
+
+        ToneSource ( ToneSource const & ) = delete;
+        ToneSource &operator = ( ToneSource const & ) = delete;
+
+        ToneSource ( ToneSource && ) = delete;
+        ToneSource &operator = ( ToneSource && ) = delete;
+
+        explicit ToneSource ( android_vulkan::eSoundChannel channel, float volume, float pan ) noexcept;
+
+        ~ToneSource () override = default;
+
+        void FillPCM ( std::span<android_vulkan::PCMStreamer::PCMType> buffer, float channelVolume ) noexcept override;
+
+        [[nodiscard]] android_vulkan::eSoundChannel GetSoundChannel () const noexcept;
+        [[nodiscard]] size_t GetStops () const noexcept;
+        void SetVolume ( float volume ) noexcept;
+
+        [[nodiscard]] bool SetSoundAsset ( android_vulkan::SoundStorage &soundStorage,
+            std::string_view const file,
+            bool looped,
+            size_t samplesPerBurst
+        ) noexcept;
+
+    private:
+        static void OnStopRequested ( android_vulkan::PCMSource &source ) noexcept;
+};
+
+ToneSource::ToneSource ( android_vulkan::eSoundChannel channel, float volume, float pan ) noexcept:
+    _channel ( channel ),
+    _pan ( pan ),
+    _streamer ( std::make_unique<android_vulkan::PCMStreamerWAV> ( *this, &ToneSource::OnStopRequested ) ),
+    _volume ( volume )
+{
+    // NOTHING
+}
+
+void ToneSource::FillPCM ( std::span<android_vulkan::PCMStreamer::PCMType> buffer, float channelVolume ) noexcept
+{
+    float const volume = _volume * channelVolume;
+    float const left = volume * ( 1.0F - _pan );
+    float const right = volume * _pan;
+
+    _streamer->GetNextBuffer ( buffer,
+        android_vulkan::PCMStreamer::Gain ( _leftBefore, left ),
+        android_vulkan::PCMStreamer::Gain ( _rightBefore, right )
+    );
+
+    _leftBefore = left;
+    _rightBefore = right;
+}
+
+android_vulkan::eSoundChannel ToneSource::GetSoundChannel () const noexcept
+{
+    return _channel;
+}
+
+size_t ToneSource::GetStops () const noexcept
+{
+    return _stops;
+}
+
+void ToneSource::SetVolume ( float volume ) noexcept
+{
+    _volume = volume;
+}
+
+bool ToneSource::SetSoundAsset ( android_vulkan::SoundStorage &soundStorage,
+    std::string_view const file,
+    bool looped,
+    size_t samplesPerBurst
+) noexcept
+{
+    return _streamer->SetSoundAsset ( soundStorage, file, looped, samplesPerBurst );
+}
+
+void ToneSource::OnStopRequested ( android_vulkan::PCMSource &source ) noexcept
+{
+    // SoundEmitter removes itself from the mixer here. The benchmark keeps the source in the mix to keep the load.
+    ++static_cast<ToneSource &> ( source )._stops;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+[[nodiscard]] static float NextRandom ( uint32_t &state ) noexcept
+{
+    state = state * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+
+    // 24 upper bits fit the float mantissa exactly. Result is in range [0.0F, 1.0F).
+    constexpr float scale = 1.0F / static_cast<float> ( 1U << 24U );
+    return static_cast<float> ( state >> 8U ) * scale;
+}
+
+static void Hash ( uint64_t &hash, std::span<android_vulkan::PCMStreamer::PCMType const> samples ) noexcept
+{
+    for ( auto const sample : samples )
+    {
+        auto const bits = static_cast<uint16_t> ( sample );
+        hash = ( hash ^ static_cast<uint64_t> ( bits & 0xFFU ) ) * HASH_PRIME;
+        hash = ( hash ^ static_cast<uint64_t> ( bits >> 8U ) ) * HASH_PRIME;
+    }
+}
+
+[[nodiscard]] static bool CreateAsset ( std::filesystem::path const &path, Asset const &asset, uint32_t &random ) noexcept
+{
+    constexpr auto sampleRate = static_cast<uint32_t> ( android_vulkan::PCMMixer::GetSampleRate () );
+    constexpr uint16_t bytesPerSample = sizeof ( android_vulkan::PCMStreamer::PCMType );
+
+    auto const blockAlign = static_cast<uint16_t> ( asset._channels * bytesPerSample );
+    uint32_t const dataSize = asset._frames * static_cast<uint32_t> ( blockAlign );
+
+    WAVEHeader const header
+    {
+        ._chunkId = { 'R', 'I', 'F', 'F' },
+        ._chunkSize = static_cast<uint32_t> ( sizeof ( WAVEHeader ) ) - 8U + dataSize,
+        ._format = { 'W', 'A', 'V', 'E' },
+        ._fmtChunkId = { 'f', 'm', 't', ' ' },
+        ._fmtChunkSize = 16U,
+        ._audioFormat = 1U,
+        ._numChannels = asset._channels,
+        ._sampleRate = sampleRate,
+        ._byteRate = sampleRate * static_cast<uint32_t> ( blockAlign ),
+        ._blockAlign = blockAlign,
+        ._bitsPerSample = 8U * bytesPerSample,
+        ._dataChunkId = { 'd', 'a', 't', 'a' },
+        ._dataChunkSize = dataSize
+    };
+
+    std::vector<android_vulkan::PCMStreamer::PCMType> samples ( asset._frames * asset._channels );
+    float const omega = GX_MATH_DOUBLE_PI * asset._frequency / static_cast<float> ( sampleRate );
+
+    for ( size_t i = 0U; i < samples.size (); ++i )
+    {
+        // Stereo channels have different phase. So the pan is audible in the mix.
+        float const phase = static_cast<float> ( i / asset._channels ) * omega +
+            static_cast<float> ( i % asset._channels ) * GX_MATH_HALF_PI;
+
+        float const value = asset._frequency > 0.0F ? std::sin ( phase ) : 2.0F * NextRandom ( random ) - 1.0F;
+        samples[ i ] = static_cast<android_vulkan::PCMStreamer::PCMType> ( AMPLITUDE * value );
+    }
+
+    std::ofstream stream ( path, std::ios::binary );
+
+    if ( !stream.is_open () ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "Can't create %s.", path.c_str () );
+        return false;
+    }
+
+    stream.write ( reinterpret_cast<char const*> ( &header ), sizeof ( header ) );
+    stream.write ( reinterpret_cast<char const*> ( samples.data () ), static_cast<std::streamsize> ( dataSize ) );
+    return stream.good ();
+}
+
+[[nodiscard]] static bool CreateSources ( std::vector<std::unique_ptr<ToneSource>> &sources,
+    android_vulkan::SoundStorage &soundStorage,
+    std::filesystem::path const &directory,
+    size_t count,
+    size_t samplesPerBurst
+) noexcept
+{
+    // Both source sets get the same parameters. So they produce the same samples.
+    uint32_t random = RANDOM_SEED;
+    sources.reserve ( count );
+
+    for ( size_t i = 0U; i < count; ++i )
+    {
+        Asset const &asset = ASSETS[ i % std::size ( ASSETS ) ];
+        auto const channel = static_cast<android_vulkan::eSoundChannel> ( i % std::size ( CHANNEL_VOLUME ) );
+        float const volume = 0.5F + 0.5F * NextRandom ( random );
+        float const pan = NextRandom ( random );
+
+        auto &source = sources.emplace_back ( std::make_unique<ToneSource> ( channel, volume, pan ) );
+
+        if ( !source->SetSoundAsset ( soundStorage, ( directory / asset._name ).string (), asset._looped,
+            samplesPerBurst ) )
+        {
+            [[unlikely]]
+            return false;
+        }
+    }
+
+    return true;
+}
+
+[[nodiscard]] int main ( int argc, char* argv[] )
+{
+    size_t const sourceCount = argc > 1 ? std::strtoull ( argv[ 1U ], nullptr, 10 ) : DEFAULT_SOURCES;
+    size_t const bursts = argc > 2 ? std::strtoull ( argv[ 2U ], nullptr, 10 ) : DEFAULT_BURSTS;
+    size_t const frames = argc > 3 ? std::strtoull ( argv[ 3U ], nullptr, 10 ) : DEFAULT_FRAMES;
+
+    if ( ( sourceCount == 0U ) | ( bursts == 0U ) | ( frames == 0U ) ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "Sources, bursts and frames must be positive." );
+        return EXIT_FAILURE;
+    }
+
+    std::filesystem::path const directory = std::filesystem::temp_directory_path () / "sound-mixer-benchmark";
+    std::error_code error {};
+    std::filesystem::create_directories ( directory, error );
+
+    if ( error ) [[unlikely]]
+    {
+        android_vulkan::LogError ( "Can't create %s.", directory.c_str () );
+        return EXIT_FAILURE;
+    }
+
+    uint32_t random = RANDOM_SEED;
+
+    for ( auto const &asset : ASSETS )
+    {
+        if ( !CreateAsset ( directory / asset._name, asset, random ) ) [[unlikely]]
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    size_t const samplesPerBurst = frames * static_cast<size_t> ( android_vulkan::PCMMixer::GetChannelCount () );
+    android_vulkan::SoundStorage soundStorage {};
+
+    // The mixed set goes through PCMMixer. The reference set is summed explicitly source by source.
+    std::vector<std::unique_ptr<ToneSource>> mixed {};
+    std::vector<std::unique_ptr<ToneSource>> reference {};
+
+    bool const isCreated = CreateSources ( mixed, soundStorage, directory, sourceCount, samplesPerBurst ) &&
+        CreateSources ( reference, soundStorage, directory, sourceCount, samplesPerBurst );
+
+    if ( !isCreated ) [[unlikely]]
+        return EXIT_FAILURE;
+
+    android_vulkan::PCMMixer mixer {};
+    std::vector<size_t> order ( sourceCount );
+    std::iota ( order.begin (), order.end (), 0U );
+
+    for ( auto const &source : mixed )
+    {
+        if ( !mixer.Add ( *source, source->GetSoundChannel () ) ) [[unlikely]]
+        {
+            android_vulkan::LogError ( "Can't add source. Track limit is reached." );
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<android_vulkan::PCMStreamer::PCMType> mixBuffer ( samplesPerBurst );
+    std::vector<android_vulkan::PCMStreamer::PCMType> referenceBuffer ( samplesPerBurst );
+    std::vector<android_vulkan::PCMStreamer::PCMType> sourceBuffer ( samplesPerBurst );
+
+    constexpr auto pcmMax = static_cast<int32_t> ( std::numeric_limits<android_vulkan::PCMStreamer::PCMType>::max () );
+    constexpr auto pcmMin = static_cast<int32_t> ( std::numeric_limits<android_vulkan::PCMStreamer::PCMType>::min () );
+
+    std::chrono::nanoseconds mix {};
+    size_t clipped = 0U;
+    size_t mismatches = 0U;
+    uint64_t hash = HASH_OFFSET;
+
+    for ( size_t burst = 0U; burst < bursts; ++burst )
+    {
+        if ( burst % VOLUME_PERIOD == VOLUME_PERIOD - 1U )
+        {
+            auto const idx = static_cast<size_t> ( NextRandom ( random ) * static_cast<float> ( sourceCount ) );
+            float const volume = NextRandom ( random );
+            mixed[ idx ]->SetVolume ( volume );
+            reference[ idx ]->SetVolume ( volume );
+        }
+
+        if ( burst % CHURN_PERIOD == CHURN_PERIOD - 1U )
+        {
+            // The same as pause and play of the emitter. The source goes to the end of the mix order.
+            auto const pos = static_cast<size_t> ( NextRandom ( random ) * static_cast<float> ( order.size () ) );
+            size_t const idx = order[ pos ];
+            ToneSource &source = *mixed[ idx ];
+
+            if ( !mixer.Remove ( source ) || !mixer.Add ( source, source.GetSoundChannel () ) ) [[unlikely]]
+            {
+                android_vulkan::LogError ( "Pause-play churn failed." );
+                return EXIT_FAILURE;
+            }
+
+            order.erase ( order.cbegin () + static_cast<std::ptrdiff_t> ( pos ) );
+            order.push_back ( idx );
+        }
+
+        auto const start = std::chrono::steady_clock::now ();
+        mixer.Mix ( mixBuffer, CHANNEL_VOLUME );
+        mix += std::chrono::steady_clock::now () - start;
+
+        std::memset ( referenceBuffer.data (), 0, samplesPerBurst * sizeof ( android_vulkan::PCMStreamer::PCMType ) );
+
+        for ( size_t const idx : order )
+        {
+            ToneSource &source = *reference[ idx ];
+            std::memset ( sourceBuffer.data (), 0, samplesPerBurst * sizeof ( android_vulkan::PCMStreamer::PCMType ) );
+            source.FillPCM ( sourceBuffer, CHANNEL_VOLUME[ static_cast<size_t> ( source.GetSoundChannel () ) ] );
+
+            for ( size_t i = 0U; i < samplesPerBurst; ++i )
+            {
+                int32_t const sum = static_cast<int32_t> ( referenceBuffer[ i ] ) +
+                    static_cast<int32_t> ( sourceBuffer[ i ] );
+
+                referenceBuffer[ i ] =
+                    static_cast<android_vulkan::PCMStreamer::PCMType> ( std::clamp ( sum, pcmMin, pcmMax ) );
+            }
+        }
+
+        for ( size_t i = 0U; i < samplesPerBurst; ++i )
+        {
+            auto const sample = static_cast<int32_t> ( referenceBuffer[ i ] );
+            mismatches += static_cast<size_t> ( mixBuffer[ i ] != referenceBuffer[ i ] );
+            clipped += static_cast<size_t> ( ( sample == pcmMin ) | ( sample == pcmMax ) );
+        }
+
+        Hash ( hash, mixBuffer );
+    }
+
+    size_t stops = 0U;
+
+    for ( auto const &source : mixed )
+        stops += source->GetStops ();
+
+    double const mixMs = std::chrono::duration<double, std::milli> ( mix ).count ();
+    double const audioMs = 1.0e+3 * static_cast<double> ( bursts * frames ) /
+        static_cast<double> ( android_vulkan::PCMMixer::GetSampleRate () );
+
+    android_vulkan::LogInfo ( "sound_mixer: %zu sources, %zu bursts of %zu frames, mix %.3f ms, %.3f us per burst, "
+        "realtime x%.1f, clipped %.2f %%, stops %zu, mismatches %zu, hash %016" PRIx64,
+        sourceCount,
+        bursts,
+        frames,
+        mixMs,
+        1.0e+3 * mixMs / static_cast<double> ( bursts ),
+        audioMs / mixMs,
+        100.0 * static_cast<double> ( clipped ) / static_cast<double> ( bursts * samplesPerBurst ),
+        stops,
+        mismatches,
+        hash
+    );
+
+    std::filesystem::remove_all ( directory, error );
+    return mismatches == 0U ? EXIT_SUCCESS : EXIT_FAILURE;
+}